@@ -1,4 +1,4 @@
-import React, { useState, useCallback, useEffect } from 'react';
+import React, { useState, useCallback, useEffect, useMemo } from 'react';
 import { StyleSheet } from 'react-native';
 import { useColorScheme } from '@/hooks/useColorScheme';
 import { Colors } from '@/constants/Colors';
@@ -10,6 +10,7 @@ import { LoadingScreen } from '@/components/LoadingScreen';
 import { VoiceButton } from '@/components/VoiceButton';
 import { ConversationService } from '@/services/ConversationService';
 import { useVoiceInteraction } from '@/hooks/voice/useVoiceInteraction';
+import { VoiceTurnHandlers } from '@/services/VoiceService';
 
 interface Message {
   text: string;
@@ -69,13 +70,34 @@ export default function ConversationTab() {
     [handleSendMessage]
   );
 
+  // Voice turns are answered and spoken natively where the pipeline is
+  // available; handleVoiceInput only sees recordings when it isn't
+  const voiceTurn = useMemo<VoiceTurnHandlers>(() => {
+    let question = '';
+    return {
+      onTranscript: (text) => {
+        question = text;
+        setMessages(prev => [...prev, { text, isUser: true }]);
+        setIsProcessing(true);
+      },
+      onResponse: (text) => {
+        setIsProcessing(false);
+        if (!question || !text) return;
+        setMessages(prev => [...prev, { text, isUser: false }]);
+        ConversationService.getInstance().addExchange(question, text)
+          .catch(error => console.error('Error saving voice turn:', error));
+        question = '';
+      },
+    };
+  }, []);
+
   const handlePressListen = useCallback(async () => {
     if (isListening) {
       await stopListening();
     } else {
-      await startListening(handleVoiceInput);
+      await startListening(handleVoiceInput, voiceTurn);
     }
-  }, [isListening, startListening, stopListening, handleVoiceInput]);
+  }, [isListening, startListening, stopListening, handleVoiceInput, voiceTurn]);
 
   if (!selectedBook) {
     return (
@@ -0,0 +1,191 @@
+#include <jni.h>
+#include <string>
+#include <vector>
+#include "answer-cache-native.h"
+#include <android/log.h>
+
+#define LOG_TAG "AnswerCacheNative"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+using namespace bookmark::answer_cache;
+
+namespace {
+
+std::string toString(JNIEnv* env, jstring value) {
+    const char* utf = env->GetStringUTFChars(value, nullptr);
+    std::string result(utf);
+    env->ReleaseStringUTFChars(value, utf);
+    return result;
+}
+
+} // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_bookmark_AnswerCacheModule_createCacheNative(
+    JNIEnv* env,
+    jobject thiz,
+    jint dimension,
+    jfloat threshold,
+    jint capacity
+) {
+    return reinterpret_cast<jlong>(answer_cache_create(dimension, threshold, capacity));
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_bookmark_AnswerCacheModule_loadCacheNative(
+    JNIEnv* env,
+    jobject thiz,
+    jstring path,
+    jfloat threshold,
+    jint capacity
+) {
+    const char* file_path = env->GetStringUTFChars(path, nullptr);
+    AnswerCache* cache = answer_cache_load(file_path, threshold, capacity);
+    env->ReleaseStringUTFChars(path, file_path);
+    return reinterpret_cast<jlong>(cache);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_AnswerCacheModule_saveCacheNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong cache_ptr,
+    jstring path
+) {
+    auto* cache = reinterpret_cast<AnswerCache*>(cache_ptr);
+    const char* file_path = env->GetStringUTFChars(path, nullptr);
+    bool success = answer_cache_save(cache, file_path);
+    env->ReleaseStringUTFChars(path, file_path);
+    return success;
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_AnswerCacheModule_destroyCacheNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong cache_ptr
+) {
+    answer_cache_destroy(reinterpret_cast<AnswerCache*>(cache_ptr));
+}
+
+JNIEXPORT jint JNICALL
+Java_com_bookmark_AnswerCacheModule_getDimensionNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong cache_ptr
+) {
+    auto* cache = reinterpret_cast<AnswerCache*>(cache_ptr);
+    return cache ? cache->dimension() : 0;
+}
+
+// Returns the cached answer, or null on a miss. The best similarity seen is
+// written to similarity_out either way.
+JNIEXPORT jstring JNICALL
+Java_com_bookmark_AnswerCacheModule_lookupNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong cache_ptr,
+    jstring book_id,
+    jstring index_version,
+    jfloatArray embedding,
+    jfloatArray similarity_out
+) {
+    auto* cache = reinterpret_cast<AnswerCache*>(cache_ptr);
+    if (!cache || env->GetArrayLength(embedding) != cache->dimension()) {
+        return nullptr;
+    }
+
+    std::vector<float> query(cache->dimension());
+    env->GetFloatArrayRegion(embedding, 0, cache->dimension(), query.data());
+
+    std::string answer;
+    float similarity = 0.0f;
+    bool hit = cache->lookup(toString(env, book_id), toString(env, index_version),
+                             query.data(), answer, &similarity);
+    env->SetFloatArrayRegion(similarity_out, 0, 1, &similarity);
+
+    return hit ? env->NewStringUTF(answer.c_str()) : nullptr;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_AnswerCacheModule_insertNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong cache_ptr,
+    jstring book_id,
+    jstring index_version,
+    jfloatArray embedding,
+    jstring answer
+) {
+    auto* cache = reinterpret_cast<AnswerCache*>(cache_ptr);
+    if (!cache || env->GetArrayLength(embedding) != cache->dimension()) {
+        return false;
+    }
+
+    std::vector<float> key(cache->dimension());
+    env->GetFloatArrayRegion(embedding, 0, cache->dimension(), key.data());
+
+    return cache->insert(toString(env, book_id), toString(env, index_version),
+                         key.data(), toString(env, answer));
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_AnswerCacheModule_invalidateNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong cache_ptr,
+    jstring book_id
+) {
+    auto* cache = reinterpret_cast<AnswerCache*>(cache_ptr);
+    const char* id = env->GetStringUTFChars(book_id, nullptr);
+    answer_cache_invalidate(cache, id);
+    env->ReleaseStringUTFChars(book_id, id);
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_AnswerCacheModule_clearNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong cache_ptr
+) {
+    answer_cache_clear(reinterpret_cast<AnswerCache*>(cache_ptr));
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_AnswerCacheModule_setThresholdNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong cache_ptr,
+    jfloat threshold
+) {
+    answer_cache_set_threshold(reinterpret_cast<AnswerCache*>(cache_ptr), threshold);
+}
+
+// hits, misses, invalidations, books, entries
+JNIEXPORT jdoubleArray JNICALL
+Java_com_bookmark_AnswerCacheModule_getStatsNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong cache_ptr
+) {
+    AnswerCacheStats stats;
+    if (!answer_cache_get_stats(reinterpret_cast<AnswerCache*>(cache_ptr), &stats)) {
+        return nullptr;
+    }
+
+    const jdouble values[] = {
+        static_cast<jdouble>(stats.hits),
+        static_cast<jdouble>(stats.misses),
+        static_cast<jdouble>(stats.invalidations),
+        static_cast<jdouble>(stats.books),
+        static_cast<jdouble>(stats.entries),
+    };
+    jdoubleArray result = env->NewDoubleArray(5);
+    env->SetDoubleArrayRegion(result, 0, 5, values);
+    return result;
+}
+
+} // extern "C"
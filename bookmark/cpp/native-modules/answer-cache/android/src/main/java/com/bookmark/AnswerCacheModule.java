@@ -0,0 +1,192 @@
+package com.bookmark;
+
+import com.facebook.react.bridge.ReactApplicationContext;
+import com.facebook.react.bridge.ReactContextBaseJavaModule;
+import com.facebook.react.bridge.ReactMethod;
+import com.facebook.react.bridge.Promise;
+import com.facebook.react.bridge.ReadableArray;
+import com.facebook.react.bridge.WritableMap;
+import com.facebook.react.bridge.Arguments;
+
+public class AnswerCacheModule extends ReactContextBaseJavaModule {
+    private long cachePtr = 0;
+
+    static {
+        System.loadLibrary("answer-cache-native");
+    }
+
+    public AnswerCacheModule(ReactApplicationContext reactContext) {
+        super(reactContext);
+    }
+
+    @Override
+    public String getName() {
+        return "AnswerCacheNative";
+    }
+
+    private void destroyCache() {
+        if (cachePtr != 0) {
+            destroyCacheNative(cachePtr);
+            cachePtr = 0;
+        }
+    }
+
+    private static float[] toFloatArray(ReadableArray values) {
+        float[] result = new float[values.size()];
+        for (int i = 0; i < values.size(); i++) {
+            result[i] = (float) values.getDouble(i);
+        }
+        return result;
+    }
+
+    // Loads the cache saved at path, falling back to an empty one when there
+    // is none or it was built for another embedding width
+    @ReactMethod
+    public synchronized void initialize(int dimension, String path, double threshold, int capacity, Promise promise) {
+        try {
+            destroyCache();
+            if (path != null) {
+                cachePtr = loadCacheNative(path, (float) threshold, capacity);
+                if (cachePtr != 0 && getDimensionNative(cachePtr) != dimension) {
+                    destroyCache();
+                }
+            }
+            if (cachePtr == 0) {
+                cachePtr = createCacheNative(dimension, (float) threshold, capacity);
+            }
+            promise.resolve(cachePtr != 0);
+        } catch (Exception e) {
+            promise.reject("ERR_ANSWER_CACHE", "Failed to initialize answer cache: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void lookup(String bookId, String indexVersion, ReadableArray embedding, Promise promise) {
+        try {
+            if (cachePtr == 0) {
+                throw new IllegalStateException("Answer cache not initialized");
+            }
+
+            float[] similarity = new float[1];
+            String answer = lookupNative(cachePtr, bookId, indexVersion, toFloatArray(embedding), similarity);
+            if (answer == null) {
+                promise.resolve(null);
+                return;
+            }
+
+            WritableMap result = Arguments.createMap();
+            result.putString("answer", answer);
+            result.putDouble("similarity", similarity[0]);
+            promise.resolve(result);
+        } catch (Exception e) {
+            promise.reject("ERR_ANSWER_CACHE", "Failed to look up answer: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void insert(String bookId, String indexVersion, ReadableArray embedding, String answer, Promise promise) {
+        try {
+            if (cachePtr == 0) {
+                throw new IllegalStateException("Answer cache not initialized");
+            }
+
+            promise.resolve(insertNative(cachePtr, bookId, indexVersion, toFloatArray(embedding), answer));
+        } catch (Exception e) {
+            promise.reject("ERR_ANSWER_CACHE", "Failed to cache answer: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void invalidate(String bookId, Promise promise) {
+        try {
+            if (cachePtr != 0) {
+                invalidateNative(cachePtr, bookId);
+            }
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_ANSWER_CACHE", "Failed to invalidate answers: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void clear(Promise promise) {
+        try {
+            if (cachePtr != 0) {
+                clearNative(cachePtr);
+            }
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_ANSWER_CACHE", "Failed to clear answer cache: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void save(String path, Promise promise) {
+        try {
+            if (cachePtr == 0) {
+                throw new IllegalStateException("Answer cache not initialized");
+            }
+
+            promise.resolve(saveCacheNative(cachePtr, path));
+        } catch (Exception e) {
+            promise.reject("ERR_ANSWER_CACHE", "Failed to save answer cache: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void setThreshold(double threshold, Promise promise) {
+        try {
+            if (cachePtr == 0) {
+                throw new IllegalStateException("Answer cache not initialized");
+            }
+
+            setThresholdNative(cachePtr, (float) threshold);
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_ANSWER_CACHE", "Failed to set threshold: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void getStats(Promise promise) {
+        try {
+            if (cachePtr == 0) {
+                throw new IllegalStateException("Answer cache not initialized");
+            }
+
+            double[] stats = getStatsNative(cachePtr);
+            WritableMap result = Arguments.createMap();
+            result.putDouble("hits", stats[0]);
+            result.putDouble("misses", stats[1]);
+            result.putDouble("invalidations", stats[2]);
+            result.putInt("books", (int) stats[3]);
+            result.putInt("entries", (int) stats[4]);
+            promise.resolve(result);
+        } catch (Exception e) {
+            promise.reject("ERR_ANSWER_CACHE", "Failed to get answer cache stats: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void cleanup(Promise promise) {
+        try {
+            destroyCache();
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_ANSWER_CACHE", "Failed to cleanup answer cache: " + e.getMessage());
+        }
+    }
+
+    // Native method declarations
+    private native long createCacheNative(int dimension, float threshold, int capacity);
+    private native long loadCacheNative(String path, float threshold, int capacity);
+    private native boolean saveCacheNative(long cachePtr, String path);
+    private native void destroyCacheNative(long cachePtr);
+    private native int getDimensionNative(long cachePtr);
+    private native String lookupNative(long cachePtr, String bookId, String indexVersion, float[] embedding, float[] similarityOut);
+    private native boolean insertNative(long cachePtr, String bookId, String indexVersion, float[] embedding, String answer);
+    private native void invalidateNative(long cachePtr, String bookId);
+    private native void clearNative(long cachePtr);
+    private native void setThresholdNative(long cachePtr, float threshold);
+    private native double[] getStatsNative(long cachePtr);
+}
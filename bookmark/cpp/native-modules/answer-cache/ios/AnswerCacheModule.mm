@@ -0,0 +1,176 @@
+#import "AnswerCacheModule.h"
+#import <React/RCTLog.h>
+#import "answer-cache-native.h"
+
+using namespace bookmark::answer_cache;
+
+@implementation AnswerCacheModule {
+    AnswerCache* _cache;
+}
+
+RCT_EXPORT_MODULE(AnswerCacheNative)
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _cache = nullptr;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self destroyCache];
+}
+
+- (void)destroyCache {
+    if (_cache != nullptr) {
+        answer_cache_destroy(_cache);
+        _cache = nullptr;
+    }
+}
+
+static std::vector<float> toFloats(NSArray* values) {
+    std::vector<float> result(values.count);
+    for (NSUInteger i = 0; i < values.count; i++) {
+        result[i] = [values[i] floatValue];
+    }
+    return result;
+}
+
+// Loads the cache saved at path, falling back to an empty one when there is
+// none or it was built for another embedding width
+RCT_EXPORT_METHOD(initialize:(nonnull NSNumber*)dimension
+                  path:(NSString*)path
+                  threshold:(nonnull NSNumber*)threshold
+                  capacity:(nonnull NSNumber*)capacity
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        [self destroyCache];
+        if (path != nil) {
+            _cache = answer_cache_load([path UTF8String], [threshold floatValue], [capacity unsignedLongValue]);
+            if (_cache != nullptr && _cache->dimension() != [dimension intValue]) {
+                [self destroyCache];
+            }
+        }
+        if (_cache == nullptr) {
+            _cache = answer_cache_create([dimension intValue], [threshold floatValue], [capacity unsignedLongValue]);
+        }
+        resolve(@(_cache != nullptr));
+    } @catch (NSException* e) {
+        reject(@"ERR_ANSWER_CACHE", @"Failed to initialize answer cache", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(lookup:(NSString*)bookId
+                  indexVersion:(NSString*)indexVersion
+                  embedding:(NSArray*)embedding
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_cache == nullptr) {
+            reject(@"ERR_ANSWER_CACHE", @"Answer cache not initialized", nil);
+            return;
+        }
+
+        std::vector<float> query = toFloats(embedding);
+        if (query.size() != static_cast<size_t>(_cache->dimension())) {
+            resolve(nil);
+            return;
+        }
+
+        std::string answer;
+        float similarity = 0.0f;
+        if (!_cache->lookup([bookId UTF8String], [indexVersion UTF8String], query.data(), answer, &similarity)) {
+            resolve(nil);
+            return;
+        }
+        resolve(@{@"answer": @(answer.c_str()), @"similarity": @(similarity)});
+    } @catch (NSException* e) {
+        reject(@"ERR_ANSWER_CACHE", @"Failed to look up answer", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(insert:(NSString*)bookId
+                  indexVersion:(NSString*)indexVersion
+                  embedding:(NSArray*)embedding
+                  answer:(NSString*)answer
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_cache == nullptr) {
+            reject(@"ERR_ANSWER_CACHE", @"Answer cache not initialized", nil);
+            return;
+        }
+
+        std::vector<float> key = toFloats(embedding);
+        bool success = answer_cache_insert(
+            _cache,
+            [bookId UTF8String],
+            [indexVersion UTF8String],
+            key.data(),
+            key.size(),
+            [answer UTF8String]
+        );
+        resolve(@(success));
+    } @catch (NSException* e) {
+        reject(@"ERR_ANSWER_CACHE", @"Failed to cache answer", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(invalidate:(NSString*)bookId
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    answer_cache_invalidate(_cache, [bookId UTF8String]);
+    resolve(nil);
+}
+
+RCT_EXPORT_METHOD(clear:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    answer_cache_clear(_cache);
+    resolve(nil);
+}
+
+RCT_EXPORT_METHOD(save:(NSString*)path
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    if (_cache == nullptr) {
+        reject(@"ERR_ANSWER_CACHE", @"Answer cache not initialized", nil);
+        return;
+    }
+    resolve(@(answer_cache_save(_cache, [path UTF8String])));
+}
+
+RCT_EXPORT_METHOD(setThreshold:(nonnull NSNumber*)threshold
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    if (_cache == nullptr) {
+        reject(@"ERR_ANSWER_CACHE", @"Answer cache not initialized", nil);
+        return;
+    }
+    answer_cache_set_threshold(_cache, [threshold floatValue]);
+    resolve(nil);
+}
+
+RCT_EXPORT_METHOD(getStats:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    AnswerCacheStats stats;
+    if (!answer_cache_get_stats(_cache, &stats)) {
+        reject(@"ERR_ANSWER_CACHE", @"Answer cache not initialized", nil);
+        return;
+    }
+    resolve(@{
+        @"hits": @(stats.hits),
+        @"misses": @(stats.misses),
+        @"invalidations": @(stats.invalidations),
+        @"books": @(stats.books),
+        @"entries": @(stats.entries)
+    });
+}
+
+RCT_EXPORT_METHOD(cleanup:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    [self destroyCache];
+    resolve(nil);
+}
+
+@end
@@ -0,0 +1,354 @@
+#include "answer-cache-native.h"
+#include "metrics-native.h"
+#include "binary-io.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+
+namespace bookmark {
+namespace answer_cache {
+
+namespace {
+
+using binary_io::Reader;
+using binary_io::Writer;
+using binary_io::readFile;
+
+const char kCacheMagic[] = "BMAC";
+constexpr uint32_t kFormatVersion = 1;
+
+} // namespace
+
+AnswerCache* AnswerCache::create(int dimension, float threshold, size_t capacity) {
+    if (dimension <= 0 || capacity == 0) return nullptr;
+    return new AnswerCache(dimension, threshold, capacity);
+}
+
+AnswerCache::AnswerCache(int dimension, float threshold, size_t capacity)
+    : dimension_(dimension), threshold_(threshold), capacity_(capacity) {}
+
+AnswerCache* AnswerCache::load(const std::string& path, float threshold, size_t capacity) {
+    try {
+        std::string data;
+        if (!readFile(path, data)) {
+            return nullptr;
+        }
+
+        Reader reader(data);
+        std::string_view magic;
+        uint32_t version, dimension, book_count;
+        if (!reader.bytes(4, magic) || magic != std::string_view(kCacheMagic, 4) ||
+            !reader.u32(version) || version != kFormatVersion ||
+            !reader.u32(dimension) || dimension == 0 || !reader.u32(book_count)) {
+            return nullptr;
+        }
+
+        std::unique_ptr<AnswerCache> cache(create(static_cast<int>(dimension), threshold, capacity));
+        if (!cache) return nullptr;
+
+        std::vector<float> rows;
+        for (uint32_t b = 0; b < book_count; ++b) {
+            std::string book_id, index_version;
+            uint32_t entry_count;
+            if (!reader.string(book_id) || !reader.string(index_version) || !reader.u32(entry_count)) {
+                return nullptr;
+            }
+
+            Book& book = cache->books_[book_id];
+            book.index_version = index_version;
+            book.index = std::make_unique<::faiss::IndexFlatIP>(static_cast<int>(dimension));
+
+            rows.resize(static_cast<size_t>(entry_count) * dimension);
+            book.entries.resize(entry_count);
+            for (uint32_t e = 0; e < entry_count; ++e) {
+                Entry& entry = book.entries[e];
+                if (!reader.string(entry.answer) || !reader.u64(entry.last_used)) return nullptr;
+                for (uint32_t d = 0; d < dimension; ++d) {
+                    if (!reader.f32(rows[static_cast<size_t>(e) * dimension + d])) return nullptr;
+                }
+                cache->clock_ = std::max(cache->clock_, entry.last_used);
+            }
+            if (entry_count > 0) {
+                book.index->add(entry_count, rows.data());
+            }
+
+            // The file may come from a build with a larger capacity
+            while (book.entries.size() > cache->capacity_) {
+                cache->evict(book);
+            }
+        }
+
+        return cache.release();
+    } catch (...) {
+        metrics::reportException(metrics::Module::AnswerCache, "load");
+        return nullptr;
+    }
+}
+
+bool AnswerCache::save(const std::string& path) const {
+    try {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        Writer writer;
+        writer.bytes(std::string_view(kCacheMagic, 4));
+        writer.u32(kFormatVersion);
+        writer.u32(static_cast<uint32_t>(dimension_));
+        writer.u32(static_cast<uint32_t>(books_.size()));
+
+        std::vector<float> row(dimension_);
+        for (const auto& [book_id, book] : books_) {
+            writer.string(book_id);
+            writer.string(book.index_version);
+            writer.u32(static_cast<uint32_t>(book.entries.size()));
+
+            for (size_t e = 0; e < book.entries.size(); ++e) {
+                writer.string(book.entries[e].answer);
+                writer.u64(book.entries[e].last_used);
+                book.index->reconstruct(static_cast<::faiss::idx_t>(e), row.data());
+                for (float value : row) writer.f32(value);
+            }
+        }
+
+        return writer.writeTo(path);
+    } catch (...) {
+        metrics::reportException(metrics::Module::AnswerCache, "save");
+        return false;
+    }
+}
+
+bool AnswerCache::lookup(const std::string& book_id,
+                         const std::string& index_version,
+                         const float* embedding,
+                         std::string& answer_out,
+                         float* similarity_out) {
+    if (!embedding) return false;
+    std::vector<float> query = normalized(embedding);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Book* book = bookFor(book_id, index_version, false);
+    if (!book || book->entries.empty() || query.empty()) {
+        ++misses_;
+        metrics::increment(metrics::Counter::AnswerCacheMisses);
+        return false;
+    }
+
+    try {
+        float similarity;
+        ::faiss::idx_t row;
+        book->index->search(1, query.data(), 1, &similarity, &row);
+        if (similarity_out) *similarity_out = similarity;
+
+        if (row < 0 || similarity < threshold_) {
+            ++misses_;
+            metrics::increment(metrics::Counter::AnswerCacheMisses);
+            return false;
+        }
+
+        Entry& entry = book->entries[static_cast<size_t>(row)];
+        entry.last_used = ++clock_;
+        answer_out = entry.answer;
+        ++hits_;
+        metrics::increment(metrics::Counter::AnswerCacheHits);
+        return true;
+    } catch (...) {
+        metrics::reportException(metrics::Module::AnswerCache, "lookup");
+        return false;
+    }
+}
+
+bool AnswerCache::insert(const std::string& book_id,
+                         const std::string& index_version,
+                         const float* embedding,
+                         const std::string& answer) {
+    if (!embedding || answer.empty()) return false;
+    std::vector<float> key = normalized(embedding);
+    if (key.empty()) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Book* book = bookFor(book_id, index_version, true);
+
+    try {
+        // A rephrasing close enough to hit replaces the older answer
+        if (!book->entries.empty()) {
+            float similarity;
+            ::faiss::idx_t row;
+            book->index->search(1, key.data(), 1, &similarity, &row);
+            if (row >= 0 && similarity >= threshold_) {
+                Entry& entry = book->entries[static_cast<size_t>(row)];
+                entry.answer = answer;
+                entry.last_used = ++clock_;
+                return true;
+            }
+        }
+
+        if (book->entries.size() >= capacity_) {
+            evict(*book);
+        }
+        book->index->add(1, key.data());
+        book->entries.push_back({answer, ++clock_});
+        return true;
+    } catch (...) {
+        metrics::reportException(metrics::Module::AnswerCache, "insert");
+        return false;
+    }
+}
+
+void AnswerCache::invalidate(const std::string& book_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    books_.erase(book_id);
+}
+
+void AnswerCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    books_.clear();
+}
+
+void AnswerCache::setThreshold(float threshold) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    threshold_ = threshold;
+}
+
+AnswerCacheStats AnswerCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AnswerCacheStats stats = {};
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.invalidations = invalidations_;
+    stats.books = static_cast<uint32_t>(books_.size());
+    for (const auto& [book_id, book] : books_) {
+        stats.entries += static_cast<uint32_t>(book.entries.size());
+    }
+    return stats;
+}
+
+AnswerCache::Book* AnswerCache::bookFor(const std::string& book_id,
+                                        const std::string& index_version,
+                                        bool create) {
+    auto it = books_.find(book_id);
+    if (it != books_.end() && it->second.index_version != index_version) {
+        books_.erase(it);
+        it = books_.end();
+        ++invalidations_;
+    }
+    if (it != books_.end()) return &it->second;
+    if (!create) return nullptr;
+
+    Book& book = books_[book_id];
+    book.index_version = index_version;
+    book.index = std::make_unique<::faiss::IndexFlatIP>(dimension_);
+    return &book;
+}
+
+void AnswerCache::evict(Book& book) {
+    // Drop the least recently used quarter at once; the flat index can only
+    // be rebuilt, so evicting one entry per insert would rebuild every time
+    const size_t keep = book.entries.size() - std::max<size_t>(1, book.entries.size() / 4);
+
+    std::vector<size_t> order(book.entries.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&book](size_t a, size_t b) {
+        return book.entries[a].last_used > book.entries[b].last_used;
+    });
+    order.resize(keep);
+    std::sort(order.begin(), order.end());
+
+    std::vector<float> rows(keep * dimension_);
+    std::vector<Entry> entries;
+    entries.reserve(keep);
+    for (size_t i = 0; i < keep; ++i) {
+        book.index->reconstruct(static_cast<::faiss::idx_t>(order[i]), rows.data() + i * dimension_);
+        entries.push_back(std::move(book.entries[order[i]]));
+    }
+
+    book.index->reset();
+    if (keep > 0) book.index->add(static_cast<::faiss::idx_t>(keep), rows.data());
+    book.entries = std::move(entries);
+}
+
+std::vector<float> AnswerCache::normalized(const float* embedding) const {
+    double norm = 0.0;
+    for (int i = 0; i < dimension_; ++i) norm += static_cast<double>(embedding[i]) * embedding[i];
+    if (norm <= 0.0) return {};
+
+    const float scale = static_cast<float>(1.0 / std::sqrt(norm));
+    std::vector<float> unit(embedding, embedding + dimension_);
+    for (float& value : unit) value *= scale;
+    return unit;
+}
+
+// C API Implementation
+extern "C" {
+
+AnswerCache* answer_cache_create(int dimension, float threshold, size_t capacity) {
+    return AnswerCache::create(dimension, threshold, capacity);
+}
+
+AnswerCache* answer_cache_load(const char* path, float threshold, size_t capacity) {
+    if (!path) return nullptr;
+    return AnswerCache::load(path, threshold, capacity);
+}
+
+bool answer_cache_save(AnswerCache* cache, const char* path) {
+    if (!cache || !path) return false;
+    return cache->save(path);
+}
+
+void answer_cache_destroy(AnswerCache* cache) {
+    delete cache;
+}
+
+size_t answer_cache_lookup(AnswerCache* cache,
+                           const char* book_id,
+                           const char* index_version,
+                           const float* embedding,
+                           size_t embedding_size,
+                           char* answer_out,
+                           size_t answer_size,
+                           float* similarity_out) {
+    if (!cache || !book_id || !index_version || !embedding || !answer_out) return 0;
+    if (embedding_size != static_cast<size_t>(cache->dimension())) return 0;
+
+    std::string answer;
+    if (!cache->lookup(book_id, index_version, embedding, answer, similarity_out) ||
+        answer.size() >= answer_size) {
+        return 0;
+    }
+    memcpy(answer_out, answer.c_str(), answer.size() + 1);
+    return answer.size();
+}
+
+bool answer_cache_insert(AnswerCache* cache,
+                         const char* book_id,
+                         const char* index_version,
+                         const float* embedding,
+                         size_t embedding_size,
+                         const char* answer) {
+    if (!cache || !book_id || !index_version || !embedding || !answer) return false;
+    if (embedding_size != static_cast<size_t>(cache->dimension())) return false;
+    return cache->insert(book_id, index_version, embedding, answer);
+}
+
+void answer_cache_invalidate(AnswerCache* cache, const char* book_id) {
+    if (cache && book_id) cache->invalidate(book_id);
+}
+
+void answer_cache_clear(AnswerCache* cache) {
+    if (cache) cache->clear();
+}
+
+void answer_cache_set_threshold(AnswerCache* cache, float threshold) {
+    if (cache) cache->setThreshold(threshold);
+}
+
+bool answer_cache_get_stats(AnswerCache* cache, AnswerCacheStats* stats_out) {
+    if (!cache || !stats_out) return false;
+    *stats_out = cache->stats();
+    return true;
+}
+
+} // extern "C"
+
+} // namespace answer_cache
+} // namespace bookmark
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <faiss/IndexFlat.h>
+
+namespace bookmark {
+namespace answer_cache {
+
+// Cosine similarity a question needs with a cached one to reuse its answer
+constexpr float kDefaultThreshold = 0.95f;
+// Answers kept per book before the least recently used are evicted
+constexpr size_t kDefaultCapacity = 256;
+
+struct AnswerCacheStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t invalidations; // books dropped because their index changed
+    uint32_t books;
+    uint32_t entries;
+};
+
+// Answers to past questions, keyed by book and looked up by question
+// embedding, so a reader re-asking "who is X?" skips search and generation.
+//
+// Each book has a small inner-product FAISS index over unit-length question
+// embeddings, so scores are cosine similarities. Entries are stamped with an
+// opaque version of the book's search index; a lookup or insert with another
+// version drops the book's answers, since they were grounded in chunks that
+// may no longer exist. Safe to use from several threads.
+class AnswerCache {
+public:
+    static AnswerCache* create(int dimension,
+                               float threshold = kDefaultThreshold,
+                               size_t capacity = kDefaultCapacity);
+    static AnswerCache* load(const std::string& path,
+                             float threshold = kDefaultThreshold,
+                             size_t capacity = kDefaultCapacity);
+    ~AnswerCache() = default;
+
+    bool save(const std::string& path) const;
+
+    // Fills answer_out with the answer to the closest cached question about
+    // book_id, if it scores at least the threshold
+    bool lookup(const std::string& book_id,
+                const std::string& index_version,
+                const float* embedding,
+                std::string& answer_out,
+                float* similarity_out = nullptr);
+    bool insert(const std::string& book_id,
+                const std::string& index_version,
+                const float* embedding,
+                const std::string& answer);
+
+    void invalidate(const std::string& book_id);
+    void clear();
+
+    void setThreshold(float threshold);
+    int dimension() const { return dimension_; }
+    AnswerCacheStats stats() const;
+
+private:
+    struct Entry {
+        std::string answer;
+        uint64_t last_used;
+    };
+
+    // Rows of index line up with entries
+    struct Book {
+        std::string index_version;
+        std::unique_ptr<::faiss::IndexFlatIP> index;
+        std::vector<Entry> entries;
+    };
+
+    AnswerCache(int dimension, float threshold, size_t capacity);
+
+    // Returns the book's entries, dropping them first if they were recorded
+    // against another index version. Null for an unknown book unless create.
+    Book* bookFor(const std::string& book_id, const std::string& index_version, bool create);
+    void evict(Book& book);
+    std::vector<float> normalized(const float* embedding) const;
+
+    int dimension_;
+    float threshold_;
+    size_t capacity_;
+    uint64_t clock_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t invalidations_ = 0;
+    std::unordered_map<std::string, Book> books_;
+    mutable std::mutex mutex_;
+};
+
+// React Native binding interface
+extern "C" {
+    AnswerCache* answer_cache_create(int dimension, float threshold, size_t capacity);
+    AnswerCache* answer_cache_load(const char* path, float threshold, size_t capacity);
+    bool answer_cache_save(AnswerCache* cache, const char* path);
+    void answer_cache_destroy(AnswerCache* cache);
+    // Copies the answer, NUL-terminated, and returns its length; 0 on a miss
+    // or when answer_size is too small
+    size_t answer_cache_lookup(AnswerCache* cache,
+                               const char* book_id,
+                               const char* index_version,
+                               const float* embedding,
+                               size_t embedding_size,
+                               char* answer_out,
+                               size_t answer_size,
+                               float* similarity_out);
+    bool answer_cache_insert(AnswerCache* cache,
+                             const char* book_id,
+                             const char* index_version,
+                             const float* embedding,
+                             size_t embedding_size,
+                             const char* answer);
+    void answer_cache_invalidate(AnswerCache* cache, const char* book_id);
+    void answer_cache_clear(AnswerCache* cache);
+    void answer_cache_set_threshold(AnswerCache* cache, float threshold);
+    bool answer_cache_get_stats(AnswerCache* cache, AnswerCacheStats* stats_out);
+}
+
+} // namespace answer_cache
+} // namespace bookmark
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bookmark {
+namespace bench {
+
+// Path from the environment, empty when unset
+inline std::string envPath(const char* name) {
+    const char* value = std::getenv(name);
+    return value ? value : "";
+}
+
+// Unit-normalized random vectors, like the embeddings FAISS sees in the app
+inline std::vector<float> randomVectors(size_t count, int dimension, uint32_t seed = 42) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+
+    std::vector<float> data(count * dimension);
+    for (size_t i = 0; i < count; ++i) {
+        float* row = data.data() + i * dimension;
+        float norm = 0.0f;
+        for (int d = 0; d < dimension; ++d) {
+            row[d] = dist(rng);
+            norm += row[d] * row[d];
+        }
+        norm = std::sqrt(norm);
+        for (int d = 0; d < dimension; ++d) {
+            row[d] /= norm;
+        }
+    }
+    return data;
+}
+
+// Speech-band tone with a little noise, for when no recording is supplied
+inline std::vector<float> syntheticSpeech(double seconds, int sample_rate) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-0.02f, 0.02f);
+
+    std::vector<float> samples(static_cast<size_t>(seconds * sample_rate));
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const double t = static_cast<double>(i) / sample_rate;
+        samples[i] = 0.3f * static_cast<float>(std::sin(2.0 * M_PI * 220.0 * t)) + noise(rng);
+    }
+    return samples;
+}
+
+// Public-domain prose used by the text benchmarks
+inline const std::string& samplePassage() {
+    static const std::string passage =
+        "Call me Ishmael. Some years ago, never mind how long precisely, having little or no "
+        "money in my purse, and nothing particular to interest me on shore, I thought I would "
+        "sail about a little and see the watery part of the world. It is a way I have of "
+        "driving off the spleen and regulating the circulation. Whenever I find myself growing "
+        "grim about the mouth; whenever it is a damp, drizzly November in my soul; whenever I "
+        "find myself involuntarily pausing before coffin warehouses, and bringing up the rear "
+        "of every funeral I meet; then, I account it high time to get to sea as soon as I can.";
+    return passage;
+}
+
+} // namespace bench
+} // namespace bookmark
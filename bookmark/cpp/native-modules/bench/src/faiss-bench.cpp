@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+
+#include <faiss/index_factory.h>
+
+#include "bench-util.h"
+#include "faiss-native.h"
+
+using bookmark::faiss::FaissIndex;
+using namespace bookmark::bench;
+
+namespace {
+
+constexpr int kDimension = 768; // RAGService index width
+constexpr int kTopK = 3;        // RAGService.query default
+
+std::string tempIndexPath() {
+    return (std::filesystem::temp_directory_path() / "bookmark-bench.index").string();
+}
+
+std::unique_ptr<FaissIndex> filledIndex(size_t count) {
+    std::unique_ptr<FaissIndex> index(FaissIndex::create(kDimension));
+    auto data = randomVectors(count, kDimension);
+    index->addBatch(data.data(), count);
+    return index;
+}
+
+} // namespace
+
+// One add() per chunk, as RAGService.addText does today
+static void BM_FaissAddSingle(benchmark::State& state) {
+    const size_t count = state.range(0);
+    auto data = randomVectors(count, kDimension);
+
+    for (auto _ : state) {
+        std::unique_ptr<FaissIndex> index(FaissIndex::create(kDimension));
+        for (size_t i = 0; i < count; ++i) {
+            index->add(std::vector<float>(data.begin() + i * kDimension, data.begin() + (i + 1) * kDimension));
+        }
+        benchmark::DoNotOptimize(index->size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_FaissAddSingle)->Arg(1000)->Arg(8000)->Unit(benchmark::kMillisecond);
+
+static void BM_FaissAddBatch(benchmark::State& state) {
+    const size_t count = state.range(0);
+    auto data = randomVectors(count, kDimension);
+
+    for (auto _ : state) {
+        std::unique_ptr<FaissIndex> index(FaissIndex::create(kDimension));
+        index->addBatch(data.data(), count);
+        benchmark::DoNotOptimize(index->size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_FaissAddBatch)->Arg(1000)->Arg(8000)->Arg(32000)->Unit(benchmark::kMillisecond);
+
+static void BM_FaissSearch(benchmark::State& state) {
+    auto index = filledIndex(state.range(0));
+    auto queries = randomVectors(64, kDimension, 7);
+
+    size_t q = 0;
+    for (auto _ : state) {
+        std::vector<float> query(queries.begin() + q * kDimension, queries.begin() + (q + 1) * kDimension);
+        benchmark::DoNotOptimize(index->search(query, kTopK));
+        q = (q + 1) % 64;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FaissSearch)->Arg(1000)->Arg(8000)->Arg(32000)->Unit(benchmark::kMicrosecond);
+
+static void BM_FaissSave(benchmark::State& state) {
+    auto index = filledIndex(state.range(0));
+    const std::string path = tempIndexPath();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index->save(path));
+    }
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_FaissSave)->Arg(1000)->Arg(8000)->Arg(32000)->Unit(benchmark::kMillisecond);
+
+static void BM_FaissLoad(benchmark::State& state) {
+    const std::string path = tempIndexPath();
+    filledIndex(state.range(0))->save(path);
+
+    for (auto _ : state) {
+        std::unique_ptr<FaissIndex> index(FaissIndex::load(path));
+        benchmark::DoNotOptimize(index.get());
+    }
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_FaissLoad)->Arg(1000)->Arg(8000)->Arg(32000)->Unit(benchmark::kMillisecond);
+
+// Index types the wrapper could move to, built straight through FAISS so
+// build cost and search latency can be compared against the flat index
+static void BM_FaissIndexTypeBuild(benchmark::State& state, const char* description) {
+    const size_t count = state.range(0);
+    auto data = randomVectors(count, kDimension);
+
+    for (auto _ : state) {
+        std::unique_ptr<::faiss::Index> index(::faiss::index_factory(kDimension, description));
+        if (!index->is_trained) {
+            index->train(count, data.data());
+        }
+        index->add(count, data.data());
+        benchmark::DoNotOptimize(index->ntotal);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_FaissIndexTypeSearch(benchmark::State& state, const char* description) {
+    const size_t count = state.range(0);
+    auto data = randomVectors(count, kDimension);
+    auto queries = randomVectors(64, kDimension, 7);
+
+    std::unique_ptr<::faiss::Index> index(::faiss::index_factory(kDimension, description));
+    if (!index->is_trained) {
+        index->train(count, data.data());
+    }
+    index->add(count, data.data());
+
+    std::vector<float> distances(kTopK);
+    std::vector<::faiss::idx_t> labels(kTopK);
+    size_t q = 0;
+    for (auto _ : state) {
+        index->search(1, queries.data() + q * kDimension, kTopK, distances.data(), labels.data());
+        benchmark::DoNotOptimize(labels.data());
+        q = (q + 1) % 64;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_CAPTURE(BM_FaissIndexTypeBuild, flat, "Flat")->Arg(8000)->Arg(32000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FaissIndexTypeBuild, hnsw32, "HNSW32")->Arg(8000)->Arg(32000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FaissIndexTypeBuild, ivf256, "IVF256,Flat")->Arg(8000)->Arg(32000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FaissIndexTypeSearch, flat, "Flat")->Arg(8000)->Arg(32000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_FaissIndexTypeSearch, hnsw32, "HNSW32")->Arg(8000)->Arg(32000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_FaissIndexTypeSearch, ivf256, "IVF256,Flat")->Arg(8000)->Arg(32000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+
+#include "bench-util.h"
+#include "mlc-llm-native.h"
+
+using bookmark::mlc_llm::LLMContext;
+using namespace bookmark::bench;
+
+namespace {
+
+// Loaded once for every LLM benchmark; a small local model keeps runs short
+LLMContext* sharedLLM(benchmark::State& state) {
+    static std::unique_ptr<LLMContext> ctx = []() -> std::unique_ptr<LLMContext> {
+        const std::string model = envPath("BOOKMARK_BENCH_LLM_MODEL");
+        const std::string tokenizer = envPath("BOOKMARK_BENCH_LLM_TOKENIZER");
+        if (model.empty() || tokenizer.empty()) return nullptr;
+
+        std::unique_ptr<LLMContext> llm(LLMContext::create(model, tokenizer));
+        if (!llm || !llm->loadModel()) return nullptr;
+        return llm;
+    }();
+
+    if (!ctx) {
+        state.SkipWithError("Set BOOKMARK_BENCH_LLM_MODEL and BOOKMARK_BENCH_LLM_TOKENIZER to a loadable model");
+    }
+    return ctx.get();
+}
+
+} // namespace
+
+static void BM_LLMEmbedding(benchmark::State& state) {
+    LLMContext* llm = sharedLLM(state);
+    if (!llm) return;
+
+    const std::string& text = samplePassage();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(llm->getEmbeddings(text));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_LLMEmbedding)->Unit(benchmark::kMillisecond);
+
+static void BM_LLMEmbeddingBatch(benchmark::State& state) {
+    LLMContext* llm = sharedLLM(state);
+    if (!llm) return;
+
+    std::vector<std::string> texts(state.range(0), samplePassage());
+    std::vector<float> out;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(llm->getEmbeddingsBatch(texts, out));
+    }
+    state.SetItemsProcessed(state.iterations() * texts.size());
+}
+BENCHMARK(BM_LLMEmbeddingBatch)->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMillisecond);
+
+static void BM_LLMGenerate(benchmark::State& state) {
+    LLMContext* llm = sharedLLM(state);
+    if (!llm) return;
+
+    const int max_tokens = static_cast<int>(state.range(0));
+    const std::string prompt = "Context:\n" + samplePassage() + "\n\nQuestion: Why does the narrator go to sea?\n\nAnswer:";
+
+    size_t tokens = 0;
+    double first_token_ms = 0.0;
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        bool first = true;
+        // Greedy-ish sampling keeps output length comparable between runs
+        llm->generateStream(prompt, "You are a helpful assistant.", max_tokens, 0.0f, 1.0f,
+            [&](const std::string&) {
+                if (first) {
+                    first_token_ms += std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start).count();
+                    first = false;
+                }
+                ++tokens;
+                return true;
+            });
+    }
+
+    state.counters["tokens_per_second"] = benchmark::Counter(tokens, benchmark::Counter::kIsRate);
+    state.counters["first_token_ms"] = benchmark::Counter(first_token_ms, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_LLMGenerate)->Arg(32)->Arg(128)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "bench-util.h"
+#include "terms-native.h"
+
+using bookmark::terms::TermDictionary;
+using bookmark::terms::Tokenizer;
+using namespace bookmark::bench;
+
+namespace {
+
+// Sample passage repeated up to roughly the requested size
+std::string bookText(size_t bytes) {
+    std::string text;
+    text.reserve(bytes + samplePassage().size());
+    while (text.size() < bytes) {
+        text += samplePassage();
+        text += ' ';
+    }
+    return text;
+}
+
+} // namespace
+
+static void BM_TermsTokenize(benchmark::State& state) {
+    const std::string text = bookText(state.range(0));
+
+    for (auto _ : state) {
+        Tokenizer tokenizer(text.data(), text.size());
+        std::string_view term;
+        size_t offset;
+        size_t tokens = 0;
+        while (tokenizer.next(term, offset)) {
+            ++tokens;
+        }
+        benchmark::DoNotOptimize(tokens);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_TermsTokenize)->Arg(1 << 20)->Arg(8 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_TermsBuild(benchmark::State& state) {
+    const std::string text = bookText(state.range(0));
+
+    for (auto _ : state) {
+        std::unique_ptr<TermDictionary> dictionary(TermDictionary::build(text.data(), text.size()));
+        benchmark::DoNotOptimize(dictionary->termCount());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_TermsBuild)->Arg(1 << 20)->Arg(8 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_TermsTopK(benchmark::State& state) {
+    const std::string text = bookText(8 << 20);
+    std::unique_ptr<TermDictionary> dictionary(TermDictionary::build(text.data(), text.size()));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dictionary->topTerms(state.range(0)));
+    }
+}
+BENCHMARK(BM_TermsTopK)->Arg(20)->Arg(200)->Unit(benchmark::kMicrosecond);
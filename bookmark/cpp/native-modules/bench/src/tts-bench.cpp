@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "bench-util.h"
+#include "tts-native.h"
+
+using bookmark::tts::TTSContext;
+using namespace bookmark::bench;
+
+namespace {
+
+TTSContext* sharedTTS(benchmark::State& state) {
+    static std::unique_ptr<TTSContext> ctx = []() -> std::unique_ptr<TTSContext> {
+        const std::string model = envPath("BOOKMARK_BENCH_TTS_MODEL");
+        const std::string config = envPath("BOOKMARK_BENCH_TTS_CONFIG");
+        if (model.empty() || config.empty()) return nullptr;
+
+        std::unique_ptr<TTSContext> tts(TTSContext::create(model, config));
+        if (!tts || !tts->loadModel()) return nullptr;
+        return tts;
+    }();
+
+    if (!ctx) {
+        state.SkipWithError("Set BOOKMARK_BENCH_TTS_MODEL and BOOKMARK_BENCH_TTS_CONFIG to a Piper voice");
+    }
+    return ctx.get();
+}
+
+// First n sentences of the sample passage
+std::string sentences(size_t n) {
+    const std::string& passage = samplePassage();
+    size_t end = 0;
+    for (size_t i = 0; i < n && end != std::string::npos; ++i) {
+        end = passage.find_first_of(".;", end + 1);
+    }
+    return end == std::string::npos ? passage : passage.substr(0, end + 1);
+}
+
+} // namespace
+
+// Phonemes are cached after the first iteration, so this measures the
+// steady state of repeated answers; phonemize_ms shows what remains
+static void BM_TTSSynthesize(benchmark::State& state) {
+    TTSContext* tts = sharedTTS(state);
+    if (!tts) return;
+
+    const std::string text = sentences(state.range(0));
+    size_t samples = 0;
+    double phonemize_ms = 0.0;
+    double inference_ms = 0.0;
+
+    for (auto _ : state) {
+        std::vector<float> audio = tts->synthesize(text);
+        samples += audio.size();
+
+        const auto stats = tts->lastStats();
+        phonemize_ms += stats.phonemize_ms;
+        inference_ms += stats.inference_ms;
+    }
+
+    state.counters["samples_per_second"] = benchmark::Counter(samples, benchmark::Counter::kIsRate);
+    state.counters["audio_seconds_per_second"] =
+        benchmark::Counter(static_cast<double>(samples) / tts->sampleRate(), benchmark::Counter::kIsRate);
+    state.counters["phonemize_ms"] = benchmark::Counter(phonemize_ms, benchmark::Counter::kAvgIterations);
+    state.counters["inference_ms"] = benchmark::Counter(inference_ms, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_TTSSynthesize)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+#include "bench-util.h"
+#include "whisper-native.h"
+
+using bookmark::whisper::WhisperContext;
+using namespace bookmark::bench;
+
+namespace {
+
+constexpr int kSampleRate = 16000;
+
+WhisperContext* sharedWhisper(benchmark::State& state) {
+    static std::unique_ptr<WhisperContext> ctx = []() -> std::unique_ptr<WhisperContext> {
+        const std::string model = envPath("BOOKMARK_BENCH_WHISPER_MODEL");
+        if (model.empty()) return nullptr;
+        return std::unique_ptr<WhisperContext>(WhisperContext::create(model));
+    }();
+
+    if (!ctx) {
+        state.SkipWithError("Set BOOKMARK_BENCH_WHISPER_MODEL to a ggml Whisper model");
+    }
+    return ctx.get();
+}
+
+// 16 kHz mono 16-bit PCM WAV, as VoiceService records
+bool readWav(const std::string& path, std::vector<float>& samples) {
+    std::ifstream in(path, std::ios::binary);
+    char header[12];
+    if (!in.read(header, 12) || memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    char id[4];
+    uint32_t size;
+    while (in.read(id, 4) && in.read(reinterpret_cast<char*>(&size), 4)) {
+        if (memcmp(id, "data", 4) != 0) {
+            in.seekg(size + (size & 1), std::ios::cur);
+            continue;
+        }
+        std::vector<int16_t> pcm(size / sizeof(int16_t));
+        in.read(reinterpret_cast<char*>(pcm.data()), pcm.size() * sizeof(int16_t));
+        samples.resize(pcm.size());
+        for (size_t i = 0; i < pcm.size(); ++i) {
+            samples[i] = pcm[i] / 32768.0f;
+        }
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// Real-time factor: processing time / audio duration, lower is better.
+// Uses BOOKMARK_BENCH_WHISPER_WAV when set, otherwise synthetic audio of
+// the requested length.
+static void BM_WhisperTranscribe(benchmark::State& state) {
+    WhisperContext* whisper = sharedWhisper(state);
+    if (!whisper) return;
+
+    std::vector<float> audio;
+    const std::string wav = envPath("BOOKMARK_BENCH_WHISPER_WAV");
+    if (wav.empty() || !readWav(wav, audio)) {
+        audio = syntheticSpeech(static_cast<double>(state.range(0)), kSampleRate);
+    }
+    const double audio_seconds = static_cast<double>(audio.size()) / kSampleRate;
+
+    double elapsed = 0.0;
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(whisper->transcribe(audio, kSampleRate));
+        elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    state.counters["audio_seconds"] = audio_seconds;
+    state.counters["rtf"] = elapsed / (audio_seconds * state.iterations());
+}
+BENCHMARK(BM_WhisperTranscribe)->Arg(5)->Arg(30)->Unit(benchmark::kMillisecond)->UseRealTime();
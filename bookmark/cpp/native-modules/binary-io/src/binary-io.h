@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace bookmark {
+namespace binary_io {
+
+// Little-endian serialization for the modules' on-disk formats (term
+// dictionaries and libraries, the answer cache). Header-only, so each
+// module compiles its own copy.
+class Writer {
+public:
+    void u8(uint8_t value) { buffer_.push_back(static_cast<char>(value)); }
+    void u32(uint32_t value) {
+        for (int i = 0; i < 4; ++i) u8(static_cast<uint8_t>(value >> (8 * i)));
+    }
+    void u64(uint64_t value) {
+        for (int i = 0; i < 8; ++i) u8(static_cast<uint8_t>(value >> (8 * i)));
+    }
+    void f32(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        u32(bits);
+    }
+    void varint(uint32_t value) {
+        while (value >= 0x80) {
+            u8(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        u8(static_cast<uint8_t>(value));
+    }
+    // Length-prefixed
+    void string(std::string_view value) {
+        u32(static_cast<uint32_t>(value.size()));
+        bytes(value);
+    }
+    void bytes(std::string_view data) { buffer_.append(data.data(), data.size()); }
+
+    // Written to a temporary file first so a crash never leaves a torn file
+    bool writeTo(const std::string& path) const {
+        const std::string tmp_path = path + ".tmp";
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+            if (!out) return false;
+        }
+        return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+    }
+
+private:
+    std::string buffer_;
+};
+
+// Reads what Writer wrote; every read fails rather than run past the end
+class Reader {
+public:
+    explicit Reader(const std::string& data) : p_(data.data()), end_(data.data() + data.size()) {}
+
+    bool u8(uint8_t& value) {
+        if (p_ >= end_) return false;
+        value = static_cast<uint8_t>(*p_++);
+        return true;
+    }
+    bool u32(uint32_t& value) {
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            uint8_t byte;
+            if (!u8(byte)) return false;
+            value |= static_cast<uint32_t>(byte) << (8 * i);
+        }
+        return true;
+    }
+    bool u64(uint64_t& value) {
+        value = 0;
+        for (int i = 0; i < 8; ++i) {
+            uint8_t byte;
+            if (!u8(byte)) return false;
+            value |= static_cast<uint64_t>(byte) << (8 * i);
+        }
+        return true;
+    }
+    bool f32(float& value) {
+        uint32_t bits;
+        if (!u32(bits)) return false;
+        memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+    bool varint(uint32_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            uint8_t byte;
+            if (!u8(byte)) return false;
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+    bool string(std::string& value) {
+        uint32_t size;
+        if (!u32(size) || static_cast<size_t>(end_ - p_) < size) return false;
+        value.assign(p_, size);
+        p_ += size;
+        return true;
+    }
+    bool bytes(size_t size, std::string_view& value) {
+        if (static_cast<size_t>(end_ - p_) < size) return false;
+        value = std::string_view(p_, size);
+        p_ += size;
+        return true;
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+inline bool readFile(const std::string& path, std::string& data) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    data = contents.str();
+    return true;
+}
+
+} // namespace binary_io
+} // namespace bookmark
@@ -0,0 +1,210 @@
+#include <jni.h>
+#include <string>
+#include <vector>
+#include "chunk-store-native.h"
+#include <android/log.h>
+
+#define LOG_TAG "ChunkStoreNative"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+using namespace bookmark::chunk_store;
+
+namespace {
+
+std::string toString(JNIEnv* env, jstring value) {
+    const char* utf = env->GetStringUTFChars(value, nullptr);
+    std::string result(utf);
+    env->ReleaseStringUTFChars(value, utf);
+    return result;
+}
+
+} // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_bookmark_ChunkStoreModule_openStoreNative(
+    JNIEnv* env,
+    jobject thiz,
+    jstring path
+) {
+    const char* file_path = env->GetStringUTFChars(path, nullptr);
+    ChunkStore* store = chunk_store_open(file_path, static_cast<int>(EmbeddingFormat::Float16));
+    env->ReleaseStringUTFChars(path, file_path);
+    return reinterpret_cast<jlong>(store);
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_ChunkStoreModule_closeStoreNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong store_ptr
+) {
+    chunk_store_close(reinterpret_cast<ChunkStore*>(store_ptr));
+}
+
+JNIEXPORT jint JNICALL
+Java_com_bookmark_ChunkStoreModule_getChunkCountNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong store_ptr,
+    jstring book_id
+) {
+    auto* store = reinterpret_cast<ChunkStore*>(store_ptr);
+    return store ? static_cast<jint>(store->chunkCount(toString(env, book_id))) : 0;
+}
+
+// Chunk texts and their start and end offsets, as parallel arrays
+JNIEXPORT jobjectArray JNICALL
+Java_com_bookmark_ChunkStoreModule_getChunksNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong store_ptr,
+    jstring book_id,
+    jint first,
+    jint count,
+    jlongArray offsets_out
+) {
+    auto* store = reinterpret_cast<ChunkStore*>(store_ptr);
+    std::vector<ChunkRecord> chunks;
+    if (!store || first < 0 || count < 0 ||
+        !store->getChunks(toString(env, book_id), first, count, chunks)) {
+        return nullptr;
+    }
+
+    jclass string_class = env->FindClass("java/lang/String");
+    jobjectArray texts = env->NewObjectArray(static_cast<jsize>(chunks.size()), string_class, nullptr);
+    std::vector<jlong> offsets;
+    offsets.reserve(chunks.size() * 2);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        jstring text = env->NewStringUTF(chunks[i].text.c_str());
+        env->SetObjectArrayElement(texts, static_cast<jsize>(i), text);
+        env->DeleteLocalRef(text);
+        offsets.push_back(chunks[i].start);
+        offsets.push_back(chunks[i].end);
+    }
+    if (env->GetArrayLength(offsets_out) >= static_cast<jsize>(offsets.size())) {
+        env->SetLongArrayRegion(offsets_out, 0, static_cast<jsize>(offsets.size()), offsets.data());
+    }
+    return texts;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_ChunkStoreModule_removeBookNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong store_ptr,
+    jstring book_id
+) {
+    auto* store = reinterpret_cast<ChunkStore*>(store_ptr);
+    const char* id = env->GetStringUTFChars(book_id, nullptr);
+    bool success = chunk_store_remove_book(store, id);
+    env->ReleaseStringUTFChars(book_id, id);
+    return success;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_ChunkStoreModule_rebuildIndexNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong store_ptr,
+    jstring book_id,
+    jstring index_path,
+    jstring reduction_path
+) {
+    auto* store = reinterpret_cast<ChunkStore*>(store_ptr);
+    const char* id = env->GetStringUTFChars(book_id, nullptr);
+    const char* path = env->GetStringUTFChars(index_path, nullptr);
+    const char* reduction = reduction_path ? env->GetStringUTFChars(reduction_path, nullptr) : nullptr;
+    bool success = chunk_store_rebuild_index(store, id, path, reduction);
+    if (reduction) env->ReleaseStringUTFChars(reduction_path, reduction);
+    env->ReleaseStringUTFChars(index_path, path);
+    env->ReleaseStringUTFChars(book_id, id);
+    return success;
+}
+
+// stored, indexed, checked, mismatched, ok
+JNIEXPORT jdoubleArray JNICALL
+Java_com_bookmark_ChunkStoreModule_verifyIndexNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong store_ptr,
+    jstring book_id,
+    jstring index_path,
+    jint samples
+) {
+    auto* store = reinterpret_cast<ChunkStore*>(store_ptr);
+    const char* id = env->GetStringUTFChars(book_id, nullptr);
+    const char* path = env->GetStringUTFChars(index_path, nullptr);
+    VerifyReport report;
+    bool success = chunk_store_verify_index(store, id, path, samples > 0 ? samples : 0, &report);
+    env->ReleaseStringUTFChars(index_path, path);
+    env->ReleaseStringUTFChars(book_id, id);
+    if (!success) {
+        return nullptr;
+    }
+
+    const jdouble values[] = {
+        static_cast<jdouble>(report.stored),
+        static_cast<jdouble>(report.indexed),
+        static_cast<jdouble>(report.checked),
+        static_cast<jdouble>(report.mismatched),
+        report.ok ? 1.0 : 0.0,
+    };
+    jdoubleArray result = env->NewDoubleArray(5);
+    env->SetDoubleArrayRegion(result, 0, 5, values);
+    return result;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_ChunkStoreModule_trainReductionNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong store_ptr,
+    jint kind,
+    jint width,
+    jint max_samples,
+    jstring path
+) {
+    auto* store = reinterpret_cast<ChunkStore*>(store_ptr);
+    const char* file_path = env->GetStringUTFChars(path, nullptr);
+    bool success = chunk_store_train_reduction(store, kind, width, max_samples > 0 ? max_samples : 0, file_path);
+    env->ReleaseStringUTFChars(path, file_path);
+    return success;
+}
+
+// dimension, recall, bytes per vector and search time for each width measured
+JNIEXPORT jdoubleArray JNICALL
+Java_com_bookmark_ChunkStoreModule_reductionReportNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong store_ptr,
+    jint kind,
+    jintArray widths,
+    jint max_samples,
+    jint k
+) {
+    auto* store = reinterpret_cast<ChunkStore*>(store_ptr);
+    jsize count = env->GetArrayLength(widths);
+    std::vector<int> values(count);
+    env->GetIntArrayRegion(widths, 0, count, reinterpret_cast<jint*>(values.data()));
+
+    std::vector<bookmark::faiss::ReductionRecall> report(count);
+    size_t rows = chunk_store_reduction_report(store, kind, values.data(), values.size(),
+                                               max_samples > 0 ? max_samples : 0, k, report.data());
+
+    std::vector<jdouble> flat;
+    flat.reserve(rows * 4);
+    for (size_t i = 0; i < rows; ++i) {
+        flat.push_back(report[i].dimension);
+        flat.push_back(report[i].recall);
+        flat.push_back(static_cast<jdouble>(report[i].bytes_per_vector));
+        flat.push_back(report[i].search_us);
+    }
+    jdoubleArray result = env->NewDoubleArray(static_cast<jsize>(flat.size()));
+    env->SetDoubleArrayRegion(result, 0, static_cast<jsize>(flat.size()), flat.data());
+    return result;
+}
+
+} // extern "C"
@@ -0,0 +1,203 @@
+package com.bookmark;
+
+import com.facebook.react.bridge.ReactApplicationContext;
+import com.facebook.react.bridge.ReactContextBaseJavaModule;
+import com.facebook.react.bridge.ReactMethod;
+import com.facebook.react.bridge.Promise;
+import com.facebook.react.bridge.ReadableArray;
+import com.facebook.react.bridge.WritableArray;
+import com.facebook.react.bridge.WritableMap;
+import com.facebook.react.bridge.Arguments;
+
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+public class ChunkStoreModule extends ReactContextBaseJavaModule {
+    private long storePtr = 0;
+    // Rebuilds and reduction training read the whole library, keep them off
+    // the bridge thread
+    private final ExecutorService workExecutor = Executors.newSingleThreadExecutor();
+
+    static {
+        System.loadLibrary("chunk-store-native");
+    }
+
+    public ChunkStoreModule(ReactApplicationContext reactContext) {
+        super(reactContext);
+    }
+
+    @Override
+    public String getName() {
+        return "ChunkStoreNative";
+    }
+
+    private void closeStore() {
+        if (storePtr != 0) {
+            closeStoreNative(storePtr);
+            storePtr = 0;
+        }
+    }
+
+    private void requireStore() {
+        if (storePtr == 0) {
+            throw new IllegalStateException("Chunk store not open");
+        }
+    }
+
+    @ReactMethod
+    public synchronized void open(String path, Promise promise) {
+        try {
+            closeStore();
+            storePtr = openStoreNative(path);
+            promise.resolve(storePtr != 0);
+        } catch (Exception e) {
+            promise.reject("ERR_CHUNK_STORE", "Failed to open chunk store: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void getChunkCount(String bookId, Promise promise) {
+        try {
+            requireStore();
+            promise.resolve(getChunkCountNative(storePtr, bookId));
+        } catch (Exception e) {
+            promise.reject("ERR_CHUNK_STORE", "Failed to count chunks: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void getChunks(String bookId, int first, int count, Promise promise) {
+        try {
+            requireStore();
+
+            long[] offsets = new long[Math.max(count, 0) * 2];
+            String[] texts = getChunksNative(storePtr, bookId, first, count, offsets);
+            if (texts == null) {
+                throw new RuntimeException("Chunks could not be read");
+            }
+
+            WritableArray result = Arguments.createArray();
+            for (int i = 0; i < texts.length; i++) {
+                WritableMap chunk = Arguments.createMap();
+                chunk.putString("text", texts[i]);
+                chunk.putDouble("start", offsets[i * 2]);
+                chunk.putDouble("end", offsets[i * 2 + 1]);
+                result.pushMap(chunk);
+            }
+            promise.resolve(result);
+        } catch (Exception e) {
+            promise.reject("ERR_CHUNK_STORE", "Failed to get chunks: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void removeBook(String bookId, Promise promise) {
+        try {
+            requireStore();
+            promise.resolve(removeBookNative(storePtr, bookId));
+        } catch (Exception e) {
+            promise.reject("ERR_CHUNK_STORE", "Failed to remove book: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void rebuildIndex(String bookId, String indexPath, String reductionPath, Promise promise) {
+        workExecutor.execute(() -> {
+            synchronized (this) {
+                try {
+                    requireStore();
+                    promise.resolve(rebuildIndexNative(storePtr, bookId, indexPath, reductionPath));
+                } catch (Exception e) {
+                    promise.reject("ERR_CHUNK_STORE", "Failed to rebuild index: " + e.getMessage());
+                }
+            }
+        });
+    }
+
+    @ReactMethod
+    public synchronized void verifyIndex(String bookId, String indexPath, int samples, Promise promise) {
+        try {
+            requireStore();
+
+            double[] report = verifyIndexNative(storePtr, bookId, indexPath, samples);
+            if (report == null) {
+                throw new RuntimeException("Index could not be checked");
+            }
+
+            WritableMap result = Arguments.createMap();
+            result.putDouble("stored", report[0]);
+            result.putDouble("indexed", report[1]);
+            result.putDouble("checked", report[2]);
+            result.putDouble("mismatched", report[3]);
+            result.putBoolean("ok", report[4] != 0);
+            promise.resolve(result);
+        } catch (Exception e) {
+            promise.reject("ERR_CHUNK_STORE", "Failed to verify index: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void trainReduction(int kind, int width, int maxSamples, String path, Promise promise) {
+        workExecutor.execute(() -> {
+            synchronized (this) {
+                try {
+                    requireStore();
+                    promise.resolve(trainReductionNative(storePtr, kind, width, maxSamples, path));
+                } catch (Exception e) {
+                    promise.reject("ERR_CHUNK_STORE", "Failed to train reduction: " + e.getMessage());
+                }
+            }
+        });
+    }
+
+    @ReactMethod
+    public void getReductionReport(int kind, ReadableArray widths, int maxSamples, int k, Promise promise) {
+        int[] values = new int[widths.size()];
+        for (int i = 0; i < values.length; i++) {
+            values[i] = widths.getInt(i);
+        }
+
+        workExecutor.execute(() -> {
+            synchronized (this) {
+                try {
+                    requireStore();
+
+                    double[] report = reductionReportNative(storePtr, kind, values, maxSamples, k);
+                    WritableArray result = Arguments.createArray();
+                    for (int i = 0; i + 3 < report.length; i += 4) {
+                        WritableMap row = Arguments.createMap();
+                        row.putInt("dimension", (int) report[i]);
+                        row.putDouble("recall", report[i + 1]);
+                        row.putDouble("bytesPerVector", report[i + 2]);
+                        row.putDouble("searchUs", report[i + 3]);
+                        result.pushMap(row);
+                    }
+                    promise.resolve(result);
+                } catch (Exception e) {
+                    promise.reject("ERR_CHUNK_STORE", "Failed to measure reduction: " + e.getMessage());
+                }
+            }
+        });
+    }
+
+    @ReactMethod
+    public synchronized void cleanup(Promise promise) {
+        try {
+            closeStore();
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_CHUNK_STORE", "Failed to cleanup chunk store: " + e.getMessage());
+        }
+    }
+
+    // Native method declarations
+    private native long openStoreNative(String path);
+    private native void closeStoreNative(long storePtr);
+    private native int getChunkCountNative(long storePtr, String bookId);
+    private native String[] getChunksNative(long storePtr, String bookId, int first, int count, long[] offsetsOut);
+    private native boolean removeBookNative(long storePtr, String bookId);
+    private native boolean rebuildIndexNative(long storePtr, String bookId, String indexPath, String reductionPath);
+    private native double[] verifyIndexNative(long storePtr, String bookId, String indexPath, int samples);
+    private native boolean trainReductionNative(long storePtr, int kind, int width, int maxSamples, String path);
+    private native double[] reductionReportNative(long storePtr, int kind, int[] widths, int maxSamples, int k);
+}
@@ -0,0 +1,4 @@
+#import <React/RCTBridgeModule.h>
+
+@interface ChunkStoreModule : NSObject <RCTBridgeModule>
+@end
@@ -0,0 +1,199 @@
+#import "ChunkStoreModule.h"
+#import <React/RCTLog.h>
+#import "chunk-store-native.h"
+
+using namespace bookmark::chunk_store;
+
+@implementation ChunkStoreModule {
+    ChunkStore* _store;
+}
+
+RCT_EXPORT_MODULE(ChunkStoreNative)
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _store = nullptr;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self closeStore];
+}
+
+- (void)closeStore {
+    if (_store != nullptr) {
+        chunk_store_close(_store);
+        _store = nullptr;
+    }
+}
+
+RCT_EXPORT_METHOD(open:(NSString*)path
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        [self closeStore];
+        _store = chunk_store_open([path UTF8String], static_cast<int>(EmbeddingFormat::Float16));
+        resolve(@(_store != nullptr));
+    } @catch (NSException* e) {
+        reject(@"ERR_CHUNK_STORE", @"Failed to open chunk store", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(getChunkCount:(NSString*)bookId
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    if (_store == nullptr) {
+        reject(@"ERR_CHUNK_STORE", @"Chunk store not open", nil);
+        return;
+    }
+    resolve(@(chunk_store_count(_store, [bookId UTF8String])));
+}
+
+RCT_EXPORT_METHOD(getChunks:(NSString*)bookId
+                  first:(nonnull NSNumber*)first
+                  count:(nonnull NSNumber*)count
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_store == nullptr) {
+            reject(@"ERR_CHUNK_STORE", @"Chunk store not open", nil);
+            return;
+        }
+
+        std::vector<ChunkRecord> chunks;
+        if (!_store->getChunks([bookId UTF8String], [first unsignedLongValue], [count unsignedLongValue], chunks)) {
+            reject(@"ERR_CHUNK_STORE", @"Chunks could not be read", nil);
+            return;
+        }
+
+        NSMutableArray* result = [NSMutableArray arrayWithCapacity:chunks.size()];
+        for (const auto& chunk : chunks) {
+            [result addObject:@{
+                @"text": [NSString stringWithUTF8String:chunk.text.c_str()] ?: @"",
+                @"start": @(chunk.start),
+                @"end": @(chunk.end)
+            }];
+        }
+        resolve(result);
+    } @catch (NSException* e) {
+        reject(@"ERR_CHUNK_STORE", @"Failed to get chunks", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(removeBook:(NSString*)bookId
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    if (_store == nullptr) {
+        reject(@"ERR_CHUNK_STORE", @"Chunk store not open", nil);
+        return;
+    }
+    resolve(@(chunk_store_remove_book(_store, [bookId UTF8String])));
+}
+
+RCT_EXPORT_METHOD(rebuildIndex:(NSString*)bookId
+                  indexPath:(NSString*)indexPath
+                  reductionPath:(NSString*)reductionPath
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_store == nullptr) {
+            reject(@"ERR_CHUNK_STORE", @"Chunk store not open", nil);
+            return;
+        }
+        resolve(@(chunk_store_rebuild_index(_store, [bookId UTF8String], [indexPath UTF8String],
+                                            reductionPath != nil ? [reductionPath UTF8String] : nullptr)));
+    } @catch (NSException* e) {
+        reject(@"ERR_CHUNK_STORE", @"Failed to rebuild index", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(verifyIndex:(NSString*)bookId
+                  indexPath:(NSString*)indexPath
+                  samples:(nonnull NSNumber*)samples
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_store == nullptr) {
+            reject(@"ERR_CHUNK_STORE", @"Chunk store not open", nil);
+            return;
+        }
+
+        VerifyReport report;
+        if (!chunk_store_verify_index(_store, [bookId UTF8String], [indexPath UTF8String],
+                                      [samples unsignedLongValue], &report)) {
+            reject(@"ERR_CHUNK_STORE", @"Index could not be checked", nil);
+            return;
+        }
+        resolve(@{
+            @"stored": @(report.stored),
+            @"indexed": @(report.indexed),
+            @"checked": @(report.checked),
+            @"mismatched": @(report.mismatched),
+            @"ok": @(report.ok)
+        });
+    } @catch (NSException* e) {
+        reject(@"ERR_CHUNK_STORE", @"Failed to verify index", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(trainReduction:(nonnull NSNumber*)kind
+                  width:(nonnull NSNumber*)width
+                  maxSamples:(nonnull NSNumber*)maxSamples
+                  path:(NSString*)path
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_store == nullptr) {
+            reject(@"ERR_CHUNK_STORE", @"Chunk store not open", nil);
+            return;
+        }
+        resolve(@(chunk_store_train_reduction(_store, [kind intValue], [width intValue],
+                                              [maxSamples unsignedLongValue], [path UTF8String])));
+    } @catch (NSException* e) {
+        reject(@"ERR_CHUNK_STORE", @"Failed to train reduction", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(getReductionReport:(nonnull NSNumber*)kind
+                  widths:(NSArray*)widths
+                  maxSamples:(nonnull NSNumber*)maxSamples
+                  k:(nonnull NSNumber*)k
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_store == nullptr) {
+            reject(@"ERR_CHUNK_STORE", @"Chunk store not open", nil);
+            return;
+        }
+
+        std::vector<int> values;
+        for (NSNumber* width in widths) {
+            values.push_back([width intValue]);
+        }
+        std::vector<bookmark::faiss::ReductionRecall> report(values.size());
+        size_t rows = chunk_store_reduction_report(_store, [kind intValue], values.data(), values.size(),
+                                                   [maxSamples unsignedLongValue], [k intValue], report.data());
+
+        NSMutableArray* result = [NSMutableArray arrayWithCapacity:rows];
+        for (size_t i = 0; i < rows; i++) {
+            [result addObject:@{
+                @"dimension": @(report[i].dimension),
+                @"recall": @(report[i].recall),
+                @"bytesPerVector": @(report[i].bytes_per_vector),
+                @"searchUs": @(report[i].search_us)
+            }];
+        }
+        resolve(result);
+    } @catch (NSException* e) {
+        reject(@"ERR_CHUNK_STORE", @"Failed to measure reduction", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(cleanup:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    [self closeStore];
+    resolve(nil);
+}
+
+@end
@@ -0,0 +1,682 @@
+#include "chunk-store-native.h"
+#include "metrics-native.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <sqlite3.h>
+#include <sys/stat.h>
+
+namespace bookmark {
+namespace chunk_store {
+
+namespace {
+
+// Vectors per addBatch call when rebuilding an index
+constexpr size_t kRebuildBatchRows = 1024;
+
+// Nearest neighbours a stored embedding may be beyond its own chunk during
+// verification; duplicated passages have identical embeddings
+constexpr int kVerifyNeighbours = 4;
+
+// Of the samples drawn for a reduction report, one in this many is a query
+constexpr size_t kReportQueryStride = 10;
+
+const char* const kSchema =
+    "CREATE TABLE IF NOT EXISTS chunk_books ("
+    "  book_id TEXT PRIMARY KEY,"
+    "  dimension INTEGER NOT NULL,"
+    "  format INTEGER NOT NULL"
+    ");"
+    "CREATE TABLE IF NOT EXISTS chunks ("
+    "  book_id TEXT NOT NULL,"
+    "  chunk_index INTEGER NOT NULL,"
+    "  content TEXT NOT NULL,"
+    "  start_position INTEGER,"
+    "  end_position INTEGER,"
+    "  embedding BLOB NOT NULL,"
+    "  PRIMARY KEY (book_id, chunk_index)"
+    ") WITHOUT ROWID;";
+
+// Finalizes on scope exit, so early returns can't leak a statement
+class Statement {
+public:
+    Statement(sqlite3* db, const char* sql) {
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt_, nullptr) != SQLITE_OK) {
+            metrics::reportError(metrics::Module::ChunkStore, "prepare", sqlite3_errmsg(db));
+            stmt_ = nullptr;
+        }
+    }
+    ~Statement() { sqlite3_finalize(stmt_); }
+    Statement(const Statement&) = delete;
+    Statement& operator=(const Statement&) = delete;
+
+    explicit operator bool() const { return stmt_ != nullptr; }
+    sqlite3_stmt* get() const { return stmt_; }
+
+    void bind(int column, const std::string& text) {
+        sqlite3_bind_text(stmt_, column, text.data(), static_cast<int>(text.size()), SQLITE_TRANSIENT);
+    }
+    void bind(int column, int64_t value) { sqlite3_bind_int64(stmt_, column, value); }
+    void bindBlob(int column, const std::string& blob) {
+        sqlite3_bind_blob(stmt_, column, blob.data(), static_cast<int>(blob.size()), SQLITE_TRANSIENT);
+    }
+
+    int step() { return sqlite3_step(stmt_); }
+    void reset() {
+        sqlite3_reset(stmt_);
+        sqlite3_clear_bindings(stmt_);
+    }
+
+private:
+    sqlite3_stmt* stmt_ = nullptr;
+};
+
+// Rolls back unless committed, so a failed batch leaves nothing behind
+class Transaction {
+public:
+    explicit Transaction(sqlite3* db) : db_(db) {
+        began_ = sqlite3_exec(db_, "BEGIN IMMEDIATE", nullptr, nullptr, nullptr) == SQLITE_OK;
+    }
+    ~Transaction() {
+        if (began_ && !committed_) sqlite3_exec(db_, "ROLLBACK", nullptr, nullptr, nullptr);
+    }
+
+    explicit operator bool() const { return began_; }
+    bool commit() {
+        committed_ = sqlite3_exec(db_, "COMMIT", nullptr, nullptr, nullptr) == SQLITE_OK;
+        return committed_;
+    }
+
+private:
+    sqlite3* db_;
+    bool began_ = false;
+    bool committed_ = false;
+};
+
+size_t bytesPerValue(EmbeddingFormat format) {
+    return format == EmbeddingFormat::Float16 ? 2 : 4;
+}
+
+} // namespace
+
+// IEEE 754 binary16, rounding to nearest even
+uint16_t toHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t raw_exponent = (bits >> 23) & 0xFF;
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    if (raw_exponent == 0xFF) {
+        return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+    }
+    int32_t exponent = static_cast<int32_t>(raw_exponent) - 127 + 15;
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00);
+    }
+    if (exponent <= 0) {
+        if (exponent < -10) return static_cast<uint16_t>(sign);
+        // Subnormal: shift the implicit bit in
+        mantissa |= 0x800000;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1))) half++;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // A carry out of the mantissa correctly bumps the exponent
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1FFF;
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) half++;
+    return static_cast<uint16_t>(sign | half);
+}
+
+float fromHalf(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // Subnormal: normalize into a float exponent
+            int32_t e = 1;
+            while (!(mantissa & 0x400)) {
+                mantissa <<= 1;
+                e--;
+            }
+            mantissa &= 0x3FF;
+            bits = sign | (static_cast<uint32_t>(e + 127 - 15) << 23) | (mantissa << 13);
+        }
+    } else if (exponent == 31) {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Little-endian, like the other on-disk formats here
+void packEmbedding(const float* values, int dimension, EmbeddingFormat format, std::string& out) {
+    out.resize(static_cast<size_t>(dimension) * bytesPerValue(format));
+    char* p = &out[0];
+    for (int i = 0; i < dimension; ++i) {
+        if (format == EmbeddingFormat::Float16) {
+            uint16_t half = toHalf(values[i]);
+            *p++ = static_cast<char>(half);
+            *p++ = static_cast<char>(half >> 8);
+        } else {
+            uint32_t bits;
+            memcpy(&bits, &values[i], sizeof(bits));
+            for (int b = 0; b < 4; ++b) *p++ = static_cast<char>(bits >> (8 * b));
+        }
+    }
+}
+
+bool unpackEmbedding(const void* blob, size_t size, int dimension, EmbeddingFormat format, float* out) {
+    if (size != static_cast<size_t>(dimension) * bytesPerValue(format)) return false;
+    const auto* p = static_cast<const uint8_t*>(blob);
+    for (int i = 0; i < dimension; ++i) {
+        if (format == EmbeddingFormat::Float16) {
+            out[i] = fromHalf(static_cast<uint16_t>(p[0] | (p[1] << 8)));
+            p += 2;
+        } else {
+            uint32_t bits = 0;
+            for (int b = 0; b < 4; ++b) bits |= static_cast<uint32_t>(p[b]) << (8 * b);
+            memcpy(&out[i], &bits, sizeof(bits));
+            p += 4;
+        }
+    }
+    return true;
+}
+
+ChunkStore* ChunkStore::open(const std::string& path, EmbeddingFormat format) {
+    sqlite3* db = nullptr;
+    int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX;
+    if (sqlite3_open_v2(path.c_str(), &db, flags, nullptr) != SQLITE_OK) {
+        metrics::reportError(metrics::Module::ChunkStore, "open", db ? sqlite3_errmsg(db) : path.c_str());
+        sqlite3_close(db);
+        return nullptr;
+    }
+
+    // Ingestion writes through its own connection while the app reads
+    sqlite3_busy_timeout(db, 5000);
+    std::unique_ptr<ChunkStore> store(new ChunkStore(db, format));
+    if (!store->exec("PRAGMA journal_mode=WAL") ||
+        !store->exec("PRAGMA synchronous=NORMAL") ||
+        !store->exec(kSchema)) {
+        return nullptr;
+    }
+    return store.release();
+}
+
+ChunkStore::ChunkStore(sqlite3* db, EmbeddingFormat format) : db_(db), format_(format) {}
+
+ChunkStore::~ChunkStore() {
+    sqlite3_close(db_);
+}
+
+bool ChunkStore::exec(const char* sql) {
+    char* error = nullptr;
+    if (sqlite3_exec(db_, sql, nullptr, nullptr, &error) != SQLITE_OK) {
+        metrics::reportError(metrics::Module::ChunkStore, "exec", error ? error : sql);
+        sqlite3_free(error);
+        return false;
+    }
+    return true;
+}
+
+bool ChunkStore::addChunks(const std::string& book_id,
+                           size_t first,
+                           const std::vector<ChunkRecord>& chunks,
+                           const float* embeddings,
+                           int dimension) {
+    if (chunks.empty()) return true;
+    if (!embeddings || dimension <= 0) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Transaction transaction(db_);
+    if (!transaction) {
+        metrics::reportError(metrics::Module::ChunkStore, "add", sqlite3_errmsg(db_));
+        return false;
+    }
+
+    // The book's width and format are fixed by its first batch
+    EmbeddingFormat format = format_;
+    {
+        Statement select(db_, "SELECT dimension, format FROM chunk_books WHERE book_id = ?");
+        if (!select) return false;
+        select.bind(1, book_id);
+        if (select.step() == SQLITE_ROW) {
+            if (sqlite3_column_int(select.get(), 0) != dimension) {
+                metrics::reportError(metrics::Module::ChunkStore, "add", "embedding width changed");
+                return false;
+            }
+            format = static_cast<EmbeddingFormat>(sqlite3_column_int(select.get(), 1));
+        } else {
+            Statement insert(db_, "INSERT INTO chunk_books (book_id, dimension, format) VALUES (?, ?, ?)");
+            if (!insert) return false;
+            insert.bind(1, book_id);
+            insert.bind(2, static_cast<int64_t>(dimension));
+            insert.bind(3, static_cast<int64_t>(format));
+            if (insert.step() != SQLITE_DONE) return false;
+        }
+    }
+
+    Statement insert(db_,
+        "INSERT OR REPLACE INTO chunks "
+        "(book_id, chunk_index, content, start_position, end_position, embedding) "
+        "VALUES (?, ?, ?, ?, ?, ?)");
+    if (!insert) return false;
+
+    std::string blob;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        packEmbedding(embeddings + i * static_cast<size_t>(dimension), dimension, format, blob);
+        insert.bind(1, book_id);
+        insert.bind(2, static_cast<int64_t>(first + i));
+        insert.bind(3, chunks[i].text);
+        if (chunks[i].start >= 0) insert.bind(4, chunks[i].start);
+        if (chunks[i].end >= 0) insert.bind(5, chunks[i].end);
+        insert.bindBlob(6, blob);
+        if (insert.step() != SQLITE_DONE) {
+            metrics::reportError(metrics::Module::ChunkStore, "add", sqlite3_errmsg(db_));
+            return false;
+        }
+        insert.reset();
+    }
+
+    if (!transaction.commit()) {
+        metrics::reportError(metrics::Module::ChunkStore, "commit", sqlite3_errmsg(db_));
+        return false;
+    }
+    return true;
+}
+
+bool ChunkStore::truncate(const std::string& book_id, size_t count) {
+    if (count == 0) return removeBook(book_id);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Statement remove(db_, "DELETE FROM chunks WHERE book_id = ? AND chunk_index >= ?");
+    if (!remove) return false;
+    remove.bind(1, book_id);
+    remove.bind(2, static_cast<int64_t>(count));
+    return remove.step() == SQLITE_DONE;
+}
+
+bool ChunkStore::removeBook(const std::string& book_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Transaction transaction(db_);
+    if (!transaction) return false;
+
+    for (const char* sql : {"DELETE FROM chunks WHERE book_id = ?", "DELETE FROM chunk_books WHERE book_id = ?"}) {
+        Statement remove(db_, sql);
+        if (!remove) return false;
+        remove.bind(1, book_id);
+        if (remove.step() != SQLITE_DONE) return false;
+    }
+    return transaction.commit();
+}
+
+size_t ChunkStore::chunkCount(const std::string& book_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Statement count(db_, "SELECT COUNT(*) FROM chunks WHERE book_id = ?");
+    if (!count) return 0;
+    count.bind(1, book_id);
+    return count.step() == SQLITE_ROW ? static_cast<size_t>(sqlite3_column_int64(count.get(), 0)) : 0;
+}
+
+int ChunkStore::dimension(const std::string& book_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Statement select(db_, "SELECT dimension FROM chunk_books WHERE book_id = ?");
+    if (!select) return 0;
+    select.bind(1, book_id);
+    return select.step() == SQLITE_ROW ? sqlite3_column_int(select.get(), 0) : 0;
+}
+
+bool ChunkStore::getChunks(const std::string& book_id, size_t first, size_t count, std::vector<ChunkRecord>& out) {
+    out.clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Statement select(db_,
+        "SELECT content, start_position, end_position FROM chunks "
+        "WHERE book_id = ? AND chunk_index >= ? AND chunk_index < ? ORDER BY chunk_index");
+    if (!select) return false;
+    select.bind(1, book_id);
+    select.bind(2, static_cast<int64_t>(first));
+    select.bind(3, static_cast<int64_t>(first + count));
+
+    int result;
+    while ((result = select.step()) == SQLITE_ROW) {
+        ChunkRecord record;
+        const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(select.get(), 0));
+        record.text.assign(text ? text : "", static_cast<size_t>(sqlite3_column_bytes(select.get(), 0)));
+        if (sqlite3_column_type(select.get(), 1) != SQLITE_NULL) record.start = sqlite3_column_int64(select.get(), 1);
+        if (sqlite3_column_type(select.get(), 2) != SQLITE_NULL) record.end = sqlite3_column_int64(select.get(), 2);
+        out.push_back(std::move(record));
+    }
+    return result == SQLITE_DONE;
+}
+
+template <typename Row>
+bool ChunkStore::forEachEmbedding(const std::string& book_id, Row&& row) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    int dimension = 0;
+    EmbeddingFormat format = format_;
+    {
+        Statement select(db_, "SELECT dimension, format FROM chunk_books WHERE book_id = ?");
+        if (!select) return false;
+        select.bind(1, book_id);
+        if (select.step() != SQLITE_ROW) return false;
+        dimension = sqlite3_column_int(select.get(), 0);
+        format = static_cast<EmbeddingFormat>(sqlite3_column_int(select.get(), 1));
+    }
+
+    // Streamed a row at a time; only one decoded vector is held
+    Statement select(db_, "SELECT chunk_index, embedding FROM chunks WHERE book_id = ? ORDER BY chunk_index");
+    if (!select) return false;
+    select.bind(1, book_id);
+
+    std::vector<float> embedding(static_cast<size_t>(dimension));
+    int result;
+    while ((result = select.step()) == SQLITE_ROW) {
+        int64_t chunk_index = sqlite3_column_int64(select.get(), 0);
+        const void* blob = sqlite3_column_blob(select.get(), 1);
+        size_t size = static_cast<size_t>(sqlite3_column_bytes(select.get(), 1));
+        if (!unpackEmbedding(blob, size, dimension, format, embedding.data())) {
+            metrics::reportError(metrics::Module::ChunkStore, "read", "embedding has the wrong size");
+            return false;
+        }
+        if (!row(chunk_index, embedding)) return true;
+    }
+    return result == SQLITE_DONE;
+}
+
+faiss::FaissIndex* ChunkStore::buildIndex(const std::string& book_id, const faiss::EmbeddingReduction* reduction) {
+    int width = dimension(book_id);
+    if (width <= 0) return nullptr;
+    if (reduction && reduction->inputDimension() != width) {
+        metrics::reportError(metrics::Module::ChunkStore, "rebuild", "reduction is for another embedding width");
+        return nullptr;
+    }
+
+    std::unique_ptr<faiss::FaissIndex> index(reduction ? faiss::FaissIndex::create(*reduction)
+                                                       : faiss::FaissIndex::create(width));
+    if (!index) return nullptr;
+
+    std::vector<float> batch;
+    batch.reserve(kRebuildBatchRows * static_cast<size_t>(width));
+    int64_t expected = 0;
+    bool consistent = true;
+
+    bool read = forEachEmbedding(book_id, [&](int64_t chunk_index, const std::vector<float>& embedding) {
+        // Vector ids are positions, so a gap would shift every later chunk
+        if (chunk_index != expected++) {
+            consistent = false;
+            return false;
+        }
+        batch.insert(batch.end(), embedding.begin(), embedding.end());
+        if (batch.size() >= kRebuildBatchRows * static_cast<size_t>(width)) {
+            if (!index->addBatch(batch.data(), batch.size() / width)) {
+                consistent = false;
+                return false;
+            }
+            batch.clear();
+        }
+        return true;
+    });
+
+    if (read && consistent && !batch.empty()) {
+        consistent = index->addBatch(batch.data(), batch.size() / width);
+    }
+    if (!read || !consistent || index->size() == 0) {
+        metrics::reportError(metrics::Module::ChunkStore, "rebuild", book_id.c_str());
+        return nullptr;
+    }
+    return index.release();
+}
+
+VerifyReport ChunkStore::verifyIndex(const std::string& book_id, faiss::FaissIndex& index, size_t samples) {
+    VerifyReport report{};
+    report.stored = chunkCount(book_id);
+    report.indexed = index.size();
+
+    int width = dimension(book_id);
+    if (report.stored == 0 || report.stored != report.indexed || width != index.dimension()) {
+        report.ok = false;
+        return report;
+    }
+
+    // Evenly spread over the book, so a stale tail or a shifted range shows
+    samples = std::max<size_t>(1, std::min<size_t>(samples, report.stored));
+    const uint64_t stride = std::max<uint64_t>(1, report.stored / samples);
+    const int k = static_cast<int>(std::min<uint64_t>(kVerifyNeighbours, report.indexed));
+    std::vector<int> ids(k);
+    std::vector<float> distances(k);
+
+    bool read = forEachEmbedding(book_id, [&](int64_t chunk_index, const std::vector<float>& embedding) {
+        if (static_cast<uint64_t>(chunk_index) % stride != 0) return true;
+
+        size_t found = index.search(embedding.data(), k, ids.data(), distances.data());
+        if (std::find(ids.begin(), ids.begin() + found, static_cast<int>(chunk_index)) == ids.begin() + found) {
+            report.mismatched++;
+        }
+        return ++report.checked < samples;
+    });
+
+    report.ok = read && report.mismatched == 0;
+    return report;
+}
+
+int ChunkStore::libraryDimension() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Statement select(db_, "SELECT dimension FROM chunk_books GROUP BY dimension ORDER BY COUNT(*) DESC LIMIT 1");
+    if (!select) return 0;
+    return select.step() == SQLITE_ROW ? sqlite3_column_int(select.get(), 0) : 0;
+}
+
+bool ChunkStore::sampleEmbeddings(int dimension, size_t max_count, std::vector<float>& out) {
+    if (dimension <= 0 || max_count == 0) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t total = 0;
+    {
+        Statement count(db_,
+            "SELECT COUNT(*) FROM chunks JOIN chunk_books USING (book_id) WHERE chunk_books.dimension = ?");
+        if (!count) return false;
+        count.bind(1, static_cast<int64_t>(dimension));
+        if (count.step() != SQLITE_ROW) return false;
+        total = sqlite3_column_int64(count.get(), 0);
+    }
+    if (total == 0) return true;
+
+    // Every stride-th row, streamed so only the sample is held
+    const int64_t stride = (total + static_cast<int64_t>(max_count) - 1) / static_cast<int64_t>(max_count);
+    Statement select(db_,
+        "SELECT chunks.embedding, chunk_books.format FROM chunks JOIN chunk_books USING (book_id) "
+        "WHERE chunk_books.dimension = ?");
+    if (!select) return false;
+    select.bind(1, static_cast<int64_t>(dimension));
+
+    size_t taken = 0;
+    int64_t row = 0;
+    int result;
+    while (taken < max_count && (result = select.step()) == SQLITE_ROW) {
+        if (row++ % stride != 0) continue;
+
+        auto format = static_cast<EmbeddingFormat>(sqlite3_column_int(select.get(), 1));
+        const void* blob = sqlite3_column_blob(select.get(), 0);
+        size_t size = static_cast<size_t>(sqlite3_column_bytes(select.get(), 0));
+        out.resize(out.size() + dimension);
+        if (!unpackEmbedding(blob, size, dimension, format, out.data() + out.size() - dimension)) {
+            metrics::reportError(metrics::Module::ChunkStore, "sample", "embedding has the wrong size");
+            return false;
+        }
+        taken++;
+    }
+    return true;
+}
+
+// C API Implementation
+extern "C" {
+
+ChunkStore* chunk_store_open(const char* path, int format) {
+    if (!path) return nullptr;
+    return ChunkStore::open(path, format == 0 ? EmbeddingFormat::Float32 : EmbeddingFormat::Float16);
+}
+
+void chunk_store_close(ChunkStore* store) {
+    delete store;
+}
+
+bool chunk_store_add_chunks(ChunkStore* store,
+                            const char* book_id,
+                            size_t first,
+                            const char* const* texts,
+                            const int64_t* starts,
+                            const int64_t* ends,
+                            const float* embeddings,
+                            size_t count,
+                            int dimension) {
+    if (!store || !book_id || !texts || !embeddings) return false;
+
+    std::vector<ChunkRecord> chunks(count);
+    for (size_t i = 0; i < count; ++i) {
+        chunks[i].text = texts[i] ? texts[i] : "";
+        if (starts) chunks[i].start = starts[i];
+        if (ends) chunks[i].end = ends[i];
+    }
+    return store->addChunks(book_id, first, chunks, embeddings, dimension);
+}
+
+bool chunk_store_truncate(ChunkStore* store, const char* book_id, size_t count) {
+    if (!store || !book_id) return false;
+    return store->truncate(book_id, count);
+}
+
+bool chunk_store_remove_book(ChunkStore* store, const char* book_id) {
+    if (!store || !book_id) return false;
+    return store->removeBook(book_id);
+}
+
+size_t chunk_store_count(ChunkStore* store, const char* book_id) {
+    if (!store || !book_id) return 0;
+    return store->chunkCount(book_id);
+}
+
+bool chunk_store_rebuild_index(ChunkStore* store,
+                               const char* book_id,
+                               const char* index_path,
+                               const char* reduction_path) {
+    if (!store || !book_id || !index_path) return false;
+
+    try {
+        std::unique_ptr<faiss::EmbeddingReduction> reduction;
+        if (reduction_path) {
+            reduction.reset(faiss::EmbeddingReduction::load(reduction_path));
+            if (!reduction) return false;
+        }
+        std::unique_ptr<faiss::FaissIndex> index(store->buildIndex(book_id, reduction.get()));
+        return index && index->save(index_path);
+    } catch (...) {
+        metrics::reportException(metrics::Module::ChunkStore, "rebuild");
+        return false;
+    }
+}
+
+bool chunk_store_verify_index(ChunkStore* store,
+                              const char* book_id,
+                              const char* index_path,
+                              size_t samples,
+                              VerifyReport* report_out) {
+    if (!store || !book_id || !index_path || !report_out) return false;
+
+    try {
+        // A missing or unreadable index verifies as empty; only an existing
+        // one is worth an error report when it fails to load
+        struct stat st;
+        std::unique_ptr<faiss::FaissIndex> index;
+        if (stat(index_path, &st) == 0) {
+            index.reset(faiss::FaissIndex::load(index_path));
+        }
+        if (!index) {
+            *report_out = VerifyReport{};
+            report_out->stored = store->chunkCount(book_id);
+            return true;
+        }
+        *report_out = store->verifyIndex(book_id, *index, samples);
+        return true;
+    } catch (...) {
+        metrics::reportException(metrics::Module::ChunkStore, "verify");
+        return false;
+    }
+}
+
+bool chunk_store_train_reduction(ChunkStore* store,
+                                 int kind,
+                                 int output_dimension,
+                                 size_t max_samples,
+                                 const char* path) {
+    if (!store || !path || output_dimension <= 0) return false;
+
+    try {
+        int dimension = store->libraryDimension();
+        std::vector<float> samples;
+        if (dimension <= 0 || !store->sampleEmbeddings(dimension, max_samples, samples)) return false;
+
+        std::unique_ptr<faiss::EmbeddingReduction> reduction(faiss::faiss_reduction_train(
+            kind, dimension, output_dimension, samples.data(), samples.size() / dimension));
+        return reduction && reduction->save(path);
+    } catch (...) {
+        metrics::reportException(metrics::Module::ChunkStore, "train reduction");
+        return false;
+    }
+}
+
+size_t chunk_store_reduction_report(ChunkStore* store,
+                                    int kind,
+                                    const int* widths,
+                                    size_t width_count,
+                                    size_t max_samples,
+                                    int k,
+                                    faiss::ReductionRecall* report_out) {
+    if (!store || !widths || !report_out || width_count == 0) return 0;
+
+    try {
+        int dimension = store->libraryDimension();
+        std::vector<float> samples;
+        if (dimension <= 0 || !store->sampleEmbeddings(dimension, max_samples, samples)) return 0;
+
+        // Queries are held out, so none finds itself
+        const size_t count = samples.size() / dimension;
+        std::vector<float> base;
+        std::vector<float> queries;
+        for (size_t i = 0; i < count; ++i) {
+            auto& target = i % kReportQueryStride == kReportQueryStride - 1 ? queries : base;
+            target.insert(target.end(), samples.begin() + i * dimension, samples.begin() + (i + 1) * dimension);
+        }
+
+        std::vector<faiss::ReductionRecall> report = faiss::measureReductionRecall(
+            kind == 1 ? faiss::ReductionKind::RandomRotation : faiss::ReductionKind::Pca,
+            dimension, base.data(), base.size() / dimension, queries.data(), queries.size() / dimension,
+            std::vector<int>(widths, widths + width_count), k);
+        std::copy(report.begin(), report.end(), report_out);
+        return report.size();
+    } catch (...) {
+        metrics::reportException(metrics::Module::ChunkStore, "reduction report");
+        return 0;
+    }
+}
+
+} // extern "C"
+
+} // namespace chunk_store
+} // namespace bookmark
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "faiss-native.h"
+#include "reduction-native.h"
+
+struct sqlite3;
+
+namespace bookmark {
+namespace chunk_store {
+
+// How embeddings are packed into their BLOBs. Half precision halves the
+// store and is well inside the noise of nearest-neighbour search; the
+// index is always rebuilt at full precision.
+enum class EmbeddingFormat : int {
+    Float32 = 0,
+    Float16 = 1,
+};
+
+struct ChunkRecord {
+    std::string text;
+    int64_t start = -1; // byte offsets in the source file, -1 if unknown
+    int64_t end = -1;
+};
+
+struct VerifyReport {
+    uint64_t stored;     // chunks in the store
+    uint64_t indexed;    // vectors in the index
+    uint64_t checked;    // stored embeddings searched for in the index
+    uint64_t mismatched; // of which the index didn't return as their own chunk
+    bool ok;
+};
+
+// Embedding BLOB encoding. Half floats are IEEE 754 binary16, rounded to
+// nearest even; values are stored little-endian.
+uint16_t toHalf(float value);
+float fromHalf(uint16_t half);
+void packEmbedding(const float* values, int dimension, EmbeddingFormat format, std::string& out);
+// False if size isn't dimension values in format
+bool unpackEmbedding(const void* blob, size_t size, int dimension, EmbeddingFormat format, float* out);
+
+// Chunk texts, byte offsets and embeddings of each book in one SQLite
+// database, so the FAISS file is derived data: it can be rebuilt or checked
+// from the stored BLOBs without embedding anything again.
+//
+// A book's chunks are numbered from 0 in index order; chunk i is vector i
+// of the book's index. Writes go in batches, one transaction per batch.
+// The database is opened in WAL mode, so readers don't wait on an ingestion
+// writing through another connection.
+class ChunkStore {
+public:
+    static ChunkStore* open(const std::string& path, EmbeddingFormat format = EmbeddingFormat::Float16);
+    ~ChunkStore();
+
+    // Stores chunks numbered first onwards with their row-major embeddings,
+    // replacing any already stored under those numbers. A book's first
+    // batch fixes its embedding width and format.
+    bool addChunks(const std::string& book_id,
+                   size_t first,
+                   const std::vector<ChunkRecord>& chunks,
+                   const float* embeddings,
+                   int dimension);
+    // Drops the book's chunks numbered count and above
+    bool truncate(const std::string& book_id, size_t count);
+    bool removeBook(const std::string& book_id);
+
+    size_t chunkCount(const std::string& book_id);
+    // 0 if the book has no chunks
+    int dimension(const std::string& book_id);
+    // Chunks numbered first to first + count - 1, fewer past the end
+    bool getChunks(const std::string& book_id, size_t first, size_t count, std::vector<ChunkRecord>& out);
+
+    // A new index holding the stored embeddings in chunk order, behind
+    // reduction if given, or null if the book has none or its numbering has
+    // gaps
+    faiss::FaissIndex* buildIndex(const std::string& book_id, const faiss::EmbeddingReduction* reduction = nullptr);
+    // Compares the index with the store: sizes and widths, then up to
+    // samples stored embeddings, spread over the book, searched for in it
+    VerifyReport verifyIndex(const std::string& book_id, faiss::FaissIndex& index, size_t samples);
+
+    // Embedding width shared by most books, 0 if there are none
+    int libraryDimension();
+    // Up to max_count embeddings of the given width, spread evenly over all
+    // books, appended row-major to out
+    bool sampleEmbeddings(int dimension, size_t max_count, std::vector<float>& out);
+
+private:
+    ChunkStore(sqlite3* db, EmbeddingFormat format);
+    bool exec(const char* sql);
+    // Calls row(chunk_index, embedding) for the book's chunks in order,
+    // decoding each BLOB into a dimension-long vector; stops early when row
+    // returns false
+    template <typename Row>
+    bool forEachEmbedding(const std::string& book_id, Row&& row);
+
+    sqlite3* db_;
+    EmbeddingFormat format_;
+    std::mutex mutex_; // the connection is used by one call at a time
+};
+
+// React Native binding interface
+extern "C" {
+    // format is an EmbeddingFormat value
+    ChunkStore* chunk_store_open(const char* path, int format);
+    void chunk_store_close(ChunkStore* store);
+    bool chunk_store_add_chunks(ChunkStore* store,
+                                const char* book_id,
+                                size_t first,
+                                const char* const* texts,
+                                const int64_t* starts,
+                                const int64_t* ends,
+                                const float* embeddings,
+                                size_t count,
+                                int dimension);
+    bool chunk_store_truncate(ChunkStore* store, const char* book_id, size_t count);
+    bool chunk_store_remove_book(ChunkStore* store, const char* book_id);
+    size_t chunk_store_count(ChunkStore* store, const char* book_id);
+
+    // Builds the book's index from the stored embeddings and saves it to
+    // index_path, behind the reduction saved at reduction_path unless null
+    bool chunk_store_rebuild_index(ChunkStore* store,
+                                   const char* book_id,
+                                   const char* index_path,
+                                   const char* reduction_path);
+    bool chunk_store_verify_index(ChunkStore* store,
+                                  const char* book_id,
+                                  const char* index_path,
+                                  size_t samples,
+                                  VerifyReport* report_out);
+
+    // Trains a reduction of the library's embeddings to output_dimension on
+    // up to max_samples of them and saves it to path. kind is a
+    // faiss::ReductionKind value.
+    bool chunk_store_train_reduction(ChunkStore* store,
+                                     int kind,
+                                     int output_dimension,
+                                     size_t max_samples,
+                                     const char* path);
+    // Recall at k of each width against full width, measured on up to
+    // max_samples library embeddings: every tenth is a query and the rest
+    // are searched. Writes a row per usable width to report_out, which must
+    // hold width_count, and returns how many.
+    size_t chunk_store_reduction_report(ChunkStore* store,
+                                        int kind,
+                                        const int* widths,
+                                        size_t width_count,
+                                        size_t max_samples,
+                                        int k,
+                                        faiss::ReductionRecall* report_out);
+}
+
+} // namespace chunk_store
+} // namespace bookmark
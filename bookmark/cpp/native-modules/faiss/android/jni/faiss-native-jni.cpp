@@ -1,7 +1,13 @@
 #include <jni.h>
+#include <memory>
 #include <string>
 #include <vector>
+#include <fbjni/fbjni.h>
+#include <ReactCommon/CallInvokerHolder.h>
 #include "faiss-native.h"
+#include "faiss-jsi.h"
+#include "reduction-native.h"
+#include "request-jni.h"
 #include <android/log.h>
 
 #define LOG_TAG "FaissNative"
@@ -10,20 +16,37 @@
 
 using namespace bookmark::faiss;
 
+namespace {
+
+// The index as seen by the JSI functions, which run on the JS thread rather
+// than the module's
+std::shared_ptr<IndexSlot> index_slot = std::make_shared<IndexSlot>();
+
+} // namespace
+
 extern "C" {
 
 JNIEXPORT jlong JNICALL
-Java_com_bookmark_FaissModule_createIndex(
+Java_com_bookmark_FaissModule_createIndexNative(
     JNIEnv* env,
     jobject thiz,
-    jint dimension
+    jint dimension,
+    jstring reduction_path
 ) {
-    FaissIndex* index = faiss_create_index(dimension);
+    FaissIndex* index;
+    if (reduction_path) {
+        const char* path = env->GetStringUTFChars(reduction_path, nullptr);
+        index = faiss_create_index_with_reduction(dimension, path);
+        env->ReleaseStringUTFChars(reduction_path, path);
+    } else {
+        index = faiss_create_index(dimension);
+    }
+    index_slot->set(index);
     return reinterpret_cast<jlong>(index);
 }
 
 JNIEXPORT jlong JNICALL
-Java_com_bookmark_FaissModule_loadIndex(
+Java_com_bookmark_FaissModule_loadIndexNative(
     JNIEnv* env,
     jobject thiz,
     jstring path
@@ -31,21 +54,24 @@ Java_com_bookmark_FaissModule_loadIndex(
     const char* file_path = env->GetStringUTFChars(path, nullptr);
     FaissIndex* index = faiss_load_index(file_path);
     env->ReleaseStringUTFChars(path, file_path);
+    index_slot->set(index);
     return reinterpret_cast<jlong>(index);
 }
 
 JNIEXPORT void JNICALL
-Java_com_bookmark_FaissModule_destroyIndex(
+Java_com_bookmark_FaissModule_destroyIndexNative(
     JNIEnv* env,
     jobject thiz,
     jlong index_ptr
 ) {
     auto* index = reinterpret_cast<FaissIndex*>(index_ptr);
+    // Waits for any JSI call still searching it
+    index_slot->clear(index);
     faiss_destroy_index(index);
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_bookmark_FaissModule_addEmbedding(
+Java_com_bookmark_FaissModule_addEmbeddingNative(
     JNIEnv* env,
     jobject thiz,
     jlong index_ptr,
@@ -54,61 +80,39 @@ Java_com_bookmark_FaissModule_addEmbedding(
     auto* index = reinterpret_cast<FaissIndex*>(index_ptr);
     jsize length = env->GetArrayLength(embedding);
     jfloat* data = env->GetFloatArrayElements(embedding, nullptr);
-    
+
     bool success = faiss_add_embedding(index, data, length);
     env->ReleaseFloatArrayElements(embedding, data, JNI_ABORT);
-    
+
     return success;
 }
 
-JNIEXPORT jobjectArray JNICALL
-Java_com_bookmark_FaissModule_search(
+// Returns as soon as the query is queued; the listener gets the ids as ints
+// and the distances as floats, closest first
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_FaissModule_searchAsyncNative(
     JNIEnv* env,
     jobject thiz,
     jlong index_ptr,
     jfloatArray query,
-    jint k
+    jint k,
+    jobject listener
 ) {
     auto* index = reinterpret_cast<FaissIndex*>(index_ptr);
     jsize length = env->GetArrayLength(query);
     jfloat* query_data = env->GetFloatArrayElements(query, nullptr);
-    
-    // Allocate arrays for results
-    std::vector<int> indices(k);
-    std::vector<float> distances(k);
-    
-    size_t num_results = faiss_search(
-        index,
-        query_data,
-        length,
-        k,
-        indices.data(),
-        distances.data()
-    );
-    
+
+    // The query is copied before this returns
+    auto* request_listener = bookmark::scheduler::RequestListener::create(env, listener);
+    bookmark::scheduler::Request* request = faiss_search_async(
+        index, query_data, length, k, bookmark::scheduler::RequestListener::onComplete, request_listener);
     env->ReleaseFloatArrayElements(query, query_data, JNI_ABORT);
-    
-    // Create result array of SearchResult objects
-    jclass result_class = env->FindClass("com/bookmark/FaissModule$SearchResult");
-    jmethodID constructor = env->GetMethodID(result_class, "<init>", "(IF)V");
-    
-    jobjectArray results = env->NewObjectArray(num_results, result_class, nullptr);
-    
-    for (size_t i = 0; i < num_results; i++) {
-        jobject result = env->NewObject(
-            result_class,
-            constructor,
-            indices[i],
-            distances[i]
-        );
-        env->SetObjectArrayElement(results, i, result);
-    }
-    
-    return results;
+
+    return bookmark::scheduler::RequestListener::submitted(env, request_listener, request);
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_bookmark_FaissModule_saveIndex(
+Java_com_bookmark_FaissModule_saveIndexNative(
     JNIEnv* env,
     jobject thiz,
     jlong index_ptr,
@@ -122,7 +126,7 @@ Java_com_bookmark_FaissModule_saveIndex(
 }
 
 JNIEXPORT void JNICALL
-Java_com_bookmark_FaissModule_clearIndex(
+Java_com_bookmark_FaissModule_clearIndexNative(
     JNIEnv* env,
     jobject thiz,
     jlong index_ptr
@@ -132,7 +136,7 @@ Java_com_bookmark_FaissModule_clearIndex(
 }
 
 JNIEXPORT jlong JNICALL
-Java_com_bookmark_FaissModule_getSize(
+Java_com_bookmark_FaissModule_getSizeNative(
     JNIEnv* env,
     jobject thiz,
     jlong index_ptr
@@ -141,4 +145,28 @@ Java_com_bookmark_FaissModule_getSize(
     return faiss_get_size(index);
 }
 
-} // extern "C"
\ No newline at end of file
+// Called on the JS thread with the jsi::Runtime behind the JavaScriptContextHolder
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_FaissModule_installNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong runtime_ptr,
+    jobject call_invoker_holder
+) {
+    auto* runtime = reinterpret_cast<facebook::jsi::Runtime*>(runtime_ptr);
+    if (!runtime || !call_invoker_holder) {
+        return false;
+    }
+
+    try {
+        auto holder = facebook::jni::wrap_alias(
+            static_cast<facebook::react::CallInvokerHolder::javaobject>(call_invoker_holder));
+        installJsi(*runtime, holder->cthis()->getCallInvoker(), index_slot);
+        return true;
+    } catch (const std::exception& e) {
+        LOGE("Failed to install JSI bindings: %s", e.what());
+        return false;
+    }
+}
+
+} // extern "C"
@@ -8,6 +8,8 @@ import com.facebook.react.bridge.ReadableArray;
 import com.facebook.react.bridge.WritableArray;
 import com.facebook.react.bridge.WritableMap;
 import com.facebook.react.bridge.Arguments;
+import com.facebook.react.bridge.JavaScriptContextHolder;
+import com.facebook.react.turbomodule.core.CallInvokerHolderImpl;
 
 public class FaissModule extends ReactContextBaseJavaModule {
     private long indexPtr = 0;
@@ -25,20 +27,38 @@ public class FaissModule extends ReactContextBaseJavaModule {
         return "FaissNative";
     }
 
-    public static class SearchResult {
-        public final int index;
-        public final float distance;
+    // Native handle shared with the voice pipeline module
+    long getIndexPtr() {
+        return indexPtr;
+    }
+
+    // Installs global.FaissNativeJSI, whose functions take Float32Arrays
+    // without copying them element by element through the bridge. JS falls
+    // back to the promise methods below when this returns false, e.g. under
+    // a remote debugger.
+    @ReactMethod(isBlockingSynchronousMethod = true)
+    public boolean install() {
+        ReactApplicationContext context = getReactApplicationContext();
+        JavaScriptContextHolder jsContext = context.getJavaScriptContextHolder();
+        if (jsContext == null || jsContext.get() == 0) {
+            return false;
+        }
+        return installNative(jsContext.get(), (CallInvokerHolderImpl) context.getJSCallInvokerHolder());
+    }
 
-        public SearchResult(int index, float distance) {
-            this.index = index;
-            this.distance = distance;
+    private void destroyIndex() {
+        if (indexPtr != 0) {
+            destroyIndexNative(indexPtr);
+            indexPtr = 0;
         }
     }
 
     @ReactMethod
-    public void createIndex(int dimension, Promise promise) {
+    public void createIndex(int dimension, String reductionPath, Promise promise) {
         try {
-            indexPtr = createIndexNative(dimension);
+            // Replacing the index would otherwise leak the old one
+            destroyIndex();
+            indexPtr = createIndexNative(dimension, reductionPath);
             promise.resolve(indexPtr != 0);
         } catch (Exception e) {
             promise.reject("ERR_FAISS", "Failed to create FAISS index: " + e.getMessage());
@@ -48,6 +68,7 @@ public class FaissModule extends ReactContextBaseJavaModule {
     @ReactMethod
     public void loadIndex(String path, Promise promise) {
         try {
+            destroyIndex();
             indexPtr = loadIndexNative(path);
             promise.resolve(indexPtr != 0);
         } catch (Exception e) {
@@ -58,10 +79,7 @@ public class FaissModule extends ReactContextBaseJavaModule {
     @ReactMethod
     public void cleanup(Promise promise) {
         try {
-            if (indexPtr != 0) {
-                destroyIndexNative(indexPtr);
-                indexPtr = 0;
-            }
+            destroyIndex();
             promise.resolve(null);
         } catch (Exception e) {
             promise.reject("ERR_FAISS", "Failed to cleanup FAISS index: " + e.getMessage());
@@ -99,17 +117,24 @@ public class FaissModule extends ReactContextBaseJavaModule {
                 queryData[i] = (float) query.getDouble(i);
             }
 
-            SearchResult[] results = searchNative(indexPtr, queryData, k);
-            WritableArray resultArray = Arguments.createArray();
-
-            for (SearchResult result : results) {
-                WritableMap resultMap = Arguments.createMap();
-                resultMap.putInt("index", result.index);
-                resultMap.putDouble("distance", result.distance);
-                resultArray.pushMap(resultMap);
-            }
-
-            promise.resolve(resultArray);
+            // Searched on a native worker so the bridge thread stays free for
+            // the other modules' calls
+            searchAsyncNative(indexPtr, queryData, k, (text, distances, indices, error) -> {
+                if (error != null) {
+                    promise.reject("ERR_FAISS", "Failed to search embeddings: " + error);
+                    return;
+                }
+
+                WritableArray resultArray = Arguments.createArray();
+                int found = indices != null ? indices.length : 0;
+                for (int i = 0; i < found; i++) {
+                    WritableMap resultMap = Arguments.createMap();
+                    resultMap.putInt("index", indices[i]);
+                    resultMap.putDouble("distance", distances[i]);
+                    resultArray.pushMap(resultMap);
+                }
+                promise.resolve(resultArray);
+            });
         } catch (Exception e) {
             promise.reject("ERR_FAISS", "Failed to search embeddings: " + e.getMessage());
         }
@@ -158,12 +183,13 @@ public class FaissModule extends ReactContextBaseJavaModule {
     }
 
     // Native method declarations
-    private native long createIndexNative(int dimension);
+    private native long createIndexNative(int dimension, String reductionPath);
     private native long loadIndexNative(String path);
     private native void destroyIndexNative(long indexPtr);
     private native boolean addEmbeddingNative(long indexPtr, float[] embedding);
-    private native SearchResult[] searchNative(long indexPtr, float[] query, int k);
+    private native boolean searchAsyncNative(long indexPtr, float[] query, int k, NativeRequestListener listener);
     private native boolean saveIndexNative(long indexPtr, String path);
     private native void clearIndexNative(long indexPtr);
     private native long getSizeNative(long indexPtr);
+    private native boolean installNative(long jsRuntimePtr, CallInvokerHolderImpl callInvokerHolder);
 }
\ No newline at end of file
@@ -1,38 +1,75 @@
 #import "FaissModule.h"
 #import <React/RCTLog.h>
+#import <React/RCTBridge+Private.h>
 #import "faiss-native.h"
+#import "faiss-jsi.h"
+#import "reduction-native.h"
+#import "NativeRequest.h"
 
 using namespace bookmark::faiss;
 
 @implementation FaissModule {
     FaissIndex* _index;
+    std::shared_ptr<IndexSlot> _slot; // index as seen by the JSI functions
 }
 
 RCT_EXPORT_MODULE()
 
+@synthesize bridge = _bridge;
+
 - (instancetype)init {
     if (self = [super init]) {
         _index = nullptr;
+        _slot = std::make_shared<IndexSlot>();
     }
     return self;
 }
 
 - (void)dealloc {
     if (_index != nullptr) {
+        _slot->clear(_index);
         faiss_destroy_index(_index);
         _index = nullptr;
     }
 }
 
+- (void*)nativeHandle {
+    return _index;
+}
+
+// Installs global.FaissNativeJSI (see faiss-jsi.h) on the JS thread. JS falls
+// back to the promise methods below when this returns NO, e.g. under a
+// remote debugger.
+RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(install) {
+    RCTCxxBridge* bridge = (RCTCxxBridge*)self.bridge;
+    auto* runtime = static_cast<facebook::jsi::Runtime*>(bridge.runtime);
+    if (runtime == nullptr) {
+        return @NO;
+    }
+
+    try {
+        installJsi(*runtime, bridge.jsCallInvoker, _slot);
+        return @YES;
+    } catch (const std::exception& e) {
+        RCTLogError(@"Failed to install JSI bindings: %s", e.what());
+        return @NO;
+    }
+}
+
 RCT_EXPORT_METHOD(createIndex:(nonnull NSNumber*)dimension
+                  reductionPath:(NSString*)reductionPath
                   resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     @try {
         if (_index != nullptr) {
+            _slot->clear(_index);
             faiss_destroy_index(_index);
         }
 
-        _index = faiss_create_index([dimension intValue]);
+        _index = reductionPath != nil
+            ? faiss_create_index_with_reduction([dimension intValue], [reductionPath UTF8String])
+            : faiss_create_index([dimension intValue]);
+        _slot->set(_index);
         resolve(@(_index != nullptr));
     } @catch (NSException* e) {
         reject(@"ERR_FAISS", @"Failed to create FAISS index", nil);
@@ -44,10 +81,12 @@ RCT_EXPORT_METHOD(loadIndex:(NSString*)path
                   rejecter:(RCTPromiseRejectBlock)reject) {
     @try {
         if (_index != nullptr) {
+            _slot->clear(_index);
             faiss_destroy_index(_index);
         }
 
         _index = faiss_load_index([path UTF8String]);
+        _slot->set(_index);
         resolve(@(_index != nullptr));
     } @catch (NSException* e) {
         reject(@"ERR_FAISS", @"Failed to load FAISS index", nil);
@@ -58,6 +97,7 @@ RCT_EXPORT_METHOD(cleanup:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     @try {
         if (_index != nullptr) {
+            _slot->clear(_index);
             faiss_destroy_index(_index);
             _index = nullptr;
         }
@@ -100,33 +140,35 @@ RCT_EXPORT_METHOD(search:(NSArray*)query
             return;
         }
 
-        float* queryData = (float*)malloc(query.count * sizeof(float));
+        std::vector<float> queryData(query.count);
         for (NSUInteger i = 0; i < query.count; i++) {
             queryData[i] = [query[i] floatValue];
         }
 
-        std::vector<int> indices([k intValue]);
-        std::vector<float> distances([k intValue]);
-
-        size_t numResults = faiss_search(
-            _index,
-            queryData,
-            query.count,
-            [k intValue],
-            indices.data(),
-            distances.data()
-        );
-        free(queryData);
-
-        NSMutableArray* results = [NSMutableArray arrayWithCapacity:numResults];
-        for (size_t i = 0; i < numResults; i++) {
-            [results addObject:@{
-                @"index": @(indices[i]),
-                @"distance": @(distances[i])
-            }];
+        // Searched on a native worker so the module queue stays free; the
+        // query is copied before this returns
+        void* done = NativeRequestRetain(^(bookmark::scheduler::Request* request) {
+            if (!request->succeeded()) {
+                reject(@"ERR_FAISS", @"Failed to search embeddings", nil);
+                return;
+            }
+
+            const std::vector<int>& indices = request->ints;
+            const std::vector<float>& distances = request->floats;
+            NSMutableArray* results = [NSMutableArray arrayWithCapacity:indices.size()];
+            for (size_t i = 0; i < indices.size(); i++) {
+                [results addObject:@{
+                    @"index": @(indices[i]),
+                    @"distance": @(distances[i])
+                }];
+            }
+            resolve(results);
+        });
+        if (!faiss_search_async(_index, queryData.data(), queryData.size(), [k intValue],
+                                NativeRequestComplete, done)) {
+            NativeRequestDiscard(done);
+            reject(@"ERR_FAISS", @"Failed to search embeddings", nil);
         }
-
-        resolve(results);
     } @catch (NSException* e) {
         reject(@"ERR_FAISS", @"Failed to search embeddings", nil);
     }
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "faiss-native.h"
+#include "jsi-bridge.h"
+
+namespace bookmark {
+namespace faiss {
+
+using IndexSlot = bridge::HandleSlot<FaissIndex>;
+
+// Installs global.FaissNativeJSI for the platform bridges.
+//
+//   addEmbeddings(embeddings: Float32Array): Promise<boolean>
+//       appends one or more row-major vectors of the index's dimension
+//   search(query: Float32Array, k: number): Promise<{ indices: ArrayBuffer, distances: ArrayBuffer }>
+//       Int32 ids and Float32 L2 distances of up to k neighbours, closest first
+//
+// Both run as scheduler tasks rather than on the JS thread: an index the
+// residency manager evicted is reloaded from disk on first use, and a search
+// waits for any addBatch holding the index. The floats are read in place,
+// so JS must leave the buffer alone until the promise settles.
+inline void installJsi(facebook::jsi::Runtime& runtime,
+                       std::shared_ptr<facebook::react::CallInvoker> invoker,
+                       std::shared_ptr<IndexSlot> slot) {
+    namespace jsi = facebook::jsi;
+
+    struct SearchResults {
+        std::vector<int> indices;
+        std::vector<float> distances;
+    };
+
+    jsi::Object binding(runtime);
+
+    binding.setProperty(runtime, "addEmbeddings", bridge::function(runtime, "addEmbeddings", 1,
+        [invoker, slot](jsi::Runtime& rt, const jsi::Value* args, size_t) {
+            bridge::FloatView embeddings = bridge::floatArg(rt, args[0], "embeddings");
+
+            return bridge::runAsync<bool>(rt, invoker,
+                [slot, embeddings]() {
+                    return slot->with([&](FaissIndex* index) {
+                        if (!index) throw std::runtime_error("FAISS index not initialized");
+
+                        auto dimension = static_cast<size_t>(index->dimension());
+                        if (embeddings.count == 0 || embeddings.count % dimension != 0) {
+                            throw std::runtime_error("embeddings length is not a multiple of the index dimension");
+                        }
+                        return faiss_add_embeddings(index, embeddings.data, embeddings.count / dimension, dimension);
+                    });
+                },
+                [](jsi::Runtime&, bool& added) { return jsi::Value(added); },
+                args[0]);
+        }));
+
+    binding.setProperty(runtime, "search", bridge::function(runtime, "search", 2,
+        [invoker, slot](jsi::Runtime& rt, const jsi::Value* args, size_t) {
+            bridge::FloatView query = bridge::floatArg(rt, args[0], "query");
+            int k = static_cast<int>(args[1].asNumber());
+            if (k <= 0) throw jsi::JSError(rt, "k must be positive");
+
+            return bridge::runAsync<SearchResults>(rt, invoker,
+                [slot, query, k]() {
+                    SearchResults results{std::vector<int>(k), std::vector<float>(k)};
+                    size_t found = slot->with([&](FaissIndex* index) {
+                        if (!index) throw std::runtime_error("FAISS index not initialized");
+                        return faiss_search(index, query.data, query.count, k,
+                                            results.indices.data(), results.distances.data());
+                    });
+                    results.indices.resize(found);
+                    results.distances.resize(found);
+                    return results;
+                },
+                [](jsi::Runtime& rt, SearchResults& results) {
+                    jsi::Object value(rt);
+                    value.setProperty(rt, "indices", bridge::toArrayBuffer(rt, std::move(results.indices)));
+                    value.setProperty(rt, "distances", bridge::toArrayBuffer(rt, std::move(results.distances)));
+                    return jsi::Value(rt, value);
+                },
+                args[0]);
+        }));
+
+    runtime.global().setProperty(runtime, "FaissNativeJSI", binding);
+}
+
+} // namespace faiss
+} // namespace bookmark
@@ -1,80 +1,237 @@
 #include "faiss-native.h"
+#include "metrics-native.h"
+#include "reduction-native.h"
+#include "residency-native.h"
+#include "scheduler-native.h"
+
+#include <algorithm>
+#include <mutex>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace bookmark {
 namespace faiss {
 
+namespace {
+
+// Width of the flat index at the end of any transforms
+int storedWidth(const ::faiss::Index* index) {
+    auto* transformed = dynamic_cast<const ::faiss::IndexPreTransform*>(index);
+    return transformed ? transformed->index->d : index->d;
+}
+
+} // namespace
+
 FaissIndex* FaissIndex::create(int dimension) {
     auto* index = new ::faiss::IndexFlatL2(dimension);
     if (!index) {
         return nullptr;
     }
-    return new FaissIndex(index);
+    return new FaissIndex(index, "");
+}
+
+FaissIndex* FaissIndex::create(const EmbeddingReduction& reduction) {
+    try {
+        auto* index = new ::faiss::IndexPreTransform(
+            reduction.cloneTransform(), new ::faiss::IndexFlatL2(reduction.outputDimension()));
+        index->own_fields = true;
+        return new FaissIndex(index, "");
+    } catch (...) {
+        metrics::reportException(metrics::Module::Faiss, "create");
+        return nullptr;
+    }
 }
 
 FaissIndex* FaissIndex::load(const std::string& path) {
     try {
-        auto* index = dynamic_cast<::faiss::IndexFlat*>(::faiss::read_index(path.c_str()));
+        auto* index = readIndex(path);
         if (!index) {
+            metrics::reportError(metrics::Module::Faiss, "load", "not a flat index");
             return nullptr;
         }
-        return new FaissIndex(index);
+        return new FaissIndex(index, path);
     } catch (...) {
+        metrics::reportException(metrics::Module::Faiss, "load");
         return nullptr;
     }
 }
 
-FaissIndex::FaissIndex(::faiss::IndexFlat* index) : index_(index) {}
+::faiss::Index* FaissIndex::readIndex(const std::string& path) {
+    std::unique_ptr<::faiss::Index> index(::faiss::read_index(path.c_str()));
+    auto* transformed = dynamic_cast<::faiss::IndexPreTransform*>(index.get());
+    auto* flat = dynamic_cast<::faiss::IndexFlat*>(transformed ? transformed->index : index.get());
+    return flat ? index.release() : nullptr;
+}
+
+FaissIndex::FaissIndex(::faiss::Index* index, const std::string& source_path)
+    : index_(index),
+      source_path_(source_path),
+      count_(static_cast<size_t>(index->ntotal)),
+      dimension_(index->d),
+      stored_dimension_(storedWidth(index)) {
+    metrics::addGauge(metrics::Gauge::IndexBytes, residentBytes());
+    scheduler::lendContext(this, typeid(FaissIndex));
+
+    // An index that matches its file on disk can be dropped while idle and
+    // read back on the next use; one with unsaved vectors has to stay
+    residency::ComponentCallbacks callbacks;
+    callbacks.load = [this]() {
+        try {
+            index_ = readIndex(source_path_);
+        } catch (...) {
+            metrics::reportException(metrics::Module::Faiss, "reload");
+            index_ = nullptr;
+        }
+        if (!index_) return false;
+        metrics::addGauge(metrics::Gauge::IndexBytes, residentBytes());
+        return true;
+    };
+    callbacks.unload = [this]() {
+        if (dirty_ || source_path_.empty()) return false;
+        metrics::addGauge(metrics::Gauge::IndexBytes, -residentBytes());
+        delete index_;
+        index_ = nullptr;
+        return true;
+    };
+    residency_id_ = residency::ResidencyManager::instance().registerComponent(
+        "index", residency::PRIORITY_INDEX, residentBytes(), std::move(callbacks));
+}
 
 FaissIndex::~FaissIndex() {
-    delete index_;
+    scheduler::retireContext(this);
+    pending_.drain();
+    residency::ResidencyManager::instance().unregisterComponent(residency_id_);
+    if (index_) {
+        metrics::addGauge(metrics::Gauge::IndexBytes, -residentBytes());
+        delete index_;
+    }
 }
 
 bool FaissIndex::add(const std::vector<float>& embedding) {
+    return addBatch(embedding.data(), 1);
+}
+
+bool FaissIndex::addBatch(const float* embeddings, size_t count) {
+    residency::Lease lease(residency_id_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!lease || !index_) return false;
+
     try {
-        index_->add(1, embedding.data());
+        index_->add(count, embeddings);
+        count_ = static_cast<size_t>(index_->ntotal);
+        dirty_ = true;
+        metrics::increment(metrics::Counter::VectorsAdded, count);
+        metrics::addGauge(metrics::Gauge::IndexBytes, static_cast<int64_t>(count * stored_dimension_ * sizeof(float)));
+        residency::ResidencyManager::instance().updateFootprint(residency_id_, residentBytes());
         return true;
     } catch (...) {
+        metrics::reportException(metrics::Module::Faiss, count == 1 ? "add" : "add batch");
         return false;
     }
 }
 
 std::vector<std::pair<int, float>> FaissIndex::search(const std::vector<float>& query, int k) {
+    if (k <= 0 || query.size() != static_cast<size_t>(dimension_)) return {};
+
+    std::vector<int> indices(k);
+    std::vector<float> distances(k);
+    size_t found = search(query.data(), k, indices.data(), distances.data());
+
+    std::vector<std::pair<int, float>> results;
+    results.reserve(found);
+    for (size_t i = 0; i < found; ++i) {
+        results.emplace_back(indices[i], distances[i]);
+    }
+    return results;
+}
+
+size_t FaissIndex::search(const float* query, int k, int* indices, float* distances) {
+    residency::Lease lease(residency_id_);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (!lease || !index_ || k <= 0) return 0;
+
+    // Asking for more neighbours than there are vectors only pads the
+    // results with -1 ids
+    k = static_cast<int>(std::min<::faiss::idx_t>(k, index_->ntotal));
+    if (k == 0) return 0;
+
+    metrics::ScopedTimer timer(metrics::Histogram::Search);
+    metrics::increment(metrics::Counter::SearchQueries);
+
+    // FAISS parallelizes through OpenMP, which would otherwise start one
+    // thread per core on every calling thread
+    scheduler::Reservation threads(scheduler::Scheduler::instance().threadBudget(scheduler::currentQoS()));
+#ifdef _OPENMP
+    omp_set_num_threads(threads.threads());
+#endif
+
     try {
-        std::vector<float> distances(k);
-        std::vector<::faiss::idx_t> indices(k);
-        
-        index_->search(1, query.data(), k, distances.data(), indices.data());
-        
-        std::vector<std::pair<int, float>> results;
-        results.reserve(k);
+        // Distances go straight into the caller's buffer; only the 64-bit
+        // ids need narrowing
+        std::vector<::faiss::idx_t> labels(k);
+        index_->search(1, query, k, distances, labels.data());
+
         for (int i = 0; i < k; ++i) {
-            results.emplace_back(indices[i], distances[i]);
+            indices[i] = static_cast<int>(labels[i]);
         }
-        return results;
+        return static_cast<size_t>(k);
     } catch (...) {
-        return {};
+        timer.cancel();
+        metrics::reportException(metrics::Module::Faiss, "search");
+        return 0;
     }
 }
 
 bool FaissIndex::save(const std::string& path) {
+    residency::Lease lease(residency_id_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!lease || !index_) return false;
+
     try {
         ::faiss::write_index(index_, path.c_str());
+        // The file is now a faithful copy to reload from
+        source_path_ = path;
+        dirty_ = false;
         return true;
     } catch (...) {
+        metrics::reportException(metrics::Module::Faiss, "save");
         return false;
     }
 }
 
 void FaissIndex::clear() {
+    residency::Lease lease(residency_id_);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!lease || !index_) return;
+
     try {
+        int64_t bytes = residentBytes();
         index_->reset();
+        count_ = 0;
+        dirty_ = true;
+        metrics::addGauge(metrics::Gauge::IndexBytes, -bytes);
+        residency::ResidencyManager::instance().updateFootprint(residency_id_, 0);
     } catch (...) {
-        // Ignore errors in reset
+        metrics::reportException(metrics::Module::Faiss, "clear");
     }
 }
 
 size_t FaissIndex::size() const {
-    return index_->ntotal;
+    return count_;
+}
+
+int FaissIndex::dimension() const {
+    return dimension_;
+}
+
+int FaissIndex::storedDimension() const {
+    return stored_dimension_;
+}
+
+int64_t FaissIndex::residentBytes() const {
+    return static_cast<int64_t>(count_) * stored_dimension_ * static_cast<int64_t>(sizeof(float));
 }
 
 // C API Implementation
@@ -98,17 +255,16 @@ bool faiss_add_embedding(FaissIndex* index, const float* embedding, size_t size)
     return index->add(std::vector<float>(embedding, embedding + size));
 }
 
+bool faiss_add_embeddings(FaissIndex* index, const float* embeddings, size_t count, size_t dimension) {
+    if (!index || !embeddings || count == 0) return false;
+    if (dimension != static_cast<size_t>(index->dimension())) return false;
+    return index->addBatch(embeddings, count);
+}
+
 size_t faiss_search(FaissIndex* index, const float* query, size_t query_size, int k, int* indices, float* distances) {
     if (!index || !query || !indices || !distances || query_size == 0) return 0;
-    
-    auto results = index->search(std::vector<float>(query, query + query_size), k);
-    
-    for (size_t i = 0; i < results.size(); ++i) {
-        indices[i] = results[i].first;
-        distances[i] = results[i].second;
-    }
-    
-    return results.size();
+    if (query_size != static_cast<size_t>(index->dimension())) return 0;
+    return index->search(query, k, indices, distances);
 }
 
 bool faiss_save_index(FaissIndex* index, const char* path) {
@@ -124,6 +280,27 @@ size_t faiss_get_size(FaissIndex* index) {
     return index ? index->size() : 0;
 }
 
+scheduler::Request* faiss_search_async(FaissIndex* index,
+                                       const float* query,
+                                       size_t query_size,
+                                       int k,
+                                       scheduler::RequestCallback callback,
+                                       void* user_data) {
+    if (!index || !query || k <= 0) return nullptr;
+    if (query_size != static_cast<size_t>(index->dimension())) return nullptr;
+
+    std::vector<float> copy(query, query + query_size);
+    return scheduler::Request::submit(
+        [index, copy = std::move(copy), k](scheduler::Request& request) {
+            request.ints.resize(k);
+            request.floats.resize(k);
+            size_t found = index->search(copy.data(), k, request.ints.data(), request.floats.data());
+            request.ints.resize(found);
+            request.floats.resize(found);
+        },
+        callback, user_data, &index->pendingRequests());
+}
+
 } // extern "C"
 
 } // namespace faiss
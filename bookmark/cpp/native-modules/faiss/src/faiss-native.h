@@ -1,29 +1,65 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 #include <memory>
 #include <faiss/IndexFlat.h>
+#include <faiss/IndexPreTransform.h>
 #include <faiss/index_io.h>
+#include "scheduler-native.h"
 
 namespace bookmark {
 namespace faiss {
 
+class EmbeddingReduction;
+
+// A flat L2 index, optionally behind an embedding reduction (see
+// reduction-native.h) that is applied to every vector added or searched
+// for and is saved in the same file.
 class FaissIndex {
 public:
     static FaissIndex* create(int dimension);
+    // Takes embeddings of the reduction's input width and stores them at its
+    // output width
+    static FaissIndex* create(const EmbeddingReduction& reduction);
     static FaissIndex* load(const std::string& path);
     ~FaissIndex();
 
     bool add(const std::vector<float>& embedding);
+    bool addBatch(const float* embeddings, size_t count);
     std::vector<std::pair<int, float>> search(const std::vector<float>& query, int k);
+    // Writes up to k neighbours of a dimension()-long query into indices and
+    // distances, closest first, and returns how many were written
+    size_t search(const float* query, int k, int* indices, float* distances);
     bool save(const std::string& path);
     void clear();
     size_t size() const;
+    // Width of the embeddings added and searched for
+    int dimension() const;
+    // Width they are stored at; below dimension() behind a reduction
+    int storedDimension() const;
+    // Vector storage held by the flat index when resident
+    int64_t residentBytes() const;
+
+    scheduler::PendingRequests& pendingRequests() { return pending_; }
 
 private:
-    FaissIndex(::faiss::IndexFlat* index);
-    ::faiss::IndexFlat* index_;
+    FaissIndex(::faiss::Index* index, const std::string& source_path);
+    // A flat index, or a flat index behind transforms; null for anything else
+    static ::faiss::Index* readIndex(const std::string& path);
+
+    ::faiss::Index* index_;     // null while evicted, see residency-native.h
+    std::string source_path_;   // file the index was last loaded from or saved to
+    std::atomic<size_t> count_;
+    int dimension_;
+    int stored_dimension_;
+    bool dirty_ = false;        // vectors added or removed since source_path_
+    uint32_t residency_id_ = 0;
+    std::shared_mutex mutex_;   // searches share, writers exclude
+    scheduler::PendingRequests pending_;
 };
 
 // React Native binding interface
@@ -32,10 +68,21 @@ extern "C" {
     FaissIndex* faiss_load_index(const char* path);
     void faiss_destroy_index(FaissIndex* index);
     bool faiss_add_embedding(FaissIndex* index, const float* embedding, size_t size);
+    bool faiss_add_embeddings(FaissIndex* index, const float* embeddings, size_t count, size_t dimension);
     size_t faiss_search(FaissIndex* index, const float* query, size_t query_size, int k, int* indices, float* distances);
     bool faiss_save_index(FaissIndex* index, const char* path);
     void faiss_clear_index(FaissIndex* index);
     size_t faiss_get_size(FaissIndex* index);
+
+    // Searches a copy of the query on the shared scheduler; the request's
+    // ints and floats hold the ids and distances, closest first. Null if the
+    // arguments are invalid.
+    scheduler::Request* faiss_search_async(FaissIndex* index,
+                                           const float* query,
+                                           size_t query_size,
+                                           int k,
+                                           scheduler::RequestCallback callback,
+                                           void* user_data);
 }
 
 } // namespace faiss
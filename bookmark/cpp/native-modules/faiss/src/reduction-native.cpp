@@ -0,0 +1,238 @@
+#include "reduction-native.h"
+#include "faiss-native.h"
+#include "metrics-native.h"
+#include "scheduler-native.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <faiss/clone_index.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace bookmark {
+namespace faiss {
+
+namespace {
+
+// Fixed so a library retrained with the same widths gets the same rotation
+constexpr int kRotationSeed = 1234;
+
+// Sets the calling thread's OpenMP thread count until the end of the scope,
+// so later FAISS calls on the same worker don't inherit it
+class ScopedOmpThreads {
+public:
+    explicit ScopedOmpThreads([[maybe_unused]] int threads) {
+#ifdef _OPENMP
+        previous_ = omp_get_max_threads();
+        omp_set_num_threads(threads);
+#endif
+    }
+    ~ScopedOmpThreads() {
+#ifdef _OPENMP
+        omp_set_num_threads(previous_);
+#endif
+    }
+    ScopedOmpThreads(const ScopedOmpThreads&) = delete;
+    ScopedOmpThreads& operator=(const ScopedOmpThreads&) = delete;
+
+#ifdef _OPENMP
+private:
+    int previous_;
+#endif
+};
+
+} // namespace
+
+EmbeddingReduction* EmbeddingReduction::train(ReductionKind kind,
+                                              int input_dimension,
+                                              int output_dimension,
+                                              const float* samples,
+                                              size_t count) {
+    if (input_dimension <= 0 || output_dimension <= 0 || output_dimension > input_dimension) {
+        return nullptr;
+    }
+
+    std::unique_ptr<::faiss::VectorTransform> transform;
+    try {
+        if (kind == ReductionKind::Pca) {
+            if (!samples || count < static_cast<size_t>(output_dimension)) {
+                metrics::reportError(metrics::Module::Faiss, "train reduction", "too few samples for PCA");
+                return nullptr;
+            }
+            transform.reset(new ::faiss::PCAMatrix(input_dimension, output_dimension));
+            transform->train(static_cast<::faiss::idx_t>(count), samples);
+        } else {
+            auto* rotation = new ::faiss::RandomRotationMatrix(input_dimension, output_dimension);
+            transform.reset(rotation);
+            rotation->init(kRotationSeed);
+        }
+    } catch (...) {
+        metrics::reportException(metrics::Module::Faiss, "train reduction");
+        return nullptr;
+    }
+    return new EmbeddingReduction(transform.release());
+}
+
+EmbeddingReduction* EmbeddingReduction::load(const std::string& path) {
+    try {
+        std::unique_ptr<::faiss::VectorTransform> transform(::faiss::read_VectorTransform(path.c_str()));
+        if (!transform || !transform->is_trained) {
+            metrics::reportError(metrics::Module::Faiss, "load reduction", "not a trained transform");
+            return nullptr;
+        }
+        return new EmbeddingReduction(transform.release());
+    } catch (...) {
+        metrics::reportException(metrics::Module::Faiss, "load reduction");
+        return nullptr;
+    }
+}
+
+EmbeddingReduction::EmbeddingReduction(::faiss::VectorTransform* transform) : transform_(transform) {}
+
+EmbeddingReduction::~EmbeddingReduction() {
+    delete transform_;
+}
+
+bool EmbeddingReduction::save(const std::string& path) const {
+    try {
+        ::faiss::write_VectorTransform(transform_, path.c_str());
+        return true;
+    } catch (...) {
+        metrics::reportException(metrics::Module::Faiss, "save reduction");
+        return false;
+    }
+}
+
+void EmbeddingReduction::apply(const float* input, size_t count, float* output) const {
+    transform_->apply_noalloc(static_cast<::faiss::idx_t>(count), input, output);
+}
+
+::faiss::VectorTransform* EmbeddingReduction::cloneTransform() const {
+    return ::faiss::clone_VectorTransform(transform_);
+}
+
+std::vector<ReductionRecall> measureReductionRecall(ReductionKind kind,
+                                                    int dimension,
+                                                    const float* base,
+                                                    size_t base_count,
+                                                    const float* queries,
+                                                    size_t query_count,
+                                                    const std::vector<int>& widths,
+                                                    int k) {
+    std::vector<ReductionRecall> report;
+    if (dimension <= 0 || !base || !queries || base_count == 0 || query_count == 0 || k <= 0) {
+        return report;
+    }
+    k = static_cast<int>(std::min<size_t>(k, base_count));
+
+    // Training and search are as parallel as a background task may be
+    scheduler::Reservation threads(scheduler::Scheduler::instance().threadBudget(scheduler::currentQoS()));
+    ScopedOmpThreads omp_threads(threads.threads());
+
+    const size_t results = query_count * static_cast<size_t>(k);
+    std::vector<::faiss::idx_t> truth(results);
+    std::vector<::faiss::idx_t> labels(results);
+    std::vector<float> distances(results);
+
+    // Searches one query at a time, as the app does, filling labels
+    auto timed_search = [&](const ::faiss::Index& index, const float* xq, int width) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t q = 0; q < query_count; ++q) {
+            index.search(1, xq + q * width, k, distances.data() + q * k, labels.data() + q * k);
+        }
+        auto elapsed = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start);
+        return elapsed.count() / static_cast<float>(query_count);
+    };
+
+    try {
+        ::faiss::IndexFlatL2 full(dimension);
+        full.add(static_cast<::faiss::idx_t>(base_count), base);
+        float full_us = timed_search(full, queries, dimension);
+        truth = labels;
+
+        std::vector<float> reduced_base;
+        std::vector<float> reduced_queries;
+        for (int width : widths) {
+            if (width <= 0 || width > dimension) continue;
+
+            ReductionRecall row{width, 1.0f, static_cast<int64_t>(width * sizeof(float)), full_us};
+            if (width < dimension) {
+                std::unique_ptr<EmbeddingReduction> reduction(
+                    EmbeddingReduction::train(kind, dimension, width, base, base_count));
+                if (!reduction) continue;
+
+                reduced_base.resize(base_count * width);
+                reduced_queries.resize(query_count * width);
+                reduction->apply(base, base_count, reduced_base.data());
+                reduction->apply(queries, query_count, reduced_queries.data());
+
+                ::faiss::IndexFlatL2 index(width);
+                index.add(static_cast<::faiss::idx_t>(base_count), reduced_base.data());
+                row.search_us = timed_search(index, reduced_queries.data(), width);
+
+                // Order within the top k doesn't matter to retrieval
+                size_t found = 0;
+                for (size_t q = 0; q < query_count; ++q) {
+                    auto begin = truth.begin() + q * k;
+                    for (int i = 0; i < k; ++i) {
+                        if (std::find(begin, begin + k, labels[q * k + i]) != begin + k) found++;
+                    }
+                }
+                row.recall = static_cast<float>(found) / static_cast<float>(results);
+            }
+            report.push_back(row);
+        }
+    } catch (...) {
+        metrics::reportException(metrics::Module::Faiss, "measure reduction");
+    }
+    return report;
+}
+
+// C API Implementation
+extern "C" {
+
+EmbeddingReduction* faiss_reduction_train(int kind,
+                                          int input_dimension,
+                                          int output_dimension,
+                                          const float* samples,
+                                          size_t count) {
+    return EmbeddingReduction::train(kind == 1 ? ReductionKind::RandomRotation : ReductionKind::Pca,
+                                     input_dimension, output_dimension, samples, count);
+}
+
+EmbeddingReduction* faiss_reduction_load(const char* path) {
+    if (!path) return nullptr;
+    return EmbeddingReduction::load(path);
+}
+
+bool faiss_reduction_save(EmbeddingReduction* reduction, const char* path) {
+    if (!reduction || !path) return false;
+    return reduction->save(path);
+}
+
+void faiss_reduction_destroy(EmbeddingReduction* reduction) {
+    delete reduction;
+}
+
+FaissIndex* faiss_create_reduced_index(const EmbeddingReduction* reduction) {
+    if (!reduction) return nullptr;
+    return FaissIndex::create(*reduction);
+}
+
+FaissIndex* faiss_create_index_with_reduction(int dimension, const char* reduction_path) {
+    std::unique_ptr<EmbeddingReduction> reduction(faiss_reduction_load(reduction_path));
+    if (!reduction) return nullptr;
+    if (reduction->inputDimension() != dimension) {
+        metrics::reportError(metrics::Module::Faiss, "create index", "reduction is for another embedding width");
+        return nullptr;
+    }
+    return FaissIndex::create(*reduction);
+}
+
+} // extern "C"
+
+} // namespace faiss
+} // namespace bookmark
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <faiss/VectorTransform.h>
+
+namespace bookmark {
+namespace faiss {
+
+class FaissIndex;
+
+enum class ReductionKind : int {
+    Pca = 0,            // principal components of the sample embeddings
+    RandomRotation = 1, // data-independent; keeps less at the same width
+};
+
+// A linear map from embeddings onto fewer dimensions, trained once per
+// library and then applied in front of each book's index (see
+// FaissIndex::create), so search cost and index size scale with the
+// reduced width rather than the model's.
+class EmbeddingReduction {
+public:
+    // PCA needs at least output_dimension samples; a random rotation
+    // ignores them
+    static EmbeddingReduction* train(ReductionKind kind,
+                                     int input_dimension,
+                                     int output_dimension,
+                                     const float* samples,
+                                     size_t count);
+    static EmbeddingReduction* load(const std::string& path);
+    ~EmbeddingReduction();
+
+    bool save(const std::string& path) const;
+
+    int inputDimension() const { return transform_->d_in; }
+    int outputDimension() const { return transform_->d_out; }
+
+    // count row-major vectors of inputDimension() into outputDimension()
+    void apply(const float* input, size_t count, float* output) const;
+
+    // A copy for an index to own
+    ::faiss::VectorTransform* cloneTransform() const;
+
+private:
+    explicit EmbeddingReduction(::faiss::VectorTransform* transform);
+
+    ::faiss::VectorTransform* transform_;
+};
+
+struct ReductionRecall {
+    int dimension;
+    float recall;             // share of the full-width top k also found at this width
+    int64_t bytes_per_vector; // index storage per chunk
+    float search_us;          // mean single-query search time
+};
+
+// For each width, trains a reduction on base, indexes base at that width
+// and compares the top k of each query with its top k at full width. Widths
+// of 0 or above dimension are skipped; dimension itself is the baseline.
+std::vector<ReductionRecall> measureReductionRecall(ReductionKind kind,
+                                                    int dimension,
+                                                    const float* base,
+                                                    size_t base_count,
+                                                    const float* queries,
+                                                    size_t query_count,
+                                                    const std::vector<int>& widths,
+                                                    int k);
+
+// React Native binding interface
+extern "C" {
+    // kind is a ReductionKind value
+    EmbeddingReduction* faiss_reduction_train(int kind,
+                                              int input_dimension,
+                                              int output_dimension,
+                                              const float* samples,
+                                              size_t count);
+    EmbeddingReduction* faiss_reduction_load(const char* path);
+    bool faiss_reduction_save(EmbeddingReduction* reduction, const char* path);
+    void faiss_reduction_destroy(EmbeddingReduction* reduction);
+
+    // An empty index taking embeddings of the reduction's input width
+    FaissIndex* faiss_create_reduced_index(const EmbeddingReduction* reduction);
+    // Same, loading the reduction from path; null if it doesn't take
+    // embeddings of dimension
+    FaissIndex* faiss_create_index_with_reduction(int dimension, const char* reduction_path);
+}
+
+} // namespace faiss
+} // namespace bookmark
@@ -0,0 +1,148 @@
+#include <jni.h>
+#include <string>
+#include "ingest-native.h"
+#include <android/log.h>
+
+#define LOG_TAG "IngestNative"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+using namespace bookmark::ingest;
+
+namespace {
+
+// Owns the ingestor together with the Java module that receives progress
+struct IngestHandle {
+    BookIngestor* ingestor;
+    JavaVM* vm;
+    jobject module;
+    jmethodID on_progress;
+};
+
+// Detaches the embedding thread from the VM when it exits
+struct ThreadAttachment {
+    JavaVM* vm = nullptr;
+    ~ThreadAttachment() {
+        if (vm) vm->DetachCurrentThread();
+    }
+};
+
+thread_local ThreadAttachment attachment;
+
+void onProgress(size_t bytes_done, size_t total_bytes, size_t chunks_done, void* user_data) {
+    auto* handle = static_cast<IngestHandle*>(user_data);
+
+    JNIEnv* env = nullptr;
+    if (handle->vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) {
+        if (handle->vm->AttachCurrentThread(reinterpret_cast<void**>(&env), nullptr) != JNI_OK) {
+            LOGE("Failed to attach ingestion thread");
+            return;
+        }
+        attachment.vm = handle->vm;
+    }
+
+    env->CallVoidMethod(
+        handle->module,
+        handle->on_progress,
+        static_cast<jlong>(bytes_done),
+        static_cast<jlong>(total_bytes),
+        static_cast<jlong>(chunks_done)
+    );
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_bookmark_IngestModule_createIngestorNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong llm_ptr
+) {
+    BookIngestor* ingestor = ingest_create(reinterpret_cast<bookmark::mlc_llm::LLMContext*>(llm_ptr));
+    if (!ingestor) {
+        LOGE("Failed to create ingestor");
+        return 0;
+    }
+
+    auto* handle = new IngestHandle();
+    handle->ingestor = ingestor;
+    env->GetJavaVM(&handle->vm);
+    handle->module = env->NewGlobalRef(thiz);
+    handle->on_progress = env->GetMethodID(
+        env->FindClass("com/bookmark/IngestModule"),
+        "onNativeProgress",
+        "(JJJ)V"
+    );
+
+    ingest_set_progress_callback(ingestor, onProgress, handle);
+    return reinterpret_cast<jlong>(handle);
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_IngestModule_destroyIngestorNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong handle_ptr
+) {
+    auto* handle = reinterpret_cast<IngestHandle*>(handle_ptr);
+    if (!handle) return;
+
+    ingest_destroy(handle->ingestor);
+    env->DeleteGlobalRef(handle->module);
+    delete handle;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_IngestModule_ingestNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong handle_ptr,
+    jstring book_path,
+    jstring index_path,
+    jint max_chunk_bytes,
+    jint overlap_bytes,
+    jint batch_size,
+    jstring store_path,
+    jstring book_id,
+    jstring reduction_path,
+    jstring term_library_path
+) {
+    auto* handle = reinterpret_cast<IngestHandle*>(handle_ptr);
+    if (!handle) return false;
+
+    const char* book = env->GetStringUTFChars(book_path, nullptr);
+    const char* index = env->GetStringUTFChars(index_path, nullptr);
+    // The chunk store and term library are each skipped without a book id
+    const char* id = book_id ? env->GetStringUTFChars(book_id, nullptr) : nullptr;
+    const char* store = store_path && id ? env->GetStringUTFChars(store_path, nullptr) : nullptr;
+    const char* reduction = reduction_path ? env->GetStringUTFChars(reduction_path, nullptr) : nullptr;
+    const char* library = term_library_path && id ? env->GetStringUTFChars(term_library_path, nullptr) : nullptr;
+
+    bool success = ingest_run(handle->ingestor, book, index, max_chunk_bytes, overlap_bytes, batch_size,
+                              store, id, reduction, library);
+
+    if (library) env->ReleaseStringUTFChars(term_library_path, library);
+    if (reduction) env->ReleaseStringUTFChars(reduction_path, reduction);
+    if (id) env->ReleaseStringUTFChars(book_id, id);
+    if (store) env->ReleaseStringUTFChars(store_path, store);
+    env->ReleaseStringUTFChars(book_path, book);
+    env->ReleaseStringUTFChars(index_path, index);
+    return success;
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_IngestModule_cancelNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong handle_ptr
+) {
+    auto* handle = reinterpret_cast<IngestHandle*>(handle_ptr);
+    if (handle) ingest_cancel(handle->ingestor);
+}
+
+} // extern "C"
@@ -0,0 +1,136 @@
+package com.bookmark;
+
+import com.facebook.react.bridge.ReactApplicationContext;
+import com.facebook.react.bridge.ReactContextBaseJavaModule;
+import com.facebook.react.bridge.ReactMethod;
+import com.facebook.react.bridge.Promise;
+import com.facebook.react.bridge.ReadableMap;
+import com.facebook.react.bridge.WritableMap;
+import com.facebook.react.bridge.Arguments;
+import com.facebook.react.modules.core.DeviceEventManagerModule;
+
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+public class IngestModule extends ReactContextBaseJavaModule {
+    private static final String EVENT_NAME = "onIngestProgress";
+
+    private long ingestorPtr = 0;
+    private final ExecutorService ingestExecutor = Executors.newSingleThreadExecutor();
+
+    static {
+        System.loadLibrary("ingest-native");
+    }
+
+    public IngestModule(ReactApplicationContext reactContext) {
+        super(reactContext);
+    }
+
+    @Override
+    public String getName() {
+        return "IngestNative";
+    }
+
+    @ReactMethod
+    public void createIngestor(Promise promise) {
+        try {
+            MLCLLMModule llm = getReactApplicationContext().getNativeModule(MLCLLMModule.class);
+            if (llm == null) {
+                throw new IllegalStateException("MLC LLM module not registered");
+            }
+
+            if (ingestorPtr != 0) {
+                destroyIngestorNative(ingestorPtr);
+            }
+
+            ingestorPtr = createIngestorNative(llm.getContextPtr());
+            promise.resolve(ingestorPtr != 0);
+        } catch (Exception e) {
+            promise.reject("ERR_INGEST", "Failed to create ingestor: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void ingest(String bookPath, String indexPath, ReadableMap options, Promise promise) {
+        if (ingestorPtr == 0) {
+            promise.reject("ERR_INGEST", "Ingestor not initialized");
+            return;
+        }
+
+        final long ptr = ingestorPtr;
+        final int maxChunkBytes = options.hasKey("maxChunkBytes") ? options.getInt("maxChunkBytes") : 512;
+        final int overlapBytes = options.hasKey("overlapBytes") ? options.getInt("overlapBytes") : 50;
+        final int batchSize = options.hasKey("batchSize") ? options.getInt("batchSize") : 16;
+        final String storePath = options.hasKey("storePath") ? options.getString("storePath") : null;
+        final String bookId = options.hasKey("bookId") ? options.getString("bookId") : null;
+        final String reductionPath = options.hasKey("reductionPath") ? options.getString("reductionPath") : null;
+        final String termLibraryPath = options.hasKey("termLibraryPath") ? options.getString("termLibraryPath") : null;
+
+        // Ingestion takes minutes for long books, keep it off the bridge thread
+        ingestExecutor.execute(() -> {
+            try {
+                promise.resolve(ingestNative(ptr, bookPath, indexPath, maxChunkBytes, overlapBytes, batchSize,
+                                             storePath, bookId, reductionPath, termLibraryPath));
+            } catch (Exception e) {
+                promise.reject("ERR_INGEST", "Failed to ingest book: " + e.getMessage());
+            }
+        });
+    }
+
+    @ReactMethod
+    public void cancel(Promise promise) {
+        try {
+            if (ingestorPtr != 0) {
+                cancelNative(ingestorPtr);
+            }
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_INGEST", "Failed to cancel ingestion: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void cleanup(Promise promise) {
+        try {
+            if (ingestorPtr != 0) {
+                cancelNative(ingestorPtr);
+                destroyIngestorNative(ingestorPtr);
+                ingestorPtr = 0;
+            }
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_INGEST", "Failed to cleanup ingestor: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void addListener(String eventName) {
+        // Required for NativeEventEmitter
+    }
+
+    @ReactMethod
+    public void removeListeners(double count) {
+        // Required for NativeEventEmitter
+    }
+
+    // Called from the native embedding thread
+    private void onNativeProgress(long bytesDone, long totalBytes, long chunksDone) {
+        WritableMap event = Arguments.createMap();
+        event.putDouble("bytesDone", bytesDone);
+        event.putDouble("totalBytes", totalBytes);
+        event.putDouble("chunksDone", chunksDone);
+
+        getReactApplicationContext()
+            .getJSModule(DeviceEventManagerModule.RCTDeviceEventEmitter.class)
+            .emit(EVENT_NAME, event);
+    }
+
+    // Native method declarations
+    private native long createIngestorNative(long llmPtr);
+    private native void destroyIngestorNative(long ingestorPtr);
+    private native boolean ingestNative(long ingestorPtr, String bookPath, String indexPath,
+                                        int maxChunkBytes, int overlapBytes, int batchSize,
+                                        String storePath, String bookId, String reductionPath,
+                                        String termLibraryPath);
+    private native void cancelNative(long ingestorPtr);
+}
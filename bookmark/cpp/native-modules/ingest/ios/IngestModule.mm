@@ -0,0 +1,143 @@
+#import "IngestModule.h"
+#import <React/RCTLog.h>
+#import "ingest-native.h"
+#import "MLCLLMModule.h"
+
+using namespace bookmark::ingest;
+
+static NSString* const kIngestProgressEvent = @"onIngestProgress";
+
+@implementation IngestModule {
+    BookIngestor* _ingestor;
+    dispatch_queue_t _ingestQueue;
+    BOOL _hasListeners;
+}
+
+RCT_EXPORT_MODULE(IngestNative)
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _ingestor = nullptr;
+        _ingestQueue = dispatch_queue_create("com.bookmark.ingest", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_ingestor != nullptr) {
+        ingest_cancel(_ingestor);
+        dispatch_sync(_ingestQueue, ^{});
+        ingest_destroy(_ingestor);
+        _ingestor = nullptr;
+    }
+}
+
+- (NSArray<NSString*>*)supportedEvents {
+    return @[kIngestProgressEvent];
+}
+
+- (void)startObserving {
+    _hasListeners = YES;
+}
+
+- (void)stopObserving {
+    _hasListeners = NO;
+}
+
+// Called from the native embedding thread
+static void onIngestProgress(size_t bytesDone, size_t totalBytes, size_t chunksDone, void* userData) {
+    IngestModule* module = (__bridge IngestModule*)userData;
+    if (!module->_hasListeners) {
+        return;
+    }
+
+    [module sendEventWithName:kIngestProgressEvent body:@{
+        @"bytesDone": @(bytesDone),
+        @"totalBytes": @(totalBytes),
+        @"chunksDone": @(chunksDone)
+    }];
+}
+
+RCT_EXPORT_METHOD(createIngestor:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        MLCLLMModule* llm = [self.bridge moduleForClass:[MLCLLMModule class]];
+
+        if (_ingestor != nullptr) {
+            ingest_destroy(_ingestor);
+        }
+
+        _ingestor = ingest_create(static_cast<bookmark::mlc_llm::LLMContext*>([llm nativeHandle]));
+        if (_ingestor != nullptr) {
+            ingest_set_progress_callback(_ingestor, onIngestProgress, (__bridge void*)self);
+        }
+        resolve(@(_ingestor != nullptr));
+    } @catch (NSException* e) {
+        reject(@"ERR_INGEST", @"Failed to create ingestor", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(ingest:(NSString*)bookPath
+                  indexPath:(NSString*)indexPath
+                  options:(NSDictionary*)options
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    if (_ingestor == nullptr) {
+        reject(@"ERR_INGEST", @"Ingestor not initialized", nil);
+        return;
+    }
+
+    BookIngestor* ingestor = _ingestor;
+    std::string book = [bookPath UTF8String];
+    std::string index = [indexPath UTF8String];
+    size_t maxChunkBytes = options[@"maxChunkBytes"] ? [options[@"maxChunkBytes"] unsignedLongValue] : 512;
+    size_t overlapBytes = options[@"overlapBytes"] ? [options[@"overlapBytes"] unsignedLongValue] : 50;
+    size_t batchSize = options[@"batchSize"] ? [options[@"batchSize"] unsignedLongValue] : 16;
+    // The chunk store and term library are each skipped without a book id
+    bool hasBookId = options[@"bookId"] != nil;
+    std::string bookId = hasBookId ? [options[@"bookId"] UTF8String] : "";
+    bool useStore = hasBookId && options[@"storePath"] != nil;
+    std::string storePath = useStore ? [options[@"storePath"] UTF8String] : "";
+    NSString* reduction = options[@"reductionPath"];
+    std::string reductionPath = reduction != nil ? [reduction UTF8String] : "";
+    bool useLibrary = hasBookId && options[@"termLibraryPath"] != nil;
+    std::string libraryPath = useLibrary ? [options[@"termLibraryPath"] UTF8String] : "";
+
+    // Ingestion takes minutes for long books, keep it off the module queue
+    dispatch_async(_ingestQueue, ^{
+        bool success = ingest_run(ingestor, book.c_str(), index.c_str(), maxChunkBytes, overlapBytes, batchSize,
+                                  useStore ? storePath.c_str() : nullptr, hasBookId ? bookId.c_str() : nullptr,
+                                  reduction != nil ? reductionPath.c_str() : nullptr,
+                                  useLibrary ? libraryPath.c_str() : nullptr);
+        resolve(@(success));
+    });
+}
+
+RCT_EXPORT_METHOD(cancel:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_ingestor != nullptr) {
+            ingest_cancel(_ingestor);
+        }
+        resolve(nil);
+    } @catch (NSException* e) {
+        reject(@"ERR_INGEST", @"Failed to cancel ingestion", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(cleanup:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_ingestor != nullptr) {
+            ingest_cancel(_ingestor);
+            dispatch_sync(_ingestQueue, ^{});
+            ingest_destroy(_ingestor);
+            _ingestor = nullptr;
+        }
+        resolve(nil);
+    } @catch (NSException* e) {
+        reject(@"ERR_INGEST", @"Failed to cleanup ingestor", nil);
+    }
+}
+
+@end
@@ -0,0 +1,583 @@
+#include "ingest-native.h"
+#include "chunk-store-native.h"
+#include "metrics-native.h"
+#include "reduction-native.h"
+#include "scheduler-native.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bookmark {
+namespace ingest {
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool isContinuationByte(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+// Read-only mapping of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        fd_ = open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) return;
+
+        struct stat st;
+        if (fstat(fd_, &st) != 0 || st.st_size == 0) return;
+
+        void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (addr == MAP_FAILED) return;
+
+        madvise(addr, st.st_size, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(addr);
+        size_ = static_cast<size_t>(st.st_size);
+    }
+
+    ~MappedFile() {
+        if (data_) munmap(const_cast<char*>(data_), size_);
+        if (fd_ >= 0) close(fd_);
+    }
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool valid() const { return data_ != nullptr; }
+
+private:
+    int fd_ = -1;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+struct ChunkBatch {
+    std::vector<ChunkSpan> spans;
+    size_t next_offset; // segmenter position after the last span
+};
+
+// Bounded hand-off between the segmenter and the embedding thread
+class BatchQueue {
+public:
+    explicit BatchQueue(size_t capacity) : capacity_(capacity) {}
+
+    bool push(ChunkBatch batch) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return closed_ || batches_.size() < capacity_; });
+        if (closed_) return false;
+        batches_.push_back(std::move(batch));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    bool pop(ChunkBatch& batch) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return closed_ || !batches_.empty(); });
+        if (batches_.empty()) return false;
+        batch = std::move(batches_.front());
+        batches_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    std::deque<ChunkBatch> batches_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    bool closed_ = false;
+};
+
+struct Checkpoint {
+    size_t chunks = 0;
+    size_t next_offset = 0;
+    size_t records_bytes = 0;
+};
+
+bool readCheckpoint(const std::string& path, Checkpoint& checkpoint) {
+    std::ifstream in(path);
+    return static_cast<bool>(in >> checkpoint.chunks >> checkpoint.next_offset >> checkpoint.records_bytes);
+}
+
+bool writeCheckpoint(const std::string& path, const Checkpoint& checkpoint) {
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        out << checkpoint.chunks << " " << checkpoint.next_offset << " " << checkpoint.records_bytes << "\n";
+        if (!out) return false;
+    }
+    return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+void appendJsonString(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+// Same naming RAGService uses for the chunk file next to an index
+std::string sidecarPathFor(const std::string& index_path, const std::string& extension) {
+    const std::string suffix = ".index";
+    if (index_path.size() > suffix.size() &&
+        index_path.compare(index_path.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        return index_path.substr(0, index_path.size() - suffix.size()) + extension;
+    }
+    return index_path + extension;
+}
+
+// Turn the one-record-per-line file into the JSON array RAGService reads
+bool writeChunksJson(const std::string& records_path, const std::string& json_path) {
+    std::ifstream in(records_path);
+    std::ofstream out(json_path, std::ios::trunc);
+    if (!in || !out) return false;
+
+    out << "[";
+    std::string line;
+    bool first = true;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        if (!first) out << ",";
+        out << line;
+        first = false;
+    }
+    out << "]";
+    return static_cast<bool>(out);
+}
+
+// Adds the book to the term library saved at path, replacing the dictionary
+// it was last ingested with. The library only weights key terms, so a
+// failure is reported without failing the ingestion.
+void updateTermLibrary(const std::string& path,
+                       const std::string& book_id,
+                       const terms::TermDictionary& dictionary,
+                       const terms::TermDictionary* previous) {
+    // A missing library file just means no books were added yet
+    std::unique_ptr<terms::TermLibrary> library(terms::TermLibrary::load(path));
+    if (!library) library.reset(terms::TermLibrary::create());
+
+    if (!library->addBook(book_id, dictionary, previous) || !library->save(path)) {
+        metrics::reportError(metrics::Module::Ingest, "term library", book_id.c_str());
+    }
+}
+
+} // namespace
+
+ChunkSegmenter::ChunkSegmenter(const char* data, size_t size, size_t max_chunk_bytes, size_t overlap_bytes)
+    : data_(data),
+      size_(size),
+      max_chunk_bytes_(max_chunk_bytes > 0 ? max_chunk_bytes : 512),
+      overlap_bytes_(overlap_bytes < max_chunk_bytes_ ? overlap_bytes : 0) {}
+
+size_t ChunkSegmenter::sentenceEnd(size_t from) const {
+    for (size_t i = from; i < size_; ++i) {
+        char c = data_[i];
+        if ((c == '.' || c == '!' || c == '?') && (i + 1 == size_ || isSpace(data_[i + 1]) ||
+                                                   data_[i + 1] == '"' || data_[i + 1] == '\'')) {
+            size_t end = i + 1;
+            while (end < size_ && (data_[end] == '"' || data_[end] == '\'')) ++end;
+            return end;
+        }
+    }
+    return size_;
+}
+
+size_t ChunkSegmenter::wordBoundaryBefore(size_t start, size_t limit) const {
+    for (size_t i = limit; i > start; --i) {
+        if (isSpace(data_[i - 1])) return i - 1;
+    }
+
+    // No whitespace at all: hard cut, but never inside a UTF-8 sequence
+    size_t cut = limit;
+    while (cut > start + 1 && isContinuationByte(data_[cut])) --cut;
+    return cut;
+}
+
+bool ChunkSegmenter::next(ChunkSpan& span) {
+    size_t content = pos_;
+    while (content < size_ && isSpace(data_[content])) ++content;
+    if (content >= size_) return false;
+
+    // Overlap: start at the first word within overlap_bytes of the
+    // previous chunk's end, never before the previous chunk itself
+    size_t start = content;
+    if (overlap_bytes_ > 0 && pos_ > 0) {
+        size_t from = pos_ > overlap_bytes_ ? pos_ - overlap_bytes_ : 0;
+        if (from < last_start_) from = last_start_;
+        for (size_t i = from; i < pos_; ++i) {
+            if (isSpace(data_[i])) {
+                start = i + 1;
+                break;
+            }
+        }
+    }
+
+    // New text: whole sentences up to max_chunk_bytes
+    size_t end = content;
+    while (end < size_) {
+        size_t sentence_end = sentenceEnd(end);
+        if (sentence_end - content <= max_chunk_bytes_) {
+            end = sentence_end;
+            continue;
+        }
+
+        if (end == content) {
+            // A single sentence longer than a chunk is split between words
+            end = wordBoundaryBefore(content, content + max_chunk_bytes_);
+        }
+        break;
+    }
+
+    span.start = start;
+    span.end = end;
+    last_start_ = start;
+    pos_ = end;
+    return true;
+}
+
+std::string normalizeChunkText(const char* data, size_t start, size_t end) {
+    std::string text;
+    text.reserve(end - start);
+
+    bool pending_space = false;
+    for (size_t i = start; i < end; ++i) {
+        if (isSpace(data[i])) {
+            pending_space = !text.empty();
+            continue;
+        }
+        if (pending_space) {
+            text += ' ';
+            pending_space = false;
+        }
+        text += data[i];
+    }
+    return text;
+}
+
+BookIngestor* BookIngestor::create(mlc_llm::LLMContext* llm) {
+    if (!llm) return nullptr;
+    return new BookIngestor(llm);
+}
+
+BookIngestor::BookIngestor(mlc_llm::LLMContext* llm) : llm_(llm) {}
+
+void BookIngestor::setProgressCallback(ingest_progress_callback callback, void* user_data) {
+    callback_ = callback;
+    user_data_ = user_data;
+}
+
+void BookIngestor::cancel() {
+    cancelled_ = true;
+}
+
+bool BookIngestor::run(const std::string& book_path, const std::string& index_path, const IngestOptions& options) {
+    cancelled_ = false;
+
+    // Ingestion yields the cores to anything the user is waiting on
+    scheduler::ScopedQoS qos(scheduler::QoS::Background);
+
+    MappedFile book(book_path);
+    if (!book.valid()) {
+        metrics::reportError(metrics::Module::Ingest, "open", book_path.c_str());
+        return false;
+    }
+
+    const std::string partial_index_path = index_path + ".partial";
+    const std::string records_path = index_path + ".chunks";
+    const std::string checkpoint_path = index_path + ".ckpt";
+
+    // Resume from the last checkpoint if one matches the partial output
+    Checkpoint checkpoint;
+    std::unique_ptr<faiss::FaissIndex> index;
+    if (readCheckpoint(checkpoint_path, checkpoint)) {
+        index.reset(faiss::FaissIndex::load(partial_index_path));
+        if (!index || index->size() != checkpoint.chunks || checkpoint.next_offset > book.size() ||
+            truncate(records_path.c_str(), checkpoint.records_bytes) != 0) {
+            index.reset();
+            checkpoint = Checkpoint();
+        }
+    }
+    if (!index) {
+        std::remove(records_path.c_str());
+    }
+
+    // The store keeps what the index has: nothing on a fresh run, and on a
+    // resume none of the chunks embedded after the checkpoint
+    std::unique_ptr<chunk_store::ChunkStore> store;
+    if (!options.store_path.empty() && !options.book_id.empty()) {
+        store.reset(chunk_store::ChunkStore::open(options.store_path));
+        bool trimmed = store && (index ? store->truncate(options.book_id, checkpoint.chunks)
+                                       : store->removeBook(options.book_id));
+        if (!trimmed) {
+            metrics::reportError(metrics::Module::Ingest, "store", options.store_path.c_str());
+            return false;
+        }
+    }
+
+    // A resumed index already carries its reduction; a new one is created
+    // behind it on the first batch
+    std::unique_ptr<faiss::EmbeddingReduction> reduction;
+    if (!options.reduction_path.empty()) {
+        reduction.reset(faiss::EmbeddingReduction::load(options.reduction_path));
+        if (!reduction) {
+            metrics::reportError(metrics::Module::Ingest, "open", options.reduction_path.c_str());
+            return false;
+        }
+    }
+
+    std::ofstream records(records_path, std::ios::app | std::ios::binary);
+    if (!records) {
+        metrics::reportError(metrics::Module::Ingest, "open", records_path.c_str());
+        return false;
+    }
+
+    const size_t batch_size = options.batch_size > 0 ? options.batch_size : 16;
+    const size_t checkpoint_batches = options.checkpoint_batches > 0 ? options.checkpoint_batches : 8;
+
+    BatchQueue queue(4);
+    std::atomic<bool> failed{false};
+    size_t chunks_done = checkpoint.chunks;
+
+    auto save_checkpoint = [&](size_t next_offset) {
+        records.flush();
+        if (!index || !index->save(partial_index_path)) return false;
+
+        Checkpoint current;
+        current.chunks = chunks_done;
+        current.next_offset = next_offset;
+        current.records_bytes = static_cast<size_t>(records.tellp());
+        return writeCheckpoint(checkpoint_path, current);
+    };
+
+    // Embedding stage: embeds each batch, adds it to the index and records
+    // the chunk metadata, checkpointing every few batches. It blocks on the
+    // queue, so it keeps a thread of its own rather than a pool worker; the
+    // embedding calls still wait for a background slot.
+    std::thread embedder([&]() {
+        scheduler::ScopedQoS qos(scheduler::QoS::Background);
+        ChunkBatch batch;
+        std::vector<std::string> texts;
+        std::vector<float> embeddings;
+        std::vector<chunk_store::ChunkRecord> stored;
+        std::string line;
+        size_t batches_since_checkpoint = 0;
+        size_t committed_offset = checkpoint.next_offset;
+
+        while (queue.pop(batch)) {
+            if (cancelled_ || failed) continue;
+
+            texts.clear();
+            for (const auto& span : batch.spans) {
+                texts.push_back(normalizeChunkText(book.data(), span.start, span.end));
+            }
+
+            size_t dimension = llm_->getEmbeddingsBatch(texts, embeddings);
+            if (dimension == 0) {
+                metrics::reportError(metrics::Module::Ingest, "embed", "batch produced no embeddings");
+                failed = true;
+                continue;
+            }
+            if (!index) {
+                index.reset(reduction ? faiss::FaissIndex::create(*reduction)
+                                      : faiss::FaissIndex::create(static_cast<int>(dimension)));
+            }
+            if (!index || static_cast<size_t>(index->dimension()) != dimension ||
+                !index->addBatch(embeddings.data(), texts.size())) {
+                metrics::reportError(metrics::Module::Ingest, "index", "failed to add batch to index");
+                failed = true;
+                continue;
+            }
+
+            if (store) {
+                stored.resize(texts.size());
+                for (size_t i = 0; i < texts.size(); ++i) {
+                    stored[i].text = texts[i];
+                    stored[i].start = static_cast<int64_t>(batch.spans[i].start);
+                    stored[i].end = static_cast<int64_t>(batch.spans[i].end);
+                }
+                if (!store->addChunks(options.book_id, chunks_done, stored, embeddings.data(),
+                                      static_cast<int>(dimension))) {
+                    metrics::reportError(metrics::Module::Ingest, "store", "failed to store batch");
+                    failed = true;
+                    continue;
+                }
+            }
+
+            for (size_t i = 0; i < texts.size(); ++i) {
+                line.clear();
+                line += "{\"text\":";
+                appendJsonString(line, texts[i]);
+                line += ",\"index\":" + std::to_string(chunks_done + i);
+                line += ",\"start\":" + std::to_string(batch.spans[i].start);
+                line += ",\"end\":" + std::to_string(batch.spans[i].end);
+                line += "}\n";
+                records << line;
+            }
+            chunks_done += texts.size();
+            committed_offset = batch.next_offset;
+
+            // A failed checkpoint is retried after the next batch; the
+            // previous one still describes a consistent state
+            if (++batches_since_checkpoint >= checkpoint_batches) {
+                if (save_checkpoint(committed_offset)) {
+                    batches_since_checkpoint = 0;
+                } else {
+                    metrics::reportError(metrics::Module::Ingest, "checkpoint", "failed to save checkpoint");
+                }
+            }
+
+            if (callback_) {
+                callback_(batch.next_offset, book.size(), chunks_done, user_data_);
+            }
+        }
+
+        // Keep whatever was committed so an interrupted run can resume
+        if (cancelled_ && !failed && batches_since_checkpoint > 0 &&
+            !save_checkpoint(committed_offset)) {
+            metrics::reportError(metrics::Module::Ingest, "checkpoint", "failed to save checkpoint");
+        }
+    });
+
+    // Term statistics are cheap next to embedding, so the whole book is
+    // tokenized on the shared scheduler every run rather than checkpointed
+    std::unique_ptr<terms::TermDictionary> dictionary;
+    auto& pool = scheduler::Scheduler::instance();
+    auto term_builder = pool.async(scheduler::QoS::Background, [&]() {
+        dictionary.reset(terms::TermDictionary::build(book.data(), book.size()));
+    });
+
+    // Segmentation stage on the calling thread
+    ChunkSegmenter segmenter(book.data(), book.size(), options.max_chunk_bytes, options.overlap_bytes);
+    segmenter.seek(checkpoint.next_offset);
+
+    ChunkBatch batch;
+    ChunkSpan span;
+    while (!cancelled_ && !failed && segmenter.next(span)) {
+        batch.spans.push_back(span);
+        if (batch.spans.size() >= batch_size) {
+            batch.next_offset = segmenter.position();
+            if (!queue.push(std::move(batch))) break;
+            batch = ChunkBatch();
+        }
+    }
+    if (!batch.spans.empty() && !cancelled_ && !failed) {
+        batch.next_offset = segmenter.position();
+        queue.push(std::move(batch));
+    }
+
+    queue.close();
+    embedder.join();
+    pool.wait(term_builder);
+    records.close();
+
+    if (cancelled_ || failed || !index) {
+        return false;
+    }
+
+    // Read before the new dictionary replaces it, to take the book's old
+    // counts back out of the term library
+    const std::string terms_path = sidecarPathFor(index_path, ".terms");
+    const bool update_library = !options.term_library_path.empty() && !options.book_id.empty();
+    std::unique_ptr<terms::TermDictionary> previous_terms(
+        update_library ? terms::TermDictionary::load(terms_path) : nullptr);
+
+    if (!index->save(index_path) ||
+        !writeChunksJson(records_path, sidecarPathFor(index_path, ".json")) ||
+        !dictionary || !dictionary->save(terms_path)) {
+        metrics::reportError(metrics::Module::Ingest, "save", index_path.c_str());
+        return false;
+    }
+
+    if (update_library) {
+        updateTermLibrary(options.term_library_path, options.book_id, *dictionary, previous_terms.get());
+    }
+
+    std::remove(partial_index_path.c_str());
+    std::remove(records_path.c_str());
+    std::remove(checkpoint_path.c_str());
+    return true;
+}
+
+// C API Implementation
+extern "C" {
+
+BookIngestor* ingest_create(mlc_llm::LLMContext* llm) {
+    return BookIngestor::create(llm);
+}
+
+void ingest_destroy(BookIngestor* ingestor) {
+    delete ingestor;
+}
+
+void ingest_set_progress_callback(BookIngestor* ingestor, ingest_progress_callback callback, void* user_data) {
+    if (ingestor) ingestor->setProgressCallback(callback, user_data);
+}
+
+bool ingest_run(BookIngestor* ingestor,
+                const char* book_path,
+                const char* index_path,
+                size_t max_chunk_bytes,
+                size_t overlap_bytes,
+                size_t batch_size,
+                const char* store_path,
+                const char* book_id,
+                const char* reduction_path,
+                const char* term_library_path) {
+    if (!ingestor || !book_path || !index_path) return false;
+
+    try {
+        IngestOptions options;
+        if (max_chunk_bytes > 0) options.max_chunk_bytes = max_chunk_bytes;
+        options.overlap_bytes = overlap_bytes;
+        if (batch_size > 0) options.batch_size = batch_size;
+        if (book_id) options.book_id = book_id;
+        if (store_path && book_id) options.store_path = store_path;
+        if (reduction_path) options.reduction_path = reduction_path;
+        if (term_library_path && book_id) options.term_library_path = term_library_path;
+        return ingestor->run(book_path, index_path, options);
+    } catch (...) {
+        metrics::reportException(metrics::Module::Ingest, "run");
+        return false;
+    }
+}
+
+void ingest_cancel(BookIngestor* ingestor) {
+    if (ingestor) ingestor->cancel();
+}
+
+} // extern "C"
+
+} // namespace ingest
+} // namespace bookmark
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "mlc-llm-native.h"
+#include "faiss-native.h"
+#include "terms-native.h"
+
+namespace bookmark {
+namespace ingest {
+
+// Byte range [start, end) of a chunk in the source file
+struct ChunkSpan {
+    size_t start;
+    size_t end;
+};
+
+// Splits raw book text into sentence-aligned chunks holding at most
+// max_chunk_bytes of new text, each prefixed with roughly overlap_bytes of
+// the previous chunk (rounded to a word boundary), like
+// BookProcessor.processBook. Offsets always refer to the original bytes,
+// so they can be stored as book_chunks positions.
+class ChunkSegmenter {
+public:
+    ChunkSegmenter(const char* data, size_t size, size_t max_chunk_bytes, size_t overlap_bytes);
+
+    bool next(ChunkSpan& span);
+    // Position is the end of the last chunk returned
+    void seek(size_t offset) { pos_ = offset; last_start_ = 0; }
+    size_t position() const { return pos_; }
+
+private:
+    size_t sentenceEnd(size_t from) const;
+    size_t wordBoundaryBefore(size_t start, size_t limit) const;
+
+    const char* data_;
+    size_t size_;
+    size_t max_chunk_bytes_;
+    size_t overlap_bytes_;
+    size_t pos_ = 0;
+    size_t last_start_ = 0;
+};
+
+// Copy of data[start, end) with runs of whitespace collapsed to one space
+std::string normalizeChunkText(const char* data, size_t start, size_t end);
+
+struct IngestOptions {
+    size_t max_chunk_bytes = 512;
+    size_t overlap_bytes = 50;
+    size_t batch_size = 16;
+    size_t checkpoint_batches = 8; // persist progress every N batches
+    // When both are set, chunks and their embeddings are also written to
+    // the chunk store at store_path under book_id (see chunk-store-native.h)
+    std::string store_path;
+    std::string book_id;
+    // When set, the index stores embeddings reduced by the transform saved
+    // here (see reduction-native.h)
+    std::string reduction_path;
+    // When set with book_id, the book's term dictionary is added to the
+    // term library saved here, replacing the one from an earlier ingestion
+    // of the same book
+    std::string term_library_path;
+};
+
+typedef void (*ingest_progress_callback)(size_t bytes_done, size_t total_bytes, size_t chunks_done, void* user_data);
+
+// Streams a book file into a FAISS index in one pass: the file is mapped,
+// segmented on the calling thread and embedded in batches on a pipeline
+// thread. Chunk texts and byte offsets are written next to the index in
+// the JSON layout RAGService.loadIndex() reads, and the book's term
+// dictionary (see terms-native.h) is built alongside as <name>.terms.
+// With a chunk store, each batch is also stored there as it is indexed.
+//
+// Progress is checkpointed periodically; calling run() again with the same
+// paths after an interruption resumes from the last checkpoint.
+class BookIngestor {
+public:
+    static BookIngestor* create(mlc_llm::LLMContext* llm);
+    ~BookIngestor() = default;
+
+    void setProgressCallback(ingest_progress_callback callback, void* user_data);
+    bool run(const std::string& book_path, const std::string& index_path, const IngestOptions& options);
+    void cancel();
+
+private:
+    explicit BookIngestor(mlc_llm::LLMContext* llm);
+
+    mlc_llm::LLMContext* llm_;
+    ingest_progress_callback callback_ = nullptr;
+    void* user_data_ = nullptr;
+    std::atomic<bool> cancelled_{false};
+};
+
+// React Native binding interface
+extern "C" {
+    BookIngestor* ingest_create(mlc_llm::LLMContext* llm);
+    void ingest_destroy(BookIngestor* ingestor);
+    void ingest_set_progress_callback(BookIngestor* ingestor, ingest_progress_callback callback, void* user_data);
+    bool ingest_run(BookIngestor* ingestor,
+                    const char* book_path,
+                    const char* index_path,
+                    size_t max_chunk_bytes,
+                    size_t overlap_bytes,
+                    size_t batch_size,
+                    const char* store_path,
+                    const char* book_id,
+                    const char* reduction_path,
+                    const char* term_library_path);
+    void ingest_cancel(BookIngestor* ingestor);
+}
+
+} // namespace ingest
+} // namespace bookmark
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <jsi/jsi.h>
+#include <ReactCommon/CallInvoker.h>
+#include "scheduler-native.h"
+
+// Helpers shared by the modules' JSI bindings. The bindings let JS hand
+// embeddings, queries and PCM to native code as ArrayBuffers, and get
+// results back as ArrayBuffers over native memory, instead of boxing every
+// float through the bridge. Header-only: each platform's bridge compiles it
+// into the module's own library.
+
+namespace bookmark {
+namespace bridge {
+
+namespace jsi = facebook::jsi;
+namespace react = facebook::react;
+
+// Floats in an ArrayBuffer or typed array argument. Points straight into
+// the JS heap, so it is only valid until control returns to JS unless the
+// buffer is pinned (see runAsync).
+struct FloatView {
+    const float* data;
+    size_t count;
+};
+
+inline FloatView floatArg(jsi::Runtime& rt, const jsi::Value& value, const char* name) {
+    if (value.isObject()) {
+        jsi::Object object = value.getObject(rt);
+        uint8_t* data = nullptr;
+        size_t size = 0;
+
+        if (object.isArrayBuffer(rt)) {
+            jsi::ArrayBuffer buffer = object.getArrayBuffer(rt);
+            data = buffer.data(rt);
+            size = buffer.size(rt);
+        } else {
+            // A typed array: a window onto its backing ArrayBuffer
+            jsi::Value backing = object.getProperty(rt, "buffer");
+            if (backing.isObject() && backing.getObject(rt).isArrayBuffer(rt)) {
+                jsi::ArrayBuffer buffer = backing.getObject(rt).getArrayBuffer(rt);
+                auto offset = static_cast<size_t>(object.getProperty(rt, "byteOffset").asNumber());
+                auto length = static_cast<size_t>(object.getProperty(rt, "byteLength").asNumber());
+                if (offset + length <= buffer.size(rt)) {
+                    data = buffer.data(rt) + offset;
+                    size = length;
+                }
+            }
+        }
+
+        if (data && size % sizeof(float) == 0 &&
+            reinterpret_cast<uintptr_t>(data) % alignof(float) == 0) {
+            return {reinterpret_cast<const float*>(data), size / sizeof(float)};
+        }
+    }
+    throw jsi::JSError(rt, std::string(name) + " must be a Float32Array or an ArrayBuffer of floats");
+}
+
+// Lets JS own a native vector as an ArrayBuffer without copying it; the
+// vector is freed when the ArrayBuffer is collected
+template <typename T>
+class VectorBuffer : public jsi::MutableBuffer {
+public:
+    explicit VectorBuffer(std::vector<T> values) : values_(std::move(values)) {}
+
+    size_t size() const override { return values_.size() * sizeof(T); }
+    uint8_t* data() override { return reinterpret_cast<uint8_t*>(values_.data()); }
+
+private:
+    std::vector<T> values_;
+};
+
+template <typename T>
+jsi::ArrayBuffer toArrayBuffer(jsi::Runtime& rt, std::vector<T> values) {
+    return jsi::ArrayBuffer(rt, std::make_shared<VectorBuffer<T>>(std::move(values)));
+}
+
+using HostFunction = std::function<jsi::Value(jsi::Runtime&, const jsi::Value* args, size_t count)>;
+
+inline jsi::Function function(jsi::Runtime& rt, const char* name, unsigned int arity, HostFunction body) {
+    return jsi::Function::createFromHostFunction(
+        rt, jsi::PropNameID::forAscii(rt, name), arity,
+        [name, arity, body = std::move(body)](jsi::Runtime& rt, const jsi::Value&, const jsi::Value* args, size_t count) {
+            if (count < arity) {
+                throw jsi::JSError(rt, std::string(name) + " expects " + std::to_string(arity) + " arguments");
+            }
+            return body(rt, args, count);
+        });
+}
+
+// A module's native object, as seen from JSI calls on the JS thread while
+// the bridge, on its own thread, creates and destroys it. Calls hold the
+// slot shared for their duration; clearing it waits them out, so the old
+// object can be destroyed right after.
+template <typename T>
+class HandleSlot {
+public:
+    void set(T* handle) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        handle_ = handle;
+    }
+
+    // Clears the slot if it still holds handle
+    void clear(T* handle) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (handle_ == handle) handle_ = nullptr;
+    }
+
+    template <typename F>
+    auto with(F&& fn) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return fn(handle_);
+    }
+
+private:
+    std::shared_mutex mutex_;
+    T* handle_ = nullptr;
+};
+
+// Runs work as an interactive task on the shared scheduler and returns a
+// promise settled with toJs(result) back on the JS thread, or rejected with
+// the message of whatever work threw. work must not touch the runtime.
+// pin keeps an input buffer alive until then, so work can read it in place;
+// JS must not write to it while the promise is pending.
+template <typename Result>
+jsi::Value runAsync(jsi::Runtime& rt,
+                    std::shared_ptr<react::CallInvoker> invoker,
+                    std::function<Result()> work,
+                    std::function<jsi::Value(jsi::Runtime&, Result&)> to_js,
+                    const jsi::Value& pin = jsi::Value::undefined()) {
+    struct Pending {
+        jsi::Value resolve;
+        jsi::Value reject;
+        jsi::Value pin;
+        Result result{};
+        std::string error;
+        bool failed = false;
+    };
+
+    auto pending = std::make_shared<Pending>();
+    pending->pin = jsi::Value(rt, pin);
+
+    jsi::Function executor = jsi::Function::createFromHostFunction(
+        rt, jsi::PropNameID::forAscii(rt, "executor"), 2,
+        [pending](jsi::Runtime& rt, const jsi::Value&, const jsi::Value* args, size_t) {
+            pending->resolve = jsi::Value(rt, args[0]);
+            pending->reject = jsi::Value(rt, args[1]);
+            return jsi::Value::undefined();
+        });
+    jsi::Value promise = rt.global().getPropertyAsFunction(rt, "Promise").callAsConstructor(rt, executor);
+
+    scheduler::Scheduler::instance().post(
+        scheduler::QoS::Interactive,
+        [pending, invoker, work = std::move(work), to_js = std::move(to_js)]() mutable {
+            try {
+                pending->result = work();
+            } catch (const std::exception& e) {
+                pending->failed = true;
+                pending->error = e.what();
+            } catch (...) {
+                pending->failed = true;
+                pending->error = "unknown error";
+            }
+
+            // The JS values may only be released on the JS thread, so this
+            // task hands over its reference rather than dropping it here
+            invoker->invokeAsync([pending = std::move(pending), to_js = std::move(to_js)](jsi::Runtime& rt) {
+                jsi::Value value;
+                if (!pending->failed) {
+                    try {
+                        value = to_js(rt, pending->result);
+                    } catch (const std::exception& e) {
+                        pending->failed = true;
+                        pending->error = e.what();
+                    }
+                }
+
+                if (pending->failed) {
+                    pending->reject.asObject(rt).asFunction(rt).call(
+                        rt, jsi::JSError(rt, pending->error).value());
+                } else {
+                    pending->resolve.asObject(rt).asFunction(rt).call(rt, value);
+                }
+                pending->resolve = jsi::Value::undefined();
+                pending->reject = jsi::Value::undefined();
+                pending->pin = jsi::Value::undefined();
+            });
+        });
+
+    return promise;
+}
+
+} // namespace bridge
+} // namespace bookmark
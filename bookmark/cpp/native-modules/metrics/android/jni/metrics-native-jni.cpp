@@ -0,0 +1,38 @@
+#include <jni.h>
+#include <string>
+#include "metrics-native.h"
+#include <android/log.h>
+
+#define LOG_TAG "MetricsNative"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+using namespace bookmark::metrics;
+
+extern "C" {
+
+JNIEXPORT jstring JNICALL
+Java_com_bookmark_MetricsModule_snapshotNative(
+    JNIEnv* env,
+    jobject thiz
+) {
+    // Counters can tick over between the sizing call and the real one
+    std::string json(bookmark_metrics_snapshot_json(nullptr, 0) + 256, '\0');
+    size_t length = bookmark_metrics_snapshot_json(&json[0], json.size());
+    if (length == 0 || length >= json.size()) {
+        LOGE("Failed to serialize metrics snapshot");
+        return nullptr;
+    }
+    json.resize(length);
+    return env->NewStringUTF(json.c_str());
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_MetricsModule_resetNative(
+    JNIEnv* env,
+    jobject thiz
+) {
+    bookmark_metrics_reset();
+}
+
+} // extern "C"
@@ -0,0 +1,48 @@
+package com.bookmark;
+
+import com.facebook.react.bridge.ReactApplicationContext;
+import com.facebook.react.bridge.ReactContextBaseJavaModule;
+import com.facebook.react.bridge.ReactMethod;
+import com.facebook.react.bridge.Promise;
+
+public class MetricsModule extends ReactContextBaseJavaModule {
+    static {
+        System.loadLibrary("metrics-native");
+    }
+
+    public MetricsModule(ReactApplicationContext reactContext) {
+        super(reactContext);
+    }
+
+    @Override
+    public String getName() {
+        return "MetricsNative";
+    }
+
+    @ReactMethod
+    public void getSnapshot(Promise promise) {
+        try {
+            String json = snapshotNative();
+            if (json == null) {
+                throw new IllegalStateException("Snapshot unavailable");
+            }
+            promise.resolve(json);
+        } catch (Exception e) {
+            promise.reject("ERR_METRICS", "Failed to read native metrics: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void reset(Promise promise) {
+        try {
+            resetNative();
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_METRICS", "Failed to reset native metrics: " + e.getMessage());
+        }
+    }
+
+    // Native method declarations
+    private native String snapshotNative();
+    private native void resetNative();
+}
@@ -0,0 +1,4 @@
+#import <React/RCTBridgeModule.h>
+
+@interface MetricsModule : NSObject <RCTBridgeModule>
+@end
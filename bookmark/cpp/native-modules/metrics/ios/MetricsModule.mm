@@ -0,0 +1,36 @@
+#import "MetricsModule.h"
+#import <React/RCTLog.h>
+#import "metrics-native.h"
+
+#include <string>
+
+using namespace bookmark::metrics;
+
+@implementation MetricsModule
+
+RCT_EXPORT_MODULE(MetricsNative)
+
+RCT_EXPORT_METHOD(getSnapshot:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        // The JSON can grow between the sizing call and the real one as
+        // counters tick over, so leave some slack
+        std::string json(bookmark_metrics_snapshot_json(nullptr, 0) + 256, '\0');
+        size_t length = bookmark_metrics_snapshot_json(&json[0], json.size());
+        if (length == 0 || length >= json.size()) {
+            reject(@"ERR_METRICS", @"Failed to serialize metrics snapshot", nil);
+            return;
+        }
+        resolve([[NSString alloc] initWithBytes:json.data() length:length encoding:NSUTF8StringEncoding]);
+    } @catch (NSException* e) {
+        reject(@"ERR_METRICS", @"Failed to read native metrics", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(reset:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    bookmark_metrics_reset();
+    resolve(nil);
+}
+
+@end
@@ -0,0 +1,442 @@
+#include "metrics-native.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__ANDROID__)
+#include <android/log.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <os/log.h>
+#endif
+
+namespace bookmark {
+namespace metrics {
+
+namespace {
+
+// Log-linear buckets in the style of HdrHistogram: values below 16us get a
+// bucket each, above that every power of two is split into 16 sub-buckets,
+// so any recorded value is off by at most ~6%. Exponents are capped at
+// 2^36us (about 19 hours); anything longer lands in the last bucket.
+constexpr uint32_t kSubBucketBits = 4;
+constexpr uint32_t kSubBuckets = 1u << kSubBucketBits;
+constexpr uint32_t kMaxExponent = 36;
+constexpr size_t kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+size_t bucketFor(uint64_t value) {
+    if (value < kSubBuckets) {
+        return static_cast<size_t>(value);
+    }
+
+    uint32_t exponent = 63 - static_cast<uint32_t>(__builtin_clzll(value));
+    if (exponent > kMaxExponent) {
+        return kBucketCount - 1;
+    }
+    uint64_t mantissa = value >> (exponent - kSubBucketBits); // in [16, 32)
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + static_cast<size_t>(mantissa - kSubBuckets);
+}
+
+// Midpoint of the values that map to a bucket
+uint64_t bucketValue(size_t bucket) {
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+
+    uint32_t exponent = static_cast<uint32_t>(bucket / kSubBuckets) + kSubBucketBits - 1;
+    uint64_t mantissa = kSubBuckets + bucket % kSubBuckets;
+    uint32_t shift = exponent - kSubBucketBits;
+    uint64_t low = mantissa << shift;
+    return low + ((uint64_t(1) << shift) >> 1);
+}
+
+struct HistogramCells {
+    std::atomic<uint64_t> buckets[kBucketCount];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max;
+};
+
+// Written only by the owning thread, so the relaxed read-modify-writes
+// below never contend
+struct ThreadSlot {
+    HistogramCells histograms[kHistogramCount];
+    std::atomic<uint64_t> counters[kCounterCount];
+    std::atomic<uint64_t> errors[kModuleCount];
+    std::atomic<bool> owned;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadSlot*> slots;
+    std::atomic<int64_t> gauges[kGaugeCount] = {};
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+// Never destroyed: threads can still release their slot while the process
+// is shutting down
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+ThreadSlot* acquireSlot() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    // Reuse the slot of an exited thread; its totals stay part of the sum
+    for (ThreadSlot* slot : reg.slots) {
+        if (!slot->owned.load(std::memory_order_relaxed)) {
+            slot->owned.store(true, std::memory_order_relaxed);
+            return slot;
+        }
+    }
+
+    auto* slot = new ThreadSlot(); // value-initialized, so zeroed
+    slot->owned.store(true, std::memory_order_relaxed);
+    reg.slots.push_back(slot);
+    return slot;
+}
+
+struct SlotOwner {
+    ThreadSlot* slot = nullptr;
+
+    ~SlotOwner() {
+        if (slot) {
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            slot->owned.store(false, std::memory_order_relaxed);
+        }
+    }
+};
+
+thread_local SlotOwner t_owner;
+
+ThreadSlot& localSlot() {
+    if (!t_owner.slot) {
+        t_owner.slot = acquireSlot();
+    }
+    return *t_owner.slot;
+}
+
+const char* const kHistogramNames[kHistogramCount] = {
+    "search", "embed", "prefill", "decode", "transcribe", "synthesize"
+};
+
+const char* const kCounterNames[kCounterCount] = {
+    "search_queries", "vectors_added", "texts_embedded", "prompts_processed",
+    "tokens_generated", "audio_ms_transcribed", "audio_ms_synthesized",
+    "answer_cache_hits", "answer_cache_misses"
+};
+
+const char* const kGaugeNames[kGaugeCount] = {
+    "index_bytes", "llm_model_bytes", "whisper_model_bytes", "tts_model_bytes"
+};
+
+const char* const kModuleNames[kModuleCount] = {
+    "faiss", "llm", "whisper", "tts", "terms", "ingest", "voice_pipeline",
+    "scheduler", "answer_cache", "chunk_store"
+};
+
+// Same tags the JNI bridges log under
+const char* const kLogTags[kModuleCount] = {
+    "FaissNative", "MLCLLMNative", "WhisperNative", "TTSNative",
+    "TermsNative", "IngestNative", "VoicePipelineNative",
+    "SchedulerNative", "AnswerCacheNative", "ChunkStoreNative"
+};
+
+int64_t residentBytes() {
+#if defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return static_cast<int64_t>(info.resident_size);
+#else
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file) {
+        return 0;
+    }
+    long pages = 0;
+    long resident = 0;
+    int fields = fscanf(file, "%ld %ld", &pages, &resident);
+    fclose(file);
+    return fields == 2 ? static_cast<int64_t>(resident) * sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
+
+uint64_t percentile(const std::vector<uint64_t>& buckets, uint64_t count, uint64_t max, double q) {
+    if (count == 0) {
+        return 0;
+    }
+
+    // Nearest rank
+    uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count)));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            // The overflow bucket has no upper bound
+            return i == kBucketCount - 1 ? max : std::min(bucketValue(i), max);
+        }
+    }
+    return max;
+}
+
+void appendf(std::string& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+void appendf(std::string& out, const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (written > 0) {
+        out.append(buffer, std::min(static_cast<size_t>(written), sizeof(buffer) - 1));
+    }
+}
+
+} // namespace
+
+void increment(Counter counter, uint64_t delta) {
+    localSlot().counters[static_cast<size_t>(counter)].fetch_add(delta, std::memory_order_relaxed);
+}
+
+void recordLatency(Histogram histogram, uint64_t micros) {
+    HistogramCells& cells = localSlot().histograms[static_cast<size_t>(histogram)];
+    cells.buckets[bucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+    cells.count.fetch_add(1, std::memory_order_relaxed);
+    cells.sum.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t max = cells.max.load(std::memory_order_relaxed);
+    while (micros > max &&
+           !cells.max.compare_exchange_weak(max, micros, std::memory_order_relaxed)) {
+    }
+}
+
+void addGauge(Gauge gauge, int64_t delta) {
+    registry().gauges[static_cast<size_t>(gauge)].fetch_add(delta, std::memory_order_relaxed);
+}
+
+void setGauge(Gauge gauge, int64_t value) {
+    registry().gauges[static_cast<size_t>(gauge)].store(value, std::memory_order_relaxed);
+}
+
+void reportError(Module module, const char* operation, const char* message) {
+    size_t index = static_cast<size_t>(module);
+    localSlot().errors[index].fetch_add(1, std::memory_order_relaxed);
+
+    const char* tag = kLogTags[index];
+    if (!message) message = "unknown error";
+#if defined(__ANDROID__)
+    __android_log_print(ANDROID_LOG_ERROR, tag, "%s failed: %s", operation, message);
+#elif defined(__APPLE__)
+    os_log_error(OS_LOG_DEFAULT, "%{public}s: %{public}s failed: %{public}s", tag, operation, message);
+#else
+    fprintf(stderr, "%s: %s failed: %s\n", tag, operation, message);
+#endif
+}
+
+void reportException(Module module, const char* operation) {
+    std::exception_ptr current = std::current_exception();
+    if (!current) {
+        reportError(module, operation, nullptr);
+        return;
+    }
+
+    try {
+        std::rethrow_exception(current);
+    } catch (const std::exception& e) {
+        reportError(module, operation, e.what());
+    } catch (...) {
+        reportError(module, operation, "non-standard exception");
+    }
+}
+
+ScopedTimer::~ScopedTimer() {
+    if (cancelled_) return;
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    recordLatency(histogram_,
+                  static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+}
+
+int64_t pathBytes(const std::string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return 0;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return S_ISREG(st.st_mode) ? static_cast<int64_t>(st.st_size) : 0;
+    }
+
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        return 0;
+    }
+
+    int64_t total = 0;
+    while (struct dirent* entry = readdir(dir)) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+        total += pathBytes(path + "/" + entry->d_name);
+    }
+    closedir(dir);
+    return total;
+}
+
+const char* histogramName(Histogram histogram) {
+    return kHistogramNames[static_cast<size_t>(histogram)];
+}
+
+const char* counterName(Counter counter) {
+    return kCounterNames[static_cast<size_t>(counter)];
+}
+
+const char* gaugeName(Gauge gauge) {
+    return kGaugeNames[static_cast<size_t>(gauge)];
+}
+
+const char* moduleName(Module module) {
+    return kModuleNames[static_cast<size_t>(module)];
+}
+
+// C API Implementation
+extern "C" {
+
+bool bookmark_metrics_snapshot(MetricsSnapshot* snapshot_out) {
+    if (!snapshot_out) return false;
+
+    Registry& reg = registry();
+    MetricsSnapshot snapshot = {};
+    std::vector<uint64_t> buckets(kBucketCount);
+
+    // The lock only keeps the slot list stable; writers never take it
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    auto uptime = std::chrono::steady_clock::now() - reg.start;
+    snapshot.uptime_ms = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(uptime).count());
+    snapshot.resident_bytes = residentBytes();
+    for (size_t g = 0; g < kGaugeCount; ++g) {
+        snapshot.gauges[g] = reg.gauges[g].load(std::memory_order_relaxed);
+    }
+
+    for (const ThreadSlot* slot : reg.slots) {
+        for (size_t c = 0; c < kCounterCount; ++c) {
+            snapshot.counters[c] += slot->counters[c].load(std::memory_order_relaxed);
+        }
+        for (size_t m = 0; m < kModuleCount; ++m) {
+            snapshot.errors[m] += slot->errors[m].load(std::memory_order_relaxed);
+        }
+    }
+
+    for (size_t h = 0; h < kHistogramCount; ++h) {
+        std::fill(buckets.begin(), buckets.end(), 0);
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+
+        for (const ThreadSlot* slot : reg.slots) {
+            const HistogramCells& cells = slot->histograms[h];
+            if (cells.count.load(std::memory_order_relaxed) == 0) continue;
+
+            for (size_t b = 0; b < kBucketCount; ++b) {
+                buckets[b] += cells.buckets[b].load(std::memory_order_relaxed);
+            }
+            sum += cells.sum.load(std::memory_order_relaxed);
+            max = std::max(max, cells.max.load(std::memory_order_relaxed));
+        }
+        // Count from the buckets so percentiles stay consistent with them
+        // even while other threads are recording
+        for (uint64_t n : buckets) count += n;
+
+        HistogramSummary& summary = snapshot.histograms[h];
+        summary.count = count;
+        summary.mean_us = count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+        summary.p50_us = percentile(buckets, count, max, 0.50);
+        summary.p90_us = percentile(buckets, count, max, 0.90);
+        summary.p99_us = percentile(buckets, count, max, 0.99);
+        summary.max_us = max;
+    }
+
+    *snapshot_out = snapshot;
+    return true;
+}
+
+size_t bookmark_metrics_snapshot_json(char* json_out, size_t json_size) {
+    MetricsSnapshot snapshot;
+    if (!bookmark_metrics_snapshot(&snapshot)) return 0;
+
+    std::string json;
+    json.reserve(2048);
+    appendf(json, "{\"uptime_ms\":%llu,\"resident_bytes\":%lld,\"histograms\":{",
+            static_cast<unsigned long long>(snapshot.uptime_ms),
+            static_cast<long long>(snapshot.resident_bytes));
+    for (size_t h = 0; h < kHistogramCount; ++h) {
+        const HistogramSummary& s = snapshot.histograms[h];
+        appendf(json, "%s\"%s\":{\"count\":%llu,\"mean_us\":%.1f,\"p50_us\":%llu,\"p90_us\":%llu,\"p99_us\":%llu,\"max_us\":%llu}",
+                h ? "," : "", kHistogramNames[h],
+                static_cast<unsigned long long>(s.count), s.mean_us,
+                static_cast<unsigned long long>(s.p50_us),
+                static_cast<unsigned long long>(s.p90_us),
+                static_cast<unsigned long long>(s.p99_us),
+                static_cast<unsigned long long>(s.max_us));
+    }
+    json += "},\"counters\":{";
+    for (size_t c = 0; c < kCounterCount; ++c) {
+        appendf(json, "%s\"%s\":%llu", c ? "," : "", kCounterNames[c],
+                static_cast<unsigned long long>(snapshot.counters[c]));
+    }
+    json += "},\"gauges\":{";
+    for (size_t g = 0; g < kGaugeCount; ++g) {
+        appendf(json, "%s\"%s\":%lld", g ? "," : "", kGaugeNames[g],
+                static_cast<long long>(snapshot.gauges[g]));
+    }
+    json += "},\"errors\":{";
+    for (size_t m = 0; m < kModuleCount; ++m) {
+        appendf(json, "%s\"%s\":%llu", m ? "," : "", kModuleNames[m],
+                static_cast<unsigned long long>(snapshot.errors[m]));
+    }
+    json += "}}";
+
+    if (json_out && json.size() < json_size) {
+        memcpy(json_out, json.c_str(), json.size() + 1);
+    }
+    return json.size();
+}
+
+void bookmark_metrics_reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    for (ThreadSlot* slot : reg.slots) {
+        for (HistogramCells& cells : slot->histograms) {
+            for (auto& bucket : cells.buckets) bucket.store(0, std::memory_order_relaxed);
+            cells.count.store(0, std::memory_order_relaxed);
+            cells.sum.store(0, std::memory_order_relaxed);
+            cells.max.store(0, std::memory_order_relaxed);
+        }
+        for (auto& counter : slot->counters) counter.store(0, std::memory_order_relaxed);
+        for (auto& errors : slot->errors) errors.store(0, std::memory_order_relaxed);
+    }
+    reg.start = std::chrono::steady_clock::now();
+}
+
+} // extern "C"
+
+} // namespace metrics
+} // namespace bookmark
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bookmark {
+namespace metrics {
+
+// Latency distributions, recorded in microseconds
+enum class Histogram : uint32_t {
+    Search,
+    Embed,
+    Prefill,    // prompt submitted to first generated token
+    Decode,     // per generated token after the first
+    Transcribe,
+    Synthesize,
+    Count
+};
+
+// Monotonic totals since process start (or the last reset)
+enum class Counter : uint32_t {
+    SearchQueries,
+    VectorsAdded,
+    TextsEmbedded,
+    PromptsProcessed,
+    TokensGenerated,
+    AudioMsTranscribed,
+    AudioMsSynthesized,
+    AnswerCacheHits,
+    AnswerCacheMisses,
+    Count
+};
+
+// Current values, adjusted as resources are loaded and released
+enum class Gauge : uint32_t {
+    IndexBytes,
+    LlmModelBytes,
+    WhisperModelBytes,
+    TtsModelBytes,
+    Count
+};
+
+// Error counts and log tags are kept per native module
+enum class Module : uint32_t {
+    Faiss,
+    Llm,
+    Whisper,
+    Tts,
+    Terms,
+    Ingest,
+    VoicePipeline,
+    Scheduler,
+    AnswerCache,
+    ChunkStore,
+    Count
+};
+
+constexpr size_t kHistogramCount = static_cast<size_t>(Histogram::Count);
+constexpr size_t kCounterCount = static_cast<size_t>(Counter::Count);
+constexpr size_t kGaugeCount = static_cast<size_t>(Gauge::Count);
+constexpr size_t kModuleCount = static_cast<size_t>(Module::Count);
+
+// Recording is lock-free: every thread owns a slot of relaxed atomics that
+// only it writes, and snapshots sum the slots. The first call on a thread
+// takes a registry lock once to claim a slot.
+void increment(Counter counter, uint64_t delta = 1);
+void recordLatency(Histogram histogram, uint64_t micros);
+void addGauge(Gauge gauge, int64_t delta);
+void setGauge(Gauge gauge, int64_t value);
+
+// Logs an error against a module (logcat on Android, os_log on Apple
+// platforms, stderr elsewhere) and counts it in the snapshot
+void reportError(Module module, const char* operation, const char* message);
+// Same, for the exception currently being handled; call from a catch block
+void reportException(Module module, const char* operation);
+
+// Records the time until destruction unless cancelled first
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer();
+
+    void cancel() { cancelled_ = true; }
+
+private:
+    Histogram histogram_;
+    std::chrono::steady_clock::time_point start_;
+    bool cancelled_ = false;
+};
+
+// Bytes a model occupies on disk: the file itself, or every file below a
+// directory (MLC models ship as a directory of weight shards)
+int64_t pathBytes(const std::string& path);
+
+const char* histogramName(Histogram histogram);
+const char* counterName(Counter counter);
+const char* gaugeName(Gauge gauge);
+const char* moduleName(Module module);
+
+struct HistogramSummary {
+    uint64_t count;
+    double mean_us;
+    uint64_t p50_us;
+    uint64_t p90_us;
+    uint64_t p99_us;
+    uint64_t max_us;
+};
+
+struct MetricsSnapshot {
+    uint64_t uptime_ms;
+    int64_t resident_bytes; // process RSS, 0 where unavailable
+    HistogramSummary histograms[kHistogramCount];
+    uint64_t counters[kCounterCount];
+    int64_t gauges[kGaugeCount];
+    uint64_t errors[kModuleCount];
+};
+
+// React Native binding interface
+extern "C" {
+    bool bookmark_metrics_snapshot(MetricsSnapshot* snapshot_out);
+    // Writes the snapshot as a JSON object and returns its length. Nothing
+    // is written when json_size is too small; call again with a buffer of
+    // at least the returned length + 1.
+    size_t bookmark_metrics_snapshot_json(char* json_out, size_t json_size);
+    // Clears histograms, counters and error counts; gauges track live
+    // resources and are left alone
+    void bookmark_metrics_reset();
+}
+
+} // namespace metrics
+} // namespace bookmark
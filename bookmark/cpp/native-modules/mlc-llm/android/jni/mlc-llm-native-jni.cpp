@@ -1,7 +1,13 @@
 #include <jni.h>
+#include <memory>
 #include <string>
 #include <vector>
+#include <fbjni/fbjni.h>
+#include <ReactCommon/CallInvokerHolder.h>
 #include "mlc-llm-native.h"
+#include "mlc-llm-jsi.h"
+#include "summarizer-native.h"
+#include "request-jni.h"
 #include <android/log.h>
 
 #define LOG_TAG "MLCLLMNative"
@@ -10,10 +16,23 @@
 
 using namespace bookmark::mlc_llm;
 
+namespace {
+
+// The context as seen by the JSI functions, which run on the JS thread and
+// the scheduler rather than the module's thread
+std::shared_ptr<ContextSlot> context_slot = std::make_shared<ContextSlot>();
+
+} // namespace
+
 extern "C" {
 
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
+    // fbjni unwraps the CallInvokerHolder handed to installNative
+    return facebook::jni::initialize(vm, [] {});
+}
+
 JNIEXPORT jlong JNICALL
-Java_com_bookmark_MLCLLMModule_createContext(
+Java_com_bookmark_MLCLLMModule_createContextNative(
     JNIEnv* env,
     jobject thiz,
     jstring model_path,
@@ -26,22 +45,25 @@ Java_com_bookmark_MLCLLMModule_createContext(
     
     env->ReleaseStringUTFChars(model_path, m_path);
     env->ReleaseStringUTFChars(tokenizer_path, t_path);
-    
+
+    context_slot->set(ctx);
     return reinterpret_cast<jlong>(ctx);
 }
 
 JNIEXPORT void JNICALL
-Java_com_bookmark_MLCLLMModule_destroyContext(
+Java_com_bookmark_MLCLLMModule_destroyContextNative(
     JNIEnv* env,
     jobject thiz,
     jlong context_ptr
 ) {
     auto* ctx = reinterpret_cast<LLMContext*>(context_ptr);
+    // Waits for a JSI embedding still using it
+    context_slot->clear(ctx);
     llm_destroy_context(ctx);
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_bookmark_MLCLLMModule_loadModel(
+Java_com_bookmark_MLCLLMModule_loadModelNative(
     JNIEnv* env,
     jobject thiz,
     jlong context_ptr
@@ -50,8 +72,10 @@ Java_com_bookmark_MLCLLMModule_loadModel(
     return llm_load_model(ctx);
 }
 
-JNIEXPORT jstring JNICALL
-Java_com_bookmark_MLCLLMModule_generate(
+// Returns as soon as the prompt is queued; the listener gets the generated
+// text
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_MLCLLMModule_generateAsyncNative(
     JNIEnv* env,
     jobject thiz,
     jlong context_ptr,
@@ -59,60 +83,134 @@ Java_com_bookmark_MLCLLMModule_generate(
     jstring system_prompt,
     jint max_tokens,
     jfloat temperature,
-    jfloat top_p
+    jfloat top_p,
+    jobject listener
 ) {
     auto* ctx = reinterpret_cast<LLMContext*>(context_ptr);
-    
+
     const char* p = env->GetStringUTFChars(prompt, nullptr);
-    const char* sp = env->GetStringUTFChars(system_prompt, nullptr);
-    
-    const char* result = llm_generate(
+    const char* sp = system_prompt ? env->GetStringUTFChars(system_prompt, nullptr) : nullptr;
+
+    auto* request_listener = bookmark::scheduler::RequestListener::create(env, listener);
+    bookmark::scheduler::Request* request = llm_generate_async(
         ctx,
         p,
         sp,
         max_tokens,
         temperature,
-        top_p
+        top_p,
+        bookmark::scheduler::RequestListener::onComplete,
+        request_listener
     );
-    
+
     env->ReleaseStringUTFChars(prompt, p);
-    env->ReleaseStringUTFChars(system_prompt, sp);
-    
-    jstring output = env->NewStringUTF(result ? result : "");
-    delete[] result; // Free allocated string from C++ side
-    return output;
+    if (sp) env->ReleaseStringUTFChars(system_prompt, sp);
+
+    return bookmark::scheduler::RequestListener::submitted(env, request_listener, request);
 }
 
-JNIEXPORT jfloatArray JNICALL
-Java_com_bookmark_MLCLLMModule_getEmbeddings(
+// Returns as soon as the text is queued; the listener gets the embedding as
+// floats, sized by the model
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_MLCLLMModule_getEmbeddingsAsyncNative(
     JNIEnv* env,
     jobject thiz,
     jlong context_ptr,
-    jstring text
+    jstring text,
+    jobject listener
 ) {
     auto* ctx = reinterpret_cast<LLMContext*>(context_ptr);
     const char* input = env->GetStringUTFChars(text, nullptr);
-    
-    // Allocate buffer for embeddings (assuming 768-dimensional embeddings)
-    const size_t embedding_size = 768;
-    std::vector<float> embeddings(embedding_size);
-    
-    size_t actual_size = llm_get_embeddings(
-        ctx,
-        input,
-        embeddings.data(),
-        embedding_size
-    );
-    
+
+    auto* request_listener = bookmark::scheduler::RequestListener::create(env, listener);
+    bookmark::scheduler::Request* request = llm_get_embeddings_async(
+        ctx, input, bookmark::scheduler::RequestListener::onComplete, request_listener);
     env->ReleaseStringUTFChars(text, input);
-    
-    if (actual_size == 0) {
-        return nullptr;
+
+    return bookmark::scheduler::RequestListener::submitted(env, request_listener, request);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_bookmark_MLCLLMModule_createSummarizerNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong context_ptr
+) {
+    auto* ctx = reinterpret_cast<LLMContext*>(context_ptr);
+    return reinterpret_cast<jlong>(llm_summarizer_create(ctx, 0, 0));
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_MLCLLMModule_destroySummarizerNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong summarizer_ptr
+) {
+    llm_summarizer_destroy(reinterpret_cast<Summarizer*>(summarizer_ptr));
+}
+
+// Returns straight away; the turn is folded into the summary in the
+// background
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_MLCLLMModule_addSummaryTurnNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong summarizer_ptr,
+    jstring role,
+    jstring text
+) {
+    auto* summarizer = reinterpret_cast<Summarizer*>(summarizer_ptr);
+    const char* r = env->GetStringUTFChars(role, nullptr);
+    const char* t = env->GetStringUTFChars(text, nullptr);
+
+    bool success = llm_summarizer_add_turn(summarizer, r, t);
+
+    env->ReleaseStringUTFChars(role, r);
+    env->ReleaseStringUTFChars(text, t);
+    return success;
+}
+
+// The listener gets the summary as text once the turns added so far are
+// folded in, or after timeout_ms with the summary as it stands
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_MLCLLMModule_getSummaryAsyncNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong summarizer_ptr,
+    jint timeout_ms,
+    jobject listener
+) {
+    auto* summarizer = reinterpret_cast<Summarizer*>(summarizer_ptr);
+
+    auto* request_listener = bookmark::scheduler::RequestListener::create(env, listener);
+    bookmark::scheduler::Request* request = llm_summarizer_get_summary_async(
+        summarizer, timeout_ms, bookmark::scheduler::RequestListener::onComplete, request_listener);
+
+    return bookmark::scheduler::RequestListener::submitted(env, request_listener, request);
+}
+
+// Called on the JS thread with the jsi::Runtime behind the JavaScriptContextHolder
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_MLCLLMModule_installNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong runtime_ptr,
+    jobject call_invoker_holder
+) {
+    auto* runtime = reinterpret_cast<facebook::jsi::Runtime*>(runtime_ptr);
+    if (!runtime || !call_invoker_holder) {
+        return false;
+    }
+
+    try {
+        auto holder = facebook::jni::wrap_alias(
+            static_cast<facebook::react::CallInvokerHolder::javaobject>(call_invoker_holder));
+        installJsi(*runtime, holder->cthis()->getCallInvoker(), context_slot);
+        return true;
+    } catch (const std::exception& e) {
+        LOGE("Failed to install JSI bindings: %s", e.what());
+        return false;
     }
-    
-    jfloatArray result = env->NewFloatArray(actual_size);
-    env->SetFloatArrayRegion(result, 0, actual_size, embeddings.data());
-    return result;
 }
 
-} // extern "C"
\ No newline at end of file
+} // extern "C"
@@ -7,9 +7,15 @@ import com.facebook.react.bridge.Promise;
 import com.facebook.react.bridge.ReadableArray;
 import com.facebook.react.bridge.WritableArray;
 import com.facebook.react.bridge.Arguments;
+import com.facebook.react.bridge.JavaScriptContextHolder;
+import com.facebook.react.turbomodule.core.CallInvokerHolderImpl;
+import java.util.HashMap;
+import java.util.Map;
 
 public class MLCLLMModule extends ReactContextBaseJavaModule {
     private long contextPtr = 0;
+    // Rolling summaries by session, all on contextPtr
+    private final Map<String, Long> summarizers = new HashMap<>();
 
     static {
         System.loadLibrary("mlc-llm-native");
@@ -24,9 +30,44 @@ public class MLCLLMModule extends ReactContextBaseJavaModule {
         return "MLCLLMNative";
     }
 
+    // Native handle shared with the voice pipeline module
+    long getContextPtr() {
+        return contextPtr;
+    }
+
+    // Installs global.MLCLLMNativeJSI, whose getEmbeddings returns an
+    // ArrayBuffer instead of copying values element by element through the
+    // bridge. JS falls back to the promise methods below when this returns
+    // false, e.g. under a remote debugger.
+    @ReactMethod(isBlockingSynchronousMethod = true)
+    public boolean install() {
+        ReactApplicationContext context = getReactApplicationContext();
+        JavaScriptContextHolder jsContext = context.getJavaScriptContextHolder();
+        if (jsContext == null || jsContext.get() == 0) {
+            return false;
+        }
+        return installNative(jsContext.get(), (CallInvokerHolderImpl) context.getJSCallInvokerHolder());
+    }
+
+    private void destroyContext() {
+        // Summarizers fold on the context, so they go first
+        for (long summarizerPtr : summarizers.values()) {
+            destroySummarizerNative(summarizerPtr);
+        }
+        summarizers.clear();
+
+        if (contextPtr != 0) {
+            destroyContextNative(contextPtr);
+            contextPtr = 0;
+        }
+    }
+
     @ReactMethod
     public void createContext(String modelPath, String tokenizerPath, Promise promise) {
         try {
+            // Replacing the context would otherwise leak the loaded model
+            destroyContext();
+
             contextPtr = createContextNative(modelPath, tokenizerPath);
             promise.resolve(contextPtr != 0);
         } catch (Exception e) {
@@ -51,10 +92,7 @@ public class MLCLLMModule extends ReactContextBaseJavaModule {
     @ReactMethod
     public void cleanup(Promise promise) {
         try {
-            if (contextPtr != 0) {
-                destroyContextNative(contextPtr);
-                contextPtr = 0;
-            }
+            destroyContext();
             promise.resolve(null);
         } catch (Exception e) {
             promise.reject("ERR_MLC_LLM", "Failed to cleanup MLC LLM context: " + e.getMessage());
@@ -75,15 +113,23 @@ public class MLCLLMModule extends ReactContextBaseJavaModule {
                 throw new IllegalStateException("MLC LLM context not initialized");
             }
 
-            String result = generateNative(
+            // Generated on a native worker so the bridge thread stays free for
+            // the other modules' calls
+            generateAsyncNative(
                 contextPtr,
                 prompt,
                 systemPrompt,
                 maxTokens,
                 temperature,
-                topP
+                topP,
+                (text, floats, ints, error) -> {
+                    if (error != null) {
+                        promise.reject("ERR_MLC_LLM", "Failed to generate text: " + error);
+                    } else {
+                        promise.resolve(text != null ? text : "");
+                    }
+                }
             );
-            promise.resolve(result);
         } catch (Exception e) {
             promise.reject("ERR_MLC_LLM", "Failed to generate text: " + e.getMessage());
         }
@@ -96,18 +142,80 @@ public class MLCLLMModule extends ReactContextBaseJavaModule {
                 throw new IllegalStateException("MLC LLM context not initialized");
             }
 
-            float[] embeddings = getEmbeddingsNative(contextPtr, text);
-            if (embeddings == null) {
-                throw new IllegalStateException("Failed to get embeddings");
+            getEmbeddingsAsyncNative(contextPtr, text, (unused, embeddings, ints, error) -> {
+                if (error != null) {
+                    promise.reject("ERR_MLC_LLM", "Failed to get embeddings: " + error);
+                    return;
+                }
+
+                WritableArray result = Arguments.createArray();
+                for (float value : embeddings) {
+                    result.pushDouble(value);
+                }
+                promise.resolve(result);
+            });
+        } catch (Exception e) {
+            promise.reject("ERR_MLC_LLM", "Failed to get embeddings: " + e.getMessage());
+        }
+    }
+
+    // Folds the turn into the session's rolling summary in the background,
+    // starting one for a new session
+    @ReactMethod
+    public void addSummaryTurn(String sessionId, String role, String text, Promise promise) {
+        try {
+            if (contextPtr == 0) {
+                throw new IllegalStateException("MLC LLM context not initialized");
+            }
+
+            Long summarizerPtr = summarizers.get(sessionId);
+            if (summarizerPtr == null) {
+                summarizerPtr = createSummarizerNative(contextPtr);
+                if (summarizerPtr == 0) {
+                    throw new IllegalStateException("Failed to create summarizer");
+                }
+                summarizers.put(sessionId, summarizerPtr);
+            }
+            promise.resolve(addSummaryTurnNative(summarizerPtr, role, text));
+        } catch (Exception e) {
+            promise.reject("ERR_MLC_LLM", "Failed to add summary turn: " + e.getMessage());
+        }
+    }
+
+    // Resolves with the summary once the turns added so far are folded in,
+    // or after timeoutMs with the summary as it stands; null for a session
+    // with no turns
+    @ReactMethod
+    public void getSummary(String sessionId, int timeoutMs, Promise promise) {
+        try {
+            Long summarizerPtr = summarizers.get(sessionId);
+            if (summarizerPtr == null) {
+                promise.resolve(null);
+                return;
             }
 
-            WritableArray result = Arguments.createArray();
-            for (float value : embeddings) {
-                result.pushDouble(value);
+            getSummaryAsyncNative(summarizerPtr, timeoutMs, (text, floats, ints, error) -> {
+                if (error != null) {
+                    promise.reject("ERR_MLC_LLM", "Failed to get summary: " + error);
+                } else {
+                    promise.resolve(text != null && !text.isEmpty() ? text : null);
+                }
+            });
+        } catch (Exception e) {
+            promise.reject("ERR_MLC_LLM", "Failed to get summary: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void endSummary(String sessionId, Promise promise) {
+        try {
+            Long summarizerPtr = summarizers.remove(sessionId);
+            if (summarizerPtr != null) {
+                destroySummarizerNative(summarizerPtr);
             }
-            promise.resolve(result);
+            promise.resolve(null);
         } catch (Exception e) {
-            promise.reject("ERR_MLC_LLM", "Failed to get embeddings: " + e.getMessage());
+            promise.reject("ERR_MLC_LLM", "Failed to end summary: " + e.getMessage());
         }
     }
 
@@ -115,13 +223,19 @@ public class MLCLLMModule extends ReactContextBaseJavaModule {
     private native long createContextNative(String modelPath, String tokenizerPath);
     private native void destroyContextNative(long contextPtr);
     private native boolean loadModelNative(long contextPtr);
-    private native String generateNative(
+    private native boolean generateAsyncNative(
         long contextPtr,
         String prompt,
         String systemPrompt,
         int maxTokens,
         float temperature,
-        float topP
+        float topP,
+        NativeRequestListener listener
     );
-    private native float[] getEmbeddingsNative(long contextPtr, String text);
+    private native boolean getEmbeddingsAsyncNative(long contextPtr, String text, NativeRequestListener listener);
+    private native long createSummarizerNative(long contextPtr);
+    private native void destroySummarizerNative(long summarizerPtr);
+    private native boolean addSummaryTurnNative(long summarizerPtr, String role, String text);
+    private native boolean getSummaryAsyncNative(long summarizerPtr, int timeoutMs, NativeRequestListener listener);
+    private native boolean installNative(long jsRuntimePtr, CallInvokerHolderImpl callInvokerHolder);
 }
\ No newline at end of file
@@ -1,35 +1,81 @@
 #import "MLCLLMModule.h"
 #import <React/RCTLog.h>
+#import <React/RCTBridge+Private.h>
 #import "mlc-llm-native.h"
+#import "mlc-llm-jsi.h"
+#import "summarizer-native.h"
+#import "NativeRequest.h"
+#include <string>
+#include <unordered_map>
 
 using namespace bookmark::mlc_llm;
 
 @implementation MLCLLMModule {
     LLMContext* _context;
+    std::shared_ptr<ContextSlot> _slot; // context as seen by the JSI functions
+    std::unordered_map<std::string, Summarizer*> _summarizers; // rolling summaries by session
 }
 
 RCT_EXPORT_MODULE()
 
+@synthesize bridge = _bridge;
+
 - (instancetype)init {
     if (self = [super init]) {
         _context = nullptr;
+        _slot = std::make_shared<ContextSlot>();
     }
     return self;
 }
 
 - (void)dealloc {
+    [self destroySummarizers];
     if (_context != nullptr) {
+        _slot->clear(_context);
         llm_destroy_context(_context);
         _context = nullptr;
     }
 }
 
+// Summarizers fold on the context, so they go before it
+- (void)destroySummarizers {
+    for (auto& entry : _summarizers) {
+        llm_summarizer_destroy(entry.second);
+    }
+    _summarizers.clear();
+}
+
+- (void*)nativeHandle {
+    return _context;
+}
+
+// Installs global.MLCLLMNativeJSI (see mlc-llm-jsi.h) on the JS thread. JS falls
+// back to the promise methods below when this returns NO, e.g. under a
+// remote debugger.
+RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(install) {
+    RCTCxxBridge* bridge = (RCTCxxBridge*)self.bridge;
+    auto* runtime = static_cast<facebook::jsi::Runtime*>(bridge.runtime);
+    if (runtime == nullptr) {
+        return @NO;
+    }
+
+    try {
+        installJsi(*runtime, bridge.jsCallInvoker, _slot);
+        return @YES;
+    } catch (const std::exception& e) {
+        RCTLogError(@"Failed to install JSI bindings: %s", e.what());
+        return @NO;
+    }
+}
+
 RCT_EXPORT_METHOD(createContext:(NSString*)modelPath
                   tokenizerPath:(NSString*)tokenizerPath
                   resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     @try {
+        [self destroySummarizers];
         if (_context != nullptr) {
+            _slot->clear(_context);
             llm_destroy_context(_context);
         }
 
@@ -37,6 +83,7 @@ RCT_EXPORT_METHOD(createContext:(NSString*)modelPath
             [modelPath UTF8String],
             [tokenizerPath UTF8String]
         );
+        _slot->set(_context);
         resolve(@(_context != nullptr));
     } @catch (NSException* e) {
         reject(@"ERR_MLC_LLM", @"Failed to create MLC LLM context", nil);
@@ -61,7 +108,9 @@ RCT_EXPORT_METHOD(loadModel:(RCTPromiseResolveBlock)resolve
 RCT_EXPORT_METHOD(cleanup:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     @try {
+        [self destroySummarizers];
         if (_context != nullptr) {
+            _slot->clear(_context);
             llm_destroy_context(_context);
             _context = nullptr;
         }
@@ -84,23 +133,26 @@ RCT_EXPORT_METHOD(generate:(NSString*)prompt
             return;
         }
 
-        const char* result = llm_generate(
-            _context,
-            [prompt UTF8String],
-            [systemPrompt UTF8String],
-            [maxTokens intValue],
-            [temperature floatValue],
-            [topP floatValue]
-        );
-
-        if (result == nullptr) {
+        // Generated on a native worker so the module queue stays free
+        void* done = NativeRequestRetain(^(bookmark::scheduler::Request* request) {
+            if (!request->succeeded()) {
+                reject(@"ERR_MLC_LLM", @"Failed to generate text", nil);
+                return;
+            }
+            resolve(@(request->text.c_str()));
+        });
+        if (!llm_generate_async(
+                _context,
+                [prompt UTF8String],
+                [systemPrompt UTF8String],
+                [maxTokens intValue],
+                [temperature floatValue],
+                [topP floatValue],
+                NativeRequestComplete,
+                done)) {
+            NativeRequestDiscard(done);
             reject(@"ERR_MLC_LLM", @"Failed to generate text", nil);
-            return;
         }
-
-        NSString* output = @(result);
-        delete[] result; // Free allocated string from C++ side
-        resolve(output);
     } @catch (NSException* e) {
         reject(@"ERR_MLC_LLM", @"Failed to generate text", nil);
     }
@@ -115,31 +167,93 @@ RCT_EXPORT_METHOD(getEmbeddings:(NSString*)text
             return;
         }
 
-        // Allocate buffer for embeddings (assuming 768-dimensional embeddings)
-        const size_t embedding_size = 768;
-        std::vector<float> embeddings(embedding_size);
-
-        size_t actual_size = llm_get_embeddings(
-            _context,
-            [text UTF8String],
-            embeddings.data(),
-            embedding_size
-        );
+        // Embedded on a native worker, at the model's width rather than an
+        // assumed 768
+        void* done = NativeRequestRetain(^(bookmark::scheduler::Request* request) {
+            if (!request->succeeded()) {
+                reject(@"ERR_MLC_LLM", @"Failed to get embeddings", nil);
+                return;
+            }
 
-        if (actual_size == 0) {
+            const std::vector<float>& embeddings = request->floats;
+            NSMutableArray* result = [NSMutableArray arrayWithCapacity:embeddings.size()];
+            for (float value : embeddings) {
+                [result addObject:@(value)];
+            }
+            resolve(result);
+        });
+        if (!llm_get_embeddings_async(_context, [text UTF8String], NativeRequestComplete, done)) {
+            NativeRequestDiscard(done);
             reject(@"ERR_MLC_LLM", @"Failed to get embeddings", nil);
+        }
+    } @catch (NSException* e) {
+        reject(@"ERR_MLC_LLM", @"Failed to get embeddings", nil);
+    }
+}
+
+// Folds the turn into the session's rolling summary in the background,
+// starting one for a new session
+RCT_EXPORT_METHOD(addSummaryTurn:(NSString*)sessionId
+                  role:(NSString*)role
+                  text:(NSString*)text
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_context == nullptr) {
+            reject(@"ERR_MLC_LLM", @"MLC LLM context not initialized", nil);
             return;
         }
 
-        NSMutableArray* result = [NSMutableArray arrayWithCapacity:actual_size];
-        for (size_t i = 0; i < actual_size; i++) {
-            [result addObject:@(embeddings[i])];
+        Summarizer*& summarizer = _summarizers[[sessionId UTF8String]];
+        if (summarizer == nullptr) {
+            summarizer = llm_summarizer_create(_context, 0, 0);
+        }
+        resolve(@(llm_summarizer_add_turn(summarizer, [role UTF8String], [text UTF8String])));
+    } @catch (NSException* e) {
+        reject(@"ERR_MLC_LLM", @"Failed to add summary turn", nil);
+    }
+}
+
+// Resolves with the summary once the turns added so far are folded in, or
+// after timeoutMs with the summary as it stands; nil for a session with no
+// turns
+RCT_EXPORT_METHOD(getSummary:(NSString*)sessionId
+                  timeoutMs:(nonnull NSNumber*)timeoutMs
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        auto it = _summarizers.find([sessionId UTF8String]);
+        if (it == _summarizers.end()) {
+            resolve(nil);
+            return;
         }
 
-        resolve(result);
+        // Waited for on a native worker so the module queue stays free
+        void* done = NativeRequestRetain(^(bookmark::scheduler::Request* request) {
+            if (!request->succeeded()) {
+                reject(@"ERR_MLC_LLM", @"Failed to get summary", nil);
+                return;
+            }
+            resolve(request->text.empty() ? nil : @(request->text.c_str()));
+        });
+        if (!llm_summarizer_get_summary_async(it->second, [timeoutMs intValue], NativeRequestComplete, done)) {
+            NativeRequestDiscard(done);
+            reject(@"ERR_MLC_LLM", @"Failed to get summary", nil);
+        }
     } @catch (NSException* e) {
-        reject(@"ERR_MLC_LLM", @"Failed to get embeddings", nil);
+        reject(@"ERR_MLC_LLM", @"Failed to get summary", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(endSummary:(NSString*)sessionId
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    auto it = _summarizers.find([sessionId UTF8String]);
+    if (it != _summarizers.end()) {
+        llm_summarizer_destroy(it->second);
+        _summarizers.erase(it);
     }
+    resolve(nil);
 }
 
 @end
\ No newline at end of file
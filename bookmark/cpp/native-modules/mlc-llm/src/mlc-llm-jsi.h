@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "jsi-bridge.h"
+#include "mlc-llm-native.h"
+
+namespace bookmark {
+namespace mlc_llm {
+
+using ContextSlot = bridge::HandleSlot<LLMContext>;
+
+// Installs global.MLCLLMNativeJSI for the platform bridges.
+//
+//   getEmbeddings(text: string): Promise<ArrayBuffer>
+//
+// The buffer holds the Float32 embedding, handed to JS without a copy.
+inline void installJsi(facebook::jsi::Runtime& runtime,
+                       std::shared_ptr<facebook::react::CallInvoker> invoker,
+                       std::shared_ptr<ContextSlot> slot) {
+    namespace jsi = facebook::jsi;
+
+    jsi::Object binding(runtime);
+
+    binding.setProperty(runtime, "getEmbeddings", bridge::function(runtime, "getEmbeddings", 1,
+        [invoker, slot](jsi::Runtime& rt, const jsi::Value* args, size_t) {
+            std::string text = args[0].asString(rt).utf8(rt);
+
+            return bridge::runAsync<std::vector<float>>(rt, invoker,
+                [slot, text]() {
+                    return slot->with([&](LLMContext* ctx) {
+                        if (!ctx) throw std::runtime_error("MLC LLM context not initialized");
+                        std::vector<float> embedding = ctx->getEmbeddings(text);
+                        if (embedding.empty()) throw std::runtime_error("Failed to get embeddings");
+                        return embedding;
+                    });
+                },
+                [](jsi::Runtime& rt, std::vector<float>& embedding) {
+                    return jsi::Value(rt, bridge::toArrayBuffer(rt, std::move(embedding)));
+                });
+        }));
+
+    runtime.global().setProperty(runtime, "MLCLLMNativeJSI", binding);
+}
+
+} // namespace mlc_llm
+} // namespace bookmark
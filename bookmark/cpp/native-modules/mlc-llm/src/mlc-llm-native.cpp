@@ -1,6 +1,13 @@
 #include "mlc-llm-native.h"
+#include "metrics-native.h"
+#include "residency-native.h"
+#include "scheduler-native.h"
+#include <algorithm>
+#include <chrono>
 #include <stdexcept>
 #include <thread>
+#include <cstdlib>
+#include <cstring>
 
 namespace bookmark {
 namespace mlc_llm {
@@ -10,15 +17,40 @@ LLMContext* LLMContext::create(const std::string& model_path, const std::string&
 }
 
 LLMContext::LLMContext(const std::string& model_path, const std::string& tokenizer_path)
-    : model_path_(model_path), tokenizer_path_(tokenizer_path) {}
+    : model_path_(model_path), tokenizer_path_(tokenizer_path) {
+    scheduler::lendContext(this, typeid(LLMContext));
+}
 
 LLMContext::~LLMContext() {
-    ctx_.reset();
+    scheduler::retireContext(this);
+    pending_.drain();
+    // Waits for a reload or prefetch still running on another thread
+    residency::ResidencyManager::instance().unregisterComponent(residency_id_);
+    if (ctx_) {
+        ctx_.reset();
+        metrics::addGauge(metrics::Gauge::LlmModelBytes, -model_bytes_);
+    }
 }
 
 bool LLMContext::loadModel() {
     if (is_loaded_) return true;
+    if (!loadWeights()) return false;
+    is_loaded_ = true;
+
+    // Evicted under memory pressure while idle; the next Lease reloads it
+    residency::ComponentCallbacks callbacks;
+    callbacks.load = [this]() { return loadWeights(); };
+    callbacks.unload = [this]() {
+        ctx_.reset();
+        metrics::addGauge(metrics::Gauge::LlmModelBytes, -model_bytes_);
+        return true;
+    };
+    residency_id_ = residency::ResidencyManager::instance().registerComponent(
+        "llm", residency::PRIORITY_LLM, model_bytes_, std::move(callbacks));
+    return true;
+}
 
+bool LLMContext::loadWeights() {
     try {
         // Configure model settings for 4-bit quantization
         mlc::llm::ModelConfig config;
@@ -27,24 +59,114 @@ bool LLMContext::loadModel() {
         config.quantization = "q4_0"; // 4-bit quantization
         config.use_metal = true;      // Use Metal on iOS/macOS
         
+        // TVM sizes its CPU thread pool once, from the environment, when the
+        // runtime starts; keep it to the big cores instead of every core
+        std::string tvm_threads = std::to_string(
+            scheduler::Scheduler::instance().threadBudget(scheduler::QoS::Interactive));
+        setenv("TVM_NUM_THREADS", tvm_threads.c_str(), 0);
+
         // Initialize the model
         ctx_ = std::make_unique<mlc::llm::LLMContext>(config);
-        is_loaded_ = true;
+
+        // Weights are loaded whole, so their size on disk approximates
+        // what the model keeps resident
+        model_bytes_ = metrics::pathBytes(model_path_);
+        metrics::addGauge(metrics::Gauge::LlmModelBytes, model_bytes_);
         return true;
     } catch (...) {
+        metrics::reportException(metrics::Module::Llm, "load model");
         return false;
     }
 }
 
+LLMContext::Hold::Hold(LLMContext& llm)
+    : llm_(llm), interactive_(scheduler::currentQoS() == scheduler::QoS::Interactive) {
+    if (!interactive_) {
+        lock_ = std::unique_lock<std::mutex>(llm_.mutex_);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> idle(llm_.idle_mutex_);
+        llm_.interactive_calls_++;
+    }
+    llm_.interactive_waiting_.fetch_add(1, std::memory_order_relaxed);
+    lock_ = std::unique_lock<std::mutex>(llm_.mutex_);
+    llm_.interactive_waiting_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+LLMContext::Hold::~Hold() {
+    lock_.unlock();
+    if (!interactive_) return;
+
+    std::vector<std::pair<const void*, std::function<void()>>> parked;
+    {
+        std::lock_guard<std::mutex> idle(llm_.idle_mutex_);
+        if (--llm_.interactive_calls_ > 0) return;
+        parked.swap(llm_.parked_);
+    }
+    for (auto& entry : parked) {
+        scheduler::Scheduler::instance().post(scheduler::QoS::Background, std::move(entry.second));
+    }
+}
+
+void LLMContext::whenInteractiveIdle(const void* key, std::function<void()> resume) {
+    {
+        std::lock_guard<std::mutex> idle(idle_mutex_);
+        if (interactive_calls_ > 0) {
+            parked_.emplace_back(key, std::move(resume));
+            return;
+        }
+    }
+    scheduler::Scheduler::instance().post(scheduler::QoS::Background, std::move(resume));
+}
+
+bool LLMContext::cancelWhenIdle(const void* key) {
+    std::lock_guard<std::mutex> idle(idle_mutex_);
+    auto it = std::find_if(parked_.begin(), parked_.end(),
+                           [key](const auto& entry) { return entry.first == key; });
+    if (it == parked_.end()) return false;
+    parked_.erase(it);
+    return true;
+}
+
 std::string LLMContext::generate(const std::string& prompt,
                                 const std::string& system_prompt,
                                 int max_tokens,
                                 float temperature,
                                 float top_p) {
+    std::string result;
+    bool success = generateStream(prompt, system_prompt, max_tokens, temperature, top_p,
+        [&result](const std::string& token) {
+            result += token;
+            return true;
+        });
+
+    if (!success) {
+        return "Error generating text";
+    }
+    return result;
+}
+
+bool LLMContext::generateStream(const std::string& prompt,
+                                const std::string& system_prompt,
+                                int max_tokens,
+                                float temperature,
+                                float top_p,
+                                const std::function<bool(const std::string&)>& on_token) {
     if (!is_loaded_) {
         throw std::runtime_error("Model not loaded");
     }
 
+    residency::Lease lease(residency_id_);
+    Hold hold(*this);
+    if (!lease || !ctx_) {
+        metrics::reportError(metrics::Module::Llm, "generate", "model could not be reloaded");
+        return false;
+    }
+
+    // Kernels run on the GPU; only the thread driving them counts
+    scheduler::Reservation threads(1);
+
     try {
         // Configure generation parameters
         mlc::llm::GenerationConfig config;
@@ -60,17 +182,32 @@ std::string LLMContext::generate(const std::string& prompt,
             full_prompt = prompt;
         }
         
-        // Generate text
-        std::string result;
-        auto callback = [&result](const std::string& token) {
-            result += token;
-            return true;
+        // Prefill is measured up to the first token, decode per token
+        // after that. Time spent in on_token is excluded from both.
+        using Clock = std::chrono::steady_clock;
+        auto elapsedUs = [](Clock::time_point since) {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - since).count());
         };
-        
-        ctx_->generate(full_prompt, config, callback);
-        return result;
+        Clock::time_point last = Clock::now();
+        bool first_token = true;
+        metrics::increment(metrics::Counter::PromptsProcessed);
+
+        // Generate text
+        ctx_->generate(full_prompt, config, [&](const std::string& token) {
+            metrics::recordLatency(first_token ? metrics::Histogram::Prefill : metrics::Histogram::Decode,
+                                   elapsedUs(last));
+            metrics::increment(metrics::Counter::TokensGenerated);
+            first_token = false;
+
+            bool keep_going = on_token(token);
+            last = Clock::now();
+            return keep_going;
+        });
+        return true;
     } catch (...) {
-        return "Error generating text";
+        metrics::reportException(metrics::Module::Llm, "generate");
+        return false;
     }
 }
 
@@ -79,14 +216,50 @@ std::vector<float> LLMContext::getEmbeddings(const std::string& text) {
         throw std::runtime_error("Model not loaded");
     }
 
+    residency::Lease lease(residency_id_);
+    Hold hold(*this);
+    if (!lease || !ctx_) {
+        metrics::reportError(metrics::Module::Llm, "embed", "model could not be reloaded");
+        return std::vector<float>();
+    }
+    scheduler::Reservation threads(1);
+
+    metrics::ScopedTimer timer(metrics::Histogram::Embed);
     try {
         // Get embeddings from the last hidden state
-        return ctx_->get_embeddings(text);
+        std::vector<float> embedding = ctx_->get_embeddings(text);
+        metrics::increment(metrics::Counter::TextsEmbedded);
+        return embedding;
     } catch (...) {
+        timer.cancel();
+        metrics::reportException(metrics::Module::Llm, "embed");
         return std::vector<float>();
     }
 }
 
+size_t LLMContext::getEmbeddingsBatch(const std::vector<std::string>& texts, std::vector<float>& out) {
+    out.clear();
+    size_t dimension = 0;
+
+    // One lease for the whole batch so the model can't be evicted midway
+    residency::Lease lease(residency_id_);
+    if (!lease) return 0;
+
+    for (const auto& text : texts) {
+        std::vector<float> embedding = getEmbeddings(text);
+        if (embedding.empty() || (dimension != 0 && embedding.size() != dimension)) {
+            out.clear();
+            return 0;
+        }
+        if (dimension == 0) {
+            dimension = embedding.size();
+            out.reserve(dimension * texts.size());
+        }
+        out.insert(out.end(), embedding.begin(), embedding.end());
+    }
+    return dimension;
+}
+
 // C API Implementation
 extern "C" {
 
@@ -127,6 +300,7 @@ const char* llm_generate(LLMContext* ctx,
         strcpy(output, result.c_str());
         return output;
     } catch (...) {
+        metrics::reportException(metrics::Module::Llm, "generate");
         return nullptr;
     }
 }
@@ -145,10 +319,50 @@ size_t llm_get_embeddings(LLMContext* ctx,
         std::copy(embeddings.begin(), embeddings.begin() + size, embedding_out);
         return size;
     } catch (...) {
+        metrics::reportException(metrics::Module::Llm, "embed");
         return 0;
     }
 }
 
+scheduler::Request* llm_generate_async(LLMContext* ctx,
+                                       const char* prompt,
+                                       const char* system_prompt,
+                                       int max_tokens,
+                                       float temperature,
+                                       float top_p,
+                                       scheduler::RequestCallback callback,
+                                       void* user_data) {
+    if (!ctx || !prompt) return nullptr;
+
+    std::string user = prompt;
+    std::string system = system_prompt ? system_prompt : "";
+    return scheduler::Request::submit(
+        [ctx, user, system, max_tokens, temperature, top_p](scheduler::Request& request) {
+            bool success = ctx->generateStream(user, system, max_tokens, temperature, top_p,
+                [&request](const std::string& token) {
+                    request.text += token;
+                    return true;
+                });
+            if (!success) request.fail("Failed to generate text");
+        },
+        callback, user_data, &ctx->pendingRequests());
+}
+
+scheduler::Request* llm_get_embeddings_async(LLMContext* ctx,
+                                             const char* text,
+                                             scheduler::RequestCallback callback,
+                                             void* user_data) {
+    if (!ctx || !text) return nullptr;
+
+    std::string input = text;
+    return scheduler::Request::submit(
+        [ctx, input](scheduler::Request& request) {
+            request.floats = ctx->getEmbeddings(input);
+            if (request.floats.empty()) request.fail("Failed to get embeddings");
+        },
+        callback, user_data, &ctx->pendingRequests());
+}
+
 } // extern "C"
 
 } // namespace mlc_llm
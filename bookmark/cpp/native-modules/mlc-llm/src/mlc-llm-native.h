@@ -1,9 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 #include <memory>
+#include <functional>
+#include <mutex>
 #include <mlc/llm.h>
+#include "scheduler-native.h"
 
 namespace bookmark {
 namespace mlc_llm {
@@ -19,14 +25,67 @@ public:
                         int max_tokens = 512,
                         float temperature = 0.7f,
                         float top_p = 0.95f);
+
+    // Streams decoded tokens to on_token as they are produced; returning
+    // false from on_token stops generation early
+    bool generateStream(const std::string& prompt,
+                        const std::string& system_prompt,
+                        int max_tokens,
+                        float temperature,
+                        float top_p,
+                        const std::function<bool(const std::string&)>& on_token);
     std::vector<float> getEmbeddings(const std::string& text);
 
+    // Embeds texts back to back into a contiguous row-major buffer; returns
+    // the embedding width, or 0 if any text fails to embed
+    size_t getEmbeddingsBatch(const std::vector<std::string>& texts, std::vector<float>& out);
+
+    scheduler::PendingRequests& pendingRequests() { return pending_; }
+
+    // True while an interactive call is waiting for the model, so background
+    // generation can stop early and hand it over
+    bool interactiveWaiting() const { return interactive_waiting_.load(std::memory_order_relaxed) > 0; }
+
+    // Posts resume as a Background task once no interactive call is waiting
+    // for or using the model, straight away if none is. Background work that
+    // stopped for one parks its continuation here rather than polling. One
+    // continuation per key; cancelWhenIdle() drops it and returns whether it
+    // was still parked.
+    void whenInteractiveIdle(const void* key, std::function<void()> resume);
+    bool cancelWhenIdle(const void* key);
+
 private:
+    // Holds the model for one call. Interactive callers are counted from
+    // when they start waiting until they let go, and the last one out posts
+    // the parked continuations.
+    class Hold {
+    public:
+        explicit Hold(LLMContext& llm);
+        ~Hold();
+        Hold(const Hold&) = delete;
+        Hold& operator=(const Hold&) = delete;
+
+    private:
+        LLMContext& llm_;
+        bool interactive_;
+        std::unique_lock<std::mutex> lock_;
+    };
+
     LLMContext(const std::string& model_path, const std::string& tokenizer_path);
+    bool loadWeights();
+
     std::unique_ptr<mlc::llm::LLMContext> ctx_;
     std::string model_path_;
     std::string tokenizer_path_;
+    int64_t model_bytes_ = 0;
+    uint32_t residency_id_ = 0; // see residency-native.h
     bool is_loaded_ = false;
+    std::mutex mutex_; // one forward pass at a time
+    std::atomic<int> interactive_waiting_{0};
+    std::mutex idle_mutex_; // guards the two below
+    int interactive_calls_ = 0; // waiting for or holding the model
+    std::vector<std::pair<const void*, std::function<void()>>> parked_;
+    scheduler::PendingRequests pending_;
 };
 
 // React Native binding interface
@@ -44,6 +103,22 @@ extern "C" {
                              const char* text, 
                              float* embedding_out,
                              size_t embedding_size);
+
+    // Run on the shared scheduler. Generation leaves its output in the
+    // request's text, embedding in its floats. Null if the arguments are
+    // invalid.
+    scheduler::Request* llm_generate_async(LLMContext* ctx,
+                                           const char* prompt,
+                                           const char* system_prompt,
+                                           int max_tokens,
+                                           float temperature,
+                                           float top_p,
+                                           scheduler::RequestCallback callback,
+                                           void* user_data);
+    scheduler::Request* llm_get_embeddings_async(LLMContext* ctx,
+                                                 const char* text,
+                                                 scheduler::RequestCallback callback,
+                                                 void* user_data);
 }
 
 } // namespace mlc_llm
@@ -0,0 +1,328 @@
+#include "summarizer-native.h"
+#include "metrics-native.h"
+#include <algorithm>
+#include <chrono>
+
+namespace bookmark {
+namespace mlc_llm {
+
+namespace {
+
+const char* const kSystemPrompt =
+    "You keep a running summary of a reader's conversation about a book. "
+    "Be concise and factual. Cover the questions asked, what was learned "
+    "and anything the reader wanted to remember.";
+
+constexpr float kTemperature = 0.3f;
+constexpr float kTopP = 0.9f;
+
+// Splits text into pieces of at most limit bytes, at whitespace where there
+// is some and never inside a UTF-8 sequence
+void splitLong(const std::string& text, size_t limit, std::vector<std::string>& out) {
+    size_t start = 0;
+    while (text.size() - start > limit) {
+        size_t end = text.find_last_of(" \n", start + limit);
+        if (end == std::string::npos || end <= start) {
+            end = start + limit;
+            while (end > start + 1 && (static_cast<unsigned char>(text[end]) & 0xC0) == 0x80) {
+                end--;
+            }
+        }
+        out.push_back(text.substr(start, end - start));
+        start = end;
+        while (start < text.size() && (text[start] == ' ' || text[start] == '\n')) start++;
+    }
+    if (start < text.size()) out.push_back(text.substr(start));
+}
+
+// Groups turns into chunks of at most limit bytes, keeping turns whole
+// unless one alone is over the limit
+std::vector<std::string> chunkTranscript(const std::vector<std::string>& turns, size_t limit) {
+    std::vector<std::string> chunks;
+    std::string current;
+    for (const auto& turn : turns) {
+        if (!current.empty() && current.size() + 1 + turn.size() > limit) {
+            chunks.push_back(std::move(current));
+            current.clear();
+        }
+        if (turn.size() > limit) {
+            splitLong(turn, limit, chunks);
+            continue;
+        }
+        if (!current.empty()) current += '\n';
+        current += turn;
+    }
+    if (!current.empty()) chunks.push_back(std::move(current));
+    return chunks;
+}
+
+std::string trimmed(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \n\t\r");
+    if (begin == std::string::npos) return std::string();
+    size_t end = text.find_last_not_of(" \n\t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+std::string excerptPrompt(const std::string& chunk) {
+    return "Conversation excerpt:\n" + chunk + "\n\nSummarize this excerpt.";
+}
+
+std::string combinePrompt(const std::vector<std::string>& partials, size_t begin, size_t end) {
+    std::string prompt = "Summaries of consecutive parts of a conversation:\n";
+    for (size_t i = begin; i < end; i++) {
+        prompt += "\n" + partials[i] + "\n";
+    }
+    return prompt + "\nCombine them into one summary, keeping their order.";
+}
+
+std::string foldPrompt(const std::string& summary, const std::string& update, bool update_is_summary) {
+    if (summary.empty()) {
+        return "Conversation:\n" + update + "\n\nSummarize this conversation.";
+    }
+    return "Summary so far:\n" + summary + "\n\n" +
+           (update_is_summary ? "Summary of the conversation since:\n" : "Conversation since:\n") + update +
+           "\n\nRewrite the summary so it also covers what was said since.";
+}
+
+} // namespace
+
+Summarizer* Summarizer::create(LLMContext* llm, const SummarizerOptions& options) {
+    if (!llm) return nullptr;
+    return new Summarizer(llm, options);
+}
+
+Summarizer::Summarizer(LLMContext* llm, const SummarizerOptions& options)
+    : llm_(llm), options_(options) {
+    // A chunk has to leave room for the instructions; a reduce step that
+    // combines fewer than two partials would never finish
+    options_.chunk_chars = std::max<size_t>(options_.chunk_chars, 512);
+    options_.fan_in = std::max<size_t>(options_.fan_in, 2);
+    options_.summary_tokens = std::max(options_.summary_tokens, 32);
+}
+
+Summarizer::~Summarizer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+        generation_++;
+        turns_.clear();
+    }
+    idle_.notify_all();
+
+    // Summary requests return as soon as they see closing_
+    pending_.drain();
+
+    // A fold parked behind an interactive call is never resumed now
+    bool parked = llm_->cancelWhenIdle(this);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (parked) running_ = false;
+    idle_.wait(lock, [this] { return !running_; });
+}
+
+void Summarizer::addTurn(const std::string& role, const std::string& text) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closing_) return;
+
+    turns_.push_back(role + ": " + text);
+    added_++;
+    if (!running_) {
+        running_ = true;
+        scheduler::Scheduler::instance().post(scheduler::QoS::Background, [this]() { run(); });
+    }
+}
+
+std::string Summarizer::summary(int timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t target = added_;
+    auto ready = [this, target] { return settled_ >= target || !running_ || closing_; };
+    if (timeout_ms < 0) {
+        idle_.wait(lock, ready);
+    } else {
+        idle_.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready);
+    }
+    return summary_;
+}
+
+size_t Summarizer::pendingTurns() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(added_ - settled_);
+}
+
+void Summarizer::reset() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_++;
+        turns_.clear();
+        summary_.clear();
+        settled_ = added_;
+    }
+    idle_.notify_all();
+}
+
+void Summarizer::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!turns_.empty() && !closing_) {
+        std::vector<std::string> turns;
+        turns.swap(turns_);
+        std::string summary = summary_;
+        uint64_t generation = generation_;
+        lock.unlock();
+
+        Outcome outcome = fold(turns, summary, generation);
+
+        lock.lock();
+        if (generation != generation_) {
+            // Reset or closing while folding; these turns are already dropped
+            continue;
+        }
+        if (outcome == Outcome::Done) {
+            summary_ = std::move(summary);
+            settled_ += turns.size();
+            idle_.notify_all();
+            continue;
+        }
+
+        // Fold them again, ahead of any added meanwhile
+        turns_.insert(turns_.begin(), turns.begin(), turns.end());
+        if (outcome == Outcome::Interrupted) {
+            // Start over once the waiting call is done with the model;
+            // straight away this would win the lock back and be interrupted
+            // again. The task stays running_ while parked.
+            llm_->whenInteractiveIdle(this, [this]() { run(); });
+            return;
+        }
+
+        // Failed; the next addTurn retries
+        break;
+    }
+    running_ = false;
+    idle_.notify_all();
+}
+
+Summarizer::Outcome Summarizer::fold(const std::vector<std::string>& turns,
+                                     std::string& summary,
+                                     uint64_t generation) {
+    std::vector<std::string> chunks = chunkTranscript(turns, options_.chunk_chars);
+    if (chunks.empty()) return Outcome::Done;
+    if (chunks.size() == 1) {
+        return complete(foldPrompt(summary, chunks[0], false), summary, generation);
+    }
+
+    // Map: summarize each chunk on its own
+    std::vector<std::string> partials;
+    partials.reserve(chunks.size());
+    for (const auto& chunk : chunks) {
+        std::string partial;
+        Outcome outcome = complete(excerptPrompt(chunk), partial, generation);
+        if (outcome != Outcome::Done) return outcome;
+        partials.push_back(std::move(partial));
+    }
+
+    // Reduce: combine neighbours until one summary is left
+    while (partials.size() > 1) {
+        std::vector<std::string> combined;
+        for (size_t begin = 0; begin < partials.size(); begin += options_.fan_in) {
+            size_t end = std::min(begin + options_.fan_in, partials.size());
+            if (end - begin == 1) {
+                combined.push_back(std::move(partials[begin]));
+                continue;
+            }
+            std::string merged;
+            Outcome outcome = complete(combinePrompt(partials, begin, end), merged, generation);
+            if (outcome != Outcome::Done) return outcome;
+            combined.push_back(std::move(merged));
+        }
+        partials.swap(combined);
+    }
+
+    if (summary.empty()) {
+        summary = std::move(partials[0]);
+        return Outcome::Done;
+    }
+    return complete(foldPrompt(summary, partials[0], true), summary, generation);
+}
+
+Summarizer::Outcome Summarizer::complete(const std::string& prompt, std::string& out, uint64_t generation) {
+    if (interrupted(generation)) return Outcome::Interrupted;
+
+    std::string text;
+    bool stopped = false;
+    try {
+        bool success = llm_->generateStream(prompt, kSystemPrompt, options_.summary_tokens, kTemperature, kTopP,
+            [&](const std::string& token) {
+                if (interrupted(generation)) {
+                    stopped = true;
+                    return false;
+                }
+                text += token;
+                return true;
+            });
+        if (!success) return Outcome::Failed;
+    } catch (...) {
+        metrics::reportException(metrics::Module::Llm, "summarize");
+        return Outcome::Failed;
+    }
+    if (stopped) return Outcome::Interrupted;
+
+    text = trimmed(text);
+    if (text.empty()) {
+        metrics::reportError(metrics::Module::Llm, "summarize", "empty summary");
+        return Outcome::Failed;
+    }
+    out = std::move(text);
+    return Outcome::Done;
+}
+
+bool Summarizer::interrupted(uint64_t generation) const {
+    return llm_->interactiveWaiting() || generation_.load() != generation;
+}
+
+// C API Implementation
+extern "C" {
+
+Summarizer* llm_summarizer_create(LLMContext* ctx, size_t chunk_chars, int summary_tokens) {
+    SummarizerOptions options;
+    if (chunk_chars > 0) options.chunk_chars = chunk_chars;
+    if (summary_tokens > 0) options.summary_tokens = summary_tokens;
+    return Summarizer::create(ctx, options);
+}
+
+void llm_summarizer_destroy(Summarizer* summarizer) {
+    delete summarizer;
+}
+
+bool llm_summarizer_add_turn(Summarizer* summarizer, const char* role, const char* text) {
+    if (!summarizer || !role || !text) return false;
+    summarizer->addTurn(role, text);
+    return true;
+}
+
+void llm_summarizer_reset(Summarizer* summarizer) {
+    if (summarizer) summarizer->reset();
+}
+
+const char* llm_summarizer_get_summary(Summarizer* summarizer, int timeout_ms) {
+    if (!summarizer) return nullptr;
+    thread_local std::string summary;
+    summary = summarizer->summary(timeout_ms);
+    return summary.c_str();
+}
+
+scheduler::Request* llm_summarizer_get_summary_async(Summarizer* summarizer,
+                                                     int timeout_ms,
+                                                     scheduler::RequestCallback callback,
+                                                     void* user_data) {
+    if (!summarizer) return nullptr;
+
+    return scheduler::Request::submit(
+        [summarizer, timeout_ms](scheduler::Request& request) {
+            request.text = summarizer->summary(timeout_ms);
+        },
+        callback, user_data, &summarizer->pendingRequests());
+}
+
+} // extern "C"
+
+} // namespace mlc_llm
+} // namespace bookmark
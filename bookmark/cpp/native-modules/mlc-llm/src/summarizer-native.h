@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "mlc-llm-native.h"
+#include "scheduler-native.h"
+
+namespace bookmark {
+namespace mlc_llm {
+
+struct SummarizerOptions {
+    size_t chunk_chars = 6000; // transcript per prompt, well inside the context window
+    size_t fan_in = 4;         // partial summaries combined per reduce prompt
+    int summary_tokens = 256;  // cap on the summary and on each partial
+};
+
+// Keeps a rolling summary of a conversation up to date as turns come in, so
+// that it is ready when the session ends rather than generated then from
+// the whole transcript.
+//
+// Turns are folded in on a background task: the model gets the summary so
+// far plus the turns added since, and rewrites the summary. Turns that pile
+// up past one prompt's worth (a long history added at once, or many turns
+// while the model was busy) are folded map-reduce style: each chunk of
+// transcript is summarized on its own, the partial summaries are combined
+// fan_in at a time until one is left, and that one is merged into the
+// summary. No prompt grows with the length of the session.
+//
+// Folding gives way to interactive calls on the same LLMContext: it stops
+// generating when one is waiting for the model, and the context posts it
+// again to start over on the same turns once that call has finished.
+class Summarizer {
+public:
+    static Summarizer* create(LLMContext* llm, const SummarizerOptions& options = SummarizerOptions());
+    // Waits for a fold in progress to stop; unfolded turns are dropped
+    ~Summarizer();
+
+    void addTurn(const std::string& role, const std::string& text);
+
+    // The summary so far, after waiting up to timeout_ms (forever if
+    // negative) for the turns added before the call to be folded in. Empty
+    // until the first fold completes.
+    std::string summary(int timeout_ms);
+
+    // Turns added but not folded in yet
+    size_t pendingTurns() const;
+
+    void reset();
+
+    scheduler::PendingRequests& pendingRequests() { return pending_; }
+
+private:
+    enum class Outcome { Done, Interrupted, Failed };
+
+    Summarizer(LLMContext* llm, const SummarizerOptions& options);
+
+    void run();
+    Outcome fold(const std::vector<std::string>& turns, std::string& summary, uint64_t generation);
+    Outcome complete(const std::string& prompt, std::string& out, uint64_t generation);
+    bool interrupted(uint64_t generation) const;
+
+    LLMContext* llm_;
+    SummarizerOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable idle_;
+    std::vector<std::string> turns_;    // added since the last fold
+    std::string summary_;
+    uint64_t added_ = 0;                // turns ever added
+    uint64_t settled_ = 0;              // of which folded in or dropped
+    bool running_ = false;              // a fold task is queued or running
+    bool closing_ = false;
+    std::atomic<uint64_t> generation_{0}; // bumped by reset() and the destructor to abandon a fold
+    scheduler::PendingRequests pending_;
+};
+
+// React Native binding interface
+extern "C" {
+    // chunk_chars and summary_tokens of 0 take the defaults
+    Summarizer* llm_summarizer_create(LLMContext* ctx, size_t chunk_chars, int summary_tokens);
+    void llm_summarizer_destroy(Summarizer* summarizer);
+    bool llm_summarizer_add_turn(Summarizer* summarizer, const char* role, const char* text);
+    void llm_summarizer_reset(Summarizer* summarizer);
+
+    // Waits on the calling thread; the string stays valid until the
+    // thread's next call
+    const char* llm_summarizer_get_summary(Summarizer* summarizer, int timeout_ms);
+
+    // Waits on the shared scheduler instead and leaves the summary in the
+    // request's text
+    scheduler::Request* llm_summarizer_get_summary_async(Summarizer* summarizer,
+                                                         int timeout_ms,
+                                                         scheduler::RequestCallback callback,
+                                                         void* user_data);
+}
+
+} // namespace mlc_llm
+} // namespace bookmark
@@ -0,0 +1,9 @@
+// Compiled only against the real modules: a C function redeclared with a
+// different signature is a hard error, so drift in backend-api.h breaks
+// the build instead of the ABI.
+#include "backend-api.h"
+
+#include "faiss-native.h"
+#include "mlc-llm-native.h"
+#include "whisper-native.h"
+#include "tts-native.h"
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+
+// The subset of the module C APIs the replay driver calls. Declared here
+// with opaque types so the driver builds against either the real modules
+// or the stub backend without pulling in FAISS/MLC/Whisper/Piper headers.
+// backend-api-check.cpp keeps these in sync with the module headers.
+
+namespace bookmark {
+
+namespace faiss {
+class FaissIndex;
+extern "C" {
+    FaissIndex* faiss_create_index(int dimension);
+    void faiss_destroy_index(FaissIndex* index);
+    bool faiss_add_embeddings(FaissIndex* index, const float* embeddings, size_t count, size_t dimension);
+    size_t faiss_search(FaissIndex* index, const float* query, size_t query_size, int k, int* indices, float* distances);
+    size_t faiss_get_size(FaissIndex* index);
+}
+} // namespace faiss
+
+namespace mlc_llm {
+class LLMContext;
+extern "C" {
+    LLMContext* llm_create_context(const char* model_path, const char* tokenizer_path);
+    void llm_destroy_context(LLMContext* ctx);
+    bool llm_load_model(LLMContext* ctx);
+    const char* llm_generate(LLMContext* ctx,
+                             const char* prompt,
+                             const char* system_prompt,
+                             int max_tokens,
+                             float temperature,
+                             float top_p);
+    size_t llm_get_embeddings(LLMContext* ctx,
+                              const char* text,
+                              float* embedding_out,
+                              size_t embedding_size);
+}
+} // namespace mlc_llm
+
+namespace whisper {
+class WhisperContext;
+extern "C" {
+    WhisperContext* whisper_create_context(const char* model_path);
+    void whisper_destroy_context(WhisperContext* ctx);
+    bool whisper_transcribe(WhisperContext* ctx, const float* pcm_data, size_t pcm_size, int sample_rate);
+    const char* whisper_get_transcription(WhisperContext* ctx);
+}
+} // namespace whisper
+
+namespace tts {
+class TTSContext;
+extern "C" {
+    TTSContext* tts_create_context(const char* model_path, const char* config_path);
+    void tts_destroy_context(TTSContext* ctx);
+    bool tts_load_model(TTSContext* ctx);
+    size_t tts_synthesize(TTSContext* ctx, const char* text, float* audio_out, size_t max_samples);
+    int tts_get_sample_rate(TTSContext* ctx);
+}
+} // namespace tts
+
+} // namespace bookmark
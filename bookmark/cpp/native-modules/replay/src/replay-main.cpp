@@ -0,0 +1,556 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "backend-api.h"
+#include "trace.h"
+
+using namespace bookmark;
+using namespace bookmark::replay;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kMaxEmbedding = 4096;
+constexpr size_t kIngestBatch = 16;
+
+// Same prompts the app uses (RAGService, NoteService)
+const char* kAnswerSystemPrompt =
+    "You are a helpful assistant that answers questions based on the given context.";
+const char* kNoteSystemPrompt =
+    "You are an AI assistant that extracts important information from conversations about books. "
+    "Your task is to identify key points, insights, and noteworthy information from the given text. "
+    "Format each point as a separate note with a clear, concise description.";
+
+struct Options {
+    std::string trace_path;
+    std::string json_path;
+    std::string llm_model;
+    std::string llm_tokenizer;
+    std::string whisper_model;
+    std::string tts_model;
+    std::string tts_config;
+    double speed = 1.0;     // >1 compresses think time between events
+    bool wait = true;       // honour trace timestamps at all
+    int max_tokens = 256;
+    int top_k = 3;
+    size_t chunk_bytes = 512;
+};
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+long peakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+long currentRssKb() {
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0, resident = 0;
+    if (!(statm >> pages >> resident)) return 0;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// Latency samples per stage, summarized with nearest-rank percentiles
+class StageStats {
+public:
+    void add(const std::string& stage, double ms) { samples_[stage].push_back(ms); }
+
+    struct Summary {
+        size_t count;
+        double mean, p50, p90, p95, p99, max;
+    };
+
+    std::map<std::string, Summary> summarize() const {
+        std::map<std::string, Summary> result;
+        for (const auto& entry : samples_) {
+            std::vector<double> sorted = entry.second;
+            std::sort(sorted.begin(), sorted.end());
+
+            auto rank = [&](double p) {
+                size_t index = static_cast<size_t>(p * sorted.size() + 0.999999);
+                return sorted[std::min(sorted.size(), std::max<size_t>(index, 1)) - 1];
+            };
+
+            double total = 0.0;
+            for (double ms : sorted) total += ms;
+            result[entry.first] = {sorted.size(), total / sorted.size(), rank(0.50), rank(0.90),
+                                   rank(0.95), rank(0.99), sorted.back()};
+        }
+        return result;
+    }
+
+private:
+    std::map<std::string, std::vector<double>> samples_;
+};
+
+class Session {
+public:
+    Session(const Options& options, StageStats& stats) : options_(options), stats_(stats) {}
+
+    ~Session() {
+        if (index_) faiss::faiss_destroy_index(index_);
+        if (llm_) mlc_llm::llm_destroy_context(llm_);
+        if (whisper_) whisper::whisper_destroy_context(whisper_);
+        if (tts_) tts::tts_destroy_context(tts_);
+    }
+
+    bool initialize() {
+        auto start = Clock::now();
+        llm_ = mlc_llm::llm_create_context(options_.llm_model.c_str(), options_.llm_tokenizer.c_str());
+        if (!llm_ || !mlc_llm::llm_load_model(llm_)) {
+            fprintf(stderr, "replay: failed to load LLM %s\n", options_.llm_model.c_str());
+            return false;
+        }
+        stats_.add("load_llm", msSince(start));
+
+        if (!options_.whisper_model.empty()) {
+            start = Clock::now();
+            whisper_ = whisper::whisper_create_context(options_.whisper_model.c_str());
+            stats_.add("load_whisper", msSince(start));
+        }
+        if (!options_.tts_model.empty()) {
+            start = Clock::now();
+            tts_ = tts::tts_create_context(options_.tts_model.c_str(), options_.tts_config.c_str());
+            if (tts_ && !tts::tts_load_model(tts_)) {
+                tts::tts_destroy_context(tts_);
+                tts_ = nullptr;
+            }
+            stats_.add("load_tts", msSince(start));
+        }
+        return true;
+    }
+
+    bool run(const TraceEvent& event) {
+        switch (event.type) {
+            case TraceEventType::Book: return ingest(event.argument);
+            case TraceEventType::Ask: return askTurn(event.argument);
+            case TraceEventType::Voice: return voiceTurn(event.argument);
+            case TraceEventType::Note: return note(event.argument);
+            case TraceEventType::Summary: return summary();
+        }
+        return false;
+    }
+
+    long rssAfterIngestKb() const { return rss_after_ingest_kb_; }
+
+private:
+    // Sentence-aligned chunks of about chunk_bytes, like BookProcessor
+    std::vector<std::string> chunkText(const std::string& text) const {
+        std::vector<std::string> chunks;
+        std::string current;
+        size_t start = 0;
+        while (start < text.size()) {
+            size_t end = text.find_first_of(".!?", start);
+            end = end == std::string::npos ? text.size() : end + 1;
+            const std::string sentence = text.substr(start, end - start);
+            start = end;
+
+            if (!current.empty() && current.size() + sentence.size() > options_.chunk_bytes) {
+                chunks.push_back(current);
+                current.clear();
+            }
+            current += sentence;
+        }
+        if (!current.empty()) chunks.push_back(current);
+        return chunks;
+    }
+
+    bool ingest(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            fprintf(stderr, "replay: cannot read book %s\n", path.c_str());
+            return false;
+        }
+        std::stringstream contents;
+        contents << in.rdbuf();
+
+        const auto ingest_start = Clock::now();
+        std::vector<std::string> chunks = chunkText(contents.str());
+        std::vector<float> batch;
+        std::vector<float> embedding(kMaxEmbedding);
+        size_t batch_count = 0;
+
+        for (const auto& chunk : chunks) {
+            auto start = Clock::now();
+            size_t dimension = mlc_llm::llm_get_embeddings(llm_, chunk.c_str(), embedding.data(), embedding.size());
+            stats_.add("embed_chunk", msSince(start));
+            if (dimension == 0) return false;
+
+            if (!index_) {
+                index_ = faiss::faiss_create_index(static_cast<int>(dimension));
+                dimension_ = dimension;
+            }
+            batch.insert(batch.end(), embedding.begin(), embedding.begin() + dimension);
+            chunks_.push_back(chunk);
+
+            if (++batch_count == kIngestBatch) {
+                start = Clock::now();
+                faiss::faiss_add_embeddings(index_, batch.data(), batch_count, dimension_);
+                stats_.add("index_add", msSince(start));
+                batch.clear();
+                batch_count = 0;
+            }
+        }
+        if (batch_count > 0) {
+            faiss::faiss_add_embeddings(index_, batch.data(), batch_count, dimension_);
+        }
+
+        stats_.add("ingest_book", msSince(ingest_start));
+        rss_after_ingest_kb_ = std::max(rss_after_ingest_kb_, currentRssKb());
+        return true;
+    }
+
+    // Retrieval + generation shared by typed and spoken turns
+    bool answer(const std::string& question, std::string& answer_out) {
+        std::vector<std::string> context;
+        if (index_) {
+            std::vector<float> query(kMaxEmbedding);
+            auto start = Clock::now();
+            size_t dimension = mlc_llm::llm_get_embeddings(llm_, question.c_str(), query.data(), query.size());
+            stats_.add("embed_query", msSince(start));
+
+            std::vector<int> indices(options_.top_k);
+            std::vector<float> distances(options_.top_k);
+            start = Clock::now();
+            size_t found = faiss::faiss_search(index_, query.data(), dimension, options_.top_k,
+                                               indices.data(), distances.data());
+            stats_.add("search", msSince(start));
+
+            for (size_t i = 0; i < found; ++i) {
+                if (indices[i] >= 0 && static_cast<size_t>(indices[i]) < chunks_.size()) {
+                    context.push_back(chunks_[indices[i]]);
+                }
+            }
+        }
+
+        std::string prompt = question;
+        if (!context.empty()) {
+            std::string joined;
+            for (const auto& chunk : context) {
+                joined += (joined.empty() ? "" : "\n\n") + chunk;
+            }
+            prompt = "Context:\n" + joined + "\n\nQuestion: " + question + "\n\nAnswer:";
+        }
+
+        return generate("generate", prompt, kAnswerSystemPrompt, options_.max_tokens, answer_out);
+    }
+
+    bool generate(const char* stage, const std::string& prompt, const char* system_prompt,
+                  int max_tokens, std::string& out) {
+        const auto start = Clock::now();
+        const char* result = mlc_llm::llm_generate(llm_, prompt.c_str(), system_prompt, max_tokens, 0.7f, 0.95f);
+        stats_.add(stage, msSince(start));
+        if (!result) return false;
+
+        out = result;
+        delete[] result; // Free allocated string from C++ side
+        return true;
+    }
+
+    bool askTurn(const std::string& question) {
+        const auto start = Clock::now();
+        std::string reply;
+        if (!answer(question, reply)) return false;
+        stats_.add("turn_text", msSince(start));
+        remember(question, reply);
+        return true;
+    }
+
+    bool voiceTurn(const std::string& source) {
+        if (!whisper_) {
+            fprintf(stderr, "replay: voice event without --whisper-model, skipped\n");
+            return true;
+        }
+
+        std::vector<float> pcm;
+        if (!loadAudio(source, pcm)) {
+            fprintf(stderr, "replay: cannot read audio %s\n", source.c_str());
+            return false;
+        }
+
+        const auto turn_start = Clock::now();
+        auto start = Clock::now();
+        if (!whisper::whisper_transcribe(whisper_, pcm.data(), pcm.size(), 16000)) return false;
+        const char* text = whisper::whisper_get_transcription(whisper_);
+        const std::string question = text ? text : "";
+        stats_.add("transcribe", msSince(start));
+
+        std::string reply;
+        if (!answer(question, reply)) return false;
+
+        // Sentence by sentence, as VoiceService plays answers
+        if (tts_) {
+            const int sample_rate = tts::tts_get_sample_rate(tts_);
+            std::vector<float> audio(static_cast<size_t>(sample_rate) * 60);
+            bool first = true;
+            size_t begin = 0;
+            while (begin < reply.size()) {
+                size_t end = reply.find_first_of(".!?", begin);
+                end = end == std::string::npos ? reply.size() : end + 1;
+                const std::string sentence = reply.substr(begin, end - begin);
+                begin = end;
+
+                start = Clock::now();
+                tts::tts_synthesize(tts_, sentence.c_str(), audio.data(), audio.size());
+                stats_.add("synthesize_sentence", msSince(start));
+                if (first) {
+                    stats_.add("first_audio", msSince(turn_start));
+                    first = false;
+                }
+            }
+        }
+
+        stats_.add("turn_voice", msSince(turn_start));
+        remember(question, reply);
+        return true;
+    }
+
+    bool note(const std::string& text) {
+        const std::string content = text.empty() ? last_answer_ : text;
+        const std::string prompt =
+            "Extract important points from this conversation:\n" + content +
+            "\n\nFocus on:\n- Main ideas and themes\n- Character insights\n- Plot developments\n"
+            "- Literary analysis\n- Significant quotes\n\nFormat each point as a separate note.";
+
+        std::string notes;
+        return generate("note", prompt, kNoteSystemPrompt, options_.max_tokens, notes);
+    }
+
+    bool summary() {
+        std::string transcript;
+        for (const auto& entry : history_) {
+            transcript += entry + "\n";
+        }
+        const std::string prompt =
+            "Summarize the following notes from a book discussion session:\n" + transcript +
+            "\nCreate a concise summary that captures the main points and insights discussed.";
+
+        std::string result;
+        return generate("summary", prompt, nullptr, 300, result);
+    }
+
+    void remember(const std::string& question, const std::string& reply) {
+        history_.push_back("User: " + question);
+        history_.push_back("Assistant: " + reply);
+        last_answer_ = reply;
+    }
+
+    // 16-bit PCM WAV at 16 kHz, or "synthetic:<seconds>" of silence
+    bool loadAudio(const std::string& source, std::vector<float>& pcm) const {
+        if (source.rfind("synthetic:", 0) == 0) {
+            pcm.assign(static_cast<size_t>(atof(source.c_str() + 10) * 16000), 0.0f);
+            return !pcm.empty();
+        }
+
+        std::ifstream in(source, std::ios::binary);
+        char header[12];
+        if (!in.read(header, 12) || memcmp(header, "RIFF", 4) != 0) return false;
+
+        char id[4];
+        uint32_t size;
+        while (in.read(id, 4) && in.read(reinterpret_cast<char*>(&size), 4)) {
+            if (memcmp(id, "data", 4) != 0) {
+                in.seekg(size + (size & 1), std::ios::cur);
+                continue;
+            }
+            std::vector<int16_t> samples(size / sizeof(int16_t));
+            in.read(reinterpret_cast<char*>(samples.data()), samples.size() * sizeof(int16_t));
+            pcm.resize(samples.size());
+            for (size_t i = 0; i < samples.size(); ++i) {
+                pcm[i] = samples[i] / 32768.0f;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    const Options& options_;
+    StageStats& stats_;
+
+    mlc_llm::LLMContext* llm_ = nullptr;
+    whisper::WhisperContext* whisper_ = nullptr;
+    tts::TTSContext* tts_ = nullptr;
+    faiss::FaissIndex* index_ = nullptr;
+    size_t dimension_ = 0;
+
+    std::vector<std::string> chunks_;
+    std::vector<std::string> history_;
+    std::string last_answer_;
+    long rss_after_ingest_kb_ = 0;
+};
+
+void printUsage() {
+    fprintf(stderr,
+        "usage: bookmark-replay --trace FILE [options]\n"
+        "  --llm-model PATH --llm-tokenizer PATH\n"
+        "  --whisper-model PATH\n"
+        "  --tts-model PATH --tts-config PATH\n"
+        "  --speed X         replay think time X times faster (default 1)\n"
+        "  --no-wait         ignore trace timestamps\n"
+        "  --max-tokens N    generation limit per answer (default 256)\n"
+        "  --top-k N         chunks retrieved per question (default 3)\n"
+        "  --json FILE       write the report as JSON\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+#ifdef BOOKMARK_REPLAY_STUB
+    // The stub backend ignores paths, so every stage is on by default
+    options.llm_model = options.llm_tokenizer = "stub";
+    options.whisper_model = "stub";
+    options.tts_model = options.tts_config = "stub";
+#endif
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : ""; };
+
+        if (arg == "--trace") options.trace_path = value();
+        else if (arg == "--json") options.json_path = value();
+        else if (arg == "--llm-model") options.llm_model = value();
+        else if (arg == "--llm-tokenizer") options.llm_tokenizer = value();
+        else if (arg == "--whisper-model") options.whisper_model = value();
+        else if (arg == "--tts-model") options.tts_model = value();
+        else if (arg == "--tts-config") options.tts_config = value();
+        else if (arg == "--speed") options.speed = atof(value());
+        else if (arg == "--no-wait") options.wait = false;
+        else if (arg == "--max-tokens") options.max_tokens = atoi(value());
+        else if (arg == "--top-k") options.top_k = atoi(value());
+        else return false;
+    }
+
+    return !options.trace_path.empty() && !options.llm_model.empty() && options.speed > 0 &&
+           options.max_tokens > 0 && options.top_k > 0;
+}
+
+void printReport(const std::map<std::string, StageStats::Summary>& stages, long peak_rss_kb,
+                 long ingest_rss_kb, size_t events, size_t failures) {
+    printf("%-22s %6s %9s %9s %9s %9s %9s %9s\n", "stage", "count", "mean", "p50", "p90", "p95", "p99", "max");
+    for (const auto& entry : stages) {
+        const auto& s = entry.second;
+        printf("%-22s %6zu %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+               entry.first.c_str(), s.count, s.mean, s.p50, s.p90, s.p95, s.p99, s.max);
+    }
+    printf("\nevents: %zu (%zu failed)  peak RSS: %.1f MiB  RSS after ingest: %.1f MiB\n",
+           events, failures, peak_rss_kb / 1024.0, ingest_rss_kb / 1024.0);
+}
+
+// Quoted and escaped for a JSON string value
+std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+    return out;
+}
+
+bool writeJson(const std::string& path, const Options& options,
+               const std::map<std::string, StageStats::Summary>& stages,
+               long peak_rss_kb, long ingest_rss_kb, size_t events, size_t failures) {
+    FILE* out = fopen(path.c_str(), "w");
+    if (!out) return false;
+
+    fprintf(out, "{\n  \"trace\": %s,\n", jsonString(options.trace_path).c_str());
+#ifdef BOOKMARK_REPLAY_STUB
+    fprintf(out, "  \"backend\": \"stub\",\n");
+#else
+    fprintf(out, "  \"backend\": \"native\",\n");
+#endif
+    fprintf(out, "  \"events\": %zu,\n  \"failures\": %zu,\n", events, failures);
+    fprintf(out, "  \"peak_rss_kb\": %ld,\n  \"rss_after_ingest_kb\": %ld,\n", peak_rss_kb, ingest_rss_kb);
+    fprintf(out, "  \"stages_ms\": {");
+
+    bool first = true;
+    for (const auto& entry : stages) {
+        const auto& s = entry.second;
+        fprintf(out, "%s\n    %s: {\"count\": %zu, \"mean\": %.3f, \"p50\": %.3f, \"p90\": %.3f, "
+                     "\"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f}",
+                first ? "" : ",", jsonString(entry.first).c_str(), s.count, s.mean, s.p50, s.p90, s.p95, s.p99, s.max);
+        first = false;
+    }
+    fprintf(out, "\n  }\n}\n");
+    return fclose(out) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    std::vector<TraceEvent> events;
+    std::string error;
+    if (!parseTrace(options.trace_path, events, error)) {
+        fprintf(stderr, "replay: %s\n", error.c_str());
+        return 2;
+    }
+
+    StageStats stats;
+    Session session(options, stats);
+    if (!session.initialize()) {
+        return 1;
+    }
+
+    // Trace time starts once models are loaded, as the app's would
+    const auto session_start = Clock::now();
+    size_t failures = 0;
+
+    for (const auto& event : events) {
+        if (options.wait) {
+            const auto due = session_start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::milli>(event.at_ms / options.speed));
+            std::this_thread::sleep_until(due);
+            // How far behind schedule the previous turns pushed this one
+            stats.add("schedule_lag", std::max(0.0, msSince(due)));
+        }
+
+        if (!session.run(event)) {
+            fprintf(stderr, "replay: line %d: %s event failed\n", event.line, eventTypeName(event.type));
+            ++failures;
+        }
+    }
+
+    const auto stages = stats.summarize();
+    const long peak_rss_kb = peakRssKb();
+    printReport(stages, peak_rss_kb, session.rssAfterIngestKb(), events.size(), failures);
+
+    if (!options.json_path.empty() &&
+        !writeJson(options.json_path, options, stages, peak_rss_kb, session.rssAfterIngestKb(), events.size(), failures)) {
+        fprintf(stderr, "replay: cannot write %s\n", options.json_path.c_str());
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+#include "backend-api.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Simulated backend for running the replay driver without models. Costs
+// are modelled on a mid-range phone and can be tuned through
+// BOOKMARK_STUB_* environment variables; FAISS search is a real brute-force
+// scan so retrieval cost still scales with the index.
+
+namespace bookmark {
+
+namespace {
+
+double envDouble(const char* name, double fallback) {
+    const char* value = std::getenv(name);
+    return value ? std::atof(value) : fallback;
+}
+
+void simulate(double ms) {
+    if (ms > 0) {
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(ms));
+    }
+}
+
+// FNV-1a seeded pseudo-embedding, stable for the same text
+void pseudoEmbedding(const char* text, float* out, size_t dimension) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (const char* p = text; *p; ++p) {
+        hash ^= static_cast<unsigned char>(*p);
+        hash *= 1099511628211ULL;
+    }
+
+    float norm = 0.0f;
+    for (size_t i = 0; i < dimension; ++i) {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        out[i] = static_cast<float>(static_cast<int64_t>(hash % 2001) - 1000) / 1000.0f;
+        norm += out[i] * out[i];
+    }
+    norm = std::sqrt(norm);
+    for (size_t i = 0; i < dimension; ++i) {
+        out[i] /= norm;
+    }
+}
+
+} // namespace
+
+namespace faiss {
+
+class FaissIndex {
+public:
+    explicit FaissIndex(int dimension) : dimension(dimension) {}
+    int dimension;
+    std::vector<float> vectors;
+};
+
+extern "C" {
+
+FaissIndex* faiss_create_index(int dimension) {
+    return dimension > 0 ? new FaissIndex(dimension) : nullptr;
+}
+
+void faiss_destroy_index(FaissIndex* index) {
+    delete index;
+}
+
+bool faiss_add_embeddings(FaissIndex* index, const float* embeddings, size_t count, size_t dimension) {
+    if (!index || !embeddings || dimension != static_cast<size_t>(index->dimension)) return false;
+    index->vectors.insert(index->vectors.end(), embeddings, embeddings + count * dimension);
+    return true;
+}
+
+size_t faiss_search(FaissIndex* index, const float* query, size_t query_size, int k, int* indices, float* distances) {
+    if (!index || !query || query_size != static_cast<size_t>(index->dimension) || k <= 0) return 0;
+
+    std::fill(indices, indices + k, -1);
+    std::fill(distances, distances + k, std::numeric_limits<float>::max());
+
+    const size_t count = index->vectors.size() / query_size;
+    for (size_t row = 0; row < count; ++row) {
+        const float* v = index->vectors.data() + row * query_size;
+        float distance = 0.0f;
+        for (size_t d = 0; d < query_size; ++d) {
+            const float diff = v[d] - query[d];
+            distance += diff * diff;
+        }
+
+        // Insertion into the sorted top-k
+        for (int slot = 0; slot < k; ++slot) {
+            if (distance < distances[slot]) {
+                std::move_backward(distances + slot, distances + k - 1, distances + k);
+                std::move_backward(indices + slot, indices + k - 1, indices + k);
+                distances[slot] = distance;
+                indices[slot] = static_cast<int>(row);
+                break;
+            }
+        }
+    }
+    return static_cast<size_t>(k);
+}
+
+size_t faiss_get_size(FaissIndex* index) {
+    return index ? index->vectors.size() / index->dimension : 0;
+}
+
+} // extern "C"
+} // namespace faiss
+
+namespace mlc_llm {
+
+class LLMContext {};
+
+extern "C" {
+
+LLMContext* llm_create_context(const char*, const char*) {
+    return new LLMContext();
+}
+
+void llm_destroy_context(LLMContext* ctx) {
+    delete ctx;
+}
+
+bool llm_load_model(LLMContext* ctx) {
+    simulate(envDouble("BOOKMARK_STUB_LOAD_MS", 1500.0));
+    return ctx != nullptr;
+}
+
+const char* llm_generate(LLMContext* ctx,
+                         const char* prompt,
+                         const char* system_prompt,
+                         int max_tokens,
+                         float,
+                         float) {
+    if (!ctx || !prompt) return nullptr;
+
+    // Prefill scales with prompt size, decode with generated tokens
+    const size_t prompt_bytes = strlen(prompt) + (system_prompt ? strlen(system_prompt) : 0);
+    const int tokens = std::min(max_tokens, static_cast<int>(envDouble("BOOKMARK_STUB_ANSWER_TOKENS", 96)));
+    simulate(prompt_bytes / 1024.0 * envDouble("BOOKMARK_STUB_PREFILL_MS_PER_KB", 60.0));
+    simulate(tokens * envDouble("BOOKMARK_STUB_DECODE_MS_PER_TOKEN", 45.0));
+
+    std::string answer;
+    for (int i = 0; i < tokens; ++i) {
+        answer += (i % 12 == 11) ? "stub. " : "stub ";
+    }
+
+    char* output = new char[answer.length() + 1];
+    strcpy(output, answer.c_str());
+    return output;
+}
+
+size_t llm_get_embeddings(LLMContext* ctx, const char* text, float* embedding_out, size_t embedding_size) {
+    if (!ctx || !text || !embedding_out) return 0;
+
+    const size_t dimension = std::min<size_t>(embedding_size, 768);
+    simulate(envDouble("BOOKMARK_STUB_EMBED_MS", 12.0) + strlen(text) / 1024.0 * envDouble("BOOKMARK_STUB_PREFILL_MS_PER_KB", 60.0));
+    pseudoEmbedding(text, embedding_out, dimension);
+    return dimension;
+}
+
+} // extern "C"
+} // namespace mlc_llm
+
+namespace whisper {
+
+class WhisperContext {
+public:
+    std::string transcription;
+};
+
+extern "C" {
+
+WhisperContext* whisper_create_context(const char*) {
+    simulate(envDouble("BOOKMARK_STUB_LOAD_MS", 1500.0) / 4);
+    return new WhisperContext();
+}
+
+void whisper_destroy_context(WhisperContext* ctx) {
+    delete ctx;
+}
+
+bool whisper_transcribe(WhisperContext* ctx, const float* pcm_data, size_t pcm_size, int sample_rate) {
+    if (!ctx || !pcm_data || sample_rate <= 0) return false;
+
+    const double seconds = static_cast<double>(pcm_size) / sample_rate;
+    simulate(seconds * 1000.0 * envDouble("BOOKMARK_STUB_WHISPER_RTF", 0.35));
+    ctx->transcription = "What happens in this part of the book after " + std::to_string(static_cast<int>(seconds)) + " seconds?";
+    return true;
+}
+
+const char* whisper_get_transcription(WhisperContext* ctx) {
+    return ctx ? ctx->transcription.c_str() : nullptr;
+}
+
+} // extern "C"
+} // namespace whisper
+
+namespace tts {
+
+class TTSContext {};
+
+extern "C" {
+
+TTSContext* tts_create_context(const char*, const char*) {
+    return new TTSContext();
+}
+
+void tts_destroy_context(TTSContext* ctx) {
+    delete ctx;
+}
+
+bool tts_load_model(TTSContext* ctx) {
+    simulate(envDouble("BOOKMARK_STUB_LOAD_MS", 1500.0) / 4);
+    return ctx != nullptr;
+}
+
+size_t tts_synthesize(TTSContext* ctx, const char* text, float* audio_out, size_t max_samples) {
+    if (!ctx || !text || !audio_out) return 0;
+
+    // Roughly 2.5 words per second of speech
+    size_t words = 1;
+    for (const char* p = text; *p; ++p) {
+        if (*p == ' ') ++words;
+    }
+    const double seconds = words / 2.5;
+    simulate(seconds * 1000.0 * envDouble("BOOKMARK_STUB_TTS_RTF", 0.25));
+
+    const size_t samples = std::min(max_samples, static_cast<size_t>(seconds * 22050));
+    std::fill(audio_out, audio_out + samples, 0.0f);
+    return samples;
+}
+
+int tts_get_sample_rate(TTSContext*) {
+    return 22050;
+}
+
+} // extern "C"
+} // namespace tts
+
+} // namespace bookmark
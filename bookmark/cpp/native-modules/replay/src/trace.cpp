@@ -0,0 +1,100 @@
+#include "trace.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace bookmark {
+namespace replay {
+
+namespace {
+
+std::string directoryOf(const std::string& path) {
+    const size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? "." : path.substr(0, slash);
+}
+
+std::string trim(const std::string& value) {
+    const size_t start = value.find_first_not_of(" \t\r");
+    if (start == std::string::npos) return "";
+    const size_t end = value.find_last_not_of(" \t\r");
+    return value.substr(start, end - start + 1);
+}
+
+bool parseType(const std::string& name, TraceEventType& type) {
+    if (name == "book") type = TraceEventType::Book;
+    else if (name == "ask") type = TraceEventType::Ask;
+    else if (name == "voice") type = TraceEventType::Voice;
+    else if (name == "note") type = TraceEventType::Note;
+    else if (name == "summary") type = TraceEventType::Summary;
+    else return false;
+    return true;
+}
+
+} // namespace
+
+bool parseTrace(const std::string& path, std::vector<TraceEvent>& events, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open trace " + path;
+        return false;
+    }
+
+    const std::string base = directoryOf(path);
+    std::string raw;
+    int line_number = 0;
+    double last_at = 0.0;
+
+    while (std::getline(in, raw)) {
+        ++line_number;
+        const std::string line = trim(raw);
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        TraceEvent event;
+        std::string type_name;
+        if (!(fields >> event.at_ms >> type_name) || !parseType(type_name, event.type)) {
+            error = path + ":" + std::to_string(line_number) + ": expected '<at_ms> <book|ask|voice|note|summary> ...'";
+            return false;
+        }
+        if (event.at_ms < last_at) {
+            error = path + ":" + std::to_string(line_number) + ": events must be in time order";
+            return false;
+        }
+
+        std::getline(fields, event.argument);
+        event.argument = trim(event.argument);
+        event.line = line_number;
+
+        const bool needs_argument = event.type == TraceEventType::Book ||
+                                    event.type == TraceEventType::Ask ||
+                                    event.type == TraceEventType::Voice;
+        if (needs_argument && event.argument.empty()) {
+            error = path + ":" + std::to_string(line_number) + ": " + type_name + " needs an argument";
+            return false;
+        }
+
+        const bool is_path = event.type == TraceEventType::Book ||
+                             (event.type == TraceEventType::Voice && event.argument.rfind("synthetic:", 0) != 0);
+        if (is_path && event.argument[0] != '/') {
+            event.argument = base + "/" + event.argument;
+        }
+
+        last_at = event.at_ms;
+        events.push_back(std::move(event));
+    }
+    return true;
+}
+
+const char* eventTypeName(TraceEventType type) {
+    switch (type) {
+        case TraceEventType::Book: return "book";
+        case TraceEventType::Ask: return "ask";
+        case TraceEventType::Voice: return "voice";
+        case TraceEventType::Note: return "note";
+        case TraceEventType::Summary: return "summary";
+    }
+    return "unknown";
+}
+
+} // namespace replay
+} // namespace bookmark
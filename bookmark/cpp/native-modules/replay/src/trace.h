@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace bookmark {
+namespace replay {
+
+enum class TraceEventType {
+    Book,    // ingest a book text file: chunk, embed, index
+    Ask,     // typed question: retrieve and generate
+    Voice,   // spoken question: transcribe, retrieve, generate, synthesize
+    Note,    // note extraction from the last answer
+    Summary, // summary of the conversation so far
+};
+
+struct TraceEvent {
+    double at_ms;          // offset from session start
+    TraceEventType type;
+    std::string argument;  // path, question or note text
+    int line;
+};
+
+// Session traces are plain text, one event per line:
+//
+//   # comment
+//   <at_ms> book <path>
+//   <at_ms> ask <question>
+//   <at_ms> voice <wav path | synthetic:seconds>
+//   <at_ms> note [text, defaults to the last answer]
+//   <at_ms> summary
+//
+// Relative paths are resolved against the trace file's directory. Events
+// must be in time order.
+bool parseTrace(const std::string& path, std::vector<TraceEvent>& events, std::string& error);
+
+const char* eventTypeName(TraceEventType type);
+
+} // namespace replay
+} // namespace bookmark
@@ -0,0 +1,69 @@
+#include <jni.h>
+#include <string>
+#include "residency-native.h"
+#include <android/log.h>
+
+#define LOG_TAG "ResidencyNative"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+using namespace bookmark::residency;
+
+extern "C" {
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_ResidencyModule_setBudgetNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong bytes
+) {
+    residency_set_budget(static_cast<int64_t>(bytes));
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_bookmark_ResidencyModule_getBudgetNative(
+    JNIEnv* env,
+    jobject thiz
+) {
+    return static_cast<jlong>(residency_get_budget());
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_ResidencyModule_memoryPressureNative(
+    JNIEnv* env,
+    jobject thiz,
+    jint level
+) {
+    LOGI("Memory pressure level %d", static_cast<int>(level));
+    residency_memory_pressure(static_cast<int>(level));
+}
+
+JNIEXPORT jint JNICALL
+Java_com_bookmark_ResidencyModule_prefetchNative(
+    JNIEnv* env,
+    jobject thiz,
+    jstring name
+) {
+    const char* name_str = env->GetStringUTFChars(name, nullptr);
+    size_t queued = residency_prefetch(name_str);
+    env->ReleaseStringUTFChars(name, name_str);
+    return static_cast<jint>(queued);
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_bookmark_ResidencyModule_snapshotNative(
+    JNIEnv* env,
+    jobject thiz
+) {
+    // Components can change state between the sizing call and the real one
+    std::string json(residency_snapshot_json(nullptr, 0) + 256, '\0');
+    size_t length = residency_snapshot_json(&json[0], json.size());
+    if (length == 0 || length >= json.size()) {
+        LOGE("Failed to serialize residency snapshot");
+        return nullptr;
+    }
+    json.resize(length);
+    return env->NewStringUTF(json.c_str());
+}
+
+} // extern "C"
@@ -0,0 +1,113 @@
+package com.bookmark;
+
+import android.content.ComponentCallbacks2;
+import android.content.res.Configuration;
+
+import com.facebook.react.bridge.ReactApplicationContext;
+import com.facebook.react.bridge.ReactContextBaseJavaModule;
+import com.facebook.react.bridge.ReactMethod;
+import com.facebook.react.bridge.Promise;
+
+public class ResidencyModule extends ReactContextBaseJavaModule implements ComponentCallbacks2 {
+    static {
+        System.loadLibrary("residency-native");
+    }
+
+    // Mirrors MemoryPressure in residency-native.h
+    private static final int PRESSURE_MODERATE = 1;
+    private static final int PRESSURE_CRITICAL = 2;
+
+    public ResidencyModule(ReactApplicationContext reactContext) {
+        super(reactContext);
+        reactContext.getApplicationContext().registerComponentCallbacks(this);
+    }
+
+    @Override
+    public String getName() {
+        return "ResidencyNative";
+    }
+
+    @Override
+    public void invalidate() {
+        getReactApplicationContext().getApplicationContext().unregisterComponentCallbacks(this);
+        super.invalidate();
+    }
+
+    @Override
+    public void onTrimMemory(int level) {
+        // Backgrounded and on the kill list, or foreground and the system is
+        // about to start killing: drop every idle model. Otherwise just caches.
+        if (level == TRIM_MEMORY_RUNNING_CRITICAL || level >= TRIM_MEMORY_MODERATE) {
+            memoryPressureNative(PRESSURE_CRITICAL);
+        } else {
+            memoryPressureNative(PRESSURE_MODERATE);
+        }
+    }
+
+    @Override
+    public void onLowMemory() {
+        memoryPressureNative(PRESSURE_CRITICAL);
+    }
+
+    @Override
+    public void onConfigurationChanged(Configuration newConfig) {
+    }
+
+    @ReactMethod
+    public void setBudget(double bytes, Promise promise) {
+        try {
+            setBudgetNative((long) bytes);
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_RESIDENCY", "Failed to set memory budget: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void getBudget(Promise promise) {
+        try {
+            promise.resolve((double) getBudgetNative());
+        } catch (Exception e) {
+            promise.reject("ERR_RESIDENCY", "Failed to read memory budget: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void prefetch(String name, Promise promise) {
+        try {
+            promise.resolve(prefetchNative(name));
+        } catch (Exception e) {
+            promise.reject("ERR_RESIDENCY", "Failed to prefetch " + name + ": " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void trimMemory(int level, Promise promise) {
+        try {
+            memoryPressureNative(level);
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_RESIDENCY", "Failed to trim memory: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void getSnapshot(Promise promise) {
+        try {
+            String json = snapshotNative();
+            if (json == null) {
+                throw new IllegalStateException("Snapshot unavailable");
+            }
+            promise.resolve(json);
+        } catch (Exception e) {
+            promise.reject("ERR_RESIDENCY", "Failed to read residency snapshot: " + e.getMessage());
+        }
+    }
+
+    // Native method declarations
+    private native void setBudgetNative(long bytes);
+    private native long getBudgetNative();
+    private native void memoryPressureNative(int level);
+    private native int prefetchNative(String name);
+    private native String snapshotNative();
+}
@@ -0,0 +1,92 @@
+#import "ResidencyModule.h"
+#import <React/RCTLog.h>
+#import <UIKit/UIKit.h>
+#import "residency-native.h"
+
+#include <string>
+
+using namespace bookmark::residency;
+
+@implementation ResidencyModule
+
+RCT_EXPORT_MODULE(ResidencyNative)
+
++ (BOOL)requiresMainQueueSetup {
+    return NO;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        NSNotificationCenter* center = [NSNotificationCenter defaultCenter];
+        [center addObserver:self
+                   selector:@selector(didReceiveMemoryWarning)
+                       name:UIApplicationDidReceiveMemoryWarningNotification
+                     object:nil];
+        [center addObserver:self
+                   selector:@selector(didEnterBackground)
+                       name:UIApplicationDidEnterBackgroundNotification
+                     object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)didReceiveMemoryWarning {
+    RCTLogInfo(@"Memory warning, evicting idle models");
+    residency_memory_pressure(PRESSURE_CRITICAL);
+}
+
+- (void)didEnterBackground {
+    // Jetsam targets large background apps first; shed caches while we can
+    residency_memory_pressure(PRESSURE_MODERATE);
+}
+
+RCT_EXPORT_METHOD(setBudget:(double)bytes
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    residency_set_budget(static_cast<int64_t>(bytes));
+    resolve(nil);
+}
+
+RCT_EXPORT_METHOD(getBudget:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    resolve(@(static_cast<double>(residency_get_budget())));
+}
+
+RCT_EXPORT_METHOD(prefetch:(NSString*)name
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        resolve(@(residency_prefetch([name UTF8String])));
+    } @catch (NSException* e) {
+        reject(@"ERR_RESIDENCY", @"Failed to prefetch component", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(trimMemory:(int)level
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    residency_memory_pressure(level);
+    resolve(nil);
+}
+
+RCT_EXPORT_METHOD(getSnapshot:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        // Components can change state between the sizing call and the real one
+        std::string json(residency_snapshot_json(nullptr, 0) + 256, '\0');
+        size_t length = residency_snapshot_json(&json[0], json.size());
+        if (length == 0 || length >= json.size()) {
+            reject(@"ERR_RESIDENCY", @"Failed to serialize residency snapshot", nil);
+            return;
+        }
+        resolve([[NSString alloc] initWithBytes:json.data() length:length encoding:NSUTF8StringEncoding]);
+    } @catch (NSException* e) {
+        reject(@"ERR_RESIDENCY", @"Failed to read residency snapshot", nil);
+    }
+}
+
+@end
@@ -0,0 +1,440 @@
+#include "residency-native.h"
+#include "scheduler-native.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+namespace bookmark {
+namespace residency {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// A use counts as following another when it comes within this window
+constexpr auto kSuccessorWindow = std::chrono::seconds(30);
+// Prefetch a successor once it has followed at least this many times and
+// in at least half of all observed transitions
+constexpr uint32_t kMinTransitions = 3;
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now().time_since_epoch()).count();
+}
+
+int64_t physicalMemoryBytes() {
+#if defined(__APPLE__)
+    uint64_t bytes = 0;
+    size_t size = sizeof(bytes);
+    if (sysctlbyname("hw.memsize", &bytes, &size, nullptr, 0) != 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(bytes);
+#else
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGESIZE);
+    return pages > 0 && page_size > 0 ? static_cast<int64_t>(pages) * page_size : 0;
+#endif
+}
+
+// Foreground apps on both platforms start getting killed well before they
+// reach physical RAM; 60% leaves room for the JS runtime and the UI
+int64_t defaultBudget() {
+    int64_t physical = physicalMemoryBytes();
+    return physical > 0 ? physical / 10 * 6 : INT64_MAX;
+}
+
+const char* stateName(State state) {
+    switch (state) {
+        case State::Resident: return "resident";
+        case State::Trimmed: return "trimmed";
+        case State::Evicted: return "evicted";
+    }
+    return "unknown";
+}
+
+std::string transitionKey(const std::string& from, const std::string& to) {
+    return from + '\n' + to;
+}
+
+} // namespace
+
+struct Component {
+    ComponentId id;
+    std::string name;
+    int priority;
+    ComponentCallbacks callbacks;
+
+    // Serializes load, unload and trim. Eviction only ever try_locks it, so
+    // a component that is busy loading is simply skipped.
+    std::mutex mutex;
+    bool alive = true;
+
+    std::atomic<int64_t> bytes;
+    std::atomic<int64_t> trimmed_bytes{0};
+    std::atomic<State> state{State::Resident};
+    std::atomic<int> pins{0};
+    std::atomic<int64_t> last_used_ms;
+    std::atomic<bool> prefetching{false};
+    std::atomic<uint32_t> evictions{0};
+    std::atomic<uint32_t> reloads{0};
+    std::atomic<uint32_t> trims{0};
+
+    int64_t residentBytes() const {
+        switch (state.load(std::memory_order_relaxed)) {
+            case State::Resident: return bytes.load(std::memory_order_relaxed);
+            case State::Trimmed:
+                return std::max<int64_t>(0, bytes.load(std::memory_order_relaxed) -
+                                                trimmed_bytes.load(std::memory_order_relaxed));
+            case State::Evicted: return 0;
+        }
+        return 0;
+    }
+};
+
+ResidencyManager& ResidencyManager::instance() {
+    // Never destroyed: components may unregister during static destruction
+    static ResidencyManager* manager = new ResidencyManager();
+    return *manager;
+}
+
+ResidencyManager::ResidencyManager() : budget_(defaultBudget()) {}
+
+ComponentId ResidencyManager::registerComponent(const std::string& name,
+                                                int priority,
+                                                int64_t bytes,
+                                                ComponentCallbacks callbacks) {
+    auto component = std::make_shared<Component>();
+    component->name = name;
+    component->priority = priority;
+    component->callbacks = std::move(callbacks);
+    component->bytes = std::max<int64_t>(bytes, 0);
+    component->last_used_ms = nowMs();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    component->id = next_id_++;
+    components_[component->id] = component;
+
+    // The new component was just loaded for a reason, make room around it
+    shrinkLocked(budget(), component->id, true);
+    return component->id;
+}
+
+void ResidencyManager::unregisterComponent(ComponentId id) {
+    std::shared_ptr<Component> component;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = components_.find(id);
+        if (it == components_.end()) return;
+        component = it->second;
+        components_.erase(it);
+    }
+
+    // Wait out a load or prefetch still running on another thread; after
+    // this the callbacks are never invoked again
+    std::lock_guard<std::mutex> lock(component->mutex);
+    component->alive = false;
+}
+
+void ResidencyManager::updateFootprint(ComponentId id, int64_t bytes) {
+    auto component = find(id);
+    if (!component) return;
+    component->bytes = std::max<int64_t>(bytes, 0);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    shrinkLocked(budget(), id, true);
+}
+
+std::shared_ptr<Component> ResidencyManager::find(ComponentId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = components_.find(id);
+    return it == components_.end() ? nullptr : it->second;
+}
+
+bool ResidencyManager::acquire(ComponentId id) {
+    auto component = find(id);
+    if (!component) return false;
+
+    {
+        std::unique_lock<std::mutex> lock(component->mutex);
+        if (!component->alive) return false;
+
+        // Pinned before anything else so concurrent eviction passes skip it
+        component->pins.fetch_add(1);
+
+        if (component->state == State::Evicted) {
+            {
+                std::lock_guard<std::mutex> manager_lock(mutex_);
+                shrinkLocked(budget() - component->bytes.load(), id, true);
+            }
+
+            bool loaded = false;
+            try {
+                loaded = component->callbacks.load && component->callbacks.load();
+            } catch (...) {
+                loaded = false;
+            }
+            if (!loaded) {
+                component->pins.fetch_sub(1);
+                return false;
+            }
+            component->reloads.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Trimmed caches refill as soon as the component is used again
+        component->trimmed_bytes = 0;
+        component->state = State::Resident;
+        component->last_used_ms = nowMs();
+    }
+
+    recordUse(id);
+    return true;
+}
+
+void ResidencyManager::release(ComponentId id) {
+    auto component = find(id);
+    if (!component) return;
+
+    component->last_used_ms = nowMs();
+    component->pins.fetch_sub(1);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    shrinkLocked(budget(), 0, true);
+}
+
+size_t ResidencyManager::prefetch(const std::string& name) {
+    std::vector<std::shared_ptr<Component>> targets;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& entry : components_) {
+            if (entry.second->name == name && entry.second->state == State::Evicted) {
+                targets.push_back(entry.second);
+            }
+        }
+    }
+
+    for (const auto& component : targets) {
+        prefetchComponent(component);
+    }
+    return targets.size();
+}
+
+void ResidencyManager::prefetchComponent(const std::shared_ptr<Component>& component) {
+    if (component->prefetching.exchange(true)) return;
+
+    // Loading a model takes seconds; never do it on the caller's thread,
+    // and never ahead of work the user is waiting on
+    scheduler::Scheduler::instance().post(scheduler::QoS::Background, [this, component]() {
+        if (component->state == State::Evicted && acquire(component->id)) {
+            release(component->id);
+        }
+        component->prefetching = false;
+    });
+}
+
+void ResidencyManager::recordUse(ComponentId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = components_.find(id);
+    if (it == components_.end()) return;
+    const std::string& name = it->second->name;
+
+    // Prefetches are not user activity and must not teach the predictor
+    if (it->second->prefetching) return;
+
+    auto now = Clock::now();
+    if (last_used_ != 0 && last_used_ != id && now - last_used_at_ < kSuccessorWindow) {
+        auto previous = components_.find(last_used_);
+        if (previous != components_.end() && previous->second->name != name) {
+            transitions_[transitionKey(previous->second->name, name)]++;
+            transitions_from_[previous->second->name]++;
+        }
+    }
+    last_used_ = id;
+    last_used_at_ = now;
+
+    // Predict what comes next and warm it up if it fits without evicting
+    uint32_t total = transitions_from_[name];
+    if (total < kMinTransitions) return;
+
+    int64_t resident = residentBytesLocked();
+    for (const auto& entry : components_) {
+        const auto& candidate = entry.second;
+        if (candidate->name == name || candidate->state != State::Evicted) continue;
+
+        auto transition = transitions_.find(transitionKey(name, candidate->name));
+        if (transition == transitions_.end()) continue;
+        uint32_t count = transition->second;
+        if (count >= kMinTransitions && count * 2 >= total &&
+            resident + candidate->bytes.load() <= budget()) {
+            prefetchComponent(candidate);
+            resident += candidate->bytes.load();
+        }
+    }
+}
+
+void ResidencyManager::setBudget(int64_t bytes) {
+    budget_ = bytes > 0 ? bytes : defaultBudget();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    shrinkLocked(budget(), 0, true);
+}
+
+int64_t ResidencyManager::residentBytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return residentBytesLocked();
+}
+
+int64_t ResidencyManager::residentBytesLocked() const {
+    int64_t total = 0;
+    for (const auto& entry : components_) {
+        total += entry.second->residentBytes();
+    }
+    return total;
+}
+
+void ResidencyManager::onMemoryPressure(int level) {
+    if (level <= PRESSURE_NONE) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    shrinkLocked(0, 0, level >= PRESSURE_CRITICAL);
+}
+
+void ResidencyManager::shrinkLocked(int64_t target, ComponentId keep, bool evict) {
+    int64_t resident = residentBytesLocked();
+    if (resident <= target) return;
+
+    std::vector<std::shared_ptr<Component>> candidates;
+    for (const auto& entry : components_) {
+        const auto& component = entry.second;
+        if (component->id != keep && component->pins.load() == 0 && component->state != State::Evicted) {
+            candidates.push_back(component);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        if (a->priority != b->priority) return a->priority < b->priority;
+        return a->last_used_ms.load() < b->last_used_ms.load();
+    });
+
+    // Cheap first: drop caches, which come back on their own
+    for (const auto& component : candidates) {
+        if (resident <= target) return;
+        if (!component->callbacks.trim || component->state != State::Resident) continue;
+
+        std::unique_lock<std::mutex> lock(component->mutex, std::try_to_lock);
+        if (!lock.owns_lock() || !component->alive || component->pins.load() != 0) continue;
+
+        int64_t freed = 0;
+        try {
+            freed = component->callbacks.trim();
+        } catch (...) {
+            continue;
+        }
+        freed = std::min(std::max<int64_t>(freed, 0), component->bytes.load());
+        component->trimmed_bytes = freed;
+        component->state = State::Trimmed;
+        component->trims.fetch_add(1, std::memory_order_relaxed);
+        resident -= freed;
+    }
+
+    if (!evict) return;
+
+    for (const auto& component : candidates) {
+        if (resident <= target) return;
+        if (!component->callbacks.unload) continue;
+
+        std::unique_lock<std::mutex> lock(component->mutex, std::try_to_lock);
+        if (!lock.owns_lock() || !component->alive || component->pins.load() != 0 ||
+            component->state == State::Evicted) {
+            continue;
+        }
+
+        int64_t held = component->residentBytes();
+        bool unloaded = false;
+        try {
+            unloaded = component->callbacks.unload();
+        } catch (...) {
+            unloaded = false;
+        }
+        if (!unloaded) continue;
+
+        component->state = State::Evicted;
+        component->trimmed_bytes = 0;
+        component->evictions.fetch_add(1, std::memory_order_relaxed);
+        resident -= held;
+    }
+}
+
+std::string ResidencyManager::snapshotJson() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<std::shared_ptr<Component>> components;
+    for (const auto& entry : components_) {
+        components.push_back(entry.second);
+    }
+    std::sort(components.begin(), components.end(), [](const auto& a, const auto& b) {
+        return a->id < b->id;
+    });
+
+    char buffer[512];
+    std::string json;
+    snprintf(buffer, sizeof(buffer), "{\"budget_bytes\":%lld,\"resident_bytes\":%lld,\"components\":[",
+             static_cast<long long>(budget()), static_cast<long long>(residentBytesLocked()));
+    json += buffer;
+
+    int64_t now = nowMs();
+    for (size_t i = 0; i < components.size(); ++i) {
+        const auto& c = components[i];
+        snprintf(buffer, sizeof(buffer),
+                 "%s{\"name\":\"%s\",\"state\":\"%s\",\"priority\":%d,\"bytes\":%lld,\"resident_bytes\":%lld,"
+                 "\"pins\":%d,\"idle_ms\":%lld,\"evictions\":%u,\"reloads\":%u,\"trims\":%u}",
+                 i ? "," : "", c->name.c_str(), stateName(c->state.load()), c->priority,
+                 static_cast<long long>(c->bytes.load()), static_cast<long long>(c->residentBytes()),
+                 c->pins.load(), static_cast<long long>(c->pins.load() ? 0 : now - c->last_used_ms.load()),
+                 c->evictions.load(), c->reloads.load(), c->trims.load());
+        json += buffer;
+    }
+    json += "]}";
+    return json;
+}
+
+// C API Implementation
+extern "C" {
+
+void residency_set_budget(int64_t bytes) {
+    ResidencyManager::instance().setBudget(bytes);
+}
+
+int64_t residency_get_budget() {
+    return ResidencyManager::instance().budget();
+}
+
+int64_t residency_get_resident_bytes() {
+    return ResidencyManager::instance().residentBytes();
+}
+
+void residency_memory_pressure(int level) {
+    ResidencyManager::instance().onMemoryPressure(level);
+}
+
+size_t residency_prefetch(const char* name) {
+    if (!name) return 0;
+    return ResidencyManager::instance().prefetch(name);
+}
+
+size_t residency_snapshot_json(char* json_out, size_t json_size) {
+    std::string json = ResidencyManager::instance().snapshotJson();
+    if (json_out && json.size() < json_size) {
+        memcpy(json_out, json.c_str(), json.size() + 1);
+    }
+    return json.size();
+}
+
+} // extern "C"
+
+} // namespace residency
+} // namespace bookmark
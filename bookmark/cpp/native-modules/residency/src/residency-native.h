@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bookmark {
+namespace residency {
+
+// Lower priorities are trimmed and evicted first
+enum Priority : int {
+    PRIORITY_TTS = 10,
+    PRIORITY_INDEX = 20,
+    PRIORITY_WHISPER = 30,
+    PRIORITY_LLM = 40,
+};
+
+enum MemoryPressure : int {
+    PRESSURE_NONE = 0,
+    PRESSURE_MODERATE = 1, // drop caches of idle components
+    PRESSURE_CRITICAL = 2, // also evict every idle component
+};
+
+enum class State : int {
+    Resident,
+    Trimmed,
+    Evicted,
+};
+
+struct ComponentCallbacks {
+    // Brings an evicted component back; false if it could not be reloaded
+    std::function<bool()> load;
+    // Releases the component's memory; false if it can't be dropped right
+    // now (e.g. unsaved changes). Leave empty for components that must stay.
+    std::function<bool()> unload;
+    // Optional: frees caches and scratch buffers, returning the bytes released
+    std::function<int64_t()> trim;
+};
+
+struct Component;
+using ComponentId = uint32_t;
+
+// Process-wide registry of the memory-heavy parts of the native modules.
+// Components register their footprint once loaded and take a Lease around
+// every use. When the resident total exceeds the budget, or the OS reports
+// memory pressure, idle (unleased) components are trimmed and then evicted,
+// lowest priority and least recently used first. An evicted component is
+// reloaded by the next Lease, and prefetched in the background when it
+// usually follows a component that was just used (e.g. the LLM after
+// Whisper in a voice turn) and fits in the budget without evicting.
+class ResidencyManager {
+public:
+    static ResidencyManager& instance();
+
+    ComponentId registerComponent(const std::string& name, int priority, int64_t bytes, ComponentCallbacks callbacks);
+    // Blocks until any in-flight load or eviction of the component finishes
+    void unregisterComponent(ComponentId id);
+    void updateFootprint(ComponentId id, int64_t bytes);
+
+    // Reloads the component if needed and pins it; false if it couldn't be loaded
+    bool acquire(ComponentId id);
+    void release(ComponentId id);
+
+    // Loads every evicted component with this name in the background,
+    // making room the same way acquire() does. Returns how many were queued.
+    size_t prefetch(const std::string& name);
+
+    void setBudget(int64_t bytes);
+    int64_t budget() const { return budget_.load(std::memory_order_relaxed); }
+    int64_t residentBytes();
+
+    void onMemoryPressure(int level);
+
+    std::string snapshotJson();
+
+private:
+    ResidencyManager();
+
+    std::shared_ptr<Component> find(ComponentId id);
+    int64_t residentBytesLocked() const;
+    // Trims, then evicts, idle components other than keep until the
+    // resident total is at most target
+    void shrinkLocked(int64_t target, ComponentId keep, bool evict);
+    void recordUse(ComponentId id);
+    void prefetchComponent(const std::shared_ptr<Component>& component);
+
+    std::mutex mutex_;
+    std::unordered_map<ComponentId, std::shared_ptr<Component>> components_;
+    ComponentId next_id_ = 1;
+    std::atomic<int64_t> budget_;
+
+    // Successor statistics for predictive prefetch, keyed by component name
+    // so they survive a component being destroyed and re-created
+    ComponentId last_used_ = 0;
+    std::chrono::steady_clock::time_point last_used_at_;
+    std::unordered_map<std::string, uint32_t> transitions_;      // "from\nto"
+    std::unordered_map<std::string, uint32_t> transitions_from_;
+};
+
+// Pins a component for the lifetime of the lease, reloading it first if it
+// was evicted. A lease on id 0 (unregistered component) is always valid.
+class Lease {
+public:
+    explicit Lease(ComponentId id) : id_(id) {
+        ok_ = id_ == 0 || ResidencyManager::instance().acquire(id_);
+    }
+    ~Lease() {
+        if (id_ != 0 && ok_) ResidencyManager::instance().release(id_);
+    }
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+    explicit operator bool() const { return ok_; }
+
+private:
+    ComponentId id_;
+    bool ok_;
+};
+
+// React Native binding interface
+extern "C" {
+    void residency_set_budget(int64_t bytes);
+    int64_t residency_get_budget();
+    int64_t residency_get_resident_bytes();
+    void residency_memory_pressure(int level);
+    size_t residency_prefetch(const char* name);
+    // Same sizing contract as bookmark_metrics_snapshot_json
+    size_t residency_snapshot_json(char* json_out, size_t json_size);
+}
+
+} // namespace residency
+} // namespace bookmark
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <jni.h>
+#include "scheduler-native.h"
+
+namespace bookmark {
+namespace scheduler {
+
+// Bridges a module's *_async call to a com.bookmark.NativeRequestListener.
+//
+//   auto* listener = RequestListener::create(env, java_listener);
+//   Request* request = whisper_transcribe_async(..., RequestListener::onComplete, listener);
+//   return RequestListener::submitted(env, listener, request);
+//
+// The listener owns the request from then on and releases it once the Java
+// side has the results.
+class RequestListener {
+public:
+    static RequestListener* create(JNIEnv* env, jobject listener) {
+        if (!listener) return nullptr;
+        auto* self = new RequestListener();
+        env->GetJavaVM(&self->vm_);
+        self->listener_ = env->NewGlobalRef(listener);
+        return self;
+    }
+
+    // A RequestCallback; runs on the worker that completed the request
+    static void onComplete(Request* request, void* user_data) {
+        auto* self = static_cast<RequestListener*>(user_data);
+        JNIEnv* env = envForCurrentThread(self->vm_);
+        if (env) {
+            if (request->succeeded()) {
+                self->deliver(env, request->text.empty() ? nullptr : request->text.c_str(),
+                              request->floats.data(), request->floats.size(),
+                              request->ints.data(), request->ints.size(), nullptr);
+            } else {
+                self->deliver(env, nullptr, nullptr, 0, nullptr, 0, request->error().c_str());
+            }
+            env->DeleteGlobalRef(self->listener_);
+        }
+        request->release();
+        delete self;
+    }
+
+    // Completes the listener with an error when the call was rejected
+    // up front, and returns whether the request was submitted
+    static jboolean submitted(JNIEnv* env, RequestListener* self, Request* request) {
+        if (request) return true;
+        if (self) {
+            self->deliver(env, nullptr, nullptr, 0, nullptr, 0, "Invalid arguments");
+            env->DeleteGlobalRef(self->listener_);
+            delete self;
+        }
+        return false;
+    }
+
+private:
+    RequestListener() = default;
+
+    // Detaches pool workers from the VM when they exit
+    struct ThreadAttachment {
+        JavaVM* vm = nullptr;
+        ~ThreadAttachment() {
+            if (vm) vm->DetachCurrentThread();
+        }
+    };
+
+    static JNIEnv* envForCurrentThread(JavaVM* vm) {
+        thread_local ThreadAttachment attachment;
+        JNIEnv* env = nullptr;
+        if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) == JNI_OK) {
+            return env;
+        }
+        if (vm->AttachCurrentThread(reinterpret_cast<void**>(&env), nullptr) != JNI_OK) {
+            return nullptr;
+        }
+        attachment.vm = vm;
+        return env;
+    }
+
+    void deliver(JNIEnv* env,
+                 const char* text,
+                 const float* floats, size_t float_count,
+                 const int* ints, size_t int_count,
+                 const char* error) {
+        jstring j_text = text ? env->NewStringUTF(text) : nullptr;
+        jstring j_error = error ? env->NewStringUTF(error) : nullptr;
+
+        jfloatArray j_floats = nullptr;
+        if (float_count > 0) {
+            j_floats = env->NewFloatArray(static_cast<jsize>(float_count));
+            env->SetFloatArrayRegion(j_floats, 0, static_cast<jsize>(float_count), floats);
+        }
+        jintArray j_ints = nullptr;
+        if (int_count > 0) {
+            j_ints = env->NewIntArray(static_cast<jsize>(int_count));
+            env->SetIntArrayRegion(j_ints, 0, static_cast<jsize>(int_count), reinterpret_cast<const jint*>(ints));
+        }
+
+        jclass cls = env->GetObjectClass(listener_);
+        jmethodID on_complete = env->GetMethodID(
+            cls, "onComplete", "(Ljava/lang/String;[F[ILjava/lang/String;)V");
+        if (on_complete) {
+            env->CallVoidMethod(listener_, on_complete, j_text, j_floats, j_ints, j_error);
+        }
+        if (env->ExceptionCheck()) {
+            env->ExceptionClear();
+        }
+
+        env->DeleteLocalRef(cls);
+        if (j_text) env->DeleteLocalRef(j_text);
+        if (j_error) env->DeleteLocalRef(j_error);
+        if (j_floats) env->DeleteLocalRef(j_floats);
+        if (j_ints) env->DeleteLocalRef(j_ints);
+    }
+
+    JavaVM* vm_ = nullptr;
+    jobject listener_ = nullptr;
+};
+
+} // namespace scheduler
+} // namespace bookmark
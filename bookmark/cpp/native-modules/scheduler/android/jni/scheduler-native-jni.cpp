@@ -0,0 +1,60 @@
+#include <jni.h>
+#include <string>
+#include "scheduler-native.h"
+#include <android/log.h>
+
+#define LOG_TAG "SchedulerNative"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+using namespace bookmark::scheduler;
+
+extern "C" {
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_SchedulerModule_setMaxThreadsNative(
+    JNIEnv* env,
+    jobject thiz,
+    jint threads
+) {
+    scheduler_set_max_threads(static_cast<int>(threads));
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_SchedulerModule_setBackgroundLimitNative(
+    JNIEnv* env,
+    jobject thiz,
+    jint threads
+) {
+    scheduler_set_background_limit(static_cast<int>(threads));
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_com_bookmark_SchedulerModule_getStatsNative(
+    JNIEnv* env,
+    jobject thiz
+) {
+    SchedulerStats stats;
+    if (!scheduler_get_stats(&stats)) {
+        LOGE("Failed to read scheduler stats");
+        return nullptr;
+    }
+
+    CpuTopology topology = Scheduler::instance().topology();
+    jlong values[9] = {
+        stats.max_threads,
+        stats.background_limit,
+        stats.active_interactive,
+        stats.active_background,
+        static_cast<jlong>(stats.tasks_run),
+        static_cast<jlong>(stats.tasks_stolen),
+        static_cast<jlong>(stats.background_deferred),
+        topology.big_cores,
+        topology.little_cores
+    };
+    jlongArray result = env->NewLongArray(9);
+    env->SetLongArrayRegion(result, 0, 9, values);
+    return result;
+}
+
+} // extern "C"
@@ -0,0 +1,9 @@
+package com.bookmark;
+
+// Completion of an async native call, handed over by
+// scheduler/android/jni/request-jni.h. Called once, on the native worker
+// that ran the call. error is null on success; each call documents which of
+// text, floats and ints it fills in, and the others are null.
+public interface NativeRequestListener {
+    void onComplete(String text, float[] floats, int[] ints, String error);
+}
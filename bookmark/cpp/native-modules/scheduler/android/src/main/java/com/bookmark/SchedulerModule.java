@@ -0,0 +1,73 @@
+package com.bookmark;
+
+import com.facebook.react.bridge.Arguments;
+import com.facebook.react.bridge.ReactApplicationContext;
+import com.facebook.react.bridge.ReactContextBaseJavaModule;
+import com.facebook.react.bridge.ReactMethod;
+import com.facebook.react.bridge.Promise;
+import com.facebook.react.bridge.WritableMap;
+
+public class SchedulerModule extends ReactContextBaseJavaModule {
+    static {
+        System.loadLibrary("scheduler-native");
+    }
+
+    public SchedulerModule(ReactApplicationContext reactContext) {
+        super(reactContext);
+    }
+
+    @Override
+    public String getName() {
+        return "SchedulerNative";
+    }
+
+    @ReactMethod
+    public void setMaxThreads(int threads, Promise promise) {
+        try {
+            setMaxThreadsNative(threads);
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_SCHEDULER", "Failed to set thread cap: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void setBackgroundLimit(int threads, Promise promise) {
+        try {
+            setBackgroundLimitNative(threads);
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_SCHEDULER", "Failed to set background limit: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void getStats(Promise promise) {
+        try {
+            long[] values = getStatsNative();
+            if (values == null) {
+                throw new IllegalStateException("Stats unavailable");
+            }
+
+            // Same order as getStatsNative in scheduler-native-jni.cpp
+            WritableMap stats = Arguments.createMap();
+            stats.putInt("maxThreads", (int) values[0]);
+            stats.putInt("backgroundLimit", (int) values[1]);
+            stats.putInt("activeInteractive", (int) values[2]);
+            stats.putInt("activeBackground", (int) values[3]);
+            stats.putDouble("tasksRun", values[4]);
+            stats.putDouble("tasksStolen", values[5]);
+            stats.putDouble("backgroundDeferred", values[6]);
+            stats.putInt("bigCores", (int) values[7]);
+            stats.putInt("littleCores", (int) values[8]);
+            promise.resolve(stats);
+        } catch (Exception e) {
+            promise.reject("ERR_SCHEDULER", "Failed to read scheduler stats: " + e.getMessage());
+        }
+    }
+
+    // Native method declarations
+    private native void setMaxThreadsNative(int threads);
+    private native void setBackgroundLimitNative(int threads);
+    private native long[] getStatsNative();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#import <Foundation/Foundation.h>
+#include "scheduler-native.h"
+
+// Bridges a module's *_async call to a block, which runs once on the
+// worker that completed the request:
+//
+//   void* done = NativeRequestRetain(^(bookmark::scheduler::Request* request) { ... });
+//   if (!whisper_transcribe_async(..., NativeRequestComplete, done)) {
+//       NativeRequestDiscard(done);
+//   }
+//
+// The request is released after the block returns.
+typedef void (^NativeRequestBlock)(bookmark::scheduler::Request* request);
+
+static inline void* NativeRequestRetain(NativeRequestBlock block) {
+    return (__bridge_retained void*)[block copy];
+}
+
+static inline void NativeRequestComplete(bookmark::scheduler::Request* request, void* user_data) {
+    NativeRequestBlock block = (__bridge_transfer NativeRequestBlock)user_data;
+    block(request);
+    request->release();
+}
+
+// For when the call was rejected and the block will never run
+static inline void NativeRequestDiscard(void* user_data) {
+    NativeRequestBlock block = (__bridge_transfer NativeRequestBlock)user_data;
+    (void)block;
+}
@@ -0,0 +1,4 @@
+#import <React/RCTBridgeModule.h>
+
+@interface SchedulerModule : NSObject <RCTBridgeModule>
+@end
@@ -0,0 +1,51 @@
+#import "SchedulerModule.h"
+#import <React/RCTLog.h>
+#import "scheduler-native.h"
+
+using namespace bookmark::scheduler;
+
+@implementation SchedulerModule
+
+RCT_EXPORT_MODULE(SchedulerNative)
+
+RCT_EXPORT_METHOD(setMaxThreads:(int)threads
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    scheduler_set_max_threads(threads);
+    resolve(nil);
+}
+
+RCT_EXPORT_METHOD(setBackgroundLimit:(int)threads
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    scheduler_set_background_limit(threads);
+    resolve(nil);
+}
+
+RCT_EXPORT_METHOD(getStats:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        SchedulerStats stats;
+        if (!scheduler_get_stats(&stats)) {
+            reject(@"ERR_SCHEDULER", @"Scheduler stats unavailable", nil);
+            return;
+        }
+
+        CpuTopology topology = Scheduler::instance().topology();
+        resolve(@{
+            @"maxThreads": @(stats.max_threads),
+            @"backgroundLimit": @(stats.background_limit),
+            @"activeInteractive": @(stats.active_interactive),
+            @"activeBackground": @(stats.active_background),
+            @"tasksRun": @(stats.tasks_run),
+            @"tasksStolen": @(stats.tasks_stolen),
+            @"backgroundDeferred": @(stats.background_deferred),
+            @"bigCores": @(topology.big_cores),
+            @"littleCores": @(topology.little_cores)
+        });
+    } @catch (NSException* e) {
+        reject(@"ERR_SCHEDULER", @"Failed to read scheduler stats", nil);
+    }
+}
+
+@end
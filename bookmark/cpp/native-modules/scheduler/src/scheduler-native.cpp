@@ -0,0 +1,702 @@
+#include "scheduler-native.h"
+#include "metrics-native.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <unordered_map>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <pthread.h>
+#include <sys/qos.h>
+#include <sys/sysctl.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace bookmark {
+namespace scheduler {
+
+namespace {
+
+// QoS of the task or scope the thread is in, -1 outside of both
+thread_local int tl_qos = -1;
+// Core placement last applied to the thread, -1 if we never moved it
+thread_local int tl_placed = -1;
+// Slots held by this thread through running tasks or reservations. Work a
+// thread does while it already holds one doesn't need another.
+thread_local int tl_holds = 0;
+thread_local Worker* tl_worker = nullptr;
+
+int interactiveOf(uint64_t active) { return static_cast<int>(active & 0xffffffffu); }
+int backgroundOf(uint64_t active) { return static_cast<int>(active >> 32); }
+uint64_t slotsOf(QoS qos, int slots) {
+    return qos == QoS::Interactive ? static_cast<uint64_t>(slots) : static_cast<uint64_t>(slots) << 32;
+}
+
+struct Clusters {
+    std::vector<int> big;    // every core outside the slowest cluster
+    std::vector<int> little; // the slowest cluster, empty on homogeneous CPUs
+};
+
+#if defined(__linux__) && !defined(__APPLE__)
+long readCpuValue(int cpu, const char* file) {
+    char path[96];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/%s", cpu, file);
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+    long value = -1;
+    if (fscanf(f, "%ld", &value) != 1) value = -1;
+    fclose(f);
+    return value;
+}
+#endif
+
+// Android kernels publish each core's relative capacity; plain Linux usually
+// only has the cpufreq limits, which rank the clusters the same way
+Clusters detectClusters() {
+    Clusters clusters;
+    long count = sysconf(_SC_NPROCESSORS_CONF);
+    if (count <= 0) count = std::max(1u, std::thread::hardware_concurrency());
+
+#if defined(__linux__) && !defined(__APPLE__)
+    std::vector<long> capacity(count);
+    for (int cpu = 0; cpu < count; ++cpu) {
+        capacity[cpu] = readCpuValue(cpu, "cpu_capacity");
+        if (capacity[cpu] <= 0) capacity[cpu] = readCpuValue(cpu, "cpufreq/cpuinfo_max_freq");
+    }
+    long lowest = *std::min_element(capacity.begin(), capacity.end());
+    long highest = *std::max_element(capacity.begin(), capacity.end());
+    for (int cpu = 0; cpu < count; ++cpu) {
+        if (lowest > 0 && lowest != highest && capacity[cpu] == lowest) {
+            clusters.little.push_back(cpu);
+        } else {
+            clusters.big.push_back(cpu);
+        }
+    }
+#else
+    // Apple doesn't expose core ids; only the counts matter for the budget,
+    // and placement goes through the thread's QoS class instead
+    int performance = 0;
+    int efficiency = 0;
+#if defined(__APPLE__)
+    size_t size = sizeof(int);
+    if (sysctlbyname("hw.perflevel0.logicalcpu", &performance, &size, nullptr, 0) != 0) performance = 0;
+    size = sizeof(int);
+    if (sysctlbyname("hw.perflevel1.logicalcpu", &efficiency, &size, nullptr, 0) != 0) efficiency = 0;
+#endif
+    if (performance <= 0) {
+        performance = static_cast<int>(count);
+        efficiency = 0;
+    }
+    for (int cpu = 0; cpu < performance; ++cpu) clusters.big.push_back(cpu);
+    for (int cpu = 0; cpu < efficiency; ++cpu) clusters.little.push_back(performance + cpu);
+#endif
+    return clusters;
+}
+
+const Clusters& clusters() {
+    static const Clusters detected = detectClusters();
+    return detected;
+}
+
+// Moves the calling thread to the cores for a QoS class, or back to where
+// it started for -1. Threads created afterwards inherit the placement.
+void place(int qos) {
+    if (qos == tl_placed) return;
+    const Clusters& c = clusters();
+    if (c.little.empty()) {
+        tl_placed = qos;
+        return;
+    }
+
+#if defined(__APPLE__)
+    static thread_local qos_class_t original = QOS_CLASS_UNSPECIFIED;
+    static thread_local bool saved = false;
+    if (!saved) {
+        original = qos_class_self();
+        saved = true;
+    }
+    qos_class_t target = original;
+    if (qos == static_cast<int>(QoS::Interactive)) target = QOS_CLASS_USER_INITIATED;
+    if (qos == static_cast<int>(QoS::Background)) target = QOS_CLASS_UTILITY;
+    pthread_set_qos_class_self_np(target, 0);
+#elif defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (qos != static_cast<int>(QoS::Background)) {
+        for (int cpu : c.big) CPU_SET(cpu, &mask);
+    }
+    if (qos != static_cast<int>(QoS::Interactive)) {
+        for (int cpu : c.little) CPU_SET(cpu, &mask);
+    }
+    // Best effort: a cgroup or a hotplugged-off core can make this fail
+    sched_setaffinity(0, sizeof(mask), &mask);
+#endif
+    tl_placed = qos;
+}
+
+} // namespace
+
+struct Worker {
+    std::mutex mutex; // guards tasks
+    std::deque<Task> tasks;
+    std::thread thread;
+};
+
+QoS currentQoS() {
+    return tl_qos < 0 ? QoS::Interactive : static_cast<QoS>(tl_qos);
+}
+
+Scheduler& Scheduler::instance() {
+    // Never destroyed: workers and detached library threads may still be
+    // submitting while static destructors run
+    static Scheduler* scheduler = new Scheduler();
+    return *scheduler;
+}
+
+Scheduler::Scheduler() {
+    const Clusters& c = clusters();
+    topology_.big_cores = static_cast<int>(c.big.size());
+    topology_.little_cores = static_cast<int>(c.little.size());
+
+    int cores = topology_.big_cores + topology_.little_cores;
+    max_threads_ = std::max(1, cores);
+    // Background work gets the little cluster, or half the cores on a
+    // homogeneous CPU, and never the whole cap
+    int background = topology_.little_cores > 0 ? topology_.little_cores : cores / 2;
+    background_limit_ = std::max(1, std::min(background, cores - 1));
+}
+
+void Scheduler::startWorkers() {
+    int count = topology_.big_cores + topology_.little_cores;
+    for (int i = 0; i < count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->thread = std::thread(&Scheduler::workerLoop, this, i);
+        workers_[i]->thread.detach();
+    }
+}
+
+void Scheduler::post(QoS qos, std::function<void()> fn) {
+    std::call_once(started_, [this]() { startWorkers(); });
+
+    pending_.fetch_add(1);
+    if (tl_worker) {
+        // Nested work stays on this worker's deque, where it is likely still in cache
+        std::lock_guard<std::mutex> lock(tl_worker->mutex);
+        tl_worker->tasks.push_back(Task{std::move(fn), qos});
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queues_[static_cast<int>(qos)].push_back(Task{std::move(fn), qos});
+    }
+    notify();
+}
+
+void Scheduler::notify() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++epoch_;
+    }
+    wake_.notify_all();
+}
+
+int Scheduler::acquireSlots(QoS qos, int min_slots, int wanted) {
+    uint64_t active = active_.load();
+    while (true) {
+        int interactive = interactiveOf(active);
+        int background = backgroundOf(active);
+        int available = max_threads_.load() - interactive - background;
+        if (qos == QoS::Background) {
+            available = std::min(available, background_limit_.load() - background);
+        }
+        int slots = std::min(available, wanted);
+        if (slots < min_slots || slots <= 0) return 0;
+        if (active_.compare_exchange_weak(active, active + slotsOf(qos, slots))) {
+            return slots;
+        }
+    }
+}
+
+void Scheduler::releaseSlots(QoS qos, int slots) {
+    if (slots <= 0) return;
+    active_.fetch_sub(slotsOf(qos, slots));
+    // Deferred background tasks may fit now
+    if (pending_.load() > 0 || waiting_.load() > 0) notify();
+}
+
+bool Scheduler::takeTask(Worker* self, Task& task) {
+    if (pending_.load() == 0) return false;
+
+    // A thread already inside a task runs nested work on the slot it holds
+    const bool holds_slot = tl_holds > 0;
+    auto admit = [&](QoS qos) {
+        if (holds_slot) return true;
+        if (acquireSlots(qos, 1, 1) == 1) return true;
+        if (qos == QoS::Background) background_deferred_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    };
+    auto takeFrom = [&](std::deque<Task>& tasks, bool from_back) {
+        // Interactive tasks first; background ones only if admitted
+        for (int pass = 0; pass < 2; ++pass) {
+            QoS want = pass == 0 ? QoS::Interactive : QoS::Background;
+            for (size_t i = 0; i < tasks.size(); ++i) {
+                size_t at = from_back ? tasks.size() - 1 - i : i;
+                if (tasks[at].qos != want) continue;
+                if (!admit(want)) break;
+                task = std::move(tasks[at]);
+                tasks.erase(tasks.begin() + static_cast<std::ptrdiff_t>(at));
+                pending_.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (self) {
+        std::lock_guard<std::mutex> lock(self->mutex);
+        if (takeFrom(self->tasks, true)) return true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int q = 0; q < 2; ++q) {
+            auto& queue = queues_[q];
+            if (queue.empty() || !admit(static_cast<QoS>(q))) continue;
+            task = std::move(queue.front());
+            queue.pop_front();
+            pending_.fetch_sub(1);
+            return true;
+        }
+    }
+    for (auto& worker : workers_) {
+        if (worker.get() == self) continue;
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if (takeFrom(worker->tasks, false)) {
+            tasks_stolen_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Scheduler::run(Task& task) {
+    const bool owns_slot = tl_holds == 0;
+    const int previous = tl_qos;
+    tl_qos = static_cast<int>(task.qos);
+    place(tl_qos);
+    ++tl_holds;
+
+    try {
+        task.fn();
+    } catch (...) {
+        // async() captures exceptions in the future; this only catches post()
+        metrics::reportException(metrics::Module::Scheduler, "task");
+    }
+
+    --tl_holds;
+    tl_qos = previous;
+    // Back to the placement of whatever this thread was doing before; idle
+    // workers keep theirs until the next task
+    if (tl_holds > 0 || !tl_worker) place(tl_qos);
+    tasks_run_.fetch_add(1, std::memory_order_relaxed);
+    if (owns_slot) releaseSlots(task.qos, 1);
+}
+
+bool Scheduler::runOne() {
+    Task task;
+    if (!takeTask(tl_worker, task)) return false;
+    run(task);
+    return true;
+}
+
+void Scheduler::workerLoop(size_t index) {
+    tl_worker = workers_[index].get();
+
+    while (true) {
+        uint64_t epoch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            epoch = epoch_;
+        }
+
+        Task task;
+        if (takeTask(tl_worker, task)) {
+            run(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&]() { return epoch_ != epoch; });
+    }
+}
+
+void Scheduler::parallelFor(size_t begin, size_t end, size_t grain,
+                            const std::function<void(size_t, size_t)>& body) {
+    if (end <= begin) return;
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = (end - begin + grain - 1) / grain;
+    const QoS qos = currentQoS();
+    // The caller works through chunks too, so it counts against the cap
+    Reservation caller(qos, 1);
+    const size_t helpers = std::min<size_t>(chunks, static_cast<size_t>(threadBudget(qos))) - 1;
+
+    // Chunks are claimed dynamically, so helpers that start late just find
+    // nothing left and the caller is never stuck waiting on a busy pool
+    struct Shared {
+        std::atomic<size_t> next{0};
+        std::mutex mutex;
+        std::exception_ptr error;
+    };
+    auto shared = std::make_shared<Shared>();
+    auto work = [shared, begin, end, grain, chunks, &body]() {
+        size_t chunk;
+        while ((chunk = shared->next.fetch_add(1)) < chunks) {
+            size_t lo = begin + chunk * grain;
+            size_t hi = std::min(end, lo + grain);
+            try {
+                body(lo, hi);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                if (!shared->error) shared->error = std::current_exception();
+                shared->next = chunks;
+            }
+        }
+    };
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(helpers);
+    for (size_t i = 0; i < helpers; ++i) {
+        futures.push_back(async(qos, work));
+    }
+    work();
+    for (auto& future : futures) {
+        wait(future);
+    }
+    if (shared->error) std::rethrow_exception(shared->error);
+}
+
+int Scheduler::threadBudget(QoS qos) const {
+    int cap = max_threads_.load();
+    int budget = qos == QoS::Background ? background_limit_.load() : std::max(1, topology_.big_cores);
+    return std::max(1, std::min(budget, cap));
+}
+
+void Scheduler::setMaxThreads(int threads) {
+    int cores = topology_.big_cores + topology_.little_cores;
+    max_threads_ = std::max(1, std::min(threads, cores));
+    background_limit_ = std::max(1, std::min(background_limit_.load(), max_threads_.load() - 1));
+    notify();
+}
+
+void Scheduler::setBackgroundLimit(int threads) {
+    background_limit_ = std::max(1, std::min(threads, max_threads_.load() - 1));
+    notify();
+}
+
+SchedulerStats Scheduler::stats() const {
+    SchedulerStats stats = {};
+    uint64_t active = active_.load();
+    stats.max_threads = max_threads_.load();
+    stats.background_limit = background_limit_.load();
+    stats.active_interactive = interactiveOf(active);
+    stats.active_background = backgroundOf(active);
+    stats.tasks_run = tasks_run_.load(std::memory_order_relaxed);
+    stats.tasks_stolen = tasks_stolen_.load(std::memory_order_relaxed);
+    stats.background_deferred = background_deferred_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+ScopedQoS::ScopedQoS(QoS qos) : previous_(tl_qos) {
+    tl_qos = static_cast<int>(qos);
+    place(tl_qos);
+}
+
+ScopedQoS::~ScopedQoS() {
+    tl_qos = previous_;
+    place(tl_qos);
+}
+
+Reservation::Reservation(QoS qos, int wanted)
+    : qos_(qos), threads_(1), held_(0), scope_(qos) {
+    Scheduler& scheduler = Scheduler::instance();
+    wanted = std::max(1, wanted);
+
+    if (tl_holds == 0) {
+        if (qos == QoS::Interactive) {
+            // The user is waiting; never hold an interactive caller back
+            scheduler.active_.fetch_add(slotsOf(qos, 1));
+        } else {
+            // Background callers wait their turn like background tasks do
+            std::unique_lock<std::mutex> lock(scheduler.mutex_);
+            scheduler.waiting_.fetch_add(1);
+            while (scheduler.acquireSlots(qos, 1, 1) == 0) {
+                scheduler.background_deferred_.fetch_add(1, std::memory_order_relaxed);
+                uint64_t epoch = scheduler.epoch_;
+                scheduler.wake_.wait(lock, [&]() { return scheduler.epoch_ != epoch; });
+            }
+            scheduler.waiting_.fetch_sub(1);
+        }
+        held_ = 1;
+    }
+    ++tl_holds;
+
+    int extra = scheduler.acquireSlots(qos, 0, wanted - 1);
+    held_ += extra;
+    threads_ += extra;
+}
+
+Reservation::~Reservation() {
+    --tl_holds;
+    Scheduler::instance().releaseSlots(qos_, held_);
+}
+
+void PendingRequests::add() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++count_;
+}
+
+void PendingRequests::done() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--count_ == 0) idle_.notify_all();
+}
+
+void PendingRequests::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return count_ == 0; });
+}
+
+Request* Request::submit(Work work, RequestCallback callback, void* user_data, PendingRequests* group) {
+    auto* request = new Request(callback, user_data, group);
+    if (group) group->add();
+
+    auto shared_work = std::make_shared<Work>(std::move(work));
+    Scheduler::instance().post(currentQoS(), [request, shared_work]() {
+        request->run(*shared_work);
+    });
+    return request;
+}
+
+void Request::run(Work& work) {
+    // Already completed by cancel()
+    if (claimed_.exchange(true)) {
+        unref();
+        return;
+    }
+
+    try {
+        work(*this);
+    } catch (const std::exception& e) {
+        fail(e.what());
+    } catch (...) {
+        fail("unknown error");
+    }
+    finish();
+    unref();
+}
+
+void Request::fail(const std::string& message) {
+    error_ = message.empty() ? "failed" : message;
+}
+
+void Request::finish() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_.store(true, std::memory_order_release);
+    }
+    finished_.notify_all();
+
+    if (callback_) callback_(this, user_data_);
+    // The work can no longer touch the context
+    if (group_) group_->done();
+}
+
+bool Request::wait(int timeout_ms) {
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::milliseconds(std::max(timeout_ms, 0));
+
+    if (tl_worker) {
+        // Blocking a pool thread could starve the task being waited on
+        while (!done() && (timeout_ms < 0 || Clock::now() < deadline)) {
+            if (!Scheduler::instance().runOne()) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                finished_.wait_for(lock, std::chrono::milliseconds(1), [this]() { return done(); });
+            }
+        }
+        return done();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (timeout_ms < 0) {
+        finished_.wait(lock, [this]() { return done(); });
+    } else {
+        finished_.wait_until(lock, deadline, [this]() { return done(); });
+    }
+    return done();
+}
+
+bool Request::cancel() {
+    if (claimed_.exchange(true)) return false;
+    fail("cancelled");
+    finish();
+    return true;
+}
+
+void Request::release() {
+    unref();
+}
+
+void Request::unref() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+}
+
+namespace {
+
+struct LentContext {
+    const std::type_info* type;
+    bool retiring = false;
+    // Live loans by id, with their on_retire hooks
+    std::unordered_map<uint64_t, std::function<void()>> loans;
+};
+
+struct ContextRegistry {
+    std::mutex mutex;
+    std::condition_variable returned;
+    std::unordered_map<const void*, LentContext> contexts;
+    uint64_t next_loan = 1;
+};
+
+ContextRegistry& contextRegistry() {
+    // Never destroyed, like the scheduler: contexts may still be retired
+    // while static destructors run
+    static ContextRegistry* registry = new ContextRegistry();
+    return *registry;
+}
+
+} // namespace
+
+ContextLoan::ContextLoan(const void* context, const std::type_info& type, std::function<void()> on_retire) {
+    if (!context) return;
+
+    ContextRegistry& registry = contextRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.contexts.find(context);
+    // The address may have been freed and reused by another kind of context
+    if (it == registry.contexts.end() || it->second.retiring || *it->second.type != type) return;
+
+    context_ = context;
+    id_ = registry.next_loan++;
+    it->second.loans.emplace(id_, std::move(on_retire));
+}
+
+ContextLoan::~ContextLoan() {
+    if (!context_) return;
+
+    ContextRegistry& registry = contextRegistry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.contexts.find(context_);
+        if (it != registry.contexts.end()) it->second.loans.erase(id_);
+    }
+    registry.returned.notify_all();
+}
+
+void lendContext(const void* context, const std::type_info& type) {
+    if (!context) return;
+
+    ContextRegistry& registry = contextRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    LentContext lent;
+    lent.type = &type;
+    registry.contexts[context] = std::move(lent);
+}
+
+void retireContext(const void* context) {
+    ContextRegistry& registry = contextRegistry();
+    std::vector<std::function<void()>> hooks;
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.contexts.find(context);
+        if (it == registry.contexts.end()) return;
+
+        it->second.retiring = true;
+        for (auto& loan : it->second.loans) {
+            if (loan.second) hooks.push_back(loan.second);
+        }
+    }
+
+    // Outside the lock: a hook may end its loan, or others, itself
+    for (auto& hook : hooks) hook();
+
+    std::unique_lock<std::mutex> lock(registry.mutex);
+    registry.returned.wait(lock, [&]() {
+        auto it = registry.contexts.find(context);
+        return it == registry.contexts.end() || it->second.loans.empty();
+    });
+    registry.contexts.erase(context);
+}
+
+// C API Implementation
+extern "C" {
+
+void scheduler_set_max_threads(int threads) {
+    Scheduler::instance().setMaxThreads(threads);
+}
+
+void scheduler_set_background_limit(int threads) {
+    Scheduler::instance().setBackgroundLimit(threads);
+}
+
+bool scheduler_get_stats(SchedulerStats* stats_out) {
+    if (!stats_out) return false;
+    *stats_out = Scheduler::instance().stats();
+    return true;
+}
+
+bool request_is_done(Request* request) {
+    return request && request->done();
+}
+
+bool request_wait(Request* request, int timeout_ms) {
+    return request && request->wait(timeout_ms);
+}
+
+bool request_succeeded(Request* request) {
+    return request && request->done() && request->succeeded();
+}
+
+const char* request_get_error(Request* request) {
+    if (!request || !request->done() || request->succeeded()) return nullptr;
+    return request->error().c_str();
+}
+
+const char* request_get_text(Request* request) {
+    if (!request || !request->done()) return nullptr;
+    return request->text.c_str();
+}
+
+const float* request_get_floats(Request* request, size_t* count_out) {
+    if (!request || !request->done()) return nullptr;
+    if (count_out) *count_out = request->floats.size();
+    return request->floats.data();
+}
+
+const int* request_get_ints(Request* request, size_t* count_out) {
+    if (!request || !request->done()) return nullptr;
+    if (count_out) *count_out = request->ints.size();
+    return request->ints.data();
+}
+
+bool request_cancel(Request* request) {
+    return request && request->cancel();
+}
+
+void request_release(Request* request) {
+    if (request) request->release();
+}
+
+} // extern "C"
+
+} // namespace scheduler
+} // namespace bookmark
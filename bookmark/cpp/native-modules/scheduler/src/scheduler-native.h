@@ -0,0 +1,315 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace bookmark {
+namespace scheduler {
+
+// Interactive work is what the user is waiting on (a voice turn, a search);
+// background work (ingestion, prefetch) only gets what is left over
+enum class QoS : int {
+    Interactive = 0,
+    Background = 1,
+};
+
+// QoS of the calling thread: the class of the task it is running, whatever
+// an enclosing ScopedQoS set, or Interactive for threads we don't own (the
+// React Native bridge calls in on those for user requests)
+QoS currentQoS();
+
+// Counts of the device's CPU clusters. On homogeneous CPUs, or where the
+// topology can't be read, every core is reported as big.
+struct CpuTopology {
+    int big_cores;
+    int little_cores;
+};
+
+struct SchedulerStats {
+    int max_threads;         // cap on active threads across all QoS
+    int background_limit;    // of which background may use at most this many
+    int active_interactive;  // pool workers plus reserved library threads
+    int active_background;
+    uint64_t tasks_run;
+    uint64_t tasks_stolen;
+    uint64_t background_deferred; // times a background task waited for a slot
+};
+
+struct Task {
+    std::function<void()> fn;
+    QoS qos;
+};
+
+struct Worker;
+class Request;
+
+// One process-wide work-stealing pool shared by every native module.
+//
+// Each worker owns a deque: tasks submitted from inside a task go on the
+// submitting worker's deque and are run LIFO by it, while idle workers steal
+// the oldest ones from the other end. Tasks from outside the pool go on a
+// shared queue per QoS class.
+//
+// At most max_threads threads are active at once, counting both pool workers
+// and the threads that Whisper, OpenMP (FAISS) and TVM (MLC) spin up for a
+// call, which are accounted for through a Reservation. Background tasks only
+// start while fewer than background_limit background threads are active, so
+// part of the cap is always free for interactive work. Interactive threads
+// are kept on the big cores and background ones on the little cores where
+// the device has both.
+class Scheduler {
+public:
+    static Scheduler& instance();
+
+    // Fire and forget
+    void post(QoS qos, std::function<void()> fn);
+
+    template <typename F>
+    auto async(QoS qos, F&& fn) -> std::future<std::invoke_result_t<F>> {
+        using Result = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+        auto future = task->get_future();
+        post(qos, [task]() { (*task)(); });
+        return future;
+    }
+
+    // Runs queued tasks on the calling thread until the future is ready, so
+    // waiting from inside a task can't starve the pool
+    template <typename T>
+    T wait(std::future<T>& future) {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            if (!runOne()) {
+                future.wait_for(std::chrono::milliseconds(1));
+            }
+        }
+        return future.get();
+    }
+
+    // Splits [begin, end) into chunks of at least grain and runs body(lo, hi)
+    // on them in parallel at the caller's QoS. The caller takes part, so
+    // this is safe to call from a pool task.
+    void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    // Threads a library call may use on its own pool, given the QoS
+    int threadBudget(QoS qos) const;
+
+    void setMaxThreads(int threads);
+    void setBackgroundLimit(int threads);
+    CpuTopology topology() const { return topology_; }
+    SchedulerStats stats() const;
+
+private:
+    friend class Reservation;
+    friend class Request;
+
+    Scheduler();
+    ~Scheduler() = delete; // workers never exit; the pool lives as long as the process
+
+    void startWorkers();
+    void workerLoop(size_t index);
+    // Pops one admissible task, preferring the worker's own deque, then the
+    // shared queues, then stealing; false if there was none
+    bool takeTask(Worker* self, Task& task);
+    bool runOne();
+    void run(Task& task);
+    // Takes up to wanted slots (at least min_slots) if the cap allows,
+    // returning how many were taken
+    int acquireSlots(QoS qos, int min_slots, int wanted);
+    void releaseSlots(QoS qos, int slots);
+    void notify();
+
+    CpuTopology topology_;
+    std::atomic<int> max_threads_;
+    std::atomic<int> background_limit_;
+    // Active interactive threads in the low 32 bits, background in the high
+    // 32, so admission can check both in one compare-and-swap
+    std::atomic<uint64_t> active_{0};
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::once_flag started_;
+
+    std::mutex mutex_;                     // guards the shared queues and epoch_
+    std::condition_variable wake_;
+    std::deque<Task> queues_[2];
+    uint64_t epoch_ = 0;                   // bumped whenever there may be new work or a free slot
+    std::atomic<size_t> pending_{0};       // tasks queued anywhere
+    std::atomic<int> waiting_{0};          // background reservations waiting for a slot
+
+    std::atomic<uint64_t> tasks_run_{0};
+    std::atomic<uint64_t> tasks_stolen_{0};
+    std::atomic<uint64_t> background_deferred_{0};
+};
+
+// Runs the calling thread at a QoS class, moving it to the matching cores,
+// until the scope ends
+class ScopedQoS {
+public:
+    explicit ScopedQoS(QoS qos);
+    ~ScopedQoS();
+    ScopedQoS(const ScopedQoS&) = delete;
+    ScopedQoS& operator=(const ScopedQoS&) = delete;
+
+private:
+    int previous_; // -1 if the thread had no QoS of its own
+};
+
+// Claims slots under the thread cap for a library call that runs its own
+// threads. The calling thread always gets one slot; more are granted while
+// the cap allows. The caller runs at the reservation's QoS for its lifetime,
+// and threads it spawns inherit the core placement.
+class Reservation {
+public:
+    explicit Reservation(int wanted) : Reservation(currentQoS(), wanted) {}
+    Reservation(QoS qos, int wanted);
+    ~Reservation();
+    Reservation(const Reservation&) = delete;
+    Reservation& operator=(const Reservation&) = delete;
+
+    int threads() const { return threads_; }
+
+private:
+    QoS qos_;
+    int threads_;
+    int held_; // slots taken from the cap; the caller's own is already held inside a task
+    ScopedQoS scope_;
+};
+
+// Counts a context's async requests so the context can wait for them
+// before it is destroyed
+class PendingRequests {
+public:
+    void add();
+    void done();
+    // Blocks until every added request is done
+    void drain();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable idle_;
+    int count_ = 0;
+};
+
+// Called once when a request completes, on the thread that completed it
+typedef void (*RequestCallback)(Request* request, void* user_data);
+
+// One call to an async entry point of a module's C API, such as
+// llm_generate_async or whisper_transcribe_async. The call runs as a task
+// on the shared pool at the submitter's QoS, so calls into different
+// modules overlap instead of queuing on the bridge thread. Completion is
+// signalled through the optional callback and by the request itself, which
+// can be polled or waited on. The submitter releases the request when done
+// with it, whether or not it has completed.
+class Request {
+public:
+    using Work = std::function<void(Request&)>;
+
+    // group, if given, counts the request until it completes
+    static Request* submit(Work work,
+                           RequestCallback callback = nullptr,
+                           void* user_data = nullptr,
+                           PendingRequests* group = nullptr);
+
+    bool done() const { return done_.load(std::memory_order_acquire); }
+    // Waits up to timeout_ms, or forever if negative, and returns done().
+    // Inside a pool task the thread runs other tasks while it waits.
+    bool wait(int timeout_ms = -1);
+    // Completes the request as failed if its work hasn't started; returns
+    // whether it was in time
+    bool cancel();
+    void release();
+
+    // Only meaningful once done()
+    bool succeeded() const { return error_.empty(); }
+    const std::string& error() const { return error_; }
+
+    // For the work: marks the request failed. Throwing does the same.
+    void fail(const std::string& message);
+
+    // Results, filled in by the work; each call documents which it uses
+    std::string text;
+    std::vector<float> floats;
+    std::vector<int> ints;
+
+private:
+    Request(RequestCallback callback, void* user_data, PendingRequests* group)
+        : callback_(callback), user_data_(user_data), group_(group) {}
+    ~Request() = default;
+
+    void run(Work& work);
+    void finish();
+    void unref();
+
+    RequestCallback callback_;
+    void* user_data_;
+    PendingRequests* group_;
+    std::string error_;
+    std::atomic<bool> claimed_{false};  // by the task starting, or by cancel()
+    std::atomic<bool> done_{false};
+    std::atomic<int> refs_{2};          // the submitter's and the task's
+    std::mutex mutex_;
+    std::condition_variable finished_;
+};
+
+// A module's context borrowed by code outside the module, such as the voice
+// pipeline running turns on the whisper, LLM, index and TTS contexts that
+// their own modules create and replace. Contexts are lent when constructed
+// and retired first thing when destroyed (see lendContext); retiring calls
+// each holder's on_retire, waits for every loan to end and makes later
+// loans fail, so a holder never touches a freed context.
+class ContextLoan {
+public:
+    ContextLoan() = default;
+    // Fails unless context is a live, lent T
+    template <typename T>
+    ContextLoan(T* context, std::function<void()> on_retire = nullptr)
+        : ContextLoan(static_cast<const void*>(context), typeid(T), std::move(on_retire)) {}
+    ~ContextLoan();
+    ContextLoan(const ContextLoan&) = delete;
+    ContextLoan& operator=(const ContextLoan&) = delete;
+
+    explicit operator bool() const { return context_ != nullptr; }
+
+private:
+    ContextLoan(const void* context, const std::type_info& type, std::function<void()> on_retire);
+
+    const void* context_ = nullptr;
+    uint64_t id_ = 0;
+};
+
+void lendContext(const void* context, const std::type_info& type);
+// Blocks until the context's loans have ended; call before tearing it down
+void retireContext(const void* context);
+
+// React Native binding interface
+extern "C" {
+    void scheduler_set_max_threads(int threads);
+    void scheduler_set_background_limit(int threads);
+    bool scheduler_get_stats(SchedulerStats* stats_out);
+
+    // Async request handles returned by the modules' *_async calls. The
+    // result getters return null until the request is done.
+    bool request_is_done(Request* request);
+    bool request_wait(Request* request, int timeout_ms);
+    bool request_succeeded(Request* request);
+    const char* request_get_error(Request* request);
+    const char* request_get_text(Request* request);
+    const float* request_get_floats(Request* request, size_t* count_out);
+    const int* request_get_ints(Request* request, size_t* count_out);
+    bool request_cancel(Request* request);
+    void request_release(Request* request);
+}
+
+} // namespace scheduler
+} // namespace bookmark
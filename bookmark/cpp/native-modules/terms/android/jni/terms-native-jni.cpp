@@ -0,0 +1,224 @@
+#include <jni.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "terms-native.h"
+#include <android/log.h>
+
+#define LOG_TAG "TermsNative"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+using namespace bookmark::terms;
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_bookmark_TermsModule_buildDictionaryNative(
+    JNIEnv* env,
+    jobject thiz,
+    jstring book_path
+) {
+    const char* path = env->GetStringUTFChars(book_path, nullptr);
+    TermDictionary* dictionary = terms_build_from_file(path);
+    env->ReleaseStringUTFChars(book_path, path);
+
+    if (!dictionary) {
+        LOGE("Failed to build term dictionary");
+    }
+    return reinterpret_cast<jlong>(dictionary);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_bookmark_TermsModule_buildFromTextNative(
+    JNIEnv* env,
+    jobject thiz,
+    jstring text
+) {
+    const char* utf = env->GetStringUTFChars(text, nullptr);
+    TermDictionary* dictionary = terms_build(utf, strlen(utf));
+    env->ReleaseStringUTFChars(text, utf);
+    return reinterpret_cast<jlong>(dictionary);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_bookmark_TermsModule_loadDictionaryNative(
+    JNIEnv* env,
+    jobject thiz,
+    jstring path
+) {
+    const char* file_path = env->GetStringUTFChars(path, nullptr);
+    TermDictionary* dictionary = terms_load(file_path);
+    env->ReleaseStringUTFChars(path, file_path);
+    return reinterpret_cast<jlong>(dictionary);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_TermsModule_saveDictionaryNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong dictionary_ptr,
+    jstring path
+) {
+    auto* dictionary = reinterpret_cast<TermDictionary*>(dictionary_ptr);
+    const char* file_path = env->GetStringUTFChars(path, nullptr);
+    bool success = terms_save(dictionary, file_path);
+    env->ReleaseStringUTFChars(path, file_path);
+    return success;
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_TermsModule_destroyDictionaryNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong dictionary_ptr
+) {
+    terms_destroy(reinterpret_cast<TermDictionary*>(dictionary_ptr));
+}
+
+JNIEXPORT jint JNICALL
+Java_com_bookmark_TermsModule_countNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong dictionary_ptr,
+    jstring word
+) {
+    auto* dictionary = reinterpret_cast<TermDictionary*>(dictionary_ptr);
+    const char* utf = env->GetStringUTFChars(word, nullptr);
+    uint32_t count = terms_count(dictionary, utf);
+    env->ReleaseStringUTFChars(word, utf);
+    return static_cast<jint>(count);
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_com_bookmark_TermsModule_occurrencesNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong dictionary_ptr,
+    jstring word,
+    jint max_results
+) {
+    auto* dictionary = reinterpret_cast<TermDictionary*>(dictionary_ptr);
+    const char* utf = env->GetStringUTFChars(word, nullptr);
+
+    std::vector<uint32_t> offsets(max_results > 0 ? max_results : 0);
+    size_t total = terms_occurrences(dictionary, utf, offsets.data(), offsets.size());
+    env->ReleaseStringUTFChars(word, utf);
+
+    offsets.resize(std::min(total, offsets.size()));
+    std::vector<jlong> values(offsets.begin(), offsets.end());
+
+    jlongArray result = env->NewLongArray(values.size());
+    env->SetLongArrayRegion(result, 0, values.size(), values.data());
+    return result;
+}
+
+JNIEXPORT jobjectArray JNICALL
+Java_com_bookmark_TermsModule_topTermsNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong dictionary_ptr,
+    jlong library_ptr,
+    jint k,
+    jfloatArray scores_out
+) {
+    auto* dictionary = reinterpret_cast<TermDictionary*>(dictionary_ptr);
+    auto* library = reinterpret_cast<TermLibrary*>(library_ptr);
+
+    std::vector<char> buffer(static_cast<size_t>(k) * (kMaxTermBytes + 1) + 1);
+    std::vector<float> scores(k);
+    size_t count = terms_top_k(dictionary, library, k, buffer.data(), buffer.size(), scores.data());
+
+    jobjectArray result = env->NewObjectArray(count, env->FindClass("java/lang/String"), nullptr);
+    const char* cursor = buffer.data();
+    for (size_t i = 0; i < count; ++i) {
+        const char* newline = strchr(cursor, '\n');
+        std::string term(cursor, newline - cursor);
+        jstring value = env->NewStringUTF(term.c_str());
+        env->SetObjectArrayElement(result, i, value);
+        env->DeleteLocalRef(value);
+        cursor = newline + 1;
+    }
+
+    env->SetFloatArrayRegion(scores_out, 0, count, scores.data());
+    return result;
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_bookmark_TermsModule_loadLibraryNative(
+    JNIEnv* env,
+    jobject thiz,
+    jstring path
+) {
+    const char* file_path = env->GetStringUTFChars(path, nullptr);
+    TermLibrary* library = terms_library_load(file_path);
+    env->ReleaseStringUTFChars(path, file_path);
+
+    // A missing library file just means no books were added yet
+    if (!library) {
+        library = terms_library_create();
+    }
+    return reinterpret_cast<jlong>(library);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_TermsModule_saveLibraryNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong library_ptr,
+    jstring path
+) {
+    auto* library = reinterpret_cast<TermLibrary*>(library_ptr);
+    const char* file_path = env->GetStringUTFChars(path, nullptr);
+    bool success = terms_library_save(library, file_path);
+    env->ReleaseStringUTFChars(path, file_path);
+    return success;
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_TermsModule_destroyLibraryNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong library_ptr
+) {
+    terms_library_destroy(reinterpret_cast<TermLibrary*>(library_ptr));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_TermsModule_addBookNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong library_ptr,
+    jstring book_id,
+    jlong dictionary_ptr
+) {
+    const char* id = env->GetStringUTFChars(book_id, nullptr);
+    bool success = terms_library_add_book(
+        reinterpret_cast<TermLibrary*>(library_ptr),
+        id,
+        reinterpret_cast<TermDictionary*>(dictionary_ptr)
+    );
+    env->ReleaseStringUTFChars(book_id, id);
+    return success;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_TermsModule_removeBookNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong library_ptr,
+    jstring book_id,
+    jlong dictionary_ptr
+) {
+    const char* id = env->GetStringUTFChars(book_id, nullptr);
+    bool success = terms_library_remove_book(
+        reinterpret_cast<TermLibrary*>(library_ptr),
+        id,
+        reinterpret_cast<TermDictionary*>(dictionary_ptr)
+    );
+    env->ReleaseStringUTFChars(book_id, id);
+    return success;
+}
+
+} // extern "C"
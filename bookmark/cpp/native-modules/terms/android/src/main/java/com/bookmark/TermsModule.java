@@ -0,0 +1,221 @@
+package com.bookmark;
+
+import com.facebook.react.bridge.ReactApplicationContext;
+import com.facebook.react.bridge.ReactContextBaseJavaModule;
+import com.facebook.react.bridge.ReactMethod;
+import com.facebook.react.bridge.Promise;
+import com.facebook.react.bridge.WritableArray;
+import com.facebook.react.bridge.WritableMap;
+import com.facebook.react.bridge.Arguments;
+
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+public class TermsModule extends ReactContextBaseJavaModule {
+    private long dictionaryPtr = 0;
+    private long libraryPtr = 0;
+    private final ExecutorService buildExecutor = Executors.newSingleThreadExecutor();
+
+    static {
+        System.loadLibrary("terms-native");
+    }
+
+    public TermsModule(ReactApplicationContext reactContext) {
+        super(reactContext);
+    }
+
+    @Override
+    public String getName() {
+        return "TermsNative";
+    }
+
+    private synchronized void replaceDictionary(long ptr) {
+        if (dictionaryPtr != 0) {
+            destroyDictionaryNative(dictionaryPtr);
+        }
+        dictionaryPtr = ptr;
+    }
+
+    @ReactMethod
+    public void buildDictionary(String bookPath, String dictionaryPath, Promise promise) {
+        // Tokenizing a whole book can take a while, keep it off the bridge thread
+        buildExecutor.execute(() -> {
+            try {
+                long ptr = buildDictionaryNative(bookPath);
+                if (ptr == 0) {
+                    promise.resolve(false);
+                    return;
+                }
+                boolean saved = saveDictionaryNative(ptr, dictionaryPath);
+                replaceDictionary(ptr);
+                promise.resolve(saved);
+            } catch (Exception e) {
+                promise.reject("ERR_TERMS", "Failed to build term dictionary: " + e.getMessage());
+            }
+        });
+    }
+
+    @ReactMethod
+    public void loadDictionary(String dictionaryPath, Promise promise) {
+        try {
+            long ptr = loadDictionaryNative(dictionaryPath);
+            if (ptr != 0) {
+                replaceDictionary(ptr);
+            }
+            promise.resolve(ptr != 0);
+        } catch (Exception e) {
+            promise.reject("ERR_TERMS", "Failed to load term dictionary: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void lookup(String word, int maxResults, Promise promise) {
+        try {
+            if (dictionaryPtr == 0) {
+                throw new IllegalStateException("Term dictionary not loaded");
+            }
+
+            WritableArray offsets = Arguments.createArray();
+            for (long offset : occurrencesNative(dictionaryPtr, word, maxResults)) {
+                offsets.pushDouble(offset);
+            }
+
+            WritableMap result = Arguments.createMap();
+            result.putInt("count", countNative(dictionaryPtr, word));
+            result.putArray("offsets", offsets);
+            promise.resolve(result);
+        } catch (Exception e) {
+            promise.reject("ERR_TERMS", "Failed to look up term: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void getTopTerms(int k, boolean useLibrary, Promise promise) {
+        try {
+            if (dictionaryPtr == 0) {
+                throw new IllegalStateException("Term dictionary not loaded");
+            }
+
+            float[] scores = new float[k];
+            String[] terms = topTermsNative(dictionaryPtr, useLibrary ? libraryPtr : 0, k, scores);
+
+            WritableArray result = Arguments.createArray();
+            for (int i = 0; i < terms.length; i++) {
+                WritableMap entry = Arguments.createMap();
+                entry.putString("term", terms[i]);
+                entry.putDouble("score", scores[i]);
+                result.pushMap(entry);
+            }
+            promise.resolve(result);
+        } catch (Exception e) {
+            promise.reject("ERR_TERMS", "Failed to get top terms: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void extractKeyTerms(String text, int k, Promise promise) {
+        buildExecutor.execute(() -> {
+            long ptr = 0;
+            try {
+                ptr = buildFromTextNative(text);
+                if (ptr == 0) {
+                    throw new IllegalStateException("Failed to tokenize text");
+                }
+
+                String[] terms = topTermsNative(ptr, 0, k, new float[k]);
+                WritableArray result = Arguments.createArray();
+                for (String term : terms) {
+                    result.pushString(term);
+                }
+                promise.resolve(result);
+            } catch (Exception e) {
+                promise.reject("ERR_TERMS", "Failed to extract key terms: " + e.getMessage());
+            } finally {
+                if (ptr != 0) {
+                    destroyDictionaryNative(ptr);
+                }
+            }
+        });
+    }
+
+    @ReactMethod
+    public synchronized void loadLibrary(String path, Promise promise) {
+        try {
+            if (libraryPtr != 0) {
+                destroyLibraryNative(libraryPtr);
+            }
+            libraryPtr = loadLibraryNative(path);
+            promise.resolve(libraryPtr != 0);
+        } catch (Exception e) {
+            promise.reject("ERR_TERMS", "Failed to load term library: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void saveLibrary(String path, Promise promise) {
+        try {
+            if (libraryPtr == 0) {
+                throw new IllegalStateException("Term library not loaded");
+            }
+            promise.resolve(saveLibraryNative(libraryPtr, path));
+        } catch (Exception e) {
+            promise.reject("ERR_TERMS", "Failed to save term library: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void addBookToLibrary(String bookId, Promise promise) {
+        try {
+            if (libraryPtr == 0 || dictionaryPtr == 0) {
+                throw new IllegalStateException("Term library or dictionary not loaded");
+            }
+            promise.resolve(addBookNative(libraryPtr, bookId, dictionaryPtr));
+        } catch (Exception e) {
+            promise.reject("ERR_TERMS", "Failed to add book to term library: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void removeBookFromLibrary(String bookId, Promise promise) {
+        try {
+            if (libraryPtr == 0 || dictionaryPtr == 0) {
+                throw new IllegalStateException("Term library or dictionary not loaded");
+            }
+            promise.resolve(removeBookNative(libraryPtr, bookId, dictionaryPtr));
+        } catch (Exception e) {
+            promise.reject("ERR_TERMS", "Failed to remove book from term library: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public synchronized void cleanup(Promise promise) {
+        try {
+            if (dictionaryPtr != 0) {
+                destroyDictionaryNative(dictionaryPtr);
+                dictionaryPtr = 0;
+            }
+            if (libraryPtr != 0) {
+                destroyLibraryNative(libraryPtr);
+                libraryPtr = 0;
+            }
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_TERMS", "Failed to cleanup terms: " + e.getMessage());
+        }
+    }
+
+    // Native method declarations
+    private native long buildDictionaryNative(String bookPath);
+    private native long buildFromTextNative(String text);
+    private native long loadDictionaryNative(String path);
+    private native boolean saveDictionaryNative(long dictionaryPtr, String path);
+    private native void destroyDictionaryNative(long dictionaryPtr);
+    private native int countNative(long dictionaryPtr, String word);
+    private native long[] occurrencesNative(long dictionaryPtr, String word, int maxResults);
+    private native String[] topTermsNative(long dictionaryPtr, long libraryPtr, int k, float[] scoresOut);
+    private native long loadLibraryNative(String path);
+    private native boolean saveLibraryNative(long libraryPtr, String path);
+    private native void destroyLibraryNative(long libraryPtr);
+    private native boolean addBookNative(long libraryPtr, String bookId, long dictionaryPtr);
+    private native boolean removeBookNative(long libraryPtr, String bookId, long dictionaryPtr);
+}
@@ -0,0 +1,4 @@
+#import <React/RCTBridgeModule.h>
+
+@interface TermsModule : NSObject <RCTBridgeModule>
+@end
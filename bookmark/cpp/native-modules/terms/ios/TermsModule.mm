@@ -0,0 +1,210 @@
+#import "TermsModule.h"
+#import <React/RCTLog.h>
+#import "terms-native.h"
+
+using namespace bookmark::terms;
+
+@implementation TermsModule {
+    TermDictionary* _dictionary;
+    TermLibrary* _library;
+    dispatch_queue_t _termsQueue;
+}
+
+RCT_EXPORT_MODULE(TermsNative)
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _dictionary = nullptr;
+        _library = nullptr;
+        _termsQueue = dispatch_queue_create("com.bookmark.terms", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_dictionary != nullptr) {
+        terms_destroy(_dictionary);
+        _dictionary = nullptr;
+    }
+    if (_library != nullptr) {
+        terms_library_destroy(_library);
+        _library = nullptr;
+    }
+}
+
+// Module state is only touched on _termsQueue
+- (void)replaceDictionary:(TermDictionary*)dictionary {
+    if (_dictionary != nullptr) {
+        terms_destroy(_dictionary);
+    }
+    _dictionary = dictionary;
+}
+
+static NSArray<NSDictionary*>* topTerms(TermDictionary* dictionary, TermLibrary* library, size_t k) {
+    std::vector<char> buffer(k * (kMaxTermBytes + 1) + 1);
+    std::vector<float> scores(k);
+    size_t count = terms_top_k(dictionary, library, k, buffer.data(), buffer.size(), scores.data());
+
+    NSArray<NSString*>* terms = [@(buffer.data()) componentsSeparatedByString:@"\n"];
+    NSMutableArray<NSDictionary*>* result = [NSMutableArray arrayWithCapacity:count];
+    for (size_t i = 0; i < count; ++i) {
+        [result addObject:@{@"term": terms[i], @"score": @(scores[i])}];
+    }
+    return result;
+}
+
+RCT_EXPORT_METHOD(buildDictionary:(NSString*)bookPath
+                  dictionaryPath:(NSString*)dictionaryPath
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    std::string book = [bookPath UTF8String];
+    std::string path = [dictionaryPath UTF8String];
+    dispatch_async(_termsQueue, ^{
+        TermDictionary* dictionary = terms_build_from_file(book.c_str());
+        if (dictionary == nullptr) {
+            resolve(@NO);
+            return;
+        }
+        bool saved = terms_save(dictionary, path.c_str());
+        [self replaceDictionary:dictionary];
+        resolve(@(saved));
+    });
+}
+
+RCT_EXPORT_METHOD(loadDictionary:(NSString*)dictionaryPath
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    std::string path = [dictionaryPath UTF8String];
+    dispatch_async(_termsQueue, ^{
+        TermDictionary* dictionary = terms_load(path.c_str());
+        if (dictionary != nullptr) {
+            [self replaceDictionary:dictionary];
+        }
+        resolve(@(dictionary != nullptr));
+    });
+}
+
+RCT_EXPORT_METHOD(lookup:(NSString*)word
+                  maxResults:(nonnull NSNumber*)maxResults
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    std::string term = [word UTF8String];
+    size_t limit = [maxResults unsignedLongValue];
+    dispatch_async(_termsQueue, ^{
+        if (self->_dictionary == nullptr) {
+            reject(@"ERR_TERMS", @"Term dictionary not loaded", nil);
+            return;
+        }
+
+        std::vector<uint32_t> offsets(limit);
+        size_t total = terms_occurrences(self->_dictionary, term.c_str(), offsets.data(), offsets.size());
+
+        NSMutableArray<NSNumber*>* result = [NSMutableArray arrayWithCapacity:std::min(total, limit)];
+        for (size_t i = 0; i < std::min(total, limit); ++i) {
+            [result addObject:@(offsets[i])];
+        }
+        resolve(@{@"count": @(total), @"offsets": result});
+    });
+}
+
+RCT_EXPORT_METHOD(getTopTerms:(nonnull NSNumber*)k
+                  useLibrary:(BOOL)useLibrary
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    dispatch_async(_termsQueue, ^{
+        if (self->_dictionary == nullptr) {
+            reject(@"ERR_TERMS", @"Term dictionary not loaded", nil);
+            return;
+        }
+        resolve(topTerms(self->_dictionary, useLibrary ? self->_library : nullptr, [k unsignedLongValue]));
+    });
+}
+
+RCT_EXPORT_METHOD(extractKeyTerms:(NSString*)text
+                  k:(nonnull NSNumber*)k
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    std::string utf = [text UTF8String];
+    dispatch_async(_termsQueue, ^{
+        TermDictionary* dictionary = terms_build(utf.data(), utf.size());
+        if (dictionary == nullptr) {
+            reject(@"ERR_TERMS", @"Failed to extract key terms", nil);
+            return;
+        }
+
+        NSArray<NSDictionary*>* scored = topTerms(dictionary, nullptr, [k unsignedLongValue]);
+        terms_destroy(dictionary);
+        resolve([scored valueForKey:@"term"]);
+    });
+}
+
+RCT_EXPORT_METHOD(loadLibrary:(NSString*)path
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    std::string file_path = [path UTF8String];
+    dispatch_async(_termsQueue, ^{
+        if (self->_library != nullptr) {
+            terms_library_destroy(self->_library);
+        }
+
+        // A missing library file just means no books were added yet
+        self->_library = terms_library_load(file_path.c_str());
+        if (self->_library == nullptr) {
+            self->_library = terms_library_create();
+        }
+        resolve(@(self->_library != nullptr));
+    });
+}
+
+RCT_EXPORT_METHOD(saveLibrary:(NSString*)path
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    std::string file_path = [path UTF8String];
+    dispatch_async(_termsQueue, ^{
+        if (self->_library == nullptr) {
+            reject(@"ERR_TERMS", @"Term library not loaded", nil);
+            return;
+        }
+        resolve(@(terms_library_save(self->_library, file_path.c_str())));
+    });
+}
+
+RCT_EXPORT_METHOD(addBookToLibrary:(NSString*)bookId
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    std::string book_id = [bookId UTF8String];
+    dispatch_async(_termsQueue, ^{
+        if (self->_library == nullptr || self->_dictionary == nullptr) {
+            reject(@"ERR_TERMS", @"Term library or dictionary not loaded", nil);
+            return;
+        }
+        resolve(@(terms_library_add_book(self->_library, book_id.c_str(), self->_dictionary)));
+    });
+}
+
+RCT_EXPORT_METHOD(removeBookFromLibrary:(NSString*)bookId
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    std::string book_id = [bookId UTF8String];
+    dispatch_async(_termsQueue, ^{
+        if (self->_library == nullptr || self->_dictionary == nullptr) {
+            reject(@"ERR_TERMS", @"Term library or dictionary not loaded", nil);
+            return;
+        }
+        resolve(@(terms_library_remove_book(self->_library, book_id.c_str(), self->_dictionary)));
+    });
+}
+
+RCT_EXPORT_METHOD(cleanup:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    dispatch_async(_termsQueue, ^{
+        [self replaceDictionary:nullptr];
+        if (self->_library != nullptr) {
+            terms_library_destroy(self->_library);
+            self->_library = nullptr;
+        }
+        resolve(nil);
+    });
+}
+
+@end
@@ -0,0 +1,617 @@
+#include "terms-native.h"
+#include "metrics-native.h"
+#include "binary-io.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace bookmark {
+namespace terms {
+
+namespace {
+
+using binary_io::Reader;
+using binary_io::Writer;
+using binary_io::readFile;
+
+enum CharClass : uint8_t {
+    kSeparator = 0,
+    kWord = 1,
+    kApostrophe = 2,
+};
+
+struct CharTables {
+    uint8_t cls[256];
+    char lower[256];
+
+    CharTables() {
+        for (int c = 0; c < 256; ++c) {
+            bool word = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                        (c >= '0' && c <= '9') || c == '_' || c >= 0x80;
+            cls[c] = word ? kWord : kSeparator;
+            lower[c] = static_cast<char>(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+        }
+        cls[static_cast<uint8_t>('\'')] = kApostrophe;
+    }
+};
+
+const CharTables& tables() {
+    static const CharTables instance;
+    return instance;
+}
+
+// Class and byte length of the character at p. Only lead bytes of the
+// Latin-1 supplement and general punctuation blocks need a second look.
+inline uint8_t classAt(const char* p, size_t remaining, size_t& length) {
+    const auto c = static_cast<uint8_t>(p[0]);
+    length = 1;
+    if (c < 0xC2 || remaining < 2) {
+        return tables().cls[c];
+    }
+
+    const auto c1 = static_cast<uint8_t>(p[1]);
+    if (c == 0xC2 && c1 >= 0xA0 && c1 <= 0xBF) {
+        length = 2; // no-break space, guillemets, inverted marks
+        return kSeparator;
+    }
+    if (c == 0xE2 && (c1 == 0x80 || c1 == 0x81) && remaining >= 3) {
+        length = 3; // dashes, curly quotes, ellipsis
+        return c1 == 0x80 && static_cast<uint8_t>(p[2]) == 0x99 ? kApostrophe : kSeparator;
+    }
+    return kWord;
+}
+
+uint64_t fnv1a(std::string_view data) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+const std::unordered_set<std::string_view>& stopwords() {
+    static const std::unordered_set<std::string_view> words = {
+        "the", "be", "to", "of", "and", "a", "in", "that", "have", "i",
+        "it", "for", "not", "on", "with", "he", "as", "you", "do", "at",
+        "this", "but", "his", "by", "from", "they", "we", "say", "her", "she",
+        "or", "an", "will", "my", "one", "all", "would", "there", "their", "what",
+        "so", "up", "out", "if", "about", "who", "get", "which", "go", "me",
+        "when", "make", "can", "like", "time", "no", "just", "him", "know", "take",
+        "into", "year", "your", "some", "could", "them", "see", "other", "than", "then",
+        "now", "look", "only", "come", "its", "over", "think", "also", "back", "after",
+        "use", "two", "how", "our", "work", "first", "well", "way", "even", "new",
+        "want", "because", "any", "these", "give", "day", "most", "us", "is", "was",
+        "are", "were", "been", "being", "has", "had", "having", "does", "did", "doing",
+        "said", "says", "very", "more", "much", "many", "such", "own", "same", "too",
+        "should", "shall", "may", "might", "must", "upon", "here", "where", "why", "again",
+        "once", "while", "through", "before", "under", "above", "below", "between", "both", "each",
+        "few", "off", "down", "until", "against", "during", "without", "within", "those", "whom",
+        "himself", "herself", "itself", "themselves", "myself", "yourself", "ourselves", "nor", "yet", "ever",
+        "never", "every", "still", "though", "although", "whether", "another", "around", "whose", "whatever",
+        "dont", "didnt", "cant", "wont", "isnt", "wasnt", "im", "ive", "youre", "thats",
+        "mr", "mrs", "miss", "sir", "oh", "yes", "shes", "hes", "let", "went",
+    };
+    return words;
+}
+
+bool isKeyTermCandidate(std::string_view term) {
+    if (term.size() < 3) return false;
+    bool has_letter = std::any_of(term.begin(), term.end(), [](char c) {
+        return !(c >= '0' && c <= '9') && c != '_';
+    });
+    return has_letter && stopwords().count(term) == 0;
+}
+
+const char kDictionaryMagic[] = "BMTD";
+const char kLibraryMagic[] = "BMTL";
+constexpr uint32_t kFormatVersion = 1;
+
+} // namespace
+
+const char* Arena::copy(const char* data, size_t size) {
+    if (blocks_.empty() || offset_ + size > block_size_) {
+        blocks_.emplace_back(new char[std::max(block_size_, size)]);
+        offset_ = 0;
+    }
+    char* dest = blocks_.back().get() + offset_;
+    memcpy(dest, data, size);
+    offset_ += size;
+    return dest;
+}
+
+bool Tokenizer::next(std::string_view& term, size_t& offset) {
+    const CharTables& t = tables();
+
+    while (pos_ < size_) {
+        size_t length;
+        while (pos_ < size_ && classAt(data_ + pos_, size_ - pos_, length) != kWord) {
+            pos_ += length;
+        }
+        if (pos_ >= size_) break;
+
+        const size_t start = pos_;
+        size_t term_size = 0;
+        bool too_long = false;
+
+        while (pos_ < size_) {
+            uint8_t cls = classAt(data_ + pos_, size_ - pos_, length);
+            if (cls == kWord) {
+                if (term_size + length <= kMaxTermBytes) {
+                    for (size_t i = 0; i < length; ++i) {
+                        buffer_[term_size++] = t.lower[static_cast<uint8_t>(data_[pos_ + i])];
+                    }
+                } else {
+                    too_long = true;
+                }
+                pos_ += length;
+                continue;
+            }
+
+            // "don't" becomes "dont", matching BookProcessor's punctuation stripping
+            size_t next_length;
+            if (cls == kApostrophe && pos_ + length < size_ &&
+                classAt(data_ + pos_ + length, size_ - pos_ - length, next_length) == kWord) {
+                pos_ += length;
+                continue;
+            }
+            break;
+        }
+
+        if (too_long) continue;
+
+        term = std::string_view(buffer_, term_size);
+        offset = start;
+        return true;
+    }
+    return false;
+}
+
+TermTable::TermTable() : slots_(1024, 0) {}
+
+size_t TermTable::slotFor(uint64_t hash, std::string_view term) const {
+    const size_t mask = slots_.size() - 1;
+    size_t slot = hash & mask;
+    while (slots_[slot] != 0) {
+        const Entry& entry = entries_[slots_[slot] - 1];
+        if (entry.hash == hash && entry.length == term.size() &&
+            memcmp(entry.text, term.data(), term.size()) == 0) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void TermTable::grow() {
+    std::vector<uint32_t> slots(slots_.size() * 2, 0);
+    const size_t mask = slots.size() - 1;
+    for (size_t id = 0; id < entries_.size(); ++id) {
+        size_t slot = entries_[id].hash & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = static_cast<uint32_t>(id + 1);
+    }
+    slots_.swap(slots);
+}
+
+uint32_t TermTable::intern(std::string_view term) {
+    const uint64_t hash = fnv1a(term);
+    size_t slot = slotFor(hash, term);
+    if (slots_[slot] != 0) {
+        return slots_[slot] - 1;
+    }
+
+    // Keep the load factor under one half so probe runs stay short
+    if ((entries_.size() + 1) * 2 > slots_.size()) {
+        grow();
+        slot = slotFor(hash, term);
+    }
+
+    const auto id = static_cast<uint32_t>(entries_.size());
+    entries_.push_back({hash, arena_.copy(term.data(), term.size()), static_cast<uint32_t>(term.size())});
+    slots_[slot] = id + 1;
+    return id;
+}
+
+int64_t TermTable::find(std::string_view term) const {
+    const uint32_t slot_value = slots_[slotFor(fnv1a(term), term)];
+    return slot_value == 0 ? -1 : static_cast<int64_t>(slot_value - 1);
+}
+
+TermDictionary* TermDictionary::build(const char* data, size_t size) {
+    // Offsets are stored as 32 bits
+    if (size > std::numeric_limits<uint32_t>::max()) {
+        return nullptr;
+    }
+
+    try {
+        std::unique_ptr<TermDictionary> dictionary(new TermDictionary());
+        Tokenizer tokenizer(data, size);
+        std::string_view term;
+        size_t offset;
+
+        while (tokenizer.next(term, offset)) {
+            const uint32_t id = dictionary->table_.intern(term);
+            if (id == dictionary->occurrences_.size()) {
+                dictionary->occurrences_.emplace_back();
+            }
+            dictionary->occurrences_[id].push_back(static_cast<uint32_t>(offset));
+            ++dictionary->total_tokens_;
+        }
+        return dictionary.release();
+    } catch (...) {
+        metrics::reportException(metrics::Module::Terms, "build");
+        return nullptr;
+    }
+}
+
+TermDictionary* TermDictionary::buildFromFile(const std::string& path) {
+    std::string data;
+    if (!readFile(path, data)) {
+        return nullptr;
+    }
+    return build(data.data(), data.size());
+}
+
+TermDictionary* TermDictionary::load(const std::string& path) {
+    try {
+        std::string data;
+        if (!readFile(path, data)) {
+            return nullptr;
+        }
+
+        Reader reader(data);
+        std::string_view magic;
+        uint32_t version, term_count;
+        uint64_t total_tokens;
+        if (!reader.bytes(4, magic) || magic != std::string_view(kDictionaryMagic, 4) ||
+            !reader.u32(version) || version != kFormatVersion ||
+            !reader.u64(total_tokens) || !reader.u32(term_count)) {
+            return nullptr;
+        }
+
+        std::unique_ptr<TermDictionary> dictionary(new TermDictionary());
+        dictionary->total_tokens_ = total_tokens;
+        dictionary->occurrences_.reserve(term_count);
+
+        for (uint32_t i = 0; i < term_count; ++i) {
+            uint8_t length;
+            std::string_view term;
+            uint32_t count;
+            if (!reader.u8(length) || !reader.bytes(length, term) || !reader.u32(count)) {
+                return nullptr;
+            }
+
+            if (dictionary->table_.intern(term) != i) {
+                return nullptr; // duplicate term, corrupt file
+            }
+
+            std::vector<uint32_t> offsets(count);
+            uint32_t offset = 0;
+            for (uint32_t j = 0; j < count; ++j) {
+                uint32_t delta;
+                if (!reader.varint(delta)) return nullptr;
+                offset += delta;
+                offsets[j] = offset;
+            }
+            dictionary->occurrences_.push_back(std::move(offsets));
+        }
+
+        return dictionary.release();
+    } catch (...) {
+        metrics::reportException(metrics::Module::Terms, "load");
+        return nullptr;
+    }
+}
+
+bool TermDictionary::save(const std::string& path) const {
+    try {
+        Writer writer;
+        writer.bytes(std::string_view(kDictionaryMagic, 4));
+        writer.u32(kFormatVersion);
+        writer.u64(total_tokens_);
+        writer.u32(static_cast<uint32_t>(table_.size()));
+
+        // Offsets are ascending, so deltas keep most of them to one or two bytes
+        for (uint32_t id = 0; id < table_.size(); ++id) {
+            const std::string_view term = table_.term(id);
+            writer.u8(static_cast<uint8_t>(term.size()));
+            writer.bytes(term);
+            writer.u32(static_cast<uint32_t>(occurrences_[id].size()));
+
+            uint32_t previous = 0;
+            for (uint32_t offset : occurrences_[id]) {
+                writer.varint(offset - previous);
+                previous = offset;
+            }
+        }
+
+        return writer.writeTo(path);
+    } catch (...) {
+        metrics::reportException(metrics::Module::Terms, "save");
+        return false;
+    }
+}
+
+int64_t TermDictionary::lookup(const std::string& word) const {
+    Tokenizer tokenizer(word.data(), word.size());
+    std::string_view term;
+    size_t offset;
+    if (!tokenizer.next(term, offset)) {
+        return -1;
+    }
+    return table_.find(term);
+}
+
+uint32_t TermDictionary::count(const std::string& word) const {
+    const int64_t id = lookup(word);
+    return id < 0 ? 0 : static_cast<uint32_t>(occurrences_[id].size());
+}
+
+const std::vector<uint32_t>* TermDictionary::occurrences(const std::string& word) const {
+    const int64_t id = lookup(word);
+    return id < 0 ? nullptr : &occurrences_[id];
+}
+
+std::vector<ScoredTerm> TermDictionary::topTerms(size_t k, const TermLibrary* library) const {
+    if (k == 0 || total_tokens_ == 0) {
+        return {};
+    }
+
+    // Min-heap of the best k seen so far; the root is the one to evict
+    using Candidate = std::pair<float, uint32_t>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> heap;
+
+    for (uint32_t id = 0; id < table_.size(); ++id) {
+        const std::string_view term = table_.term(id);
+        if (!isKeyTermCandidate(term)) continue;
+
+        const double tf = static_cast<double>(occurrences_[id].size()) / total_tokens_;
+        const auto score = static_cast<float>(library ? tf * library->idf(term) : tf);
+
+        if (heap.size() < k) {
+            heap.emplace(score, id);
+        } else if (score > heap.top().first) {
+            heap.pop();
+            heap.emplace(score, id);
+        }
+    }
+
+    std::vector<ScoredTerm> results(heap.size());
+    for (size_t i = results.size(); i > 0; --i) {
+        const Candidate& top = heap.top();
+        results[i - 1] = {std::string(table_.term(top.second)), top.first};
+        heap.pop();
+    }
+    return results;
+}
+
+TermLibrary* TermLibrary::create() {
+    return new TermLibrary();
+}
+
+TermLibrary* TermLibrary::load(const std::string& path) {
+    try {
+        std::string data;
+        if (!readFile(path, data)) {
+            return nullptr;
+        }
+
+        Reader reader(data);
+        std::string_view magic;
+        uint32_t version, book_count, term_count;
+        if (!reader.bytes(4, magic) || magic != std::string_view(kLibraryMagic, 4) ||
+            !reader.u32(version) || version != kFormatVersion || !reader.u32(book_count)) {
+            return nullptr;
+        }
+
+        std::unique_ptr<TermLibrary> library(new TermLibrary());
+        for (uint32_t i = 0; i < book_count; ++i) {
+            uint32_t length;
+            std::string_view book_id;
+            if (!reader.u32(length) || !reader.bytes(length, book_id)) return nullptr;
+            library->books_.emplace(book_id);
+        }
+
+        if (!reader.u32(term_count)) return nullptr;
+        for (uint32_t i = 0; i < term_count; ++i) {
+            uint8_t length;
+            std::string_view term;
+            uint32_t frequency;
+            if (!reader.u8(length) || !reader.bytes(length, term) || !reader.u32(frequency)) {
+                return nullptr;
+            }
+            if (library->table_.intern(term) != i) return nullptr;
+            library->document_frequency_.push_back(frequency);
+        }
+
+        return library.release();
+    } catch (...) {
+        metrics::reportException(metrics::Module::Terms, "library load");
+        return nullptr;
+    }
+}
+
+bool TermLibrary::save(const std::string& path) const {
+    try {
+        Writer writer;
+        writer.bytes(std::string_view(kLibraryMagic, 4));
+        writer.u32(kFormatVersion);
+
+        writer.u32(static_cast<uint32_t>(books_.size()));
+        for (const auto& book_id : books_) {
+            writer.u32(static_cast<uint32_t>(book_id.size()));
+            writer.bytes(book_id);
+        }
+
+        // Terms no book uses any more are dropped here
+        uint32_t live_terms = 0;
+        for (uint32_t frequency : document_frequency_) {
+            if (frequency > 0) ++live_terms;
+        }
+        writer.u32(live_terms);
+        for (uint32_t id = 0; id < table_.size(); ++id) {
+            if (document_frequency_[id] == 0) continue;
+            const std::string_view term = table_.term(id);
+            writer.u8(static_cast<uint8_t>(term.size()));
+            writer.bytes(term);
+            writer.u32(document_frequency_[id]);
+        }
+
+        return writer.writeTo(path);
+    } catch (...) {
+        metrics::reportException(metrics::Module::Terms, "library save");
+        return false;
+    }
+}
+
+bool TermLibrary::addBook(const std::string& book_id,
+                          const TermDictionary& dictionary,
+                          const TermDictionary* previous) {
+    try {
+        if (books_.count(book_id) > 0 && (!previous || !removeBook(book_id, *previous))) {
+            return false;
+        }
+        books_.insert(book_id);
+        for (uint32_t id = 0; id < dictionary.termCount(); ++id) {
+            const uint32_t term_id = table_.intern(dictionary.term(id));
+            if (term_id == document_frequency_.size()) {
+                document_frequency_.push_back(0);
+            }
+            ++document_frequency_[term_id];
+        }
+        return true;
+    } catch (...) {
+        metrics::reportException(metrics::Module::Terms, "library add");
+        return false;
+    }
+}
+
+bool TermLibrary::removeBook(const std::string& book_id, const TermDictionary& dictionary) {
+    if (books_.erase(book_id) == 0) {
+        return false;
+    }
+    for (uint32_t id = 0; id < dictionary.termCount(); ++id) {
+        const int64_t term_id = table_.find(dictionary.term(id));
+        if (term_id >= 0 && document_frequency_[term_id] > 0) {
+            --document_frequency_[term_id];
+        }
+    }
+    return true;
+}
+
+uint32_t TermLibrary::documentFrequency(std::string_view term) const {
+    const int64_t id = table_.find(term);
+    return id < 0 ? 0 : document_frequency_[id];
+}
+
+double TermLibrary::idf(std::string_view term) const {
+    const double books = static_cast<double>(books_.size());
+    return std::log((1.0 + books) / (1.0 + documentFrequency(term))) + 1.0;
+}
+
+// C API Implementation
+extern "C" {
+
+TermDictionary* terms_build(const char* text, size_t size) {
+    if (!text) return nullptr;
+    return TermDictionary::build(text, size);
+}
+
+TermDictionary* terms_build_from_file(const char* path) {
+    if (!path) return nullptr;
+    return TermDictionary::buildFromFile(path);
+}
+
+TermDictionary* terms_load(const char* path) {
+    if (!path) return nullptr;
+    return TermDictionary::load(path);
+}
+
+bool terms_save(TermDictionary* dictionary, const char* path) {
+    if (!dictionary || !path) return false;
+    return dictionary->save(path);
+}
+
+void terms_destroy(TermDictionary* dictionary) {
+    delete dictionary;
+}
+
+uint32_t terms_count(TermDictionary* dictionary, const char* word) {
+    if (!dictionary || !word) return 0;
+    return dictionary->count(word);
+}
+
+size_t terms_occurrences(TermDictionary* dictionary, const char* word, uint32_t* offsets_out, size_t max_offsets) {
+    if (!dictionary || !word) return 0;
+
+    const std::vector<uint32_t>* offsets = dictionary->occurrences(word);
+    if (!offsets) return 0;
+
+    if (offsets_out) {
+        const size_t copy_count = std::min(max_offsets, offsets->size());
+        std::copy(offsets->begin(), offsets->begin() + copy_count, offsets_out);
+    }
+    return offsets->size();
+}
+
+size_t terms_top_k(TermDictionary* dictionary,
+                   TermLibrary* library,
+                   size_t k,
+                   char* terms_out,
+                   size_t terms_size,
+                   float* scores_out) {
+    if (!dictionary || !terms_out || terms_size == 0) return 0;
+
+    size_t written = 0;
+    size_t used = 0;
+    for (const auto& scored : dictionary->topTerms(k, library)) {
+        if (used + scored.term.size() + 1 >= terms_size) break;
+        memcpy(terms_out + used, scored.term.data(), scored.term.size());
+        used += scored.term.size();
+        terms_out[used++] = '\n';
+        if (scores_out) scores_out[written] = scored.score;
+        ++written;
+    }
+    terms_out[used] = '\0';
+    return written;
+}
+
+TermLibrary* terms_library_create() {
+    return TermLibrary::create();
+}
+
+TermLibrary* terms_library_load(const char* path) {
+    if (!path) return nullptr;
+    return TermLibrary::load(path);
+}
+
+bool terms_library_save(TermLibrary* library, const char* path) {
+    if (!library || !path) return false;
+    return library->save(path);
+}
+
+void terms_library_destroy(TermLibrary* library) {
+    delete library;
+}
+
+bool terms_library_add_book(TermLibrary* library, const char* book_id, TermDictionary* dictionary) {
+    if (!library || !book_id || !dictionary) return false;
+    return library->addBook(book_id, *dictionary);
+}
+
+bool terms_library_remove_book(TermLibrary* library, const char* book_id, TermDictionary* dictionary) {
+    if (!library || !book_id || !dictionary) return false;
+    return library->removeBook(book_id, *dictionary);
+}
+
+} // extern "C"
+
+} // namespace terms
+} // namespace bookmark
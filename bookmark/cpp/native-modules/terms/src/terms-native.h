@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace bookmark {
+namespace terms {
+
+// Words longer than this (URLs, base64 blobs) are skipped
+constexpr size_t kMaxTermBytes = 64;
+
+// Bump allocator for term bytes. Copies stay valid until the arena is destroyed.
+class Arena {
+public:
+    explicit Arena(size_t block_size = 64 * 1024) : block_size_(block_size) {}
+
+    const char* copy(const char* data, size_t size);
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    size_t block_size_;
+    size_t offset_ = 0;
+};
+
+// Splits UTF-8 text into lowercased words with their byte offsets. Bytes are
+// classified through a 256-entry table so the inner loops stay branch-light.
+// Non-ASCII letters are kept verbatim (no Unicode case folding); typographic
+// quotes, dashes and other Latin-1/general punctuation separate words.
+class Tokenizer {
+public:
+    Tokenizer(const char* data, size_t size) : data_(data), size_(size) {}
+
+    // term points into an internal buffer valid until the next call
+    bool next(std::string_view& term, size_t& offset);
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    char buffer_[kMaxTermBytes];
+};
+
+// Open-addressing hash table assigning dense ids to terms
+class TermTable {
+public:
+    TermTable();
+
+    uint32_t intern(std::string_view term);
+    // Returns -1 when the term is unknown
+    int64_t find(std::string_view term) const;
+    std::string_view term(uint32_t id) const { return {entries_[id].text, entries_[id].length}; }
+    size_t size() const { return entries_.size(); }
+
+private:
+    struct Entry {
+        uint64_t hash;
+        const char* text;
+        uint32_t length;
+    };
+
+    size_t slotFor(uint64_t hash, std::string_view term) const;
+    void grow();
+
+    Arena arena_;
+    std::vector<uint32_t> slots_; // id + 1, 0 marks an empty slot
+    std::vector<Entry> entries_;
+};
+
+struct ScoredTerm {
+    std::string term;
+    float score;
+};
+
+class TermLibrary;
+
+// Per-book term statistics: occurrence offsets for every word, persisted
+// next to the book's index so word lookups don't rescan the text.
+class TermDictionary {
+public:
+    static TermDictionary* build(const char* data, size_t size);
+    static TermDictionary* buildFromFile(const std::string& path);
+    static TermDictionary* load(const std::string& path);
+    ~TermDictionary() = default;
+
+    bool save(const std::string& path) const;
+
+    // Lookups normalize the word the same way the tokenizer does
+    uint32_t count(const std::string& word) const;
+    const std::vector<uint32_t>* occurrences(const std::string& word) const;
+
+    // Highest scoring terms, skipping stopwords, numbers and words under
+    // three bytes. Scores are TF-IDF against the library when one is
+    // given, plain term frequency otherwise.
+    std::vector<ScoredTerm> topTerms(size_t k, const TermLibrary* library = nullptr) const;
+
+    size_t termCount() const { return table_.size(); }
+    uint64_t totalTokens() const { return total_tokens_; }
+    std::string_view term(uint32_t id) const { return table_.term(id); }
+
+private:
+    TermDictionary() = default;
+
+    int64_t lookup(const std::string& word) const;
+
+    TermTable table_;
+    std::vector<std::vector<uint32_t>> occurrences_;
+    uint64_t total_tokens_ = 0;
+};
+
+// Document frequencies across every book in the user's library, used as the
+// IDF side of TF-IDF. Books are tracked by id, so each counts once.
+class TermLibrary {
+public:
+    static TermLibrary* create();
+    static TermLibrary* load(const std::string& path);
+    ~TermLibrary() = default;
+
+    bool save(const std::string& path) const;
+
+    // Re-adding a book replaces it. previous must then be the dictionary it
+    // was last added with, whose counts are taken back first; without it
+    // re-adding fails and the library is left as it was.
+    bool addBook(const std::string& book_id,
+                 const TermDictionary& dictionary,
+                 const TermDictionary* previous = nullptr);
+    bool removeBook(const std::string& book_id, const TermDictionary& dictionary);
+
+    uint32_t bookCount() const { return static_cast<uint32_t>(books_.size()); }
+    uint32_t documentFrequency(std::string_view term) const;
+    // Smoothed inverse document frequency, 1.0 for an empty library
+    double idf(std::string_view term) const;
+
+private:
+    TermLibrary() = default;
+
+    TermTable table_;
+    std::vector<uint32_t> document_frequency_;
+    std::unordered_set<std::string> books_;
+};
+
+// React Native binding interface
+extern "C" {
+    TermDictionary* terms_build(const char* text, size_t size);
+    TermDictionary* terms_build_from_file(const char* path);
+    TermDictionary* terms_load(const char* path);
+    bool terms_save(TermDictionary* dictionary, const char* path);
+    void terms_destroy(TermDictionary* dictionary);
+    uint32_t terms_count(TermDictionary* dictionary, const char* word);
+    // Copies up to max_offsets byte offsets and returns the total number of occurrences
+    size_t terms_occurrences(TermDictionary* dictionary, const char* word, uint32_t* offsets_out, size_t max_offsets);
+    // Writes the terms as a newline separated list and returns how many were written
+    size_t terms_top_k(TermDictionary* dictionary,
+                       TermLibrary* library,
+                       size_t k,
+                       char* terms_out,
+                       size_t terms_size,
+                       float* scores_out);
+
+    TermLibrary* terms_library_create();
+    TermLibrary* terms_library_load(const char* path);
+    bool terms_library_save(TermLibrary* library, const char* path);
+    void terms_library_destroy(TermLibrary* library);
+    bool terms_library_add_book(TermLibrary* library, const char* book_id, TermDictionary* dictionary);
+    bool terms_library_remove_book(TermLibrary* library, const char* book_id, TermDictionary* dictionary);
+}
+
+} // namespace terms
+} // namespace bookmark
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "chunk-store-native.h"
+
+using namespace bookmark::chunk_store;
+
+namespace {
+
+float fromBits(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// A fresh database in the temp directory, removed with its WAL files
+class TempStore {
+public:
+    TempStore() {
+        char path[] = "/tmp/chunk-store-test-XXXXXX";
+        int fd = mkstemp(path);
+        if (fd >= 0) close(fd);
+        path_ = path;
+        store_.reset(ChunkStore::open(path_));
+    }
+    ~TempStore() {
+        store_.reset();
+        for (const char* suffix : {"", "-wal", "-shm"}) {
+            std::remove((path_ + suffix).c_str());
+        }
+    }
+
+    ChunkStore* get() const { return store_.get(); }
+
+private:
+    std::string path_;
+    std::unique_ptr<ChunkStore> store_;
+};
+
+std::vector<ChunkRecord> records(size_t count) {
+    std::vector<ChunkRecord> chunks(count);
+    for (size_t i = 0; i < count; ++i) {
+        chunks[i].text = "chunk " + std::to_string(i);
+    }
+    return chunks;
+}
+
+std::vector<float> embeddings(size_t count, int dimension, float seed) {
+    std::vector<float> values(count * dimension);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = std::sin(seed + static_cast<float>(i));
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(HalfFloat, ExactValuesRoundTrip) {
+    for (float value : {0.0f, 1.0f, -2.5f, 0.5f, 65504.0f, -65504.0f, 6.103515625e-05f}) {
+        EXPECT_EQ(fromHalf(toHalf(value)), value) << value;
+    }
+    EXPECT_EQ(toHalf(1.0f), 0x3C00);
+    EXPECT_EQ(toHalf(-0.0f), 0x8000);
+}
+
+TEST(HalfFloat, RoundsToNearestEven) {
+    // Halfway between 1 and the next half (1 + 2^-10) goes to the even 1
+    EXPECT_EQ(toHalf(1.0f + std::ldexp(1.0f, -11)), 0x3C00);
+    // Halfway above 1 + 2^-10 goes up to the even 1 + 2^-9
+    EXPECT_EQ(toHalf(1.0f + 3 * std::ldexp(1.0f, -11)), 0x3C02);
+    // Just past halfway rounds up
+    EXPECT_EQ(toHalf(1.0f + std::ldexp(1.0f, -11) + std::ldexp(1.0f, -20)), 0x3C01);
+    // Rounding the largest mantissa carries into the exponent
+    EXPECT_EQ(toHalf(2.0f - std::ldexp(1.0f, -12)), 0x4000);
+}
+
+TEST(HalfFloat, Subnormals) {
+    const float smallest = std::ldexp(1.0f, -24);
+    EXPECT_EQ(toHalf(smallest), 0x0001);
+    EXPECT_EQ(fromHalf(0x0001), smallest);
+    EXPECT_EQ(toHalf(-smallest), 0x8001);
+    EXPECT_EQ(fromHalf(0x03FF), std::ldexp(1023.0f, -24));
+    EXPECT_EQ(toHalf(std::ldexp(1023.0f, -24)), 0x03FF);
+
+    // Half the smallest subnormal ties to even zero; anything more rounds up
+    EXPECT_EQ(toHalf(std::ldexp(1.0f, -25)), 0x0000);
+    EXPECT_EQ(toHalf(std::ldexp(1.5f, -25)), 0x0001);
+    EXPECT_EQ(toHalf(std::ldexp(1.0f, -30)), 0x0000);
+
+    // The largest subnormal rounds up into the smallest normal
+    EXPECT_EQ(toHalf(std::ldexp(1023.75f, -24)), 0x0400);
+
+    // Every subnormal half survives a round trip
+    for (uint16_t half = 1; half < 0x400; ++half) {
+        EXPECT_EQ(toHalf(fromHalf(half)), half);
+    }
+}
+
+TEST(HalfFloat, InfinityAndNaN) {
+    const float inf = std::numeric_limits<float>::infinity();
+    EXPECT_EQ(toHalf(inf), 0x7C00);
+    EXPECT_EQ(toHalf(-inf), 0xFC00);
+    EXPECT_EQ(fromHalf(0x7C00), inf);
+    EXPECT_EQ(fromHalf(0xFC00), -inf);
+
+    // Past the largest half overflows to infinity
+    EXPECT_EQ(toHalf(65520.0f), 0x7C00);
+    EXPECT_EQ(toHalf(1e10f), 0x7C00);
+
+    // NaN stays NaN, including one whose payload is only in the low bits
+    EXPECT_TRUE(std::isnan(fromHalf(toHalf(std::numeric_limits<float>::quiet_NaN()))));
+    EXPECT_TRUE(std::isnan(fromHalf(toHalf(fromBits(0x7F800001)))));
+}
+
+TEST(HalfFloat, AllNormalHalvesRoundTrip) {
+    for (uint32_t half = 0x0400; half < 0x7C00; ++half) {
+        EXPECT_EQ(toHalf(fromHalf(static_cast<uint16_t>(half))), half);
+        EXPECT_EQ(toHalf(fromHalf(static_cast<uint16_t>(half | 0x8000))), half | 0x8000);
+    }
+}
+
+TEST(PackEmbedding, Float16IsLittleEndian) {
+    const float values[] = {1.0f, -2.0f};
+    std::string blob;
+    packEmbedding(values, 2, EmbeddingFormat::Float16, blob);
+    ASSERT_EQ(blob.size(), 4u);
+    EXPECT_EQ(static_cast<uint8_t>(blob[0]), 0x00);
+    EXPECT_EQ(static_cast<uint8_t>(blob[1]), 0x3C);
+    EXPECT_EQ(static_cast<uint8_t>(blob[2]), 0x00);
+    EXPECT_EQ(static_cast<uint8_t>(blob[3]), 0xC0);
+}
+
+TEST(PackEmbedding, RoundTrips) {
+    const std::vector<float> values = embeddings(1, 64, 0.25f);
+    std::vector<float> out(values.size());
+    std::string blob;
+
+    packEmbedding(values.data(), 64, EmbeddingFormat::Float32, blob);
+    ASSERT_TRUE(unpackEmbedding(blob.data(), blob.size(), 64, EmbeddingFormat::Float32, out.data()));
+    EXPECT_EQ(out, values);
+
+    packEmbedding(values.data(), 64, EmbeddingFormat::Float16, blob);
+    ASSERT_TRUE(unpackEmbedding(blob.data(), blob.size(), 64, EmbeddingFormat::Float16, out.data()));
+    for (size_t i = 0; i < values.size(); ++i) {
+        // Within half a unit in the last place of an 11-bit significand
+        EXPECT_NEAR(out[i], values[i], std::ldexp(std::fabs(values[i]), -11) + 1e-7f);
+    }
+
+    // The wrong width for the format is rejected
+    EXPECT_FALSE(unpackEmbedding(blob.data(), blob.size(), 64, EmbeddingFormat::Float32, out.data()));
+    EXPECT_FALSE(unpackEmbedding(blob.data(), blob.size() - 2, 64, EmbeddingFormat::Float16, out.data()));
+}
+
+TEST(ChunkStoreBuildIndex, BuildsContiguousBook) {
+    TempStore store;
+    ASSERT_NE(store.get(), nullptr);
+
+    const int dimension = 8;
+    const auto values = embeddings(5, dimension, 1.0f);
+    ASSERT_TRUE(store.get()->addChunks("book", 0, records(5), values.data(), dimension));
+
+    std::unique_ptr<bookmark::faiss::FaissIndex> index(store.get()->buildIndex("book"));
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index->size(), 5u);
+}
+
+TEST(ChunkStoreBuildIndex, RejectsGaps) {
+    TempStore store;
+    ASSERT_NE(store.get(), nullptr);
+
+    // Chunks 0-2 and 5-6; 3 and 4 are missing
+    const int dimension = 8;
+    const auto head = embeddings(3, dimension, 1.0f);
+    const auto tail = embeddings(2, dimension, 2.0f);
+    ASSERT_TRUE(store.get()->addChunks("book", 0, records(3), head.data(), dimension));
+    ASSERT_TRUE(store.get()->addChunks("book", 5, records(2), tail.data(), dimension));
+    EXPECT_EQ(store.get()->buildIndex("book"), nullptr);
+
+    // Filling the gap makes the book buildable again
+    const auto middle = embeddings(2, dimension, 3.0f);
+    ASSERT_TRUE(store.get()->addChunks("book", 3, records(2), middle.data(), dimension));
+    std::unique_ptr<bookmark::faiss::FaissIndex> index(store.get()->buildIndex("book"));
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index->size(), 7u);
+}
+
+TEST(ChunkStoreBuildIndex, RejectsMissingFirstChunk) {
+    TempStore store;
+    ASSERT_NE(store.get(), nullptr);
+
+    const int dimension = 8;
+    const auto values = embeddings(2, dimension, 1.0f);
+    ASSERT_TRUE(store.get()->addChunks("book", 1, records(2), values.data(), dimension));
+    EXPECT_EQ(store.get()->buildIndex("book"), nullptr);
+    EXPECT_EQ(store.get()->buildIndex("other"), nullptr);
+}
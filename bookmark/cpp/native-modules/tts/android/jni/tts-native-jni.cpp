@@ -1,7 +1,12 @@
 #include <jni.h>
+#include <memory>
 #include <string>
 #include <vector>
+#include <fbjni/fbjni.h>
+#include <ReactCommon/CallInvokerHolder.h>
 #include "tts-native.h"
+#include "tts-jsi.h"
+#include "request-jni.h"
 #include <android/log.h>
 
 #define LOG_TAG "TTSNative"
@@ -10,10 +15,23 @@
 
 using namespace bookmark::tts;
 
+namespace {
+
+// The context as seen by the JSI functions, which run on the JS thread and
+// the scheduler rather than the module's thread
+std::shared_ptr<ContextSlot> context_slot = std::make_shared<ContextSlot>();
+
+} // namespace
+
 extern "C" {
 
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
+    // fbjni unwraps the CallInvokerHolder handed to installNative
+    return facebook::jni::initialize(vm, [] {});
+}
+
 JNIEXPORT jlong JNICALL
-Java_com_bookmark_TTSModule_createContext(
+Java_com_bookmark_TTSModule_createContextNative(
     JNIEnv* env,
     jobject thiz,
     jstring model_path,
@@ -26,22 +44,25 @@ Java_com_bookmark_TTSModule_createContext(
     
     env->ReleaseStringUTFChars(model_path, m_path);
     env->ReleaseStringUTFChars(config_path, c_path);
-    
+
+    context_slot->set(ctx);
     return reinterpret_cast<jlong>(ctx);
 }
 
 JNIEXPORT void JNICALL
-Java_com_bookmark_TTSModule_destroyContext(
+Java_com_bookmark_TTSModule_destroyContextNative(
     JNIEnv* env,
     jobject thiz,
     jlong context_ptr
 ) {
     auto* ctx = reinterpret_cast<TTSContext*>(context_ptr);
+    // Waits for a JSI synthesis still using it
+    context_slot->clear(ctx);
     tts_destroy_context(ctx);
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_bookmark_TTSModule_loadModel(
+Java_com_bookmark_TTSModule_loadModelNative(
     JNIEnv* env,
     jobject thiz,
     jlong context_ptr
@@ -50,8 +71,53 @@ Java_com_bookmark_TTSModule_loadModel(
     return tts_load_model(ctx);
 }
 
-JNIEXPORT jfloatArray JNICALL
-Java_com_bookmark_TTSModule_synthesize(
+// Returns as soon as the text is queued; the listener gets the samples as
+// floats, synthesized at their exact length
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_TTSModule_synthesizeAsyncNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong context_ptr,
+    jstring text,
+    jobject listener
+) {
+    auto* ctx = reinterpret_cast<TTSContext*>(context_ptr);
+    const char* input = env->GetStringUTFChars(text, nullptr);
+
+    auto* request_listener = bookmark::scheduler::RequestListener::create(env, listener);
+    bookmark::scheduler::Request* request = tts_synthesize_async(
+        ctx, input, bookmark::scheduler::RequestListener::onComplete, request_listener);
+    env->ReleaseStringUTFChars(text, input);
+
+    return bookmark::scheduler::RequestListener::submitted(env, request_listener, request);
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_TTSModule_setCacheDirectoryNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong context_ptr,
+    jstring cache_dir
+) {
+    auto* ctx = reinterpret_cast<TTSContext*>(context_ptr);
+    const char* dir = env->GetStringUTFChars(cache_dir, nullptr);
+    tts_set_cache_dir(ctx, dir);
+    env->ReleaseStringUTFChars(cache_dir, dir);
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_TTSModule_setSampleRateNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong context_ptr,
+    jint sample_rate
+) {
+    auto* ctx = reinterpret_cast<TTSContext*>(context_ptr);
+    tts_set_sample_rate(ctx, sample_rate);
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_bookmark_TTSModule_synthesizeToFileNative(
     JNIEnv* env,
     jobject thiz,
     jlong context_ptr,
@@ -59,27 +125,69 @@ Java_com_bookmark_TTSModule_synthesize(
 ) {
     auto* ctx = reinterpret_cast<TTSContext*>(context_ptr);
     const char* input = env->GetStringUTFChars(text, nullptr);
-    
-    // Allocate a large enough buffer for audio samples
-    const size_t max_samples = 1024 * 1024; // 1M samples
-    std::vector<float> audio_buffer(max_samples);
-    
-    size_t num_samples = tts_synthesize(
-        ctx,
-        input,
-        audio_buffer.data(),
-        max_samples
-    );
-    
+
+    char path[1024];
+    size_t length = tts_synthesize_to_file(ctx, input, path, sizeof(path));
+
     env->ReleaseStringUTFChars(text, input);
-    
-    if (num_samples == 0) {
+
+    if (length == 0) {
+        LOGE("Failed to synthesize to file");
         return nullptr;
     }
-    
-    jfloatArray result = env->NewFloatArray(num_samples);
-    env->SetFloatArrayRegion(result, 0, num_samples, audio_buffer.data());
+
+    return env->NewStringUTF(path);
+}
+
+JNIEXPORT jfloatArray JNICALL
+Java_com_bookmark_TTSModule_getLastStatsNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong context_ptr
+) {
+    auto* ctx = reinterpret_cast<TTSContext*>(context_ptr);
+    TTSSynthesisStats stats;
+    if (!tts_get_last_stats(ctx, &stats)) {
+        return nullptr;
+    }
+
+    const jfloat values[] = {
+        static_cast<jfloat>(stats.phonemize_ms),
+        static_cast<jfloat>(stats.inference_ms),
+        static_cast<jfloat>(stats.total_ms),
+        static_cast<jfloat>(stats.sentences),
+        static_cast<jfloat>(stats.batches),
+        static_cast<jfloat>(stats.phoneme_cache_hits),
+        static_cast<jfloat>(stats.phoneme_cache_misses),
+    };
+
+    jfloatArray result = env->NewFloatArray(7);
+    env->SetFloatArrayRegion(result, 0, 7, values);
     return result;
 }
 
-} // extern "C"
\ No newline at end of file
+// Called on the JS thread with the jsi::Runtime behind the JavaScriptContextHolder
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_TTSModule_installNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong runtime_ptr,
+    jobject call_invoker_holder
+) {
+    auto* runtime = reinterpret_cast<facebook::jsi::Runtime*>(runtime_ptr);
+    if (!runtime || !call_invoker_holder) {
+        return false;
+    }
+
+    try {
+        auto holder = facebook::jni::wrap_alias(
+            static_cast<facebook::react::CallInvokerHolder::javaobject>(call_invoker_holder));
+        installJsi(*runtime, holder->cthis()->getCallInvoker(), context_slot);
+        return true;
+    } catch (const std::exception& e) {
+        LOGE("Failed to install JSI bindings: %s", e.what());
+        return false;
+    }
+}
+
+} // extern "C"
@@ -5,7 +5,10 @@ import com.facebook.react.bridge.ReactContextBaseJavaModule;
 import com.facebook.react.bridge.ReactMethod;
 import com.facebook.react.bridge.Promise;
 import com.facebook.react.bridge.WritableArray;
+import com.facebook.react.bridge.WritableMap;
 import com.facebook.react.bridge.Arguments;
+import com.facebook.react.bridge.JavaScriptContextHolder;
+import com.facebook.react.turbomodule.core.CallInvokerHolderImpl;
 
 public class TTSModule extends ReactContextBaseJavaModule {
     private long contextPtr = 0;
@@ -23,9 +26,37 @@ public class TTSModule extends ReactContextBaseJavaModule {
         return "TTSNative";
     }
 
+    // Native handle shared with the voice pipeline module
+    long getContextPtr() {
+        return contextPtr;
+    }
+
+    // Installs global.TTSNativeJSI, whose synthesize returns an ArrayBuffer
+    // instead of copying samples element by element through the bridge. JS
+    // falls back to the promise methods below when this returns false, e.g.
+    // under a remote debugger.
+    @ReactMethod(isBlockingSynchronousMethod = true)
+    public boolean install() {
+        ReactApplicationContext context = getReactApplicationContext();
+        JavaScriptContextHolder jsContext = context.getJavaScriptContextHolder();
+        if (jsContext == null || jsContext.get() == 0) {
+            return false;
+        }
+        return installNative(jsContext.get(), (CallInvokerHolderImpl) context.getJSCallInvokerHolder());
+    }
+
+    private void destroyContext() {
+        if (contextPtr != 0) {
+            destroyContextNative(contextPtr);
+            contextPtr = 0;
+        }
+    }
+
     @ReactMethod
     public void createContext(String modelPath, String configPath, Promise promise) {
         try {
+            // Replacing the context would otherwise leak the loaded voice
+            destroyContext();
             contextPtr = createContextNative(modelPath, configPath);
             promise.resolve(contextPtr != 0);
         } catch (Exception e) {
@@ -50,10 +81,7 @@ public class TTSModule extends ReactContextBaseJavaModule {
     @ReactMethod
     public void cleanup(Promise promise) {
         try {
-            if (contextPtr != 0) {
-                destroyContextNative(contextPtr);
-                contextPtr = 0;
-            }
+            destroyContext();
             promise.resolve(null);
         } catch (Exception e) {
             promise.reject("ERR_TTS", "Failed to cleanup TTS context: " + e.getMessage());
@@ -67,18 +95,93 @@ public class TTSModule extends ReactContextBaseJavaModule {
                 throw new IllegalStateException("TTS context not initialized");
             }
 
-            float[] audioSamples = synthesizeNative(contextPtr, text);
-            if (audioSamples == null) {
+            // Synthesized on a native worker so the bridge thread stays free
+            // for the other modules' calls
+            synthesizeAsyncNative(contextPtr, text, (unused, audioSamples, ints, error) -> {
+                if (error != null) {
+                    promise.reject("ERR_TTS", "Failed to synthesize text: " + error);
+                    return;
+                }
+
+                WritableArray result = Arguments.createArray();
+                for (float sample : audioSamples) {
+                    result.pushDouble(sample);
+                }
+                promise.resolve(result);
+            });
+        } catch (Exception e) {
+            promise.reject("ERR_TTS", "Failed to synthesize text: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void setCacheDirectory(String cacheDir, Promise promise) {
+        try {
+            if (contextPtr == 0) {
+                throw new IllegalStateException("TTS context not initialized");
+            }
+
+            setCacheDirectoryNative(contextPtr, cacheDir);
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_TTS", "Failed to set cache directory: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void setSampleRate(int sampleRate, Promise promise) {
+        try {
+            if (contextPtr == 0) {
+                throw new IllegalStateException("TTS context not initialized");
+            }
+
+            setSampleRateNative(contextPtr, sampleRate);
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_TTS", "Failed to set sample rate: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void synthesizeToFile(String text, Promise promise) {
+        try {
+            if (contextPtr == 0) {
+                throw new IllegalStateException("TTS context not initialized");
+            }
+
+            String path = synthesizeToFileNative(contextPtr, text);
+            if (path == null) {
                 throw new IllegalStateException("Failed to synthesize audio");
             }
+            promise.resolve(path);
+        } catch (Exception e) {
+            promise.reject("ERR_TTS", "Failed to synthesize text: " + e.getMessage());
+        }
+    }
 
-            WritableArray result = Arguments.createArray();
-            for (float sample : audioSamples) {
-                result.pushDouble(sample);
+    @ReactMethod
+    public void getLastStats(Promise promise) {
+        try {
+            if (contextPtr == 0) {
+                throw new IllegalStateException("TTS context not initialized");
+            }
+
+            float[] stats = getLastStatsNative(contextPtr);
+            if (stats == null) {
+                throw new IllegalStateException("No synthesis stats available");
             }
+
+            WritableMap result = Arguments.createMap();
+            result.putDouble("phonemizeMs", stats[0]);
+            result.putDouble("inferenceMs", stats[1]);
+            result.putDouble("totalMs", stats[2]);
+            result.putInt("sentences", (int) stats[3]);
+            result.putInt("batches", (int) stats[4]);
+            result.putInt("phonemeCacheHits", (int) stats[5]);
+            result.putInt("phonemeCacheMisses", (int) stats[6]);
             promise.resolve(result);
         } catch (Exception e) {
-            promise.reject("ERR_TTS", "Failed to synthesize text: " + e.getMessage());
+            promise.reject("ERR_TTS", "Failed to get synthesis stats: " + e.getMessage());
         }
     }
 
@@ -86,5 +189,10 @@ public class TTSModule extends ReactContextBaseJavaModule {
     private native long createContextNative(String modelPath, String configPath);
     private native void destroyContextNative(long contextPtr);
     private native boolean loadModelNative(long contextPtr);
-    private native float[] synthesizeNative(long contextPtr, String text);
+    private native boolean synthesizeAsyncNative(long contextPtr, String text, NativeRequestListener listener);
+    private native void setCacheDirectoryNative(long contextPtr, String cacheDir);
+    private native void setSampleRateNative(long contextPtr, int sampleRate);
+    private native String synthesizeToFileNative(long contextPtr, String text);
+    private native float[] getLastStatsNative(long contextPtr);
+    private native boolean installNative(long jsRuntimePtr, CallInvokerHolderImpl callInvokerHolder);
 }
\ No newline at end of file
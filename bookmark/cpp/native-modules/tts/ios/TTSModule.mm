@@ -1,21 +1,28 @@
 #import "TTSModule.h"
 #import <React/RCTLog.h>
+#import <React/RCTBridge+Private.h>
 #import "tts-native.h"
+#import "tts-jsi.h"
+#import "NativeRequest.h"
 #import <AVFoundation/AVFoundation.h>
 
 using namespace bookmark::tts;
 
 @implementation TTSModule {
     TTSContext* _context;
+    std::shared_ptr<ContextSlot> _slot; // context as seen by the JSI functions
     AVAudioEngine* _audioEngine;
     AVAudioPlayerNode* _playerNode;
 }
 
 RCT_EXPORT_MODULE()
 
+@synthesize bridge = _bridge;
+
 - (instancetype)init {
     if (self = [super init]) {
         _context = nullptr;
+        _slot = std::make_shared<ContextSlot>();
         _audioEngine = [[AVAudioEngine alloc] init];
         _playerNode = [[AVAudioPlayerNode alloc] init];
         [_audioEngine attachNode:_playerNode];
@@ -27,18 +34,43 @@ RCT_EXPORT_MODULE()
 
 - (void)dealloc {
     if (_context != nullptr) {
+        _slot->clear(_context);
         tts_destroy_context(_context);
         _context = nullptr;
     }
     [_audioEngine stop];
 }
 
+- (void*)nativeHandle {
+    return _context;
+}
+
+// Installs global.TTSNativeJSI (see tts-jsi.h) on the JS thread. JS falls
+// back to the promise methods below when this returns NO, e.g. under a
+// remote debugger.
+RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(install) {
+    RCTCxxBridge* bridge = (RCTCxxBridge*)self.bridge;
+    auto* runtime = static_cast<facebook::jsi::Runtime*>(bridge.runtime);
+    if (runtime == nullptr) {
+        return @NO;
+    }
+
+    try {
+        installJsi(*runtime, bridge.jsCallInvoker, _slot);
+        return @YES;
+    } catch (const std::exception& e) {
+        RCTLogError(@"Failed to install JSI bindings: %s", e.what());
+        return @NO;
+    }
+}
+
 RCT_EXPORT_METHOD(createContext:(NSString*)modelPath
                   configPath:(NSString*)configPath
                   resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     @try {
         if (_context != nullptr) {
+            _slot->clear(_context);
             tts_destroy_context(_context);
         }
 
@@ -46,6 +78,7 @@ RCT_EXPORT_METHOD(createContext:(NSString*)modelPath
             [modelPath UTF8String],
             [configPath UTF8String]
         );
+        _slot->set(_context);
         resolve(@(_context != nullptr));
     } @catch (NSException* e) {
         reject(@"ERR_TTS", @"Failed to create TTS context", nil);
@@ -71,6 +104,7 @@ RCT_EXPORT_METHOD(cleanup:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     @try {
         if (_context != nullptr) {
+            _slot->clear(_context);
             tts_destroy_context(_context);
             _context = nullptr;
         }
@@ -89,59 +123,134 @@ RCT_EXPORT_METHOD(synthesize:(NSString*)text
             return;
         }
 
-        // Allocate buffer for audio samples (1M samples = ~23 seconds at 44.1kHz)
-        const size_t max_samples = 1024 * 1024;
-        float* audio_buffer = (float*)malloc(max_samples * sizeof(float));
+        AVAudioPlayerNode* playerNode = _playerNode;
+        double sampleRate = tts_get_sample_rate(_context);
 
-        size_t num_samples = tts_synthesize(
-            _context,
-            [text UTF8String],
-            audio_buffer,
-            max_samples
-        );
+        // Synthesized on a native worker, at the exact length, so the module
+        // queue stays free
+        void* done = NativeRequestRetain(^(bookmark::scheduler::Request* request) {
+            const std::vector<float>& audio = request->floats;
+            if (!request->succeeded() || audio.empty()) {
+                reject(@"ERR_TTS", @"Failed to synthesize text", nil);
+                return;
+            }
+            AVAudioFrameCount num_samples = static_cast<AVAudioFrameCount>(audio.size());
+
+            // Create audio buffer list
+            AVAudioFormat* format = [[AVAudioFormat alloc]
+                initWithCommonFormat:AVAudioPCMFormatFloat32
+                sampleRate:sampleRate
+                channels:1
+                interleaved:NO
+            ];
+
+            AVAudioPCMBuffer* pcmBuffer = [[AVAudioPCMBuffer alloc]
+                initWithPCMFormat:format
+                frameCapacity:num_samples
+            ];
+            pcmBuffer.frameLength = num_samples;
+
+            // Copy audio data
+            memcpy(pcmBuffer.floatChannelData[0], audio.data(), num_samples * sizeof(float));
 
-        if (num_samples == 0) {
-            free(audio_buffer);
+            // Play audio
+            [playerNode stop];
+            [playerNode scheduleBuffer:pcmBuffer atTime:nil options:AVAudioPlayerNodeBufferInterrupts completionHandler:nil];
+            [playerNode play];
+
+            // Convert to array for JS
+            NSMutableArray* result = [NSMutableArray arrayWithCapacity:num_samples];
+            for (float sample : audio) {
+                [result addObject:@(sample)];
+            }
+            resolve(result);
+        });
+        if (!tts_synthesize_async(_context, [text UTF8String], NativeRequestComplete, done)) {
+            NativeRequestDiscard(done);
             reject(@"ERR_TTS", @"Failed to synthesize text", nil);
+        }
+    } @catch (NSException* e) {
+        reject(@"ERR_TTS", @"Failed to synthesize text", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(setCacheDirectory:(NSString*)cacheDir
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_context == nullptr) {
+            reject(@"ERR_TTS", @"TTS context not initialized", nil);
+            return;
+        }
+
+        tts_set_cache_dir(_context, [cacheDir UTF8String]);
+        resolve(nil);
+    } @catch (NSException* e) {
+        reject(@"ERR_TTS", @"Failed to set cache directory", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(setSampleRate:(nonnull NSNumber*)sampleRate
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_context == nullptr) {
+            reject(@"ERR_TTS", @"TTS context not initialized", nil);
             return;
         }
 
-        // Create audio buffer list
-        AVAudioFormat* format = [[AVAudioFormat alloc] 
-            initWithCommonFormat:AVAudioPCMFormatFloat32
-            sampleRate:44100
-            channels:1
-            interleaved:NO
-        ];
-
-        AVAudioPCMBuffer* pcmBuffer = [[AVAudioPCMBuffer alloc]
-            initWithPCMFormat:format
-            frameCapacity:num_samples
-        ];
-        pcmBuffer.frameLength = num_samples;
-
-        // Copy audio data
-        memcpy(pcmBuffer.floatChannelData[0], audio_buffer, num_samples * sizeof(float));
-        free(audio_buffer);
-
-        // Play audio
-        [_playerNode stop];
-        [_playerNode scheduleBuffer:pcmBuffer atTime:nil options:AVAudioPlayerNodeBufferInterrupts completionHandler:nil];
-        [_playerNode play];
-
-        // Convert to array for JS
-        NSMutableArray* result = [NSMutableArray arrayWithCapacity:num_samples];
-        float* samples = pcmBuffer.floatChannelData[0];
-        for (size_t i = 0; i < num_samples; i++) {
-            [result addObject:@(samples[i])];
+        tts_set_sample_rate(_context, [sampleRate intValue]);
+        resolve(nil);
+    } @catch (NSException* e) {
+        reject(@"ERR_TTS", @"Failed to set sample rate", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(synthesizeToFile:(NSString*)text
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        if (_context == nullptr) {
+            reject(@"ERR_TTS", @"TTS context not initialized", nil);
+            return;
+        }
+
+        char path[PATH_MAX];
+        size_t length = tts_synthesize_to_file(_context, [text UTF8String], path, sizeof(path));
+        if (length == 0) {
+            reject(@"ERR_TTS", @"Failed to synthesize text", nil);
+            return;
         }
 
-        resolve(result);
+        resolve(@(path));
     } @catch (NSException* e) {
         reject(@"ERR_TTS", @"Failed to synthesize text", nil);
     }
 }
 
+RCT_EXPORT_METHOD(getLastStats:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        TTSSynthesisStats stats;
+        if (!tts_get_last_stats(_context, &stats)) {
+            reject(@"ERR_TTS", @"TTS context not initialized", nil);
+            return;
+        }
+
+        resolve(@{
+            @"phonemizeMs": @(stats.phonemize_ms),
+            @"inferenceMs": @(stats.inference_ms),
+            @"totalMs": @(stats.total_ms),
+            @"sentences": @(stats.sentences),
+            @"batches": @(stats.batches),
+            @"phonemeCacheHits": @(stats.phoneme_cache_hits),
+            @"phonemeCacheMisses": @(stats.phoneme_cache_misses)
+        });
+    } @catch (NSException* e) {
+        reject(@"ERR_TTS", @"Failed to get synthesis stats", nil);
+    }
+}
+
 - (dispatch_queue_t)methodQueue {
     return dispatch_get_main_queue();
 }
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "jsi-bridge.h"
+#include "tts-native.h"
+
+namespace bookmark {
+namespace tts {
+
+using ContextSlot = bridge::HandleSlot<TTSContext>;
+
+// Installs global.TTSNativeJSI for the platform bridges.
+//
+//   synthesize(text: string): Promise<ArrayBuffer>
+//
+// The buffer holds Float32 samples at the context's sample rate and is the
+// synthesized vector itself, handed to JS without a copy.
+inline void installJsi(facebook::jsi::Runtime& runtime,
+                       std::shared_ptr<facebook::react::CallInvoker> invoker,
+                       std::shared_ptr<ContextSlot> slot) {
+    namespace jsi = facebook::jsi;
+
+    jsi::Object binding(runtime);
+
+    binding.setProperty(runtime, "synthesize", bridge::function(runtime, "synthesize", 1,
+        [invoker, slot](jsi::Runtime& rt, const jsi::Value* args, size_t) {
+            std::string text = args[0].asString(rt).utf8(rt);
+
+            return bridge::runAsync<std::vector<float>>(rt, invoker,
+                [slot, text]() {
+                    return slot->with([&](TTSContext* ctx) {
+                        if (!ctx) throw std::runtime_error("TTS context not initialized");
+                        std::vector<float> samples = ctx->synthesize(text);
+                        if (samples.empty()) throw std::runtime_error("Failed to synthesize audio");
+                        return samples;
+                    });
+                },
+                [](jsi::Runtime& rt, std::vector<float>& samples) {
+                    return jsi::Value(rt, bridge::toArrayBuffer(rt, std::move(samples)));
+                });
+        }));
+
+    runtime.global().setProperty(runtime, "TTSNativeJSI", binding);
+}
+
+} // namespace tts
+} // namespace bookmark
@@ -1,24 +1,292 @@
 #include "tts-native.h"
+#include "metrics-native.h"
+#include "residency-native.h"
+#include "scheduler-native.h"
 #include <stdexcept>
 #include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <ctime>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
 
 namespace bookmark {
 namespace tts {
 
+namespace {
+
+void putLE16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value & 0xff));
+    out.push_back(static_cast<uint8_t>((value >> 8) & 0xff));
+}
+
+void putLE32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<uint8_t>((value >> shift) & 0xff));
+    }
+}
+
+void putTag(std::vector<uint8_t>& out, const char* tag) {
+    out.insert(out.end(), tag, tag + 4);
+}
+
+// FNV-1a, used to derive stable cache file names from synthesized content
+uint64_t fnv1a(const std::string& data, uint64_t hash = 1469598103934665603ULL) {
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Initial size of the reusable phoneme id buffer
+constexpr size_t kTypicalSentencePhonemes = 384;
+// Piper's default sentence_silence, appended after every sentence
+constexpr float kSentenceSilenceSeconds = 0.2f;
+constexpr size_t kPhonemeCacheEntries = 512;
+
+// Rendered WAVs kept on disk; the least recently used go past this. The
+// cache directory is only purged by the OS under storage pressure.
+constexpr int64_t kMaxFileCacheBytes = 32LL * 1024 * 1024;
+constexpr const char* kTempPrefix = "render-";
+// Temporaries older than this were left by a crashed write
+constexpr time_t kStaleTempSeconds = 600;
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Split text into sentences on terminal punctuation, collapsing whitespace
+// so equivalent sentences share a phoneme cache entry
+std::vector<std::string> splitSentences(const std::string& text) {
+    std::vector<std::string> sentences;
+    std::string current;
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            if (!current.empty() && current.back() != ' ') {
+                current += ' ';
+            }
+            continue;
+        }
+
+        current += c;
+        bool terminal = c == '.' || c == '!' || c == '?';
+        bool boundary = i + 1 == text.size() || text[i + 1] == ' ' || text[i + 1] == '\n';
+        if (terminal && boundary) {
+            sentences.push_back(current);
+            current.clear();
+        }
+    }
+
+    while (!current.empty() && current.back() == ' ') {
+        current.pop_back();
+    }
+    if (!current.empty()) {
+        sentences.push_back(current);
+    }
+    return sentences;
+}
+
+bool fileExists(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && st.st_size > 44;
+}
+
+bool endsWith(const std::string& value, const char* suffix) {
+    size_t length = strlen(suffix);
+    return value.size() >= length && value.compare(value.size() - length, length, suffix) == 0;
+}
+
+bool writeAll(int fd, const uint8_t* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) return false;
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// Removes the least recently used WAVs (by modification time, which cache
+// hits refresh) until the directory holds at most max_bytes, never removing
+// keep. Leftover temporaries from interrupted writes go too.
+void trimFileCache(const std::string& dir, const std::string& keep, int64_t max_bytes) {
+    struct CachedFile {
+        std::string path;
+        time_t mtime;
+        int64_t bytes;
+    };
+
+    DIR* handle = opendir(dir.c_str());
+    if (!handle) return;
+
+    std::vector<CachedFile> files;
+    int64_t total = 0;
+    time_t now = time(nullptr);
+    while (dirent* entry = readdir(handle)) {
+        std::string name = entry->d_name;
+        std::string path = dir + "/" + name;
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+
+        if (name.compare(0, strlen(kTempPrefix), kTempPrefix) == 0) {
+            if (now - st.st_mtime > kStaleTempSeconds) unlink(path.c_str());
+            continue;
+        }
+        if (!endsWith(name, ".wav")) continue;
+
+        files.push_back({path, st.st_mtime, static_cast<int64_t>(st.st_size)});
+        total += st.st_size;
+    }
+    closedir(handle);
+
+    if (total <= max_bytes) return;
+    std::sort(files.begin(), files.end(), [](const CachedFile& a, const CachedFile& b) {
+        return a.mtime < b.mtime;
+    });
+    for (const auto& file : files) {
+        if (total <= max_bytes) break;
+        if (file.path == keep) continue;
+        if (unlink(file.path.c_str()) == 0) total -= file.bytes;
+    }
+}
+
+} // namespace
+
+std::vector<uint8_t> encodeWavPcm16(const std::vector<float>& samples, int sample_rate) {
+    const uint16_t channels = 1;
+    const uint16_t bits_per_sample = 16;
+    const uint32_t data_size = static_cast<uint32_t>(samples.size() * sizeof(int16_t));
+
+    std::vector<uint8_t> wav;
+    wav.reserve(44 + data_size);
+
+    putTag(wav, "RIFF");
+    putLE32(wav, 36 + data_size);
+    putTag(wav, "WAVE");
+
+    putTag(wav, "fmt ");
+    putLE32(wav, 16);
+    putLE16(wav, 1); // PCM
+    putLE16(wav, channels);
+    putLE32(wav, static_cast<uint32_t>(sample_rate));
+    putLE32(wav, static_cast<uint32_t>(sample_rate) * channels * bits_per_sample / 8);
+    putLE16(wav, channels * bits_per_sample / 8);
+    putLE16(wav, bits_per_sample);
+
+    putTag(wav, "data");
+    putLE32(wav, data_size);
+    for (float sample : samples) {
+        float clamped = std::max(-1.0f, std::min(1.0f, sample));
+        putLE16(wav, static_cast<uint16_t>(static_cast<int16_t>(clamped * 32767.0f)));
+    }
+
+    return wav;
+}
+
+bool PhonemeCache::get(const std::string& key, std::vector<int64_t>& ids) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return false;
+    }
+
+    entries_.splice(entries_.begin(), entries_, it->second);
+    ids = it->second->second;
+    return true;
+}
+
+void PhonemeCache::put(const std::string& key, const std::vector<int64_t>& ids) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        it->second->second = ids;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+    }
+
+    entries_.emplace_front(key, ids);
+    index_[key] = entries_.begin();
+
+    if (index_.size() > capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+}
+
+void PhonemeCache::clear() {
+    entries_.clear();
+    index_.clear();
+}
+
 TTSContext* TTSContext::create(const std::string& model_path, const std::string& config_path) {
     return new TTSContext(model_path, config_path);
 }
 
 TTSContext::TTSContext(const std::string& model_path, const std::string& config_path)
-    : model_path_(model_path), config_path_(config_path) {}
+    : model_path_(model_path),
+      config_path_(config_path),
+      phoneme_cache_(kPhonemeCacheEntries) {
+    scheduler::lendContext(this, typeid(TTSContext));
+}
 
 TTSContext::~TTSContext() {
-    ctx_.reset();
+    scheduler::retireContext(this);
+    pending_.drain();
+    residency::ResidencyManager::instance().unregisterComponent(residency_id_);
+    if (ctx_) {
+        ctx_.reset();
+        metrics::addGauge(metrics::Gauge::TtsModelBytes, -model_bytes_);
+    }
 }
 
 bool TTSContext::loadModel() {
     if (is_loaded_) return true;
 
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!loadVoice()) return false;
+    }
+    is_loaded_ = true;
+
+    // The cheapest component to drop: caches go first, then the voice
+    residency::ComponentCallbacks callbacks;
+    callbacks.load = [this]() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return loadVoice();
+    };
+    callbacks.unload = [this]() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ctx_.reset();
+        releaseBuffers();
+        metrics::addGauge(metrics::Gauge::TtsModelBytes, -model_bytes_);
+        return true;
+    };
+    callbacks.trim = [this]() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return releaseBuffers();
+    };
+    residency_id_ = residency::ResidencyManager::instance().registerComponent(
+        "tts", residency::PRIORITY_TTS, model_bytes_, std::move(callbacks));
+    return true;
+}
+
+int64_t TTSContext::releaseBuffers() {
+    int64_t freed = static_cast<int64_t>(audio_arena_.capacity() * sizeof(float) +
+                                         scratch_ids_.capacity() * sizeof(int64_t));
+    std::vector<float>().swap(audio_arena_);
+    std::vector<int64_t>().swap(scratch_ids_);
+    phoneme_cache_.clear();
+    return freed;
+}
+
+bool TTSContext::loadVoice() {
     try {
         // Initialize Piper TTS model with configuration
         piper::PiperConfig config;
@@ -26,9 +294,17 @@ bool TTSContext::loadModel() {
         config.config_path = config_path_;
         
         ctx_ = std::make_unique<piper::PiperContext>(config);
-        is_loaded_ = true;
+
+        // The ONNX session lives as long as the context; size the reusable
+        // buffers for a typical reply (~10s of audio) up front
+        scratch_ids_.reserve(kTypicalSentencePhonemes);
+        audio_arena_.reserve(static_cast<size_t>(sample_rate_.load()) * 10);
+
+        model_bytes_ = metrics::pathBytes(model_path_);
+        metrics::addGauge(metrics::Gauge::TtsModelBytes, model_bytes_);
         return true;
     } catch (...) {
+        metrics::reportException(metrics::Module::Tts, "load model");
         return false;
     }
 }
@@ -38,16 +314,159 @@ std::vector<float> TTSContext::synthesize(const std::string& text) {
         throw std::runtime_error("Model not loaded");
     }
 
+    residency::Lease lease(residency_id_);
+    // The binding doesn't expose Piper's thread count; count the caller against the cap
+    scheduler::Reservation threads(1);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!lease || !ctx_) {
+        return std::vector<float>();
+    }
+    TTSSynthesisStats stats = {};
+    auto total_start = Clock::now();
+
     try {
-        // Generate audio samples from text
         std::vector<float> audio_samples;
-        ctx_->synthesize(text, audio_samples);
+        std::vector<std::string> sentences = splitSentences(text);
+        stats.sentences = static_cast<int>(sentences.size());
+
+        // One inference per sentence: each phoneme sequence carries its own
+        // BOS/EOS pair, and the voices are trained on single utterances, so
+        // packing several into one input runs sentences together and
+        // changes their prosody. Sentences are separated by Piper's
+        // sentence silence instead.
+        const size_t silence = static_cast<size_t>(kSentenceSilenceSeconds * sample_rate_.load());
+        for (const auto& sentence : sentences) {
+            const std::vector<int64_t>& ids = phonemesFor(sentence, stats);
+            if (ids.empty()) continue;
+
+            auto start = Clock::now();
+            audio_arena_.clear();
+            ctx_->synthesizeIds(ids, audio_arena_);
+            stats.inference_ms += elapsedMs(start);
+            stats.batches++;
+
+            audio_samples.insert(audio_samples.end(), audio_arena_.begin(), audio_arena_.end());
+            audio_samples.insert(audio_samples.end(), silence, 0.0f);
+        }
+
+        stats.total_ms = elapsedMs(total_start);
+        last_stats_ = stats;
+
+        metrics::recordLatency(metrics::Histogram::Synthesize, static_cast<uint64_t>(stats.total_ms * 1000.0));
+        metrics::increment(metrics::Counter::AudioMsSynthesized,
+                           audio_samples.size() * 1000 / static_cast<size_t>(sample_rate_.load()));
         return audio_samples;
     } catch (...) {
+        metrics::reportException(metrics::Module::Tts, "synthesize");
         return std::vector<float>();
     }
 }
 
+const std::vector<int64_t>& TTSContext::phonemesFor(const std::string& sentence,
+                                                    TTSSynthesisStats& stats) {
+    if (phoneme_cache_.get(sentence, scratch_ids_)) {
+        stats.phoneme_cache_hits++;
+        return scratch_ids_;
+    }
+
+    auto start = Clock::now();
+    scratch_ids_.clear();
+    ctx_->phonemize(sentence, scratch_ids_);
+    stats.phonemize_ms += elapsedMs(start);
+    stats.phoneme_cache_misses++;
+
+    phoneme_cache_.put(sentence, scratch_ids_);
+    return scratch_ids_;
+}
+
+std::string TTSContext::synthesizeToFile(const std::string& text) {
+    std::string cache_dir = cacheDirectory();
+    if (!is_loaded_ || cache_dir.empty()) {
+        return "";
+    }
+
+    // One rate for the cache key and the encoding, even if it changes meanwhile
+    int sample_rate = sample_rate_.load();
+    std::string path = cachePathFor(cache_dir, text, sample_rate);
+    if (fileExists(path)) {
+        // Marks the entry as recently used for eviction
+        utimes(path.c_str(), nullptr);
+        return path;
+    }
+
+    std::vector<float> samples = synthesize(text);
+    if (samples.empty()) {
+        return "";
+    }
+
+    std::vector<uint8_t> wav = encodeWavPcm16(samples, sample_rate);
+
+    // Write to a temporary file unique to this call and rename, so neither a
+    // partially written entry nor two concurrent renderings of the same text
+    // can leave a torn file behind as a cache hit
+    std::string tmp_path = cache_dir + "/" + kTempPrefix + "XXXXXX";
+    int fd = mkstemp(&tmp_path[0]);
+    if (fd < 0) {
+        metrics::reportError(metrics::Module::Tts, "synthesize to file", "cannot create cache file");
+        return "";
+    }
+    bool written = writeAll(fd, wav.data(), wav.size());
+    written = close(fd) == 0 && written;
+
+    if (!written || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        unlink(tmp_path.c_str());
+        return "";
+    }
+
+    trimFileCache(cache_dir, path, kMaxFileCacheBytes);
+    return path;
+}
+
+void TTSContext::setCacheDirectory(const std::string& cache_dir) {
+    std::string dir = cache_dir;
+    while (dir.size() > 1 && dir.back() == '/') {
+        dir.pop_back();
+    }
+    if (!dir.empty()) {
+        mkdir(dir.c_str(), 0755);
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    cache_dir_ = dir;
+}
+
+std::string TTSContext::cacheDirectory() const {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    return cache_dir_;
+}
+
+void TTSContext::setSampleRate(int sample_rate) {
+    if (sample_rate > 0) {
+        sample_rate_ = sample_rate;
+    }
+}
+
+int TTSContext::sampleRate() const {
+    return sample_rate_.load();
+}
+
+TTSSynthesisStats TTSContext::lastStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_stats_;
+}
+
+std::string TTSContext::cachePathFor(const std::string& cache_dir, const std::string& text, int sample_rate) const {
+    // Key on the voice as well as the text so switching models never
+    // replays audio rendered by a different voice
+    uint64_t hash = fnv1a(model_path_);
+    hash = fnv1a(std::to_string(sample_rate), hash);
+    hash = fnv1a(text, hash);
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.wav", static_cast<unsigned long long>(hash));
+    return cache_dir + "/" + name;
+}
+
 // C API Implementation
 extern "C" {
 
@@ -79,10 +498,64 @@ size_t tts_synthesize(TTSContext* ctx,
         std::copy(samples.begin(), samples.begin() + size, audio_out);
         return size;
     } catch (...) {
+        metrics::reportException(metrics::Module::Tts, "synthesize");
         return 0;
     }
 }
 
+void tts_set_cache_dir(TTSContext* ctx, const char* cache_dir) {
+    if (ctx && cache_dir) ctx->setCacheDirectory(cache_dir);
+}
+
+void tts_set_sample_rate(TTSContext* ctx, int sample_rate) {
+    if (ctx) ctx->setSampleRate(sample_rate);
+}
+
+int tts_get_sample_rate(TTSContext* ctx) {
+    return ctx ? ctx->sampleRate() : 0;
+}
+
+size_t tts_synthesize_to_file(TTSContext* ctx,
+                              const char* text,
+                              char* path_out,
+                              size_t path_size) {
+    if (!ctx || !text || !path_out || path_size == 0) return 0;
+
+    try {
+        std::string path = ctx->synthesizeToFile(text);
+        if (path.empty() || path.size() >= path_size) {
+            return 0;
+        }
+
+        memcpy(path_out, path.c_str(), path.size() + 1);
+        return path.size();
+    } catch (...) {
+        metrics::reportException(metrics::Module::Tts, "synthesize to file");
+        return 0;
+    }
+}
+
+bool tts_get_last_stats(TTSContext* ctx, TTSSynthesisStats* stats_out) {
+    if (!ctx || !stats_out) return false;
+    *stats_out = ctx->lastStats();
+    return true;
+}
+
+scheduler::Request* tts_synthesize_async(TTSContext* ctx,
+                                         const char* text,
+                                         scheduler::RequestCallback callback,
+                                         void* user_data) {
+    if (!ctx || !text) return nullptr;
+
+    std::string input = text;
+    return scheduler::Request::submit(
+        [ctx, input](scheduler::Request& request) {
+            request.floats = ctx->synthesize(input);
+            if (request.floats.empty()) request.fail("Failed to synthesize audio");
+        },
+        callback, user_data, &ctx->pendingRequests());
+}
+
 } // extern "C"
 
 } // namespace tts
@@ -1,13 +1,51 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <memory>
 #include <vector>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include "piper/piper.h"
+#include "scheduler-native.h"
 
 namespace bookmark {
 namespace tts {
 
+// Encode mono float samples in [-1, 1] as a 16-bit PCM RIFF/WAVE file image
+std::vector<uint8_t> encodeWavPcm16(const std::vector<float>& samples, int sample_rate);
+
+// Per-call timing and cache statistics for the last synthesize() call
+struct TTSSynthesisStats {
+    double phonemize_ms;
+    double inference_ms;
+    double total_ms;
+    int sentences;
+    int batches;    // inferences run, one per sentence
+    int phoneme_cache_hits;
+    int phoneme_cache_misses;
+};
+
+// LRU cache of phoneme ids keyed by normalized sentence text
+class PhonemeCache {
+public:
+    explicit PhonemeCache(size_t capacity) : capacity_(capacity) {}
+
+    bool get(const std::string& key, std::vector<int64_t>& ids);
+    void put(const std::string& key, const std::vector<int64_t>& ids);
+    void clear();
+    size_t size() const { return index_.size(); }
+
+private:
+    using Entry = std::pair<std::string, std::vector<int64_t>>;
+
+    size_t capacity_;
+    std::list<Entry> entries_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+};
+
 class TTSContext {
 public:
     static TTSContext* create(const std::string& model_path, const std::string& config_path);
@@ -16,13 +54,46 @@ public:
     bool loadModel();
     std::vector<float> synthesize(const std::string& text);
 
+    // Synthesize straight to a WAV file, reusing a cached rendering of the
+    // same text when one exists. Returns the path of the WAV file, or an
+    // empty string on failure. The cache directory is kept under a size cap
+    // by evicting the least recently used renderings.
+    std::string synthesizeToFile(const std::string& text);
+
+    void setCacheDirectory(const std::string& cache_dir);
+    void setSampleRate(int sample_rate);
+    int sampleRate() const;
+
+    TTSSynthesisStats lastStats() const;
+
+    scheduler::PendingRequests& pendingRequests() { return pending_; }
+
 private:
     TTSContext(const std::string& model_path, const std::string& config_path);
 
+    bool loadVoice();
+    // Frees the reusable buffers and the phoneme cache, returning the bytes released
+    int64_t releaseBuffers();
+    std::string cacheDirectory() const;
+    std::string cachePathFor(const std::string& cache_dir, const std::string& text, int sample_rate) const;
+    const std::vector<int64_t>& phonemesFor(const std::string& sentence, TTSSynthesisStats& stats);
+
     std::string model_path_;
     std::string config_path_;
+    std::string cache_dir_;           // guarded by cache_mutex_
+    mutable std::mutex cache_mutex_;
     std::unique_ptr<piper::PiperContext> ctx_;
-    bool is_loaded_ = false;
+    PhonemeCache phoneme_cache_;
+    std::vector<float> audio_arena_;    // reused inference output buffer
+    std::vector<int64_t> scratch_ids_;
+    TTSSynthesisStats last_stats_ = {};
+    mutable std::mutex mutex_;
+    int64_t model_bytes_ = 0;
+    uint32_t residency_id_ = 0; // see residency-native.h
+    // Read by scheduler workers without mutex_
+    std::atomic<int> sample_rate_{22050}; // Piper medium voices
+    std::atomic<bool> is_loaded_{false};
+    scheduler::PendingRequests pending_;
 };
 
 // C API declarations for TTS
@@ -32,8 +103,20 @@ TTSContext* tts_create_context(const char* model_path, const char* config_path);
 void tts_destroy_context(TTSContext* ctx);
 bool tts_load_model(TTSContext* ctx);
 size_t tts_synthesize(TTSContext* ctx, const char* text, float* audio_out, size_t max_samples);
+void tts_set_cache_dir(TTSContext* ctx, const char* cache_dir);
+void tts_set_sample_rate(TTSContext* ctx, int sample_rate);
+int tts_get_sample_rate(TTSContext* ctx);
+size_t tts_synthesize_to_file(TTSContext* ctx, const char* text, char* path_out, size_t path_size);
+bool tts_get_last_stats(TTSContext* ctx, TTSSynthesisStats* stats_out);
+
+// Synthesizes on the shared scheduler; the request's floats hold the
+// samples at tts_get_sample_rate(). Null if the arguments are invalid.
+scheduler::Request* tts_synthesize_async(TTSContext* ctx,
+                                         const char* text,
+                                         scheduler::RequestCallback callback,
+                                         void* user_data);
 
 } // extern "C"
 
 } // namespace tts
-} // namespace bookmark
\ No newline at end of file
+} // namespace bookmark
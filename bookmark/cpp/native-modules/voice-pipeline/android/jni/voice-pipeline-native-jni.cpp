@@ -0,0 +1,233 @@
+#include <jni.h>
+#include <string>
+#include <vector>
+#include "voice-pipeline-native.h"
+#include <android/log.h>
+
+#define LOG_TAG "VoicePipelineNative"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+using namespace bookmark::voice;
+
+namespace {
+
+// Owns the pipeline together with the Java module that receives its events
+struct PipelineHandle {
+    VoicePipeline* pipeline;
+    JavaVM* vm;
+    jobject module;
+    jmethodID on_event;
+};
+
+// Detaches pipeline worker threads from the VM when they exit
+struct ThreadAttachment {
+    JavaVM* vm = nullptr;
+    ~ThreadAttachment() {
+        if (vm) vm->DetachCurrentThread();
+    }
+};
+
+thread_local ThreadAttachment attachment;
+
+JNIEnv* envForCurrentThread(JavaVM* vm) {
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) == JNI_OK) {
+        return env;
+    }
+    if (vm->AttachCurrentThread(reinterpret_cast<void**>(&env), nullptr) != JNI_OK) {
+        return nullptr;
+    }
+    attachment.vm = vm;
+    return env;
+}
+
+void onPipelineEvent(const VoicePipelineEvent* event, void* user_data) {
+    auto* handle = static_cast<PipelineHandle*>(user_data);
+    JNIEnv* env = envForCurrentThread(handle->vm);
+    if (!env) {
+        LOGE("Failed to attach pipeline thread");
+        return;
+    }
+
+    jstring text = env->NewStringUTF(event->text ? event->text : "");
+
+    jfloatArray audio = nullptr;
+    if (event->audio && event->audio_size > 0) {
+        audio = env->NewFloatArray(event->audio_size);
+        env->SetFloatArrayRegion(audio, 0, event->audio_size, event->audio);
+    }
+
+    const jfloat timing_values[] = {
+        static_cast<jfloat>(event->timings.transcribe_ms),
+        static_cast<jfloat>(event->timings.retrieve_ms),
+        static_cast<jfloat>(event->timings.first_token_ms),
+        static_cast<jfloat>(event->timings.first_audio_ms),
+        static_cast<jfloat>(event->timings.total_ms),
+    };
+    jfloatArray timings = env->NewFloatArray(5);
+    env->SetFloatArrayRegion(timings, 0, 5, timing_values);
+
+    env->CallVoidMethod(
+        handle->module,
+        handle->on_event,
+        static_cast<jint>(event->type),
+        text,
+        audio,
+        static_cast<jint>(event->sample_rate),
+        static_cast<jint>(event->count),
+        timings
+    );
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+    }
+
+    env->DeleteLocalRef(text);
+    if (audio) env->DeleteLocalRef(audio);
+    env->DeleteLocalRef(timings);
+}
+
+} // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_bookmark_VoicePipelineModule_createPipelineNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong whisper_ptr,
+    jlong llm_ptr,
+    jlong index_ptr,
+    jlong tts_ptr
+) {
+    VoicePipeline* pipeline = voice_pipeline_create(
+        reinterpret_cast<bookmark::whisper::WhisperContext*>(whisper_ptr),
+        reinterpret_cast<bookmark::mlc_llm::LLMContext*>(llm_ptr),
+        reinterpret_cast<bookmark::faiss::FaissIndex*>(index_ptr),
+        reinterpret_cast<bookmark::tts::TTSContext*>(tts_ptr)
+    );
+    if (!pipeline) {
+        LOGE("Failed to create voice pipeline");
+        return 0;
+    }
+
+    auto* handle = new PipelineHandle();
+    handle->pipeline = pipeline;
+    env->GetJavaVM(&handle->vm);
+    handle->module = env->NewGlobalRef(thiz);
+    handle->on_event = env->GetMethodID(
+        env->FindClass("com/bookmark/VoicePipelineModule"),
+        "onNativeEvent",
+        "(ILjava/lang/String;[FII[F)V"
+    );
+
+    voice_pipeline_set_callback(pipeline, onPipelineEvent, handle);
+    return reinterpret_cast<jlong>(handle);
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_VoicePipelineModule_destroyPipelineNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong handle_ptr
+) {
+    auto* handle = reinterpret_cast<PipelineHandle*>(handle_ptr);
+    if (!handle) return;
+
+    voice_pipeline_destroy(handle->pipeline);
+    env->DeleteGlobalRef(handle->module);
+    delete handle;
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_VoicePipelineModule_setChunksNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong handle_ptr,
+    jobjectArray chunks
+) {
+    auto* handle = reinterpret_cast<PipelineHandle*>(handle_ptr);
+    if (!handle) return;
+
+    jsize count = env->GetArrayLength(chunks);
+    std::vector<std::string> texts;
+    texts.reserve(count);
+    for (jsize i = 0; i < count; ++i) {
+        auto chunk = static_cast<jstring>(env->GetObjectArrayElement(chunks, i));
+        const char* utf = env->GetStringUTFChars(chunk, nullptr);
+        texts.emplace_back(utf);
+        env->ReleaseStringUTFChars(chunk, utf);
+        env->DeleteLocalRef(chunk);
+    }
+
+    std::vector<const char*> pointers;
+    pointers.reserve(texts.size());
+    for (const auto& text : texts) {
+        pointers.push_back(text.c_str());
+    }
+    voice_pipeline_set_chunks(handle->pipeline, pointers.data(), pointers.size());
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_VoicePipelineModule_setGenerationNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong handle_ptr,
+    jint top_k,
+    jint max_tokens,
+    jfloat temperature,
+    jfloat top_p
+) {
+    auto* handle = reinterpret_cast<PipelineHandle*>(handle_ptr);
+    if (!handle) return;
+    voice_pipeline_set_generation(handle->pipeline, top_k, max_tokens, temperature, top_p);
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_VoicePipelineModule_setContextsNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong handle_ptr,
+    jlong whisper_ptr,
+    jlong llm_ptr,
+    jlong index_ptr,
+    jlong tts_ptr
+) {
+    auto* handle = reinterpret_cast<PipelineHandle*>(handle_ptr);
+    if (!handle) return;
+    voice_pipeline_set_contexts(
+        handle->pipeline,
+        reinterpret_cast<bookmark::whisper::WhisperContext*>(whisper_ptr),
+        reinterpret_cast<bookmark::mlc_llm::LLMContext*>(llm_ptr),
+        reinterpret_cast<bookmark::faiss::FaissIndex*>(index_ptr),
+        reinterpret_cast<bookmark::tts::TTSContext*>(tts_ptr)
+    );
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_VoicePipelineModule_runTurnNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong handle_ptr,
+    jstring wav_path
+) {
+    auto* handle = reinterpret_cast<PipelineHandle*>(handle_ptr);
+    if (!handle) return false;
+
+    const char* path = env->GetStringUTFChars(wav_path, nullptr);
+    bool success = voice_pipeline_run_turn_file(handle->pipeline, path);
+    env->ReleaseStringUTFChars(wav_path, path);
+    return success;
+}
+
+JNIEXPORT void JNICALL
+Java_com_bookmark_VoicePipelineModule_cancelNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong handle_ptr
+) {
+    auto* handle = reinterpret_cast<PipelineHandle*>(handle_ptr);
+    if (handle) voice_pipeline_cancel(handle->pipeline);
+}
+
+} // extern "C"
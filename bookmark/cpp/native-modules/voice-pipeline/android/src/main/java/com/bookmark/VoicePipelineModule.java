@@ -0,0 +1,295 @@
+package com.bookmark;
+
+import android.media.AudioAttributes;
+import android.media.AudioFormat;
+import android.media.AudioTrack;
+
+import com.facebook.react.bridge.ReactApplicationContext;
+import com.facebook.react.bridge.ReactContextBaseJavaModule;
+import com.facebook.react.bridge.ReactMethod;
+import com.facebook.react.bridge.Promise;
+import com.facebook.react.bridge.ReadableArray;
+import com.facebook.react.bridge.WritableMap;
+import com.facebook.react.bridge.Arguments;
+import com.facebook.react.modules.core.DeviceEventManagerModule;
+
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicInteger;
+
+public class VoicePipelineModule extends ReactContextBaseJavaModule {
+    private static final String EVENT_NAME = "onVoicePipelineEvent";
+    private static final String[] EVENT_TYPES = {
+        "transcript", "retrieved", "token", "sentence", "audio", "done", "error"
+    };
+    private static final int EVENT_AUDIO = 4;
+
+    // Samples written to the track per call, so a cancel stops playback
+    // within about this long
+    private static final int PLAYBACK_SLICE_MS = 100;
+
+    // Changed only on the bridge thread. A pipeline is destroyed on
+    // turnExecutor after it is swapped out, so it outlives any turn still
+    // running or queued on it.
+    private volatile long pipelinePtr = 0;
+    private final ExecutorService turnExecutor = Executors.newSingleThreadExecutor();
+    private final ExecutorService audioExecutor = Executors.newSingleThreadExecutor();
+    // Bumped by cancel() and cleanup(). Audio from a turn that started in an
+    // earlier generation is dropped, including audio already queued.
+    private final AtomicInteger playbackGeneration = new AtomicInteger();
+    private volatile int turnGeneration = 0;
+    // Only touched on audioExecutor
+    private AudioTrack audioTrack;
+    private int audioTrackSampleRate = 0;
+
+    static {
+        System.loadLibrary("voice-pipeline-native");
+    }
+
+    public VoicePipelineModule(ReactApplicationContext reactContext) {
+        super(reactContext);
+    }
+
+    @Override
+    public String getName() {
+        return "VoicePipelineNative";
+    }
+
+    // The current whisper, LLM, index and TTS context pointers, in that
+    // order. The modules replace their contexts on reload, so these are read
+    // again for every turn.
+    private long[] contextPtrs() {
+        ReactApplicationContext context = getReactApplicationContext();
+        WhisperModule whisper = context.getNativeModule(WhisperModule.class);
+        MLCLLMModule llm = context.getNativeModule(MLCLLMModule.class);
+        FaissModule faiss = context.getNativeModule(FaissModule.class);
+        TTSModule tts = context.getNativeModule(TTSModule.class);
+
+        if (whisper == null || llm == null || faiss == null || tts == null) {
+            throw new IllegalStateException("Voice pipeline dependencies not registered");
+        }
+        return new long[] {
+            whisper.getContextPtr(), llm.getContextPtr(), faiss.getIndexPtr(), tts.getContextPtr()
+        };
+    }
+
+    // Cancels the pipeline's turn and destroys it once the turn has returned.
+    // pipelinePtr must no longer point at it.
+    private void releasePipeline(long ptr, Runnable then) {
+        if (ptr != 0) {
+            cancelNative(ptr);
+        }
+        turnExecutor.execute(() -> {
+            if (ptr != 0) {
+                destroyPipelineNative(ptr);
+            }
+            if (then != null) {
+                then.run();
+            }
+        });
+    }
+
+    @ReactMethod
+    public void createPipeline(Promise promise) {
+        try {
+            long[] contexts = contextPtrs();
+            long previous = pipelinePtr;
+            pipelinePtr = createPipelineNative(contexts[0], contexts[1], contexts[2], contexts[3]);
+            releasePipeline(previous, null);
+            promise.resolve(pipelinePtr != 0);
+        } catch (Exception e) {
+            promise.reject("ERR_VOICE_PIPELINE", "Failed to create voice pipeline: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void setChunks(ReadableArray chunks, Promise promise) {
+        try {
+            if (pipelinePtr == 0) {
+                throw new IllegalStateException("Voice pipeline not initialized");
+            }
+
+            String[] texts = new String[chunks.size()];
+            for (int i = 0; i < chunks.size(); i++) {
+                texts[i] = chunks.getString(i);
+            }
+
+            setChunksNative(pipelinePtr, texts);
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_VOICE_PIPELINE", "Failed to set chunks: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void setGeneration(int topK, int maxTokens, float temperature, float topP, Promise promise) {
+        try {
+            if (pipelinePtr == 0) {
+                throw new IllegalStateException("Voice pipeline not initialized");
+            }
+
+            setGenerationNative(pipelinePtr, topK, maxTokens, temperature, topP);
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_VOICE_PIPELINE", "Failed to set generation options: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void runTurn(String wavPath, Promise promise) {
+        if (pipelinePtr == 0) {
+            promise.reject("ERR_VOICE_PIPELINE", "Voice pipeline not initialized");
+            return;
+        }
+
+        final long ptr = pipelinePtr;
+        final long[] contexts;
+        try {
+            contexts = contextPtrs();
+        } catch (Exception e) {
+            promise.reject("ERR_VOICE_PIPELINE", "Failed to run voice turn: " + e.getMessage());
+            return;
+        }
+
+        // Turns run off the bridge thread so cancel() can interrupt them
+        turnExecutor.execute(() -> {
+            try {
+                // A pipeline replaced since this turn was queued has its
+                // destroy queued behind it; don't start a turn on it
+                if (ptr != pipelinePtr) {
+                    promise.reject("ERR_VOICE_PIPELINE", "Voice pipeline was released");
+                    return;
+                }
+                turnGeneration = playbackGeneration.get();
+                setContextsNative(ptr, contexts[0], contexts[1], contexts[2], contexts[3]);
+                promise.resolve(runTurnNative(ptr, wavPath));
+            } catch (Exception e) {
+                promise.reject("ERR_VOICE_PIPELINE", "Failed to run voice turn: " + e.getMessage());
+            }
+        });
+    }
+
+    @ReactMethod
+    public void cancel(Promise promise) {
+        try {
+            if (pipelinePtr != 0) {
+                cancelNative(pipelinePtr);
+            }
+            playbackGeneration.incrementAndGet();
+            audioExecutor.execute(() -> {
+                if (audioTrack != null) {
+                    audioTrack.pause();
+                    audioTrack.flush();
+                }
+            });
+            promise.resolve(null);
+        } catch (Exception e) {
+            promise.reject("ERR_VOICE_PIPELINE", "Failed to cancel voice turn: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void cleanup(Promise promise) {
+        try {
+            playbackGeneration.incrementAndGet();
+            audioExecutor.execute(() -> {
+                if (audioTrack != null) {
+                    audioTrack.release();
+                    audioTrack = null;
+                    audioTrackSampleRate = 0;
+                }
+            });
+
+            long previous = pipelinePtr;
+            pipelinePtr = 0;
+            releasePipeline(previous, () -> promise.resolve(null));
+        } catch (Exception e) {
+            promise.reject("ERR_VOICE_PIPELINE", "Failed to cleanup voice pipeline: " + e.getMessage());
+        }
+    }
+
+    @ReactMethod
+    public void addListener(String eventName) {
+        // Required for NativeEventEmitter
+    }
+
+    @ReactMethod
+    public void removeListeners(double count) {
+        // Required for NativeEventEmitter
+    }
+
+    // Called from native pipeline threads
+    private void onNativeEvent(int type, String text, float[] audio, int sampleRate, int count, float[] timings) {
+        if (type == EVENT_AUDIO && audio != null) {
+            final int generation = turnGeneration;
+            audioExecutor.execute(() -> play(audio, sampleRate, generation));
+        }
+
+        WritableMap event = Arguments.createMap();
+        event.putString("type", type >= 0 && type < EVENT_TYPES.length ? EVENT_TYPES[type] : "unknown");
+        event.putString("text", text);
+        event.putInt("count", count);
+        event.putInt("sampleRate", sampleRate);
+
+        WritableMap timingMap = Arguments.createMap();
+        timingMap.putDouble("transcribeMs", timings[0]);
+        timingMap.putDouble("retrieveMs", timings[1]);
+        timingMap.putDouble("firstTokenMs", timings[2]);
+        timingMap.putDouble("firstAudioMs", timings[3]);
+        timingMap.putDouble("totalMs", timings[4]);
+        event.putMap("timings", timingMap);
+
+        getReactApplicationContext()
+            .getJSModule(DeviceEventManagerModule.RCTDeviceEventEmitter.class)
+            .emit(EVENT_NAME, event);
+    }
+
+    private void play(float[] samples, int sampleRate, int generation) {
+        if (generation != playbackGeneration.get()) {
+            return;
+        }
+        if (audioTrack == null || audioTrackSampleRate != sampleRate) {
+            if (audioTrack != null) {
+                audioTrack.release();
+            }
+
+            int bufferSize = AudioTrack.getMinBufferSize(
+                sampleRate,
+                AudioFormat.CHANNEL_OUT_MONO,
+                AudioFormat.ENCODING_PCM_FLOAT
+            );
+            audioTrack = new AudioTrack.Builder()
+                .setAudioAttributes(new AudioAttributes.Builder()
+                    .setUsage(AudioAttributes.USAGE_ASSISTANT)
+                    .setContentType(AudioAttributes.CONTENT_TYPE_SPEECH)
+                    .build())
+                .setAudioFormat(new AudioFormat.Builder()
+                    .setEncoding(AudioFormat.ENCODING_PCM_FLOAT)
+                    .setSampleRate(sampleRate)
+                    .setChannelMask(AudioFormat.CHANNEL_OUT_MONO)
+                    .build())
+                .setBufferSizeInBytes(bufferSize)
+                .setTransferMode(AudioTrack.MODE_STREAM)
+                .build();
+            audioTrackSampleRate = sampleRate;
+        }
+
+        audioTrack.play();
+        int slice = Math.max(sampleRate * PLAYBACK_SLICE_MS / 1000, 1);
+        for (int offset = 0; offset < samples.length; offset += slice) {
+            if (generation != playbackGeneration.get()) {
+                return;
+            }
+            audioTrack.write(samples, offset, Math.min(slice, samples.length - offset), AudioTrack.WRITE_BLOCKING);
+        }
+    }
+
+    // Native method declarations
+    private native long createPipelineNative(long whisperPtr, long llmPtr, long indexPtr, long ttsPtr);
+    private native void destroyPipelineNative(long pipelinePtr);
+    private native void setChunksNative(long pipelinePtr, String[] chunks);
+    private native void setGenerationNative(long pipelinePtr, int topK, int maxTokens, float temperature, float topP);
+    private native void setContextsNative(long pipelinePtr, long whisperPtr, long llmPtr, long indexPtr, long ttsPtr);
+    private native boolean runTurnNative(long pipelinePtr, String wavPath);
+    private native void cancelNative(long pipelinePtr);
+}
@@ -0,0 +1,5 @@
+#import <React/RCTBridgeModule.h>
+#import <React/RCTEventEmitter.h>
+
+@interface VoicePipelineModule : RCTEventEmitter <RCTBridgeModule>
+@end
@@ -0,0 +1,298 @@
+#import "VoicePipelineModule.h"
+#import <React/RCTLog.h>
+#import <AVFoundation/AVFoundation.h>
+#import "voice-pipeline-native.h"
+#import "WhisperModule.h"
+#import "MLCLLMModule.h"
+#import "FaissModule.h"
+#import "TTSModule.h"
+#include <atomic>
+
+using namespace bookmark::voice;
+
+static NSString* const kVoicePipelineEvent = @"onVoicePipelineEvent";
+
+static NSString* eventTypeName(VoicePipelineEventType type) {
+    switch (type) {
+        case VOICE_EVENT_TRANSCRIPT: return @"transcript";
+        case VOICE_EVENT_RETRIEVED: return @"retrieved";
+        case VOICE_EVENT_TOKEN: return @"token";
+        case VOICE_EVENT_SENTENCE: return @"sentence";
+        case VOICE_EVENT_AUDIO: return @"audio";
+        case VOICE_EVENT_DONE: return @"done";
+        case VOICE_EVENT_ERROR: return @"error";
+    }
+    return @"unknown";
+}
+
+@implementation VoicePipelineModule {
+    // Changed only on the module queue. A pipeline is destroyed on
+    // _turnQueue after it is swapped out, so it outlives any turn still
+    // running or queued on it.
+    std::atomic<VoicePipeline*> _pipeline;
+    // Bumped by cancel and cleanup; audio from a turn that started in an
+    // earlier generation is dropped
+    std::atomic<int> _playbackGeneration;
+    std::atomic<int> _turnGeneration;
+    AVAudioEngine* _audioEngine;
+    AVAudioPlayerNode* _playerNode;
+    dispatch_queue_t _turnQueue;
+    BOOL _hasListeners;
+}
+
+RCT_EXPORT_MODULE(VoicePipelineNative)
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _pipeline = nullptr;
+        _playbackGeneration = 0;
+        _turnGeneration = 0;
+        _turnQueue = dispatch_queue_create("com.bookmark.voicepipeline", DISPATCH_QUEUE_SERIAL);
+        _audioEngine = [[AVAudioEngine alloc] init];
+        _playerNode = [[AVAudioPlayerNode alloc] init];
+        [_audioEngine attachNode:_playerNode];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    // Queued turns retain the module, so none is left by now
+    VoicePipeline* pipeline = _pipeline.exchange(nullptr);
+    if (pipeline != nullptr) {
+        voice_pipeline_destroy(pipeline);
+    }
+    [_audioEngine stop];
+}
+
+// Cancels the pipeline's turn and destroys it once the turn has returned.
+// _pipeline must no longer point at it.
+- (void)releasePipeline:(VoicePipeline*)pipeline completion:(dispatch_block_t)completion {
+    if (pipeline != nullptr) {
+        voice_pipeline_cancel(pipeline);
+    }
+    dispatch_async(_turnQueue, ^{
+        if (pipeline != nullptr) {
+            voice_pipeline_destroy(pipeline);
+        }
+        if (completion) {
+            completion();
+        }
+    });
+}
+
+- (NSArray<NSString*>*)supportedEvents {
+    return @[kVoicePipelineEvent];
+}
+
+- (void)startObserving {
+    _hasListeners = YES;
+}
+
+- (void)stopObserving {
+    _hasListeners = NO;
+}
+
+// Called from native pipeline threads
+static void onPipelineEvent(const VoicePipelineEvent* event, void* userData) {
+    VoicePipelineModule* module = (__bridge VoicePipelineModule*)userData;
+
+    if (event->type == VOICE_EVENT_AUDIO && event->audio != nullptr &&
+        module->_turnGeneration.load() == module->_playbackGeneration.load()) {
+        [module playSamples:event->audio count:event->audio_size sampleRate:event->sample_rate];
+    }
+
+    if (!module->_hasListeners) {
+        return;
+    }
+
+    [module sendEventWithName:kVoicePipelineEvent body:@{
+        @"type": eventTypeName(event->type),
+        @"text": event->text ? @(event->text) : @"",
+        @"count": @(event->count),
+        @"sampleRate": @(event->sample_rate),
+        @"timings": @{
+            @"transcribeMs": @(event->timings.transcribe_ms),
+            @"retrieveMs": @(event->timings.retrieve_ms),
+            @"firstTokenMs": @(event->timings.first_token_ms),
+            @"firstAudioMs": @(event->timings.first_audio_ms),
+            @"totalMs": @(event->timings.total_ms)
+        }
+    }];
+}
+
+- (void)playSamples:(const float*)samples count:(size_t)count sampleRate:(int)sampleRate {
+    AVAudioFormat* format = [[AVAudioFormat alloc]
+        initWithCommonFormat:AVAudioPCMFormatFloat32
+        sampleRate:sampleRate
+        channels:1
+        interleaved:NO
+    ];
+
+    AVAudioPCMBuffer* pcmBuffer = [[AVAudioPCMBuffer alloc]
+        initWithPCMFormat:format
+        frameCapacity:(AVAudioFrameCount)count
+    ];
+    pcmBuffer.frameLength = (AVAudioFrameCount)count;
+    memcpy(pcmBuffer.floatChannelData[0], samples, count * sizeof(float));
+
+    @synchronized (self) {
+        // Checked again under the lock that cancel stops the player with
+        if (_turnGeneration.load() != _playbackGeneration.load()) {
+            return;
+        }
+        if (!_audioEngine.isRunning) {
+            [_audioEngine connect:_playerNode to:_audioEngine.mainMixerNode format:format];
+            [_audioEngine startAndReturnError:nil];
+        }
+
+        // Sentences are queued back to back as they arrive
+        [_playerNode scheduleBuffer:pcmBuffer completionHandler:nil];
+        if (!_playerNode.isPlaying) {
+            [_playerNode play];
+        }
+    }
+}
+
+RCT_EXPORT_METHOD(createPipeline:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        WhisperModule* whisper = [self.bridge moduleForClass:[WhisperModule class]];
+        MLCLLMModule* llm = [self.bridge moduleForClass:[MLCLLMModule class]];
+        FaissModule* faiss = [self.bridge moduleForClass:[FaissModule class]];
+        TTSModule* tts = [self.bridge moduleForClass:[TTSModule class]];
+
+        VoicePipeline* pipeline = voice_pipeline_create(
+            static_cast<bookmark::whisper::WhisperContext*>([whisper nativeHandle]),
+            static_cast<bookmark::mlc_llm::LLMContext*>([llm nativeHandle]),
+            static_cast<bookmark::faiss::FaissIndex*>([faiss nativeHandle]),
+            static_cast<bookmark::tts::TTSContext*>([tts nativeHandle])
+        );
+
+        if (pipeline != nullptr) {
+            voice_pipeline_set_callback(pipeline, onPipelineEvent, (__bridge void*)self);
+        }
+        [self releasePipeline:_pipeline.exchange(pipeline) completion:nil];
+        resolve(@(pipeline != nullptr));
+    } @catch (NSException* e) {
+        reject(@"ERR_VOICE_PIPELINE", @"Failed to create voice pipeline", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(setChunks:(NSArray<NSString*>*)chunks
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        VoicePipeline* pipeline = _pipeline.load();
+        if (pipeline == nullptr) {
+            reject(@"ERR_VOICE_PIPELINE", @"Voice pipeline not initialized", nil);
+            return;
+        }
+
+        std::vector<const char*> texts;
+        texts.reserve(chunks.count);
+        for (NSString* chunk in chunks) {
+            texts.push_back([chunk UTF8String]);
+        }
+
+        voice_pipeline_set_chunks(pipeline, texts.data(), texts.size());
+        resolve(nil);
+    } @catch (NSException* e) {
+        reject(@"ERR_VOICE_PIPELINE", @"Failed to set chunks", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(setGeneration:(nonnull NSNumber*)topK
+                  maxTokens:(nonnull NSNumber*)maxTokens
+                  temperature:(nonnull NSNumber*)temperature
+                  topP:(nonnull NSNumber*)topP
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        VoicePipeline* pipeline = _pipeline.load();
+        if (pipeline == nullptr) {
+            reject(@"ERR_VOICE_PIPELINE", @"Voice pipeline not initialized", nil);
+            return;
+        }
+
+        voice_pipeline_set_generation(
+            pipeline,
+            [topK intValue],
+            [maxTokens intValue],
+            [temperature floatValue],
+            [topP floatValue]
+        );
+        resolve(nil);
+    } @catch (NSException* e) {
+        reject(@"ERR_VOICE_PIPELINE", @"Failed to set generation options", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(runTurn:(NSString*)wavPath
+                  resolver:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    VoicePipeline* pipeline = _pipeline.load();
+    if (pipeline == nullptr) {
+        reject(@"ERR_VOICE_PIPELINE", @"Voice pipeline not initialized", nil);
+        return;
+    }
+
+    // The modules replace their contexts on reload, so the current ones are
+    // passed for every turn
+    auto* whisper = static_cast<bookmark::whisper::WhisperContext*>(
+        [[self.bridge moduleForClass:[WhisperModule class]] nativeHandle]);
+    auto* llm = static_cast<bookmark::mlc_llm::LLMContext*>(
+        [[self.bridge moduleForClass:[MLCLLMModule class]] nativeHandle]);
+    auto* index = static_cast<bookmark::faiss::FaissIndex*>(
+        [[self.bridge moduleForClass:[FaissModule class]] nativeHandle]);
+    auto* tts = static_cast<bookmark::tts::TTSContext*>(
+        [[self.bridge moduleForClass:[TTSModule class]] nativeHandle]);
+
+    // Turns run off the module queue so cancel can interrupt them
+    std::string path = [wavPath UTF8String];
+    dispatch_async(_turnQueue, ^{
+        // A pipeline replaced since this turn was queued has its destroy
+        // queued behind it; don't start a turn on it
+        if (pipeline != self->_pipeline.load()) {
+            reject(@"ERR_VOICE_PIPELINE", @"Voice pipeline was released", nil);
+            return;
+        }
+        self->_turnGeneration = self->_playbackGeneration.load();
+        voice_pipeline_set_contexts(pipeline, whisper, llm, index, tts);
+        bool success = voice_pipeline_run_turn_file(pipeline, path.c_str());
+        resolve(@(success));
+    });
+}
+
+RCT_EXPORT_METHOD(cancel:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        VoicePipeline* pipeline = _pipeline.load();
+        if (pipeline != nullptr) {
+            voice_pipeline_cancel(pipeline);
+        }
+        @synchronized (self) {
+            ++_playbackGeneration;
+            [_playerNode stop];
+        }
+        resolve(nil);
+    } @catch (NSException* e) {
+        reject(@"ERR_VOICE_PIPELINE", @"Failed to cancel voice turn", nil);
+    }
+}
+
+RCT_EXPORT_METHOD(cleanup:(RCTPromiseResolveBlock)resolve
+                  rejecter:(RCTPromiseRejectBlock)reject) {
+    @try {
+        @synchronized (self) {
+            ++_playbackGeneration;
+            [_playerNode stop];
+        }
+        [self releasePipeline:_pipeline.exchange(nullptr) completion:^{
+            resolve(nil);
+        }];
+    } @catch (NSException* e) {
+        reject(@"ERR_VOICE_PIPELINE", @"Failed to cleanup voice pipeline", nil);
+    }
+}
+
+@end
@@ -0,0 +1,490 @@
+#include "voice-pipeline-native.h"
+#include "metrics-native.h"
+#include "scheduler-native.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace bookmark {
+namespace voice {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Sentences are cut at terminal punctuation followed by whitespace. The
+// first sentence of an answer may also be cut at a clause boundary once
+// it is long enough, so playback can start sooner.
+constexpr size_t kFirstSentenceClauseCut = 80;
+
+bool isTerminal(char c) {
+    return c == '.' || c == '!' || c == '?' || c == '\n';
+}
+
+// Returns the length of the first complete sentence in buffer, or 0
+size_t sentenceBoundary(const std::string& buffer, bool first_sentence) {
+    for (size_t i = 0; i + 1 < buffer.size(); ++i) {
+        if (isTerminal(buffer[i]) && (buffer[i + 1] == ' ' || buffer[i + 1] == '\n')) {
+            return i + 1;
+        }
+    }
+
+    if (first_sentence && buffer.size() >= kFirstSentenceClauseCut) {
+        size_t comma = buffer.rfind(", ");
+        if (comma != std::string::npos && comma > kFirstSentenceClauseCut / 2) {
+            return comma + 1;
+        }
+    }
+    return 0;
+}
+
+std::string trim(const std::string& text) {
+    size_t start = text.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(start, end - start + 1);
+}
+
+uint32_t readLE32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint16_t readLE16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+} // namespace
+
+bool readWavPcm16(const std::string& path, std::vector<float>& samples, int& sample_rate) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < 12 || memcmp(data.data(), "RIFF", 4) != 0 || memcmp(data.data() + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    uint16_t channels = 0;
+    uint16_t bits_per_sample = 0;
+    size_t offset = 12;
+
+    // Walk the chunk list rather than assuming a 44-byte header; recorders
+    // commonly insert LIST/fact chunks before the samples
+    while (offset + 8 <= data.size()) {
+        const uint8_t* chunk = data.data() + offset;
+        uint32_t chunk_size = readLE32(chunk + 4);
+        size_t body = offset + 8;
+        if (body + chunk_size > data.size()) {
+            chunk_size = static_cast<uint32_t>(data.size() - body);
+        }
+
+        if (memcmp(chunk, "fmt ", 4) == 0 && chunk_size >= 16) {
+            channels = readLE16(data.data() + body + 2);
+            sample_rate = static_cast<int>(readLE32(data.data() + body + 4));
+            bits_per_sample = readLE16(data.data() + body + 14);
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (channels == 0 || bits_per_sample != 16) return false;
+
+            size_t frames = chunk_size / (2 * channels);
+            samples.resize(frames);
+            const uint8_t* pcm = data.data() + body;
+            for (size_t i = 0; i < frames; ++i) {
+                int sum = 0;
+                for (uint16_t c = 0; c < channels; ++c) {
+                    sum += static_cast<int16_t>(readLE16(pcm + (i * channels + c) * 2));
+                }
+                samples[i] = static_cast<float>(sum) / (32768.0f * channels);
+            }
+            return true;
+        }
+
+        offset = body + chunk_size + (chunk_size & 1);
+    }
+    return false;
+}
+
+VoicePipeline* VoicePipeline::create(whisper::WhisperContext* whisper,
+                                     mlc_llm::LLMContext* llm,
+                                     faiss::FaissIndex* index,
+                                     tts::TTSContext* tts) {
+    if (!whisper || !llm || !index || !tts) {
+        return nullptr;
+    }
+    return new VoicePipeline({whisper, llm, index, tts});
+}
+
+VoicePipeline::VoicePipeline(const VoiceContexts& contexts) : contexts_(contexts) {
+    tts_thread_ = std::thread(&VoicePipeline::ttsLoop, this);
+}
+
+VoicePipeline::~VoicePipeline() {
+    // A turn still running on another thread would outlive the pipeline
+    closing_ = true;
+    cancel();
+    std::lock_guard<std::mutex> turn(turn_mutex_);
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stopping_ = true;
+        sentences_.clear();
+    }
+    queue_cv_.notify_all();
+    if (tts_thread_.joinable()) {
+        tts_thread_.join();
+    }
+}
+
+void VoicePipeline::setCallback(voice_pipeline_callback callback, void* user_data) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    callback_ = callback;
+    user_data_ = user_data;
+}
+
+void VoicePipeline::setConfig(const VoicePipelineConfig& config) {
+    config_ = config;
+}
+
+void VoicePipeline::setChunks(std::vector<std::string> chunks) {
+    std::lock_guard<std::mutex> lock(chunks_mutex_);
+    chunks_ = std::move(chunks);
+}
+
+void VoicePipeline::setContexts(const VoiceContexts& contexts) {
+    std::lock_guard<std::mutex> lock(contexts_mutex_);
+    contexts_ = contexts;
+}
+
+bool VoicePipeline::runTurn(const std::vector<float>& pcm_data, int sample_rate) {
+    std::lock_guard<std::mutex> turn(turn_mutex_);
+    if (closing_) return false;
+    turn_start_ = Clock::now();
+    timings_ = {};
+    cancelled_ = false;
+    first_audio_seen_ = false;
+
+    VoiceContexts contexts;
+    {
+        std::lock_guard<std::mutex> lock(contexts_mutex_);
+        contexts = contexts_;
+    }
+
+    // A module replacing one of these mid-turn cancels the turn, then waits
+    // for the loans to end before freeing it
+    auto on_retire = [this]() { cancel(); };
+    scheduler::ContextLoan whisper(contexts.whisper, on_retire);
+    scheduler::ContextLoan llm(contexts.llm, on_retire);
+    scheduler::ContextLoan index(contexts.index, on_retire);
+    scheduler::ContextLoan tts(contexts.tts, on_retire);
+    if (!whisper || !llm || !index || !tts) {
+        metrics::reportError(metrics::Module::VoicePipeline, "turn", "module context released");
+        emitText(VOICE_EVENT_ERROR, "A module the voice pipeline uses was released");
+        return false;
+    }
+
+    turn_ = contexts;
+    bool success = runBorrowedTurn(pcm_data, sample_rate);
+    // Every exit leaves the TTS thread idle before the loans end
+    stopTTS();
+    turn_ = {};
+    return success;
+}
+
+bool VoicePipeline::runBorrowedTurn(const std::vector<float>& pcm_data, int sample_rate) {
+    auto since_start = [this]() {
+        return std::chrono::duration<double, std::milli>(Clock::now() - turn_start_).count();
+    };
+
+    try {
+        // 1. Speech to text. The context is shared with other callers, so
+        // take this clip's text from the call rather than getTranscription()
+        std::string transcript;
+        if (!turn_.whisper->transcribe(pcm_data.data(), pcm_data.size(), sample_rate, transcript)) {
+            metrics::reportError(metrics::Module::VoicePipeline, "turn", "transcription failed");
+            emitText(VOICE_EVENT_ERROR, "Failed to transcribe audio");
+            return false;
+        }
+        std::string question = trim(transcript);
+        timings_.transcribe_ms = since_start();
+        emitText(VOICE_EVENT_TRANSCRIPT, question);
+
+        if (question.empty() || cancelled_) {
+            timings_.total_ms = since_start();
+            VoicePipelineEvent done = {};
+            done.type = VOICE_EVENT_DONE;
+            done.text = "";
+            done.timings = timings_;
+            emit(done);
+            return true;
+        }
+
+        // 2. Retrieval, straight from the final transcript
+        std::vector<std::string> context = retrieve(question);
+        timings_.retrieve_ms = since_start();
+
+        VoicePipelineEvent retrieved = {};
+        retrieved.type = VOICE_EVENT_RETRIEVED;
+        retrieved.count = static_cast<int>(context.size());
+        emit(retrieved);
+
+        // 3. Generation, feeding completed sentences to the TTS thread
+        std::string answer;
+        std::string pending;
+        bool first_sentence = true;
+
+        bool generated = turn_.llm->generateStream(
+            buildPrompt(question, context),
+            config_.system_prompt,
+            config_.max_tokens,
+            config_.temperature,
+            config_.top_p,
+            [&](const std::string& token) {
+                if (cancelled_) return false;
+
+                if (answer.empty()) {
+                    timings_.first_token_ms = since_start();
+                }
+                answer += token;
+                pending += token;
+                emitText(VOICE_EVENT_TOKEN, token);
+
+                size_t cut;
+                while ((cut = sentenceBoundary(pending, first_sentence)) > 0) {
+                    enqueueSentence(trim(pending.substr(0, cut)));
+                    pending.erase(0, cut);
+                    first_sentence = false;
+                }
+                return true;
+            });
+
+        if (!generated) {
+            metrics::reportError(metrics::Module::VoicePipeline, "turn", "generation failed");
+            emitText(VOICE_EVENT_ERROR, "Failed to generate answer");
+            return false;
+        }
+
+        enqueueSentence(trim(pending));
+        waitForTTS();
+
+        timings_.total_ms = since_start();
+        VoicePipelineEvent done = {};
+        done.type = VOICE_EVENT_DONE;
+        done.text = answer.c_str();
+        done.timings = timings_;
+        emit(done);
+        return true;
+    } catch (...) {
+        metrics::reportException(metrics::Module::VoicePipeline, "turn");
+        emitText(VOICE_EVENT_ERROR, "Voice turn failed");
+        return false;
+    }
+}
+
+bool VoicePipeline::runTurnFromFile(const std::string& wav_path) {
+    std::vector<float> samples;
+    int sample_rate = 16000;
+    if (!readWavPcm16(wav_path, samples, sample_rate) || samples.empty()) {
+        metrics::reportError(metrics::Module::VoicePipeline, "read recording", wav_path.c_str());
+        emitText(VOICE_EVENT_ERROR, "Failed to read recording");
+        return false;
+    }
+    return runTurn(samples, sample_rate);
+}
+
+void VoicePipeline::cancel() {
+    cancelled_ = true;
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    pending_sentences_ -= sentences_.size();
+    sentences_.clear();
+    queue_cv_.notify_all();
+}
+
+std::vector<std::string> VoicePipeline::retrieve(const std::string& question) {
+    std::vector<std::string> context;
+
+    std::vector<float> embedding = turn_.llm->getEmbeddings(question);
+    if (embedding.empty() || turn_.index->size() == 0) {
+        return context;
+    }
+
+    auto results = turn_.index->search(embedding, config_.top_k);
+
+    std::lock_guard<std::mutex> lock(chunks_mutex_);
+    for (const auto& result : results) {
+        if (result.first >= 0 && static_cast<size_t>(result.first) < chunks_.size()) {
+            context.push_back(chunks_[result.first]);
+        }
+    }
+    return context;
+}
+
+std::string VoicePipeline::buildPrompt(const std::string& question,
+                                       const std::vector<std::string>& context) const {
+    if (context.empty()) {
+        return question;
+    }
+
+    // Same layout as RAGService.generate
+    std::string prompt = "Context:\n";
+    for (size_t i = 0; i < context.size(); ++i) {
+        if (i > 0) prompt += "\n\n";
+        prompt += context[i];
+    }
+    prompt += "\n\nQuestion: " + question + "\n\nAnswer:";
+    return prompt;
+}
+
+void VoicePipeline::ttsLoop() {
+    // Speech is what the user is waiting on; keep it on the big cores even
+    // while ingestion is running
+    scheduler::ScopedQoS qos(scheduler::QoS::Interactive);
+
+    while (true) {
+        std::string sentence;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] { return stopping_ || !sentences_.empty(); });
+            if (stopping_) return;
+
+            sentence = std::move(sentences_.front());
+            sentences_.pop_front();
+        }
+
+        std::vector<float> samples;
+        if (!cancelled_) {
+            // An exception escaping this thread would terminate the app
+            try {
+                samples = turn_.tts->synthesize(sentence);
+            } catch (...) {
+                metrics::reportException(metrics::Module::VoicePipeline, "synthesize");
+            }
+        }
+
+        if (!samples.empty() && !cancelled_) {
+            if (!first_audio_seen_.exchange(true)) {
+                timings_.first_audio_ms = std::chrono::duration<double, std::milli>(
+                    Clock::now() - turn_start_).count();
+            }
+
+            VoicePipelineEvent audio = {};
+            audio.type = VOICE_EVENT_AUDIO;
+            audio.text = sentence.c_str();
+            audio.audio = samples.data();
+            audio.audio_size = samples.size();
+            audio.sample_rate = turn_.tts->sampleRate();
+            emit(audio);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            if (pending_sentences_ > 0) pending_sentences_--;
+        }
+        queue_cv_.notify_all();
+    }
+}
+
+void VoicePipeline::enqueueSentence(std::string sentence) {
+    if (sentence.empty() || cancelled_) return;
+
+    emitText(VOICE_EVENT_SENTENCE, sentence);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        sentences_.push_back(std::move(sentence));
+        pending_sentences_++;
+    }
+    queue_cv_.notify_all();
+}
+
+void VoicePipeline::waitForTTS() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    queue_cv_.wait(lock, [this] { return stopping_ || pending_sentences_ == 0; });
+}
+
+void VoicePipeline::stopTTS() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    pending_sentences_ -= sentences_.size();
+    sentences_.clear();
+    queue_cv_.wait(lock, [this] { return stopping_ || pending_sentences_ == 0; });
+}
+
+void VoicePipeline::emit(VoicePipelineEvent event) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (callback_) {
+        callback_(&event, user_data_);
+    }
+}
+
+void VoicePipeline::emitText(VoicePipelineEventType type, const std::string& text) {
+    VoicePipelineEvent event = {};
+    event.type = type;
+    event.text = text.c_str();
+    emit(event);
+}
+
+// C API Implementation
+extern "C" {
+
+VoicePipeline* voice_pipeline_create(whisper::WhisperContext* whisper,
+                                     mlc_llm::LLMContext* llm,
+                                     faiss::FaissIndex* index,
+                                     tts::TTSContext* tts) {
+    return VoicePipeline::create(whisper, llm, index, tts);
+}
+
+void voice_pipeline_destroy(VoicePipeline* pipeline) {
+    delete pipeline;
+}
+
+void voice_pipeline_set_callback(VoicePipeline* pipeline, voice_pipeline_callback callback, void* user_data) {
+    if (pipeline) pipeline->setCallback(callback, user_data);
+}
+
+void voice_pipeline_set_chunks(VoicePipeline* pipeline, const char* const* chunks, size_t count) {
+    if (!pipeline || (!chunks && count > 0)) return;
+
+    std::vector<std::string> texts;
+    texts.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        texts.emplace_back(chunks[i] ? chunks[i] : "");
+    }
+    pipeline->setChunks(std::move(texts));
+}
+
+void voice_pipeline_set_contexts(VoicePipeline* pipeline,
+                                 whisper::WhisperContext* whisper,
+                                 mlc_llm::LLMContext* llm,
+                                 faiss::FaissIndex* index,
+                                 tts::TTSContext* tts) {
+    if (pipeline) pipeline->setContexts({whisper, llm, index, tts});
+}
+
+void voice_pipeline_set_generation(VoicePipeline* pipeline, int top_k, int max_tokens, float temperature, float top_p) {
+    if (!pipeline) return;
+
+    VoicePipelineConfig config;
+    config.top_k = std::max(1, top_k);
+    config.max_tokens = std::max(1, max_tokens);
+    config.temperature = temperature;
+    config.top_p = top_p;
+    pipeline->setConfig(config);
+}
+
+bool voice_pipeline_run_turn(VoicePipeline* pipeline, const float* pcm_data, size_t pcm_size, int sample_rate) {
+    if (!pipeline || !pcm_data || pcm_size == 0) return false;
+    return pipeline->runTurn(std::vector<float>(pcm_data, pcm_data + pcm_size), sample_rate);
+}
+
+bool voice_pipeline_run_turn_file(VoicePipeline* pipeline, const char* wav_path) {
+    if (!pipeline || !wav_path) return false;
+    return pipeline->runTurnFromFile(wav_path);
+}
+
+void voice_pipeline_cancel(VoicePipeline* pipeline) {
+    if (pipeline) pipeline->cancel();
+}
+
+} // extern "C"
+
+} // namespace voice
+} // namespace bookmark
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "whisper-native.h"
+#include "mlc-llm-native.h"
+#include "faiss-native.h"
+#include "tts-native.h"
+
+namespace bookmark {
+namespace voice {
+
+enum VoicePipelineEventType {
+    VOICE_EVENT_TRANSCRIPT = 0,  // final ASR text for the turn
+    VOICE_EVENT_RETRIEVED = 1,   // number of context chunks retrieved
+    VOICE_EVENT_TOKEN = 2,       // generated token
+    VOICE_EVENT_SENTENCE = 3,    // sentence handed to TTS
+    VOICE_EVENT_AUDIO = 4,       // synthesized PCM for one sentence
+    VOICE_EVENT_DONE = 5,        // turn finished, timings valid
+    VOICE_EVENT_ERROR = 6,
+};
+
+// Milliseconds since the turn started (end of speech)
+struct VoiceTurnTimings {
+    double transcribe_ms;
+    double retrieve_ms;
+    double first_token_ms;
+    double first_audio_ms;
+    double total_ms;
+};
+
+struct VoicePipelineEvent {
+    VoicePipelineEventType type;
+    const char* text;         // TRANSCRIPT, TOKEN, SENTENCE, DONE (full answer), ERROR
+    const float* audio;       // AUDIO
+    size_t audio_size;        // AUDIO
+    int sample_rate;          // AUDIO
+    int count;                // RETRIEVED
+    VoiceTurnTimings timings; // DONE
+};
+
+typedef void (*voice_pipeline_callback)(const VoicePipelineEvent* event, void* user_data);
+
+struct VoicePipelineConfig {
+    int top_k = 3;
+    int max_tokens = 256;
+    float temperature = 0.7f;
+    float top_p = 0.95f;
+    std::string system_prompt =
+        "You are a helpful assistant that answers questions based on the given context.";
+};
+
+// Decode a 16-bit PCM WAV file (as recorded by VoiceService) to mono floats
+bool readWavPcm16(const std::string& path, std::vector<float>& samples, int& sample_rate);
+
+// The module contexts a turn runs on
+struct VoiceContexts {
+    whisper::WhisperContext* whisper;
+    mlc_llm::LLMContext* llm;
+    faiss::FaissIndex* index;
+    tts::TTSContext* tts;
+};
+
+// Runs a full voice turn (ASR -> retrieval -> generation -> TTS) natively.
+// Generation runs on the calling thread while completed sentences are
+// synthesized on a dedicated TTS thread, so audio for the first sentence
+// is emitted while the rest of the answer is still decoding.
+//
+// The pipeline does not own the module contexts passed to it; their
+// modules free and replace them. Each turn borrows them for its duration
+// (see scheduler::ContextLoan): a module destroying one cancels the turn
+// and waits for it, and a turn started on a context that is already gone
+// fails instead of touching it. Bridges hand over the modules' current
+// contexts before each turn with setContexts().
+class VoicePipeline {
+public:
+    static VoicePipeline* create(whisper::WhisperContext* whisper,
+                                 mlc_llm::LLMContext* llm,
+                                 faiss::FaissIndex* index,
+                                 tts::TTSContext* tts);
+    // Cancels and waits for a turn in progress
+    ~VoicePipeline();
+
+    void setCallback(voice_pipeline_callback callback, void* user_data);
+    void setConfig(const VoicePipelineConfig& config);
+    void setChunks(std::vector<std::string> chunks);
+    // Takes effect from the next turn
+    void setContexts(const VoiceContexts& contexts);
+
+    bool runTurn(const std::vector<float>& pcm_data, int sample_rate);
+    bool runTurnFromFile(const std::string& wav_path);
+    void cancel();
+
+private:
+    explicit VoicePipeline(const VoiceContexts& contexts);
+
+    bool runBorrowedTurn(const std::vector<float>& pcm_data, int sample_rate);
+    std::vector<std::string> retrieve(const std::string& question);
+    std::string buildPrompt(const std::string& question, const std::vector<std::string>& context) const;
+
+    void ttsLoop();
+    void enqueueSentence(std::string sentence);
+    void waitForTTS();
+    // Drops queued sentences and waits for the one being synthesized
+    void stopTTS();
+
+    void emit(VoicePipelineEvent event);
+    void emitText(VoicePipelineEventType type, const std::string& text);
+
+    VoiceContexts contexts_;
+    std::mutex contexts_mutex_;
+    // The contexts the running turn has borrowed; only valid during a turn
+    VoiceContexts turn_ = {};
+    std::mutex turn_mutex_; // held for the whole turn
+
+    VoicePipelineConfig config_;
+    std::vector<std::string> chunks_;
+    std::mutex chunks_mutex_;
+
+    voice_pipeline_callback callback_ = nullptr;
+    void* user_data_ = nullptr;
+    std::mutex callback_mutex_;
+
+    std::thread tts_thread_;
+    std::deque<std::string> sentences_;
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    size_t pending_sentences_ = 0;
+    bool stopping_ = false;
+
+    std::atomic<bool> cancelled_{false};
+    std::atomic<bool> closing_{false};
+    std::atomic<bool> first_audio_seen_{false};
+    std::chrono::steady_clock::time_point turn_start_;
+    VoiceTurnTimings timings_ = {};
+};
+
+// React Native binding interface
+extern "C" {
+    VoicePipeline* voice_pipeline_create(whisper::WhisperContext* whisper,
+                                         mlc_llm::LLMContext* llm,
+                                         faiss::FaissIndex* index,
+                                         tts::TTSContext* tts);
+    void voice_pipeline_destroy(VoicePipeline* pipeline);
+    void voice_pipeline_set_callback(VoicePipeline* pipeline, voice_pipeline_callback callback, void* user_data);
+    void voice_pipeline_set_chunks(VoicePipeline* pipeline, const char* const* chunks, size_t count);
+    void voice_pipeline_set_generation(VoicePipeline* pipeline, int top_k, int max_tokens, float temperature, float top_p);
+    void voice_pipeline_set_contexts(VoicePipeline* pipeline,
+                                     whisper::WhisperContext* whisper,
+                                     mlc_llm::LLMContext* llm,
+                                     faiss::FaissIndex* index,
+                                     tts::TTSContext* tts);
+    bool voice_pipeline_run_turn(VoicePipeline* pipeline, const float* pcm_data, size_t pcm_size, int sample_rate);
+    bool voice_pipeline_run_turn_file(VoicePipeline* pipeline, const char* wav_path);
+    void voice_pipeline_cancel(VoicePipeline* pipeline);
+}
+
+} // namespace voice
+} // namespace bookmark
@@ -1,7 +1,12 @@
 #include <jni.h>
+#include <memory>
 #include <string>
 #include <vector>
+#include <fbjni/fbjni.h>
+#include <ReactCommon/CallInvokerHolder.h>
 #include "whisper-native.h"
+#include "whisper-jsi.h"
+#include "request-jni.h"
 #include <android/log.h>
 
 #define LOG_TAG "WhisperNative"
@@ -10,10 +15,23 @@
 
 using namespace bookmark::whisper;
 
+namespace {
+
+// The context as seen by the JSI functions, which run on the JS thread and
+// the scheduler rather than the module's thread
+std::shared_ptr<ContextSlot> context_slot = std::make_shared<ContextSlot>();
+
+} // namespace
+
 extern "C" {
 
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
+    // fbjni unwraps the CallInvokerHolder handed to installNative
+    return facebook::jni::initialize(vm, [] {});
+}
+
 JNIEXPORT jlong JNICALL
-Java_com_bookmark_WhisperModule_createContext(
+Java_com_bookmark_WhisperModule_createContextNative(
     JNIEnv* env,
     jobject thiz,
     jstring model_path
@@ -21,43 +39,68 @@ Java_com_bookmark_WhisperModule_createContext(
     const char* path = env->GetStringUTFChars(model_path, nullptr);
     WhisperContext* ctx = whisper_create_context(path);
     env->ReleaseStringUTFChars(model_path, path);
+    context_slot->set(ctx);
     return reinterpret_cast<jlong>(ctx);
 }
 
 JNIEXPORT void JNICALL
-Java_com_bookmark_WhisperModule_destroyContext(
+Java_com_bookmark_WhisperModule_destroyContextNative(
     JNIEnv* env,
     jobject thiz,
     jlong context_ptr
 ) {
     auto* ctx = reinterpret_cast<WhisperContext*>(context_ptr);
+    // Waits for a JSI transcription still using it
+    context_slot->clear(ctx);
     whisper_destroy_context(ctx);
 }
 
-JNIEXPORT jstring JNICALL
-Java_com_bookmark_WhisperModule_transcribe(
+// Returns as soon as the clip is queued; the listener gets the text
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_WhisperModule_transcribeAsyncNative(
     JNIEnv* env,
     jobject thiz,
     jlong context_ptr,
     jfloatArray audio_data,
-    jint sample_rate
+    jint sample_rate,
+    jobject listener
 ) {
     auto* ctx = reinterpret_cast<WhisperContext*>(context_ptr);
-    
-    // Convert Java float array to C++ vector
+
     jsize length = env->GetArrayLength(audio_data);
     jfloat* data = env->GetFloatArrayElements(audio_data, nullptr);
-    
-    bool success = whisper_transcribe(ctx, data, length, sample_rate);
+
+    // The samples are copied before this returns
+    auto* request_listener = bookmark::scheduler::RequestListener::create(env, listener);
+    bookmark::scheduler::Request* request = whisper_transcribe_async(
+        ctx, data, length, sample_rate, bookmark::scheduler::RequestListener::onComplete, request_listener);
     env->ReleaseFloatArrayElements(audio_data, data, JNI_ABORT);
-    
-    if (!success) {
-        LOGE("Failed to transcribe audio");
-        return env->NewStringUTF("");
+
+    return bookmark::scheduler::RequestListener::submitted(env, request_listener, request);
+}
+
+// Called on the JS thread with the jsi::Runtime behind the JavaScriptContextHolder
+JNIEXPORT jboolean JNICALL
+Java_com_bookmark_WhisperModule_installNative(
+    JNIEnv* env,
+    jobject thiz,
+    jlong runtime_ptr,
+    jobject call_invoker_holder
+) {
+    auto* runtime = reinterpret_cast<facebook::jsi::Runtime*>(runtime_ptr);
+    if (!runtime || !call_invoker_holder) {
+        return false;
+    }
+
+    try {
+        auto holder = facebook::jni::wrap_alias(
+            static_cast<facebook::react::CallInvokerHolder::javaobject>(call_invoker_holder));
+        installJsi(*runtime, holder->cthis()->getCallInvoker(), context_slot);
+        return true;
+    } catch (const std::exception& e) {
+        LOGE("Failed to install JSI bindings: %s", e.what());
+        return false;
     }
-    
-    const char* transcription = whisper_get_transcription(ctx);
-    return env->NewStringUTF(transcription ? transcription : "");
 }
 
-} // extern "C"
\ No newline at end of file
+} // extern "C"
@@ -6,6 +6,8 @@ import com.facebook.react.bridge.ReactMethod;
 import com.facebook.react.bridge.Promise;
 import com.facebook.react.bridge.ReadableArray;
 import com.facebook.react.bridge.ReadableMap;
+import com.facebook.react.bridge.JavaScriptContextHolder;
+import com.facebook.react.turbomodule.core.CallInvokerHolderImpl;
 
 public class WhisperModule extends ReactContextBaseJavaModule {
     private long contextPtr = 0;
@@ -23,9 +25,37 @@ public class WhisperModule extends ReactContextBaseJavaModule {
         return "WhisperNative";
     }
 
+    // Native handle shared with the voice pipeline module
+    long getContextPtr() {
+        return contextPtr;
+    }
+
+    // Installs global.WhisperNativeJSI, whose transcribe takes PCM as a
+    // Float32Array instead of copying samples element by element through the
+    // bridge. JS falls back to the promise methods below when this returns
+    // false, e.g. under a remote debugger.
+    @ReactMethod(isBlockingSynchronousMethod = true)
+    public boolean install() {
+        ReactApplicationContext context = getReactApplicationContext();
+        JavaScriptContextHolder jsContext = context.getJavaScriptContextHolder();
+        if (jsContext == null || jsContext.get() == 0) {
+            return false;
+        }
+        return installNative(jsContext.get(), (CallInvokerHolderImpl) context.getJSCallInvokerHolder());
+    }
+
+    private void destroyContext() {
+        if (contextPtr != 0) {
+            destroyContextNative(contextPtr);
+            contextPtr = 0;
+        }
+    }
+
     @ReactMethod
     public void createContext(String modelPath, Promise promise) {
         try {
+            // Replacing the context would otherwise leak the loaded model
+            destroyContext();
             contextPtr = createContextNative(modelPath);
             promise.resolve(contextPtr != 0);
         } catch (Exception e) {
@@ -36,10 +66,7 @@ public class WhisperModule extends ReactContextBaseJavaModule {
     @ReactMethod
     public void cleanup(Promise promise) {
         try {
-            if (contextPtr != 0) {
-                destroyContextNative(contextPtr);
-                contextPtr = 0;
-            }
+            destroyContext();
             promise.resolve(null);
         } catch (Exception e) {
             promise.reject("ERR_WHISPER", "Failed to cleanup Whisper context: " + e.getMessage());
@@ -58,8 +85,15 @@ public class WhisperModule extends ReactContextBaseJavaModule {
                 pcmData[i] = (float) audioData.getDouble(i);
             }
 
-            String transcription = transcribeNative(contextPtr, pcmData, (int) sampleRate);
-            promise.resolve(transcription);
+            // Decoded on a native worker so the bridge thread stays free for
+            // the other modules' calls
+            transcribeAsyncNative(contextPtr, pcmData, (int) sampleRate, (text, floats, ints, error) -> {
+                if (error != null) {
+                    promise.reject("ERR_WHISPER", "Failed to transcribe audio: " + error);
+                } else {
+                    promise.resolve(text != null ? text : "");
+                }
+            });
         } catch (Exception e) {
             promise.reject("ERR_WHISPER", "Failed to transcribe audio: " + e.getMessage());
         }
@@ -68,5 +102,6 @@ public class WhisperModule extends ReactContextBaseJavaModule {
     // Native method declarations
     private native long createContextNative(String modelPath);
     private native void destroyContextNative(long contextPtr);
-    private native String transcribeNative(long contextPtr, float[] audioData, int sampleRate);
+    private native boolean transcribeAsyncNative(long contextPtr, float[] audioData, int sampleRate, NativeRequestListener listener);
+    private native boolean installNative(long jsRuntimePtr, CallInvokerHolderImpl callInvokerHolder);
 }
\ No newline at end of file
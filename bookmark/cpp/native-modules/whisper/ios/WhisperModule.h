@@ -1,4 +1,8 @@
 #import <React/RCTBridgeModule.h>
 
 @interface WhisperModule : NSObject <RCTBridgeModule>
+
+// Native handle shared with the voice pipeline module
+- (void*)nativeHandle;
+
 @end
\ No newline at end of file
@@ -1,36 +1,71 @@
 #import "WhisperModule.h"
 #import <React/RCTLog.h>
+#import <React/RCTBridge+Private.h>
 #import "whisper-native.h"
+#import "whisper-jsi.h"
+#import "NativeRequest.h"
+
+using namespace bookmark::whisper;
 
 @implementation WhisperModule {
-    whisper::WhisperContext* _context;
+    WhisperContext* _context;
+    std::shared_ptr<ContextSlot> _slot; // context as seen by the JSI functions
 }
 
 RCT_EXPORT_MODULE()
 
+@synthesize bridge = _bridge;
+
 - (instancetype)init {
     if (self = [super init]) {
         _context = nullptr;
+        _slot = std::make_shared<ContextSlot>();
     }
     return self;
 }
 
 - (void)dealloc {
     if (_context != nullptr) {
+        _slot->clear(_context);
         whisper_destroy_context(_context);
         _context = nullptr;
     }
 }
 
+- (void*)nativeHandle {
+    return _context;
+}
+
+// Installs global.WhisperNativeJSI (see whisper-jsi.h) on the JS thread. JS falls
+// back to the promise methods below when this returns NO, e.g. under a
+// remote debugger.
+RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(install) {
+    RCTCxxBridge* bridge = (RCTCxxBridge*)self.bridge;
+    auto* runtime = static_cast<facebook::jsi::Runtime*>(bridge.runtime);
+    if (runtime == nullptr) {
+        return @NO;
+    }
+
+    try {
+        installJsi(*runtime, bridge.jsCallInvoker, _slot);
+        return @YES;
+    } catch (const std::exception& e) {
+        RCTLogError(@"Failed to install JSI bindings: %s", e.what());
+        return @NO;
+    }
+}
+
 RCT_EXPORT_METHOD(createContext:(NSString*)modelPath
                   resolver:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     @try {
         if (_context != nullptr) {
+            _slot->clear(_context);
             whisper_destroy_context(_context);
         }
 
         _context = whisper_create_context([modelPath UTF8String]);
+        _slot->set(_context);
         resolve(@(_context != nullptr));
     } @catch (NSException* e) {
         reject(@"ERR_WHISPER", @"Failed to create Whisper context", nil);
@@ -41,6 +76,7 @@ RCT_EXPORT_METHOD(cleanup:(RCTPromiseResolveBlock)resolve
                   rejecter:(RCTPromiseRejectBlock)reject) {
     @try {
         if (_context != nullptr) {
+            _slot->clear(_context);
             whisper_destroy_context(_context);
             _context = nullptr;
         }
@@ -62,21 +98,25 @@ RCT_EXPORT_METHOD(transcribe:(NSArray*)audioData
         }
 
         // Convert JS array to float array
-        float* pcmData = (float*)malloc(audioData.count * sizeof(float));
+        std::vector<float> pcmData(audioData.count);
         for (NSUInteger i = 0; i < audioData.count; i++) {
             pcmData[i] = [audioData[i] floatValue];
         }
 
-        bool success = whisper_transcribe(_context, pcmData, audioData.count, [sampleRate intValue]);
-        free(pcmData);
-
-        if (!success) {
+        // Decoded on a native worker so the module queue stays free; the
+        // samples are copied before this returns
+        void* done = NativeRequestRetain(^(bookmark::scheduler::Request* request) {
+            if (!request->succeeded()) {
+                reject(@"ERR_WHISPER", @"Failed to transcribe audio", nil);
+                return;
+            }
+            resolve(@(request->text.c_str()));
+        });
+        if (!whisper_transcribe_async(_context, pcmData.data(), pcmData.size(), [sampleRate intValue],
+                                      NativeRequestComplete, done)) {
+            NativeRequestDiscard(done);
             reject(@"ERR_WHISPER", @"Failed to transcribe audio", nil);
-            return;
         }
-
-        const char* transcription = whisper_get_transcription(_context);
-        resolve(transcription ? @(transcription) : @"");
     } @catch (NSException* e) {
         reject(@"ERR_WHISPER", @"Failed to transcribe audio", nil);
     }
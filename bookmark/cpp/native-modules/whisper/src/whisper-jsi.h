@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "jsi-bridge.h"
+#include "whisper-native.h"
+
+namespace bookmark {
+namespace whisper {
+
+using ContextSlot = bridge::HandleSlot<WhisperContext>;
+
+// Installs global.WhisperNativeJSI for the platform bridges.
+//
+//   transcribe(pcm: Float32Array, sampleRate: number): Promise<string>
+//
+// The PCM is read in place by a scheduler task, so JS must leave the buffer
+// alone until the promise settles.
+inline void installJsi(facebook::jsi::Runtime& runtime,
+                       std::shared_ptr<facebook::react::CallInvoker> invoker,
+                       std::shared_ptr<ContextSlot> slot) {
+    namespace jsi = facebook::jsi;
+
+    jsi::Object binding(runtime);
+
+    binding.setProperty(runtime, "transcribe", bridge::function(runtime, "transcribe", 2,
+        [invoker, slot](jsi::Runtime& rt, const jsi::Value* args, size_t) {
+            bridge::FloatView pcm = bridge::floatArg(rt, args[0], "pcm");
+            int sample_rate = static_cast<int>(args[1].asNumber());
+
+            return bridge::runAsync<std::string>(rt, invoker,
+                [slot, pcm, sample_rate]() {
+                    return slot->with([&](WhisperContext* ctx) {
+                        if (!ctx) throw std::runtime_error("Whisper context not initialized");
+                        std::string text;
+                        if (!ctx->transcribe(pcm.data, pcm.count, sample_rate, text)) {
+                            throw std::runtime_error("Failed to transcribe audio");
+                        }
+                        return text;
+                    });
+                },
+                [](jsi::Runtime& rt, std::string& text) {
+                    return jsi::Value(jsi::String::createFromUtf8(rt, text));
+                },
+                args[0]);
+        }));
+
+    runtime.global().setProperty(runtime, "WhisperNativeJSI", binding);
+}
+
+} // namespace whisper
+} // namespace bookmark
@@ -1,4 +1,7 @@
 #include "whisper-native.h"
+#include "metrics-native.h"
+#include "residency-native.h"
+#include "scheduler-native.h"
 #include <stdexcept>
 
 namespace bookmark {
@@ -7,22 +10,66 @@ namespace whisper {
 WhisperContext* WhisperContext::create(const std::string& model_path) {
     struct whisper_context* ctx = whisper_init_from_file(model_path.c_str());
     if (!ctx) {
+        metrics::reportError(metrics::Module::Whisper, "load model", model_path.c_str());
         return nullptr;
     }
-    return new WhisperContext(ctx);
+    return new WhisperContext(ctx, model_path);
 }
 
-WhisperContext::WhisperContext(struct whisper_context* ctx) : ctx_(ctx) {}
+WhisperContext::WhisperContext(struct whisper_context* ctx, const std::string& model_path)
+    : ctx_(ctx), model_path_(model_path), model_bytes_(metrics::pathBytes(model_path)) {
+    metrics::addGauge(metrics::Gauge::WhisperModelBytes, model_bytes_);
+    scheduler::lendContext(this, typeid(WhisperContext));
+
+    // Only needed while the user talks; dropped when idle under pressure
+    residency::ComponentCallbacks callbacks;
+    callbacks.load = [this]() {
+        ctx_ = whisper_init_from_file(model_path_.c_str());
+        if (!ctx_) {
+            metrics::reportError(metrics::Module::Whisper, "reload model", model_path_.c_str());
+            return false;
+        }
+        metrics::addGauge(metrics::Gauge::WhisperModelBytes, model_bytes_);
+        return true;
+    };
+    callbacks.unload = [this]() {
+        whisper_free(ctx_);
+        ctx_ = nullptr;
+        metrics::addGauge(metrics::Gauge::WhisperModelBytes, -model_bytes_);
+        return true;
+    };
+    residency_id_ = residency::ResidencyManager::instance().registerComponent(
+        "whisper", residency::PRIORITY_WHISPER, model_bytes_, std::move(callbacks));
+}
 
 WhisperContext::~WhisperContext() {
+    scheduler::retireContext(this);
+    pending_.drain();
+    residency::ResidencyManager::instance().unregisterComponent(residency_id_);
     if (ctx_) {
+        metrics::addGauge(metrics::Gauge::WhisperModelBytes, -model_bytes_);
         whisper_free(ctx_);
         ctx_ = nullptr;
     }
 }
 
 bool WhisperContext::transcribe(const std::vector<float>& pcm_data, int sample_rate) {
-    if (!ctx_ || pcm_data.empty()) {
+    return transcribe(pcm_data.data(), pcm_data.size(), sample_rate);
+}
+
+bool WhisperContext::transcribe(const float* pcm_data, size_t pcm_size, int sample_rate) {
+    std::string text;
+    return transcribe(pcm_data, pcm_size, sample_rate, text);
+}
+
+bool WhisperContext::transcribe(const float* pcm_data, size_t pcm_size, int sample_rate, std::string& text_out) {
+    if (!pcm_data || pcm_size == 0) {
+        return false;
+    }
+
+    residency::Lease lease(residency_id_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!lease || !ctx_) {
         return false;
     }
 
@@ -34,12 +81,22 @@ bool WhisperContext::transcribe(const std::vector<float>& pcm_data, int sample_r
     params.print_timestamps = false;
     params.translate = false;
     params.language = "en";
-    params.n_threads = 4;
+
+    // Whisper runs its own threads; size them to what the shared scheduler
+    // can spare at the caller's QoS
+    scheduler::Reservation threads(scheduler::Scheduler::instance().threadBudget(scheduler::currentQoS()));
+    params.n_threads = threads.threads();
 
     // Run inference
-    if (whisper_full(ctx_, params, pcm_data.data(), pcm_data.size()) != 0) {
+    metrics::ScopedTimer timer(metrics::Histogram::Transcribe);
+    if (whisper_full(ctx_, params, pcm_data, static_cast<int>(pcm_size)) != 0) {
+        timer.cancel();
+        metrics::reportError(metrics::Module::Whisper, "transcribe", "whisper_full failed");
         return false;
     }
+    if (sample_rate > 0) {
+        metrics::increment(metrics::Counter::AudioMsTranscribed, pcm_size * 1000 / sample_rate);
+    }
 
     // Get transcription
     const int n_segments = whisper_full_n_segments(ctx_);
@@ -55,10 +112,12 @@ bool WhisperContext::transcribe(const std::vector<float>& pcm_data, int sample_r
         }
     }
 
+    text_out = last_transcription_;
     return true;
 }
 
 std::string WhisperContext::getTranscription() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return last_transcription_;
 }
 
@@ -76,13 +135,34 @@ void whisper_destroy_context(WhisperContext* ctx) {
 
 bool whisper_transcribe(WhisperContext* ctx, const float* pcm_data, size_t pcm_size, int sample_rate) {
     if (!ctx || !pcm_data || pcm_size == 0) return false;
-    std::vector<float> data(pcm_data, pcm_data + pcm_size);
-    return ctx->transcribe(data, sample_rate);
+    return ctx->transcribe(pcm_data, pcm_size, sample_rate);
 }
 
 const char* whisper_get_transcription(WhisperContext* ctx) {
     if (!ctx) return nullptr;
-    return ctx->getTranscription().c_str();
+    // Copied into a per-thread buffer; the one getTranscription() returns
+    // would be gone before the caller could read it
+    thread_local std::string transcription;
+    transcription = ctx->getTranscription();
+    return transcription.c_str();
+}
+
+scheduler::Request* whisper_transcribe_async(WhisperContext* ctx,
+                                             const float* pcm_data,
+                                             size_t pcm_size,
+                                             int sample_rate,
+                                             scheduler::RequestCallback callback,
+                                             void* user_data) {
+    if (!ctx || !pcm_data || pcm_size == 0) return nullptr;
+
+    std::vector<float> pcm(pcm_data, pcm_data + pcm_size);
+    return scheduler::Request::submit(
+        [ctx, pcm = std::move(pcm), sample_rate](scheduler::Request& request) {
+            if (!ctx->transcribe(pcm.data(), pcm.size(), sample_rate, request.text)) {
+                request.fail("Failed to transcribe audio");
+            }
+        },
+        callback, user_data, &ctx->pendingRequests());
 }
 
 } // extern "C"
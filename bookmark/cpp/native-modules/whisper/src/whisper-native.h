@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <whisper.h>
+#include "scheduler-native.h"
 
 namespace bookmark {
 namespace whisper {
@@ -14,12 +17,24 @@ public:
     ~WhisperContext();
 
     bool transcribe(const std::vector<float>& pcm_data, int sample_rate);
+    // Mono float PCM read in place, e.g. from a buffer handed over by JS
+    bool transcribe(const float* pcm_data, size_t pcm_size, int sample_rate);
+    // Also returns this clip's text, which getTranscription() can't promise
+    // once several threads share the context
+    bool transcribe(const float* pcm_data, size_t pcm_size, int sample_rate, std::string& text_out);
     std::string getTranscription() const;
 
+    scheduler::PendingRequests& pendingRequests() { return pending_; }
+
 private:
-    WhisperContext(struct whisper_context* ctx);
+    WhisperContext(struct whisper_context* ctx, const std::string& model_path);
     struct whisper_context* ctx_;
+    std::string model_path_;
+    int64_t model_bytes_;
+    uint32_t residency_id_ = 0; // see residency-native.h
     std::string last_transcription_;
+    mutable std::mutex mutex_; // one clip at a time
+    scheduler::PendingRequests pending_;
 };
 
 // React Native binding interface
@@ -28,6 +43,15 @@ extern "C" {
     void whisper_destroy_context(WhisperContext* ctx);
     bool whisper_transcribe(WhisperContext* ctx, const float* pcm_data, size_t pcm_size, int sample_rate);
     const char* whisper_get_transcription(WhisperContext* ctx);
+
+    // Transcribes a copy of the PCM on the shared scheduler; the request's
+    // text holds the transcription. Null if the arguments are invalid.
+    scheduler::Request* whisper_transcribe_async(WhisperContext* ctx,
+                                                 const float* pcm_data,
+                                                 size_t pcm_size,
+                                                 int sample_rate,
+                                                 scheduler::RequestCallback callback,
+                                                 void* user_data);
 }
 
 } // namespace whisper
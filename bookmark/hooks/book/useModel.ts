@@ -58,7 +58,12 @@ export function useModel(book?: Book) {
         setError(null);
         setIsProcessing(true);
         const ragService = RAGService.getInstance();
-        await ragService.addText(book.content);
+        if (!await ragService.loadBook(book)) {
+          await ragService.clearIndex();
+          if (!await ragService.addText(book.content)) {
+            throw new Error('Failed to load book');
+          }
+        }
       } catch (err) {
         setError(err instanceof Error ? err.message : 'Failed to load book');
       } finally {
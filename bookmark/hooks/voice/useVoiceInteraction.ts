@@ -1,5 +1,5 @@
 import { useState, useCallback, useEffect } from 'react';
-import { VoiceService } from '../../services/VoiceService';
+import { VoiceService, VoiceTurnHandlers } from '../../services/VoiceService';
 
 type VoiceCallback = (text: string) => void;
 
@@ -29,14 +29,16 @@ export function useVoiceInteraction() {
     };
   }, []);
 
-  const startListening = useCallback(async (callback: VoiceCallback) => {
+  // With turn handlers, recordings are answered and spoken natively and
+  // callback isn't used (unless the native pipeline is unavailable)
+  const startListening = useCallback(async (callback: VoiceCallback, turn?: VoiceTurnHandlers) => {
     try {
       setError(null);
       const voiceService = VoiceService.getInstance();
       await voiceService.startListening((text) => {
         setIsListening(false);
         callback(text);
-      });
+      }, turn);
       setIsListening(true);
     } catch (err) {
       setError(err instanceof Error ? err.message : 'Failed to start listening');
@@ -0,0 +1,107 @@
+import { NativeModules, Platform } from 'react-native';
+
+const LINKING_ERROR =
+  `The package 'answer-cache-native' doesn't seem to be linked. Make sure: \n\n` +
+  Platform.select({ ios: "- You have run 'pod install'\n", default: '' }) +
+  '- You rebuilt the app after installing the package\n';
+
+const AnswerCacheNative = NativeModules.AnswerCacheNative
+  ? NativeModules.AnswerCacheNative
+  : new Proxy(
+      {},
+      {
+        get() {
+          throw new Error(LINKING_ERROR);
+        },
+      }
+    );
+
+export interface CachedAnswer {
+  answer: string;
+  similarity: number; // cosine similarity of the cached question to this one
+}
+
+export interface AnswerCacheStats {
+  hits: number;
+  misses: number;
+  invalidations: number; // books dropped because their index changed
+  books: number;
+  entries: number;
+}
+
+export interface AnswerCacheOptions {
+  path?: string; // where the cache persists between sessions
+  threshold?: number; // cosine similarity a hit needs, 0.95 by default
+  capacity?: number; // answers kept per book, 256 by default
+}
+
+// Answers to past questions keyed by book and question embedding. Entries
+// are stamped with the book's index version; passing a different version
+// drops the book's answers, since the chunks they came from may be gone.
+export interface AnswerCacheModule {
+  initialize(dimension: number, options?: AnswerCacheOptions): Promise<boolean>;
+  lookup(bookId: string, indexVersion: string, embedding: Float32Array): Promise<CachedAnswer | null>;
+  insert(bookId: string, indexVersion: string, embedding: Float32Array, answer: string): Promise<boolean>;
+  invalidate(bookId: string): Promise<void>;
+  clear(): Promise<void>;
+  save(path: string): Promise<boolean>;
+  setThreshold(threshold: number): Promise<void>;
+  getStats(): Promise<AnswerCacheStats>;
+  cleanup(): Promise<void>;
+}
+
+class AnswerCacheModuleImpl implements AnswerCacheModule {
+  private static instance: AnswerCacheModuleImpl;
+  private constructor() {}
+
+  static getInstance(): AnswerCacheModuleImpl {
+    if (!AnswerCacheModuleImpl.instance) {
+      AnswerCacheModuleImpl.instance = new AnswerCacheModuleImpl();
+    }
+    return AnswerCacheModuleImpl.instance;
+  }
+
+  // Loads the cache saved at options.path, or starts an empty one
+  async initialize(dimension: number, options: AnswerCacheOptions = {}): Promise<boolean> {
+    return await AnswerCacheNative.initialize(
+      dimension,
+      options.path ? options.path.replace(/^file:\/\//, '') : null,
+      options.threshold ?? 0.95,
+      options.capacity ?? 256
+    );
+  }
+
+  async lookup(bookId: string, indexVersion: string, embedding: Float32Array): Promise<CachedAnswer | null> {
+    return await AnswerCacheNative.lookup(bookId, indexVersion, Array.from(embedding));
+  }
+
+  async insert(bookId: string, indexVersion: string, embedding: Float32Array, answer: string): Promise<boolean> {
+    return await AnswerCacheNative.insert(bookId, indexVersion, Array.from(embedding), answer);
+  }
+
+  async invalidate(bookId: string): Promise<void> {
+    await AnswerCacheNative.invalidate(bookId);
+  }
+
+  async clear(): Promise<void> {
+    await AnswerCacheNative.clear();
+  }
+
+  async save(path: string): Promise<boolean> {
+    return await AnswerCacheNative.save(path.replace(/^file:\/\//, ''));
+  }
+
+  async setThreshold(threshold: number): Promise<void> {
+    await AnswerCacheNative.setThreshold(threshold);
+  }
+
+  async getStats(): Promise<AnswerCacheStats> {
+    return await AnswerCacheNative.getStats();
+  }
+
+  async cleanup(): Promise<void> {
+    await AnswerCacheNative.cleanup();
+  }
+}
+
+export { AnswerCacheModuleImpl as AnswerCacheModule };
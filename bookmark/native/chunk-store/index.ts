@@ -0,0 +1,142 @@
+import { NativeModules, Platform } from 'react-native';
+
+const LINKING_ERROR =
+  `The package 'chunk-store-native' doesn't seem to be linked. Make sure: \n\n` +
+  Platform.select({ ios: "- You have run 'pod install'\n", default: '' }) +
+  '- You rebuilt the app after installing the package\n';
+
+const ChunkStoreNative = NativeModules.ChunkStoreNative
+  ? NativeModules.ChunkStoreNative
+  : new Proxy(
+      {},
+      {
+        get() {
+          throw new Error(LINKING_ERROR);
+        },
+      }
+    );
+
+export interface StoredChunk {
+  text: string;
+  start: number; // byte offsets in the source file, -1 if unknown
+  end: number;
+}
+
+export interface IndexVerification {
+  ok: boolean;
+  stored: number; // chunks in the store
+  indexed: number; // vectors in the index, 0 if it couldn't be read
+  checked: number; // stored embeddings searched for in the index
+  mismatched: number; // of which the index didn't return as their own chunk
+}
+
+export type ReductionKind = 'pca' | 'rotation';
+
+export interface ReductionRecall {
+  dimension: number;
+  recall: number; // share of the full-width top k also found at this width
+  bytesPerVector: number;
+  searchUs: number; // mean single-query search time
+}
+
+const REDUCTION_KINDS: Record<ReductionKind, number> = { pca: 0, rotation: 1 };
+
+// Chunk texts, offsets and embeddings of each book, kept in SQLite by
+// ingestion. A book's FAISS index can be checked against the store and
+// rebuilt from it without embedding the book again.
+export interface ChunkStoreModule {
+  open(path: string): Promise<boolean>;
+  getChunkCount(bookId: string): Promise<number>;
+  getChunks(bookId: string, first?: number, count?: number): Promise<StoredChunk[]>;
+  removeBook(bookId: string): Promise<boolean>;
+  rebuildIndex(bookId: string, indexPath: string, reductionPath?: string): Promise<boolean>;
+  verifyIndex(bookId: string, indexPath: string, samples?: number): Promise<IndexVerification>;
+  trainReduction(
+    width: number,
+    path: string,
+    options?: { kind?: ReductionKind; maxSamples?: number }
+  ): Promise<boolean>;
+  getReductionReport(
+    widths: number[],
+    options?: { kind?: ReductionKind; maxSamples?: number; k?: number }
+  ): Promise<ReductionRecall[]>;
+  cleanup(): Promise<void>;
+}
+
+class ChunkStoreModuleImpl implements ChunkStoreModule {
+  private static instance: ChunkStoreModuleImpl;
+  private constructor() {}
+
+  static getInstance(): ChunkStoreModuleImpl {
+    if (!ChunkStoreModuleImpl.instance) {
+      ChunkStoreModuleImpl.instance = new ChunkStoreModuleImpl();
+    }
+    return ChunkStoreModuleImpl.instance;
+  }
+
+  async open(path: string): Promise<boolean> {
+    return await ChunkStoreNative.open(path.replace(/^file:\/\//, ''));
+  }
+
+  async getChunkCount(bookId: string): Promise<number> {
+    return await ChunkStoreNative.getChunkCount(bookId);
+  }
+
+  // All of the book's chunks unless a range is given
+  async getChunks(bookId: string, first: number = 0, count?: number): Promise<StoredChunk[]> {
+    const total = count ?? (await ChunkStoreNative.getChunkCount(bookId)) - first;
+    if (total <= 0) return [];
+    return await ChunkStoreNative.getChunks(bookId, first, total);
+  }
+
+  async removeBook(bookId: string): Promise<boolean> {
+    return await ChunkStoreNative.removeBook(bookId);
+  }
+
+  // With a reduction path the index stores embeddings reduced by that
+  // transform (see trainReduction)
+  async rebuildIndex(bookId: string, indexPath: string, reductionPath?: string): Promise<boolean> {
+    return await ChunkStoreNative.rebuildIndex(
+      bookId,
+      indexPath.replace(/^file:\/\//, ''),
+      reductionPath ? reductionPath.replace(/^file:\/\//, '') : null
+    );
+  }
+
+  // A missing or unreadable index comes back with indexed 0 and ok false
+  async verifyIndex(bookId: string, indexPath: string, samples: number = 32): Promise<IndexVerification> {
+    return await ChunkStoreNative.verifyIndex(bookId, indexPath.replace(/^file:\/\//, ''), samples);
+  }
+
+  // Trains a transform from the library's embeddings down to width and
+  // saves it at path, for ingestion and index rebuilds to apply
+  async trainReduction(
+    width: number,
+    path: string,
+    options: { kind?: ReductionKind; maxSamples?: number } = {}
+  ): Promise<boolean> {
+    const { kind = 'pca', maxSamples = 20000 } = options;
+    return await ChunkStoreNative.trainReduction(
+      REDUCTION_KINDS[kind],
+      width,
+      maxSamples,
+      path.replace(/^file:\/\//, '')
+    );
+  }
+
+  // Top-k recall of stored embeddings reduced to each width against full
+  // width, to pick the smallest width that keeps retrieval quality
+  async getReductionReport(
+    widths: number[],
+    options: { kind?: ReductionKind; maxSamples?: number; k?: number } = {}
+  ): Promise<ReductionRecall[]> {
+    const { kind = 'pca', maxSamples = 5000, k = 10 } = options;
+    return await ChunkStoreNative.getReductionReport(REDUCTION_KINDS[kind], widths, maxSamples, k);
+  }
+
+  async cleanup(): Promise<void> {
+    await ChunkStoreNative.cleanup();
+  }
+}
+
+export { ChunkStoreModuleImpl as ChunkStoreModule };
@@ -1,4 +1,5 @@
 import { NativeModules, Platform } from 'react-native';
+import { jsiBindingsFor } from '../jsi';
 
 const LINKING_ERROR =
   `The package 'faiss-native' doesn't seem to be linked. Make sure: \n\n` +
@@ -16,13 +17,28 @@ const FaissNative = NativeModules.FaissNative
       }
     );
 
+// Both run off the JS thread; the input buffer must not be modified until
+// the promise settles
+interface FaissJSI {
+  addEmbeddings(embeddings: Float32Array): Promise<boolean>;
+  search(query: Float32Array, k: number): Promise<{ indices: ArrayBuffer; distances: ArrayBuffer }>;
+}
+
+declare global {
+  // Installed by FaissNative.install(), see
+  // cpp/native-modules/faiss/src/faiss-jsi.h
+  var FaissNativeJSI: FaissJSI | undefined;
+}
+
+const jsiBindings = jsiBindingsFor<FaissJSI>('FaissNativeJSI', FaissNative);
+
 interface SearchResult {
   index: number;
   distance: number;
 }
 
 export interface FaissModule {
-  createIndex(dimension: number): Promise<boolean>;
+  createIndex(dimension: number, reductionPath?: string): Promise<boolean>;
   loadIndex(path: string): Promise<boolean>;
   cleanup(): Promise<void>;
   addEmbedding(embedding: Float32Array): Promise<boolean>;
@@ -43,12 +59,17 @@ class FaissModuleImpl implements FaissModule {
     return FaissModuleImpl.instance;
   }
 
-  async createIndex(dimension: number): Promise<boolean> {
-    return await FaissNative.createIndex(dimension);
+  // With a reduction path (see ChunkStoreModule.trainReduction) the index
+  // still takes embeddings of dimension but stores them reduced
+  async createIndex(dimension: number, reductionPath?: string): Promise<boolean> {
+    return await FaissNative.createIndex(
+      dimension,
+      reductionPath ? reductionPath.replace(/^file:\/\//, '') : null
+    );
   }
 
   async loadIndex(path: string): Promise<boolean> {
-    return await FaissNative.loadIndex(path);
+    return await FaissNative.loadIndex(path.replace(/^file:\/\//, ''));
   }
 
   async cleanup(): Promise<void> {
@@ -56,15 +77,26 @@ class FaissModuleImpl implements FaissModule {
   }
 
   async addEmbedding(embedding: Float32Array): Promise<boolean> {
+    const jsi = jsiBindings();
+    if (jsi) {
+      return await jsi.addEmbeddings(embedding);
+    }
     return await FaissNative.addEmbedding(Array.from(embedding));
   }
 
   async search(query: Float32Array, k: number): Promise<SearchResult[]> {
+    const jsi = jsiBindings();
+    if (jsi) {
+      const found = await jsi.search(query, k);
+      const indices = new Int32Array(found.indices);
+      const distances = new Float32Array(found.distances);
+      return Array.from(indices, (index, i) => ({ index, distance: distances[i] }));
+    }
     return await FaissNative.search(Array.from(query), k);
   }
 
   async saveIndex(path: string): Promise<boolean> {
-    return await FaissNative.saveIndex(path);
+    return await FaissNative.saveIndex(path.replace(/^file:\/\//, ''));
   }
 
   async clearIndex(): Promise<void> {
@@ -0,0 +1,103 @@
+import { NativeEventEmitter, NativeModules, Platform } from 'react-native';
+
+const LINKING_ERROR =
+  `The package 'ingest-native' doesn't seem to be linked. Make sure: \n\n` +
+  Platform.select({ ios: "- You have run 'pod install'\n", default: '' }) +
+  '- You rebuilt the app after installing the package\n';
+
+const IngestNative = NativeModules.IngestNative
+  ? NativeModules.IngestNative
+  : new Proxy(
+      {},
+      {
+        get() {
+          throw new Error(LINKING_ERROR);
+        },
+      }
+    );
+
+export interface IngestProgress {
+  bytesDone: number;
+  totalBytes: number;
+  chunksDone: number;
+}
+
+export interface IngestOptions {
+  maxChunkBytes?: number;
+  overlapBytes?: number;
+  batchSize?: number;
+  // Also store each chunk and its embedding under bookId in the chunk
+  // store at path (see native/chunk-store)
+  store?: { path: string; bookId: string };
+  // Index embeddings reduced by the transform saved here, see
+  // ChunkStoreModule.trainReduction
+  reductionPath?: string;
+  // With store set, also add the book's term dictionary under store.bookId
+  // to the term library saved here, replacing the one from any earlier
+  // ingestion of the book (see TermsModule.loadLibrary)
+  termLibraryPath?: string;
+}
+
+export interface IngestModule {
+  initialize(): Promise<boolean>;
+  cleanup(): Promise<void>;
+  ingest(bookPath: string, indexPath: string, options?: IngestOptions): Promise<boolean>;
+  cancel(): Promise<void>;
+  addListener(listener: (progress: IngestProgress) => void): () => void;
+}
+
+class IngestModuleImpl implements IngestModule {
+  private static instance: IngestModuleImpl;
+  private emitter: NativeEventEmitter | null = null;
+  private constructor() {}
+
+  static getInstance(): IngestModuleImpl {
+    if (!IngestModuleImpl.instance) {
+      IngestModuleImpl.instance = new IngestModuleImpl();
+    }
+    return IngestModuleImpl.instance;
+  }
+
+  // MLC LLM must be initialized first; embeddings use its native context
+  async initialize(): Promise<boolean> {
+    return await IngestNative.createIngestor();
+  }
+
+  async cleanup(): Promise<void> {
+    await IngestNative.cleanup();
+  }
+
+  // Resumes from the last checkpoint if a previous run for the same
+  // index path was interrupted
+  async ingest(bookPath: string, indexPath: string, options: IngestOptions = {}): Promise<boolean> {
+    const { maxChunkBytes = 512, overlapBytes = 50, batchSize = 16, store, reductionPath, termLibraryPath } = options;
+    return await IngestNative.ingest(
+      bookPath.replace(/^file:\/\//, ''),
+      indexPath.replace(/^file:\/\//, ''),
+      {
+        maxChunkBytes,
+        overlapBytes,
+        batchSize,
+        ...(store ? { storePath: store.path.replace(/^file:\/\//, ''), bookId: store.bookId } : {}),
+        ...(reductionPath ? { reductionPath: reductionPath.replace(/^file:\/\//, '') } : {}),
+        ...(store && termLibraryPath
+          ? { termLibraryPath: termLibraryPath.replace(/^file:\/\//, '') }
+          : {}),
+      }
+    );
+  }
+
+  async cancel(): Promise<void> {
+    await IngestNative.cancel();
+  }
+
+  addListener(listener: (progress: IngestProgress) => void): () => void {
+    if (!this.emitter) {
+      this.emitter = new NativeEventEmitter(IngestNative);
+    }
+    const subscription = this.emitter.addListener('onIngestProgress', listener);
+    return () => subscription.remove();
+  }
+}
+
+export { IngestModuleImpl as IngestModule };
@@ -0,0 +1,26 @@
+// JSI bindings pass ArrayBuffers instead of copying every value through the
+// bridge. Each module's native side installs them as a global on install().
+//
+// Returns a getter for the bindings published as globalName, installing
+// them on first use. It yields undefined where they couldn't be installed
+// (e.g. under a remote debugger, or a native build without them), in which
+// case callers use the module's bridge methods.
+export function jsiBindingsFor<T>(
+  globalName: string,
+  nativeModule: { install(): void }
+): () => T | undefined {
+  const scope = globalThis as unknown as Record<string, T | undefined>;
+  let installAttempted = false;
+
+  return () => {
+    if (!scope[globalName] && !installAttempted) {
+      installAttempted = true;
+      try {
+        nativeModule.install();
+      } catch {
+        // Native build without the bindings; stay on the bridge
+      }
+    }
+    return scope[globalName];
+  };
+}
@@ -0,0 +1,93 @@
+import { NativeModules, Platform } from 'react-native';
+
+const LINKING_ERROR =
+  `The package 'metrics-native' doesn't seem to be linked. Make sure: \n\n` +
+  Platform.select({ ios: "- You have run 'pod install'\n", default: '' }) +
+  '- You rebuilt the app after installing the package\n';
+
+const MetricsNative = NativeModules.MetricsNative
+  ? NativeModules.MetricsNative
+  : new Proxy(
+      {},
+      {
+        get() {
+          throw new Error(LINKING_ERROR);
+        },
+      }
+    );
+
+export type LatencyStage = 'search' | 'embed' | 'prefill' | 'decode' | 'transcribe' | 'synthesize';
+
+export type MetricsCounter =
+  | 'search_queries'
+  | 'vectors_added'
+  | 'texts_embedded'
+  | 'prompts_processed'
+  | 'tokens_generated'
+  | 'audio_ms_transcribed'
+  | 'audio_ms_synthesized'
+  | 'answer_cache_hits'
+  | 'answer_cache_misses';
+
+export type MetricsGauge = 'index_bytes' | 'llm_model_bytes' | 'whisper_model_bytes' | 'tts_model_bytes';
+
+export type NativeModuleName =
+  | 'faiss'
+  | 'llm'
+  | 'whisper'
+  | 'tts'
+  | 'terms'
+  | 'ingest'
+  | 'voice_pipeline'
+  | 'scheduler'
+  | 'answer_cache'
+  | 'chunk_store';
+
+// Percentiles come from log-linear buckets and are within ~6% of the
+// recorded values. Prefill is prompt to first token; decode is per token.
+export interface LatencySummary {
+  count: number;
+  mean_us: number;
+  p50_us: number;
+  p90_us: number;
+  p99_us: number;
+  max_us: number;
+}
+
+export interface MetricsSnapshot {
+  uptime_ms: number; // since process start or the last reset
+  resident_bytes: number;
+  histograms: Record<LatencyStage, LatencySummary>;
+  counters: Record<MetricsCounter, number>;
+  gauges: Record<MetricsGauge, number>;
+  errors: Record<NativeModuleName, number>;
+}
+
+export interface MetricsModule {
+  getSnapshot(): Promise<MetricsSnapshot>;
+  reset(): Promise<void>;
+}
+
+class MetricsModuleImpl implements MetricsModule {
+  private static instance: MetricsModuleImpl;
+  private constructor() {}
+
+  static getInstance(): MetricsModuleImpl {
+    if (!MetricsModuleImpl.instance) {
+      MetricsModuleImpl.instance = new MetricsModuleImpl();
+    }
+    return MetricsModuleImpl.instance;
+  }
+
+  async getSnapshot(): Promise<MetricsSnapshot> {
+    const json: string = await MetricsNative.getSnapshot();
+    return JSON.parse(json) as MetricsSnapshot;
+  }
+
+  // Histograms, counters and error counts start over; gauges are kept
+  async reset(): Promise<void> {
+    await MetricsNative.reset();
+  }
+}
+
+export { MetricsModuleImpl as MetricsModule };
@@ -1,4 +1,5 @@
 import { NativeModules, Platform } from 'react-native';
+import { jsiBindingsFor } from '../jsi';
 
 const LINKING_ERROR =
   `The package 'mlc-llm-native' doesn't seem to be linked. Make sure: \n\n` +
@@ -16,6 +17,18 @@ const MLCLLMNative = NativeModules.MLCLLMNative
       }
     );
 
+interface MLCLLMJSI {
+  getEmbeddings(text: string): Promise<ArrayBuffer>;
+}
+
+declare global {
+  // Installed by MLCLLMNative.install(), see
+  // cpp/native-modules/mlc-llm/src/mlc-llm-jsi.h
+  var MLCLLMNativeJSI: MLCLLMJSI | undefined;
+}
+
+const jsiBindings = jsiBindingsFor<MLCLLMJSI>('MLCLLMNativeJSI', MLCLLMNative);
+
 export interface MLCLLMModule {
   initialize(modelPath: string, tokenizerPath: string): Promise<boolean>;
   cleanup(): Promise<void>;
@@ -27,10 +40,18 @@ export interface MLCLLMModule {
     topP: number
   ): Promise<string>;
   getEmbeddings(text: string): Promise<Float32Array>;
+
+  // Rolling session summaries, kept up to date natively as turns are added
+  // (see cpp/native-modules/mlc-llm/src/summarizer-native.h)
+  addSummaryTurn(sessionId: string, role: string, text: string): Promise<boolean>;
+  getSummary(sessionId: string, timeoutMs?: number): Promise<string | null>;
+  endSummary(sessionId: string): Promise<void>;
 }
 
 class MLCLLMModuleImpl implements MLCLLMModule {
   private static instance: MLCLLMModuleImpl;
+  // Several services initialize the LLM on startup; share one load per model
+  private loading: { key: string; result: Promise<boolean> } | null = null;
   private constructor() {}
 
   static getInstance(): MLCLLMModuleImpl {
@@ -41,6 +62,24 @@ class MLCLLMModuleImpl implements MLCLLMModule {
   }
 
   async initialize(modelPath: string, tokenizerPath: string): Promise<boolean> {
+    const key = `${modelPath}\n${tokenizerPath}`;
+    if (this.loading?.key !== key) {
+      const result = this.load(modelPath, tokenizerPath);
+      this.loading = { key, result };
+      // Let a failed load be retried
+      result.then(
+        (ok) => {
+          if (!ok && this.loading?.result === result) this.loading = null;
+        },
+        () => {
+          if (this.loading?.result === result) this.loading = null;
+        }
+      );
+    }
+    return await this.loading.result;
+  }
+
+  private async load(modelPath: string, tokenizerPath: string): Promise<boolean> {
     const initialized = await MLCLLMNative.createContext(modelPath, tokenizerPath);
     if (initialized) {
       return await MLCLLMNative.loadModel();
@@ -49,6 +88,7 @@ class MLCLLMModuleImpl implements MLCLLMModule {
   }
 
   async cleanup(): Promise<void> {
+    this.loading = null;
     await MLCLLMNative.cleanup();
   }
 
@@ -69,9 +109,27 @@ class MLCLLMModuleImpl implements MLCLLMModule {
   }
 
   async getEmbeddings(text: string): Promise<Float32Array> {
+    const jsi = jsiBindings();
+    if (jsi) {
+      return new Float32Array(await jsi.getEmbeddings(text));
+    }
     const embeddings = await MLCLLMNative.getEmbeddings(text);
     return new Float32Array(embeddings);
   }
+
+  async addSummaryTurn(sessionId: string, role: string, text: string): Promise<boolean> {
+    return await MLCLLMNative.addSummaryTurn(sessionId, role, text);
+  }
+
+  // Waits up to timeoutMs for turns still being folded in, then returns the
+  // summary as it stands; null if the session has none yet
+  async getSummary(sessionId: string, timeoutMs: number = 10000): Promise<string | null> {
+    return await MLCLLMNative.getSummary(sessionId, timeoutMs);
+  }
+
+  async endSummary(sessionId: string): Promise<void> {
+    await MLCLLMNative.endSummary(sessionId);
+  }
 }
 
 export { MLCLLMModuleImpl as MLCLLMModule };
\ No newline at end of file
@@ -0,0 +1,90 @@
+import { NativeModules, Platform } from 'react-native';
+
+const LINKING_ERROR =
+  `The package 'residency-native' doesn't seem to be linked. Make sure: \n\n` +
+  Platform.select({ ios: "- You have run 'pod install'\n", default: '' }) +
+  '- You rebuilt the app after installing the package\n';
+
+const ResidencyNative = NativeModules.ResidencyNative
+  ? NativeModules.ResidencyNative
+  : new Proxy(
+      {},
+      {
+        get() {
+          throw new Error(LINKING_ERROR);
+        },
+      }
+    );
+
+export type ResidentComponent = 'llm' | 'whisper' | 'tts' | 'index';
+
+export enum MemoryPressure {
+  None = 0,
+  Moderate = 1, // drop caches of idle components
+  Critical = 2, // also evict every idle component
+}
+
+export interface ComponentResidency {
+  name: ResidentComponent;
+  state: 'resident' | 'trimmed' | 'evicted';
+  priority: number; // lower is evicted first
+  bytes: number; // footprint when fully loaded
+  resident_bytes: number;
+  pins: number; // calls currently using the component
+  idle_ms: number;
+  evictions: number;
+  reloads: number;
+  trims: number;
+}
+
+export interface ResidencySnapshot {
+  budget_bytes: number;
+  resident_bytes: number;
+  components: ComponentResidency[];
+}
+
+export interface ResidencyModule {
+  setBudget(bytes: number): Promise<void>;
+  getBudget(): Promise<number>;
+  prefetch(name: ResidentComponent): Promise<number>;
+  trimMemory(level: MemoryPressure): Promise<void>;
+  getSnapshot(): Promise<ResidencySnapshot>;
+}
+
+class ResidencyModuleImpl implements ResidencyModule {
+  private static instance: ResidencyModuleImpl;
+  private constructor() {}
+
+  static getInstance(): ResidencyModuleImpl {
+    if (!ResidencyModuleImpl.instance) {
+      ResidencyModuleImpl.instance = new ResidencyModuleImpl();
+    }
+    return ResidencyModuleImpl.instance;
+  }
+
+  // Idle components are evicted until the resident total fits
+  async setBudget(bytes: number): Promise<void> {
+    await ResidencyNative.setBudget(bytes);
+  }
+
+  async getBudget(): Promise<number> {
+    return await ResidencyNative.getBudget();
+  }
+
+  // Starts reloading an evicted component in the background so the next
+  // call doesn't pay for it. Resolves with how many loads were queued.
+  async prefetch(name: ResidentComponent): Promise<number> {
+    return await ResidencyNative.prefetch(name);
+  }
+
+  async trimMemory(level: MemoryPressure): Promise<void> {
+    await ResidencyNative.trimMemory(level);
+  }
+
+  async getSnapshot(): Promise<ResidencySnapshot> {
+    const json: string = await ResidencyNative.getSnapshot();
+    return JSON.parse(json) as ResidencySnapshot;
+  }
+}
+
+export { ResidencyModuleImpl as ResidencyModule };
@@ -0,0 +1,65 @@
+import { NativeModules, Platform } from 'react-native';
+
+const LINKING_ERROR =
+  `The package 'scheduler-native' doesn't seem to be linked. Make sure: \n\n` +
+  Platform.select({ ios: "- You have run 'pod install'\n", default: '' }) +
+  '- You rebuilt the app after installing the package\n';
+
+const SchedulerNative = NativeModules.SchedulerNative
+  ? NativeModules.SchedulerNative
+  : new Proxy(
+      {},
+      {
+        get() {
+          throw new Error(LINKING_ERROR);
+        },
+      }
+    );
+
+// Active threads count pool workers plus the threads Whisper, FAISS and
+// MLC run for a call in progress
+export interface SchedulerStats {
+  maxThreads: number;
+  backgroundLimit: number;
+  activeInteractive: number;
+  activeBackground: number;
+  tasksRun: number;
+  tasksStolen: number;
+  backgroundDeferred: number; // times background work waited for a free thread
+  bigCores: number;
+  littleCores: number; // 0 on CPUs without a slower cluster
+}
+
+export interface SchedulerModule {
+  setMaxThreads(threads: number): Promise<void>;
+  setBackgroundLimit(threads: number): Promise<void>;
+  getStats(): Promise<SchedulerStats>;
+}
+
+class SchedulerModuleImpl implements SchedulerModule {
+  private static instance: SchedulerModuleImpl;
+  private constructor() {}
+
+  static getInstance(): SchedulerModuleImpl {
+    if (!SchedulerModuleImpl.instance) {
+      SchedulerModuleImpl.instance = new SchedulerModuleImpl();
+    }
+    return SchedulerModuleImpl.instance;
+  }
+
+  // Defaults to one thread per core; clamped to the core count
+  async setMaxThreads(threads: number): Promise<void> {
+    await SchedulerNative.setMaxThreads(threads);
+  }
+
+  // Defaults to the little cluster; always leaves a thread for interactive work
+  async setBackgroundLimit(threads: number): Promise<void> {
+    await SchedulerNative.setBackgroundLimit(threads);
+  }
+
+  async getStats(): Promise<SchedulerStats> {
+    return await SchedulerNative.getStats();
+  }
+}
+
+export { SchedulerModuleImpl as SchedulerModule };
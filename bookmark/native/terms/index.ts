@@ -0,0 +1,99 @@
+import { NativeModules, Platform } from 'react-native';
+
+const LINKING_ERROR =
+  `The package 'terms-native' doesn't seem to be linked. Make sure: \n\n` +
+  Platform.select({ ios: "- You have run 'pod install'\n", default: '' }) +
+  '- You rebuilt the app after installing the package\n';
+
+const TermsNative = NativeModules.TermsNative
+  ? NativeModules.TermsNative
+  : new Proxy(
+      {},
+      {
+        get() {
+          throw new Error(LINKING_ERROR);
+        },
+      }
+    );
+
+export interface TermLookup {
+  count: number;
+  offsets: number[]; // byte offsets of each occurrence in the book file
+}
+
+export interface ScoredTerm {
+  term: string;
+  score: number;
+}
+
+export interface TermsModule {
+  buildDictionary(bookPath: string, dictionaryPath: string): Promise<boolean>;
+  loadDictionary(dictionaryPath: string): Promise<boolean>;
+  lookup(word: string, maxResults?: number): Promise<TermLookup>;
+  getTopTerms(k?: number, useLibrary?: boolean): Promise<ScoredTerm[]>;
+  extractKeyTerms(text: string, k?: number): Promise<string[]>;
+  loadLibrary(path: string): Promise<boolean>;
+  saveLibrary(path: string): Promise<boolean>;
+  addBookToLibrary(bookId: string): Promise<boolean>;
+  removeBookFromLibrary(bookId: string): Promise<boolean>;
+  cleanup(): Promise<void>;
+}
+
+class TermsModuleImpl implements TermsModule {
+  private static instance: TermsModuleImpl;
+  private constructor() {}
+
+  static getInstance(): TermsModuleImpl {
+    if (!TermsModuleImpl.instance) {
+      TermsModuleImpl.instance = new TermsModuleImpl();
+    }
+    return TermsModuleImpl.instance;
+  }
+
+  async buildDictionary(bookPath: string, dictionaryPath: string): Promise<boolean> {
+    return await TermsNative.buildDictionary(
+      bookPath.replace(/^file:\/\//, ''),
+      dictionaryPath.replace(/^file:\/\//, '')
+    );
+  }
+
+  async loadDictionary(dictionaryPath: string): Promise<boolean> {
+    return await TermsNative.loadDictionary(dictionaryPath.replace(/^file:\/\//, ''));
+  }
+
+  async lookup(word: string, maxResults: number = 100): Promise<TermLookup> {
+    return await TermsNative.lookup(word, maxResults);
+  }
+
+  // Scores are TF-IDF against the loaded library when useLibrary is set,
+  // plain term frequency otherwise
+  async getTopTerms(k: number = 20, useLibrary: boolean = true): Promise<ScoredTerm[]> {
+    return await TermsNative.getTopTerms(k, useLibrary);
+  }
+
+  async extractKeyTerms(text: string, k: number = 20): Promise<string[]> {
+    return await TermsNative.extractKeyTerms(text, k);
+  }
+
+  async loadLibrary(path: string): Promise<boolean> {
+    return await TermsNative.loadLibrary(path.replace(/^file:\/\//, ''));
+  }
+
+  async saveLibrary(path: string): Promise<boolean> {
+    return await TermsNative.saveLibrary(path.replace(/^file:\/\//, ''));
+  }
+
+  async addBookToLibrary(bookId: string): Promise<boolean> {
+    return await TermsNative.addBookToLibrary(bookId);
+  }
+
+  async removeBookFromLibrary(bookId: string): Promise<boolean> {
+    return await TermsNative.removeBookFromLibrary(bookId);
+  }
+
+  async cleanup(): Promise<void> {
+    await TermsNative.cleanup();
+  }
+}
+
+export { TermsModuleImpl as TermsModule };
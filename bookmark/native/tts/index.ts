@@ -1,4 +1,5 @@
 import { NativeModules, Platform } from 'react-native';
+import { jsiBindingsFor } from '../jsi';
 
 const LINKING_ERROR =
   `The package 'tts-native' doesn't seem to be linked. Make sure: \n\n` +
@@ -16,10 +17,36 @@ const TTSNative = NativeModules.TTSNative
       }
     );
 
+interface TTSJSI {
+  synthesize(text: string): Promise<ArrayBuffer>;
+}
+
+declare global {
+  // Installed by TTSNative.install(), see
+  // cpp/native-modules/tts/src/tts-jsi.h
+  var TTSNativeJSI: TTSJSI | undefined;
+}
+
+const jsiBindings = jsiBindingsFor<TTSJSI>('TTSNativeJSI', TTSNative);
+
+export interface SynthesisStats {
+  phonemizeMs: number;
+  inferenceMs: number;
+  totalMs: number;
+  sentences: number;
+  batches: number; // inferences run, one per sentence
+  phonemeCacheHits: number;
+  phonemeCacheMisses: number;
+}
+
 export interface TTSModule {
   initialize(modelPath: string, configPath: string): Promise<boolean>;
   cleanup(): Promise<void>;
   synthesize(text: string): Promise<Float32Array>;
+  setCacheDirectory(cacheDir: string): Promise<void>;
+  setSampleRate(sampleRate: number): Promise<void>;
+  synthesizeToFile(text: string): Promise<string>;
+  getLastStats(): Promise<SynthesisStats>;
 }
 
 class TTSModuleImpl implements TTSModule {
@@ -46,9 +73,29 @@ class TTSModuleImpl implements TTSModule {
   }
 
   async synthesize(text: string): Promise<Float32Array> {
+    const jsi = jsiBindings();
+    if (jsi) {
+      return new Float32Array(await jsi.synthesize(text));
+    }
     const samples = await TTSNative.synthesize(text);
     return new Float32Array(samples);
   }
+
+  async setCacheDirectory(cacheDir: string): Promise<void> {
+    await TTSNative.setCacheDirectory(cacheDir);
+  }
+
+  async setSampleRate(sampleRate: number): Promise<void> {
+    await TTSNative.setSampleRate(sampleRate);
+  }
+
+  async synthesizeToFile(text: string): Promise<string> {
+    return await TTSNative.synthesizeToFile(text);
+  }
+
+  async getLastStats(): Promise<SynthesisStats> {
+    return await TTSNative.getLastStats();
+  }
 }
 
 export { TTSModuleImpl as TTSModule };
\ No newline at end of file
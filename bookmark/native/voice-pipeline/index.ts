@@ -0,0 +1,100 @@
+import { NativeEventEmitter, NativeModules, Platform } from 'react-native';
+
+const LINKING_ERROR =
+  `The package 'voice-pipeline-native' doesn't seem to be linked. Make sure: \n\n` +
+  Platform.select({ ios: "- You have run 'pod install'\n", default: '' }) +
+  '- You rebuilt the app after installing the package\n';
+
+const VoicePipelineNative = NativeModules.VoicePipelineNative
+  ? NativeModules.VoicePipelineNative
+  : new Proxy(
+      {},
+      {
+        get() {
+          throw new Error(LINKING_ERROR);
+        },
+      }
+    );
+
+export interface VoiceTurnTimings {
+  transcribeMs: number;
+  retrieveMs: number;
+  firstTokenMs: number;
+  firstAudioMs: number;
+  totalMs: number;
+}
+
+export interface VoicePipelineEvent {
+  type: 'transcript' | 'retrieved' | 'token' | 'sentence' | 'audio' | 'done' | 'error';
+  text: string;
+  count: number;
+  sampleRate: number;
+  timings: VoiceTurnTimings;
+}
+
+interface GenerationOptions {
+  topK?: number;
+  maxTokens?: number;
+  temperature?: number;
+  topP?: number;
+}
+
+export interface VoicePipelineModule {
+  initialize(): Promise<boolean>;
+  cleanup(): Promise<void>;
+  setChunks(chunks: string[]): Promise<void>;
+  setGeneration(options: GenerationOptions): Promise<void>;
+  runTurn(wavPath: string): Promise<boolean>;
+  cancel(): Promise<void>;
+  addListener(listener: (event: VoicePipelineEvent) => void): () => void;
+}
+
+class VoicePipelineModuleImpl implements VoicePipelineModule {
+  private static instance: VoicePipelineModuleImpl;
+  private emitter: NativeEventEmitter | null = null;
+  private constructor() {}
+
+  static getInstance(): VoicePipelineModuleImpl {
+    if (!VoicePipelineModuleImpl.instance) {
+      VoicePipelineModuleImpl.instance = new VoicePipelineModuleImpl();
+    }
+    return VoicePipelineModuleImpl.instance;
+  }
+
+  // Whisper, MLC LLM, FAISS and TTS must be initialized first; the
+  // pipeline shares their native contexts rather than loading its own
+  async initialize(): Promise<boolean> {
+    return await VoicePipelineNative.createPipeline();
+  }
+
+  async cleanup(): Promise<void> {
+    await VoicePipelineNative.cleanup();
+  }
+
+  async setChunks(chunks: string[]): Promise<void> {
+    await VoicePipelineNative.setChunks(chunks);
+  }
+
+  async setGeneration(options: GenerationOptions): Promise<void> {
+    const { topK = 3, maxTokens = 256, temperature = 0.7, topP = 0.95 } = options;
+    await VoicePipelineNative.setGeneration(topK, maxTokens, temperature, topP);
+  }
+
+  async runTurn(wavPath: string): Promise<boolean> {
+    return await VoicePipelineNative.runTurn(wavPath.replace(/^file:\/\//, ''));
+  }
+
+  async cancel(): Promise<void> {
+    await VoicePipelineNative.cancel();
+  }
+
+  addListener(listener: (event: VoicePipelineEvent) => void): () => void {
+    if (!this.emitter) {
+      this.emitter = new NativeEventEmitter(VoicePipelineNative);
+    }
+    const subscription = this.emitter.addListener('onVoicePipelineEvent', listener);
+    return () => subscription.remove();
+  }
+}
+
+export { VoicePipelineModuleImpl as VoicePipelineModule };
@@ -1,4 +1,5 @@
 import { NativeModules, Platform } from 'react-native';
+import { jsiBindingsFor } from '../jsi';
 
 const LINKING_ERROR =
   `The package 'whisper-native' doesn't seem to be linked. Make sure: \n\n` +
@@ -21,6 +22,18 @@ interface WhisperOptions {
   task?: 'transcribe' | 'translate';
 }
 
+interface WhisperJSI {
+  transcribe(pcm: Float32Array, sampleRate: number): Promise<string>;
+}
+
+declare global {
+  // Installed by WhisperNative.install(), see
+  // cpp/native-modules/whisper/src/whisper-jsi.h
+  var WhisperNativeJSI: WhisperJSI | undefined;
+}
+
+const jsiBindings = jsiBindingsFor<WhisperJSI>('WhisperNativeJSI', WhisperNative);
+
 export interface WhisperModule {
   initialize(modelPath: string): Promise<boolean>;
   cleanup(): Promise<void>;
@@ -51,6 +64,11 @@ class WhisperModuleImpl implements WhisperModule {
     sampleRate: number,
     options: WhisperOptions = {}
   ): Promise<string> {
+    const jsi = jsiBindings();
+    if (jsi) {
+      // Native code reads the samples in place until this settles
+      return await jsi.transcribe(audioData, sampleRate);
+    }
     return await NativeModules.WhisperNative.transcribe(
       Array.from(audioData),
       sampleRate,
@@ -1,4 +1,5 @@
 import { Book } from '../types/book';
+import { TermsModule } from '../native/terms';
 
 interface ChunkOptions {
   maxChunkSize?: number;
@@ -100,6 +101,12 @@ export class BookProcessor {
   }
 
   async extractKeyTerms(text: string): Promise<string[]> {
+    try {
+      return await TermsModule.getInstance().extractKeyTerms(text, 20);
+    } catch (error) {
+      console.warn('Native term extraction unavailable, falling back to JS:', error);
+    }
+
     try {
       // Split text into words
       const words = text.toLowerCase()
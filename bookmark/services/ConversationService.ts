@@ -2,10 +2,13 @@ import { RAGService } from './RAGService';
 import { ModelService } from './ModelService';
 import { DatabaseService } from './DatabaseService';
 import { BookProcessor } from './BookProcessor';
+import { NoteService } from './NoteService';
 import { Book } from '../types/book';
+import { ConversationMessage } from '../types/conversation';
 
 interface ConversationState {
   bookId: string;
+  sessionId: string;
   history: { role: 'user' | 'assistant'; content: string }[];
 }
 
@@ -15,6 +18,7 @@ export class ConversationService {
   private modelService: ModelService;
   private dbService: DatabaseService;
   private bookProcessor: BookProcessor;
+  private noteService: NoteService;
   private isInitialized: boolean = false;
   private currentState: ConversationState | null = null;
 
@@ -23,6 +27,7 @@ export class ConversationService {
     this.modelService = ModelService.getInstance();
     this.dbService = DatabaseService.getInstance();
     this.bookProcessor = BookProcessor.getInstance();
+    this.noteService = new NoteService(this.modelService);
   }
 
   static getInstance(): ConversationService {
@@ -60,16 +65,25 @@ export class ConversationService {
     }
 
     try {
-      // Get processed text from BookProcessor
-      const processedText = await this.bookProcessor.processBook(book);
-      if (!processedText) return false;
+      // Native ingestion, or the book's saved index once it has been
+      // ingested; chunking in JS is the fallback if that fails
+      const loaded = await this.ragService.loadBook(book);
+      if (!loaded) {
+        const processedText = await this.bookProcessor.processBook(book);
+        if (!processedText) return false;
+        await this.ragService.clearIndex();
+        if (!await this.ragService.addText(processedText)) return false;
+      }
 
-      // Add text to RAG system
-      await this.ragService.addText(processedText);
+      // The previous book's session is over; nothing will ask for its summary
+      if (this.currentState) {
+        await this.modelService.endSession(this.currentState.sessionId);
+      }
 
       // Initialize conversation state
       this.currentState = {
         bookId: book.id,
+        sessionId: `session_${Date.now()}_${Math.random().toString(36).substr(2, 9)}`,
         history: [],
       };
 
@@ -100,22 +114,22 @@ export class ConversationService {
         .map(msg => `${msg.role === 'user' ? 'User' : 'Assistant'}: ${msg.content}`)
         .join('\n');
 
+      // Answers depend on the earlier turns in the prompt, so only an
+      // opening question, asked without any, can share cached answers
+      const contextFree = this.currentState.history.length === 1;
+
       // Get response using RAG
       const response = await this.ragService.processQuery(
         `${historyContext}\nUser: ${message}\nAssistant:`,
         1024, // max tokens
-        0.7 // temperature
+        0.7, // temperature
+        contextFree ? { bookId: this.currentState.bookId, question: message } : undefined
       );
 
       // Add assistant response to history
       this.currentState.history.push({ role: 'assistant', content: response });
 
-      // Save conversation to database
-      await this.dbService.saveConversation(
-        this.currentState.bookId,
-        this.currentState.history
-      );
-
+      await this.recordExchange(message, response);
       return response;
     } catch (error) {
       console.error('Error processing message:', error);
@@ -123,6 +137,59 @@ export class ConversationService {
     }
   }
 
+  // Adds a question and answer produced elsewhere, such as a voice turn
+  // answered by the native pipeline, to the conversation
+  async addExchange(message: string, response: string): Promise<void> {
+    if (!this.currentState) return;
+
+    this.currentState.history.push({ role: 'user', content: message });
+    this.currentState.history.push({ role: 'assistant', content: response });
+    await this.recordExchange(message, response);
+  }
+
+  private async recordExchange(message: string, response: string): Promise<void> {
+    if (!this.currentState) return;
+
+    // Keep the session's rolling summary current; it folds in the background
+    const sessionId = this.currentState.sessionId;
+    this.noteService.recordTurn(this.createMessage(sessionId, 'user', message))
+      .then(() => this.noteService.recordTurn(this.createMessage(sessionId, 'ai', response)))
+      .catch(error => console.warn('Error updating conversation summary:', error));
+
+    // Save conversation to database
+    await this.dbService.saveConversation(
+      this.currentState.bookId,
+      this.currentState.history
+    );
+  }
+
+  // Summary of the conversation about the current book, kept up to date as
+  // messages are processed, so this returns almost immediately
+  async getConversationSummary(): Promise<string | null> {
+    if (!this.currentState) return null;
+    return await this.modelService.getSessionSummary(this.currentState.sessionId, true);
+  }
+
+  // The session turns are recorded under, for NoteService calls such as
+  // extractNotes() and generateSessionSummary()
+  getSessionId(): string | null {
+    return this.currentState?.sessionId ?? null;
+  }
+
+  private createMessage(
+    sessionId: string,
+    type: 'user' | 'ai',
+    content: string
+  ): ConversationMessage {
+    return {
+      id: `message_${Date.now()}_${Math.random().toString(36).substr(2, 9)}`,
+      sessionId,
+      content,
+      timestamp: new Date(),
+      type,
+    };
+  }
+
   async getConversationHistory(bookId: string): Promise<{ role: 'user' | 'assistant'; content: string }[]> {
     try {
       return await this.dbService.getConversation(bookId);
@@ -107,6 +107,45 @@ export class ModelService {
     }
   }
 
+  // Folds a turn into the session's rolling summary in the background
+  async summarizeTurn(sessionId: string, role: 'user' | 'assistant', content: string): Promise<void> {
+    if (!this.isInitialized) {
+      throw new Error('ModelService not initialized');
+    }
+
+    try {
+      await this.llmModule.addSummaryTurn(sessionId, role === 'user' ? 'Reader' : 'Assistant', content);
+    } catch (error) {
+      console.error('Error adding summary turn:', error);
+    }
+  }
+
+  // The session's rolling summary, or null if no turns were recorded. The
+  // session's summarizer is released unless keepOpen is set.
+  async getSessionSummary(sessionId: string, keepOpen: boolean = false): Promise<string | null> {
+    if (!this.isInitialized) return null;
+
+    try {
+      const summary = await this.llmModule.getSummary(sessionId);
+      if (!keepOpen) await this.llmModule.endSummary(sessionId);
+      return summary;
+    } catch (error) {
+      console.error('Error getting session summary:', error);
+      return null;
+    }
+  }
+
+  // Releases the session's summarizer without waiting for its summary
+  async endSession(sessionId: string): Promise<void> {
+    if (!this.isInitialized) return;
+
+    try {
+      await this.llmModule.endSummary(sessionId);
+    } catch (error) {
+      console.error('Error ending session summary:', error);
+    }
+  }
+
   async cleanup(): Promise<void> {
     try {
       if (this.isInitialized) {
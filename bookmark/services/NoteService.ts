@@ -229,10 +229,28 @@ Format each point as a separate note.`,
   }
 
   /**
-   * Generate a summary of notes for a session
+   * Feed a message into its session's rolling summary, which is updated in
+   * the background so the summary is ready when the session ends
+   */
+  async recordTurn(message: ConversationMessage): Promise<void> {
+    await this.modelService.summarizeTurn(
+      message.sessionId,
+      message.type === 'user' ? 'user' : 'assistant',
+      message.content
+    );
+  }
+
+  /**
+   * Generate a summary of a session. Sessions whose messages went through
+   * recordTurn() already have one; others are summarized from their notes.
    */
   async generateSessionSummary(sessionId: string): Promise<string> {
     try {
+      const rolling = await this.modelService.getSessionSummary(sessionId);
+      if (rolling) {
+        return rolling;
+      }
+
       const sessionNotes = await this.getNotes({ sessionId });
       
       if (sessionNotes.length === 0) {
@@ -1,23 +1,63 @@
 import * as FileSystem from 'expo-file-system';
 import { FaissModule } from '../native/faiss';
 import { MLCLLMModule } from '../native/mlc-llm';
+import { IngestModule, IngestProgress } from '../native/ingest';
+import { TermsModule } from '../native/terms';
+import { AnswerCacheModule } from '../native/answer-cache';
+import { ChunkStoreModule, ReductionKind, ReductionRecall } from '../native/chunk-store';
 import { ModelDownloader } from './ModelDownloader';
 
 interface Chunk {
   text: string;
   index: number;
+  start?: number; // byte offsets in the source file, set by native ingestion
+  end?: number;
+}
+
+// Cosine similarity a past question needs to reuse its answer
+const ANSWER_CACHE_THRESHOLD = 0.95;
+const ANSWER_CACHE_PATH = `${FileSystem.documentDirectory}answer-cache.bin`;
+
+// Chunks and embeddings of ingested books, kept apart from bookmark.db so
+// native ingestion can write it on its own connection
+const CHUNK_STORE_PATH = `${FileSystem.documentDirectory}chunks.db`;
+
+// Document frequencies across every ingested book, the IDF side of key
+// term scores; native ingestion keeps it up to date
+const TERM_LIBRARY_PATH = `${FileSystem.documentDirectory}term-library.bin`;
+
+// Per-book index files and the book text native ingestion reads
+const BOOK_INDEX_DIR = `${FileSystem.documentDirectory}books/`;
+
+// Library-wide transform applied to embeddings before indexing, once
+// trained. Each index keeps its own copy, so retraining only affects
+// indexes built afterwards.
+const EMBEDDING_REDUCTION_PATH = `${FileSystem.documentDirectory}embedding-reduction.bin`;
+
+// 32-bit FNV-1a, continuing from hash so texts can be chained
+function fnv1a(text: string, hash: number = 0x811c9dc5): number {
+  for (let i = 0; i < text.length; i++) {
+    hash ^= text.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193) >>> 0;
+  }
+  return hash;
 }
 
 export class RAGService {
   private static instance: RAGService;
   private faissModule: FaissModule;
   private llmModule: MLCLLMModule;
+  private answerCache: AnswerCacheModule;
   private chunks: Chunk[] = [];
+  // Identifies the index contents. Cached answers are tied to it, so any
+  // change to the index retires the answers built from the old one.
+  private indexVersion: string = '';
   private isInitialized: boolean = false;
 
   private constructor() {
     this.faissModule = FaissModule.getInstance();
     this.llmModule = MLCLLMModule.getInstance();
+    this.answerCache = AnswerCacheModule.getInstance();
   }
 
   static getInstance(): RAGService {
@@ -52,9 +92,16 @@ export class RAGService {
       if (!llmInitialized) throw new Error('Failed to initialize LLM');
 
       // Create FAISS index (768 dimensions for embeddings)
-      const faissInitialized = await this.faissModule.createIndex(768);
+      const faissInitialized = await this.faissModule.createIndex(768, await this.reductionPath());
       if (!faissInitialized) throw new Error('Failed to create FAISS index');
 
+      // A missing answer cache only costs speed, so don't fail over it
+      const cacheInitialized = await this.answerCache.initialize(768, {
+        path: ANSWER_CACHE_PATH,
+        threshold: ANSWER_CACHE_THRESHOLD,
+      }).catch(() => false);
+      if (!cacheInitialized) console.warn('Answer cache unavailable');
+
       if (onProgress) onProgress(1); // 100% complete
       this.isInitialized = true;
       return true;
@@ -73,11 +120,18 @@ export class RAGService {
       // Split text into chunks (simple implementation - could be improved)
       const chunks = text.split('\n\n').filter(chunk => chunk.trim().length > 0);
 
+      // The version hashes what the index holds: just this text when it
+      // starts empty, so the same book added after clearIndex() gets the
+      // same version (and keeps its cached answers) every time
+      let version = this.chunks.length > 0 ? Number(this.indexVersion) || undefined : undefined;
+
       // Get embeddings for each chunk
       for (let i = 0; i < chunks.length; i++) {
         const embeddings = await this.llmModule.getEmbeddings(chunks[i]);
         await this.faissModule.addEmbedding(embeddings);
         this.chunks.push({ text: chunks[i], index: i });
+        version = fnv1a(chunks[i], version);
+        this.indexVersion = version.toString();
       }
 
       return true;
@@ -87,6 +141,18 @@ export class RAGService {
     }
   }
 
+  // Empties the index so the next addText() starts a new book rather than
+  // appending to the previous one
+  async clearIndex(): Promise<void> {
+    if (!this.isInitialized) {
+      throw new Error('RAGService not initialized');
+    }
+
+    await this.faissModule.clearIndex();
+    this.chunks = [];
+    this.indexVersion = '';
+  }
+
   async query(
     question: string,
     k: number = 3
@@ -98,21 +164,27 @@ export class RAGService {
     try {
       // Get embeddings for the question
       const queryEmbeddings = await this.llmModule.getEmbeddings(question);
-
-      // Search for similar chunks
-      const results = await this.faissModule.search(queryEmbeddings, k);
-
-      // Map results to chunks
-      const chunks = results.map(r => this.chunks[r.index].text);
-      const distances = results.map(r => r.distance);
-
-      return { chunks, distances };
+      return await this.search(queryEmbeddings, k);
     } catch (error) {
       console.error('Error querying RAG:', error);
       throw error;
     }
   }
 
+  private async search(
+    queryEmbeddings: Float32Array,
+    k: number
+  ): Promise<{ chunks: string[]; distances: number[] }> {
+    // Search for similar chunks
+    const results = await this.faissModule.search(queryEmbeddings, k);
+
+    // Map results to chunks
+    const chunks = results.map(r => this.chunks[r.index].text);
+    const distances = results.map(r => r.distance);
+
+    return { chunks, distances };
+  }
+
   async generate(
     prompt: string,
     context: string[] = [],
@@ -144,27 +216,170 @@ export class RAGService {
     }
   }
 
+  // With cache set, answers are looked up by the embedding of
+  // cache.question within cache.bookId before anything is generated, and
+  // new answers are stored for next time. The question embedding doubles as
+  // the retrieval query, so a miss costs no extra embedding pass. Only pass
+  // cache when cache.question alone determines the answer: a prompt that
+  // carries earlier turns must not be served an answer given without them.
   async processQuery(
     question: string,
     maxTokens: number = 512,
-    temperature: number = 0.7
+    temperature: number = 0.7,
+    cache?: { bookId: string; question: string }
   ): Promise<string> {
     if (!this.isInitialized) {
       throw new Error('RAGService not initialized');
     }
 
     try {
-      // Get relevant chunks
-      const { chunks } = await this.query(question);
+      if (!cache) {
+        // Get relevant chunks
+        const { chunks } = await this.query(question);
+
+        // Generate response using chunks as context
+        return await this.generate(question, chunks, maxTokens, temperature);
+      }
 
-      // Generate response using chunks as context
-      return await this.generate(question, chunks, maxTokens, temperature);
+      const embedding = await this.llmModule.getEmbeddings(cache.question);
+      const cached = await this.answerCache
+        .lookup(cache.bookId, this.indexVersion, embedding)
+        .catch(() => null);
+      if (cached) return cached.answer;
+
+      const { chunks } = await this.search(embedding, 3);
+      const answer = await this.generate(question, chunks, maxTokens, temperature);
+
+      // Storing is best effort and shouldn't hold up the reply
+      this.answerCache
+        .insert(cache.bookId, this.indexVersion, embedding, answer)
+        .then(() => this.answerCache.save(ANSWER_CACHE_PATH))
+        .catch(error => console.warn('Error caching answer:', error));
+
+      return answer;
     } catch (error) {
       console.error('Error processing query:', error);
       throw error;
     }
   }
 
+  // Embeds a book file natively in one streaming pass and loads the
+  // resulting index. Much faster than addText() for full books. With a
+  // bookId, chunks and embeddings are also kept in the chunk store, so the
+  // index can later be checked and rebuilt without embedding again.
+  async ingestBook(
+    bookPath: string,
+    indexPath: string,
+    onProgress?: (progress: IngestProgress) => void,
+    bookId?: string
+  ): Promise<boolean> {
+    if (!this.isInitialized) {
+      throw new Error('RAGService not initialized');
+    }
+
+    const ingestModule = IngestModule.getInstance();
+    const unsubscribe = onProgress ? ingestModule.addListener(onProgress) : null;
+
+    try {
+      const ready = await ingestModule.initialize();
+      if (!ready) throw new Error('Failed to create ingestor');
+
+      const success = await ingestModule.ingest(bookPath, indexPath, {
+        store: bookId ? { path: CHUNK_STORE_PATH, bookId } : undefined,
+        reductionPath: await this.reductionPath(),
+        termLibraryPath: bookId ? TERM_LIBRARY_PATH : undefined,
+      });
+      if (!success) throw new Error('Failed to ingest book');
+
+      // Ingestion writes the book's term dictionary next to the index and
+      // adds it to the library
+      const terms = TermsModule.getInstance();
+      await terms.loadDictionary(indexPath.replace('.index', '.terms'));
+      if (bookId) {
+        await terms.loadLibrary(TERM_LIBRARY_PATH)
+          .catch(error => console.warn('Error loading term library:', error));
+      }
+
+      return await this.loadIndex(indexPath, bookId);
+    } catch (error) {
+      console.error('Error ingesting book:', error);
+      return false;
+    } finally {
+      if (unsubscribe) unsubscribe();
+      await ingestModule.cleanup();
+    }
+  }
+
+  // Makes book the one queries run against. Its saved index is loaded,
+  // after being checked against the chunk store and rebuilt from it if
+  // needed; a book seen for the first time is ingested natively.
+  async loadBook(
+    book: { id: string; content: string },
+    onProgress?: (progress: IngestProgress) => void
+  ): Promise<boolean> {
+    if (!this.isInitialized) {
+      throw new Error('RAGService not initialized');
+    }
+
+    try {
+      await FileSystem.makeDirectoryAsync(BOOK_INDEX_DIR, { intermediates: true }).catch(() => undefined);
+      const indexPath = `${BOOK_INDEX_DIR}${book.id}.index`;
+
+      const indexInfo = await FileSystem.getInfoAsync(indexPath);
+      const store = indexInfo.exists ? null : await this.openChunkStore();
+      const stored = store ? await store.getChunkCount(book.id).catch(() => 0) : 0;
+      if ((indexInfo.exists || stored > 0) && await this.loadIndex(indexPath, book.id)) {
+        // Term statistics are a nicety; the book is usable without them
+        const terms = TermsModule.getInstance();
+        await Promise.all([
+          terms.loadDictionary(indexPath.replace('.index', '.terms')),
+          terms.loadLibrary(TERM_LIBRARY_PATH),
+        ]).catch(error => console.warn('Error loading term statistics:', error));
+        return true;
+      }
+
+      const bookPath = `${BOOK_INDEX_DIR}${book.id}.txt`;
+      await FileSystem.writeAsStringAsync(bookPath, book.content);
+      return await this.ingestBook(bookPath, indexPath, onProgress, book.id);
+    } catch (error) {
+      console.error('Error loading book:', error);
+      return false;
+    }
+  }
+
+  // Chunks containing each occurrence of a word, using the term dictionary
+  // of the last ingested book. Only chunks with byte offsets can be matched.
+  async findTermChunks(word: string, maxResults: number = 10): Promise<string[]> {
+    const { offsets } = await TermsModule.getInstance().lookup(word, maxResults);
+    const located = this.chunks.filter(chunk => chunk.start !== undefined && chunk.end !== undefined);
+
+    const texts: string[] = [];
+    for (const offset of offsets) {
+      // Chunks are in file order, so the first one ending past the offset holds it
+      let low = 0;
+      let high = located.length;
+      while (low < high) {
+        const mid = (low + high) >> 1;
+        if (located[mid].end! <= offset) low = mid + 1;
+        else high = mid;
+      }
+      const chunk = located[low];
+      if (chunk && chunk.start! <= offset && !texts.includes(chunk.text)) {
+        texts.push(chunk.text);
+      }
+    }
+    return texts;
+  }
+
+  getChunkTexts(): string[] {
+    return this.chunks.map(chunk => chunk.text);
+  }
+
+  // Changes whenever the index (and so getChunkTexts()) does
+  getIndexVersion(): string {
+    return this.indexVersion;
+  }
+
   async saveIndex(path: string): Promise<boolean> {
     if (!this.isInitialized) {
       throw new Error('RAGService not initialized');
@@ -188,17 +403,46 @@ export class RAGService {
     }
   }
 
-  async loadIndex(path: string): Promise<boolean> {
+  // With a bookId the index is first checked against the book's chunks in
+  // the chunk store and rebuilt from the stored embeddings if it is missing
+  // or out of step, and the chunk texts come from the store if the JSON
+  // file is gone.
+  async loadIndex(path: string, bookId?: string): Promise<boolean> {
     try {
+      const store = bookId ? await this.openChunkStore() : null;
+      if (store && bookId) {
+        const verification = await store.verifyIndex(bookId, path);
+        if (!verification.ok && verification.stored > 0) {
+          console.warn(`Rebuilding index for ${bookId} from the chunk store`);
+          const rebuilt = await store.rebuildIndex(bookId, path, await this.reductionPath());
+          if (!rebuilt) throw new Error('Failed to rebuild index');
+        }
+      }
+
       // Load FAISS index
       const success = await this.faissModule.loadIndex(path);
       if (!success) throw new Error('Failed to load index');
 
       // Load chunks
-      const chunksJson = await FileSystem.readAsStringAsync(
-        path.replace('.index', '.json')
-      );
-      this.chunks = JSON.parse(chunksJson);
+      const chunksPath = path.replace('.index', '.json');
+      const chunksInfo = await FileSystem.getInfoAsync(chunksPath);
+      if (chunksInfo.exists || !store || !bookId) {
+        this.chunks = JSON.parse(await FileSystem.readAsStringAsync(chunksPath));
+      } else {
+        const stored = await store.getChunks(bookId);
+        this.chunks = stored.map((chunk, index) => ({
+          text: chunk.text,
+          index,
+          start: chunk.start >= 0 ? chunk.start : undefined,
+          end: chunk.end >= 0 ? chunk.end : undefined,
+        }));
+      }
+
+      // Re-ingesting a book rewrites its index file, which changes these
+      const info = await FileSystem.getInfoAsync(path);
+      this.indexVersion = info.exists
+        ? `${path}:${info.size}:${info.modificationTime}`
+        : path;
 
       return true;
     } catch (error) {
@@ -207,12 +451,54 @@ export class RAGService {
     }
   }
 
+  // Trains the embedding reduction from the embeddings of every stored book.
+  // Pick width from getReductionReport(); books ingested or rebuilt from
+  // then on are indexed at that width.
+  async trainEmbeddingReduction(width: number = 256, kind: ReductionKind = 'pca'): Promise<boolean> {
+    const store = await this.openChunkStore();
+    if (!store) return false;
+    try {
+      return await store.trainReduction(width, EMBEDDING_REDUCTION_PATH, { kind });
+    } catch (error) {
+      console.error('Error training embedding reduction:', error);
+      return false;
+    }
+  }
+
+  // Retrieval recall of the stored library at each candidate width
+  async getReductionReport(
+    widths: number[] = [64, 128, 256, 384, 768],
+    kind: ReductionKind = 'pca'
+  ): Promise<ReductionRecall[]> {
+    const store = await this.openChunkStore();
+    if (!store) return [];
+    return await store.getReductionReport(widths, { kind });
+  }
+
+  private async reductionPath(): Promise<string | undefined> {
+    const info = await FileSystem.getInfoAsync(EMBEDDING_REDUCTION_PATH);
+    return info.exists ? EMBEDDING_REDUCTION_PATH : undefined;
+  }
+
+  // Null when the store can't be opened; indexes are then used as they are
+  private async openChunkStore(): Promise<ChunkStoreModule | null> {
+    const store = ChunkStoreModule.getInstance();
+    const opened = await store.open(CHUNK_STORE_PATH).catch(() => false);
+    if (!opened) {
+      console.warn('Chunk store unavailable');
+      return null;
+    }
+    return store;
+  }
+
   async cleanup(): Promise<void> {
     try {
       if (this.isInitialized) {
         await Promise.all([
           this.faissModule.cleanup(),
-          this.llmModule.cleanup()
+          this.llmModule.cleanup(),
+          this.answerCache.cleanup(),
+          ChunkStoreModule.getInstance().cleanup().catch(() => undefined)
         ]);
         this.isInitialized = false;
       }
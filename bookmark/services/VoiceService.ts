@@ -2,23 +2,42 @@ import { Audio } from 'expo-av';
 import * as FileSystem from 'expo-file-system';
 import { WhisperModule } from '../native/whisper';
 import { TTSModule } from '../native/tts';
+import { VoicePipelineModule, VoicePipelineEvent } from '../native/voice-pipeline';
+import { ResidencyModule } from '../native/residency';
 import { ModelDownloader } from './ModelDownloader';
+import { RAGService } from './RAGService';
 
 type TranscriptionCallback = (text: string) => void;
 
+// A turn answered natively: what was heard, then the answer once it has
+// been spoken ('' if there was none)
+export interface VoiceTurnHandlers {
+  onTranscript: (text: string) => void;
+  onResponse: (text: string) => void;
+}
+
 export class VoiceService {
   private static instance: VoiceService;
   private whisperModule: WhisperModule;
   private ttsModule: TTSModule;
+  private voicePipeline: VoicePipelineModule;
+  private ragService: RAGService;
+  private residency: ResidencyModule;
   private modelDownloader: ModelDownloader;
   private recording: Audio.Recording | null = null;
   private isListening: boolean = false;
   private isInitialized: boolean = false;
   private audioPlayer: Audio.Sound | null = null;
+  private pipelineCreated: boolean = false;
+  private pipelineUnavailable: boolean = false;
+  private pipelineIndexVersion: string | null = null;
 
   private constructor() {
     this.whisperModule = WhisperModule.getInstance();
     this.ttsModule = TTSModule.getInstance();
+    this.voicePipeline = VoicePipelineModule.getInstance();
+    this.ragService = RAGService.getInstance();
+    this.residency = ResidencyModule.getInstance();
     this.modelDownloader = ModelDownloader.getInstance();
   }
 
@@ -70,6 +89,15 @@ export class VoiceService {
         throw new Error('Failed to initialize TTS');
       }
 
+      // Encode at the voice's native rate and cache rendered phrases on disk
+      const ttsConfig = JSON.parse(await FileSystem.readAsStringAsync(ttsConfigPath));
+      if (ttsConfig.audio?.sample_rate) {
+        await this.ttsModule.setSampleRate(ttsConfig.audio.sample_rate);
+      }
+      await this.ttsModule.setCacheDirectory(
+        `${FileSystem.cacheDirectory}tts`.replace(/^file:\/\//, '')
+      );
+
       // Request audio permissions
       const permission = await Audio.requestPermissionsAsync();
       if (!permission.granted) {
@@ -91,7 +119,16 @@ export class VoiceService {
     }
   }
 
-  async startListening(onTranscription: TranscriptionCallback): Promise<void> {
+  /**
+   * Record and answer the user. With turn handlers, each recording is
+   * answered natively in one bridge call (see answerNatively) and
+   * onTranscription isn't used; without them, or when the native pipeline
+   * isn't available, recordings are only transcribed and the caller answers.
+   */
+  async startListening(
+    onTranscription: TranscriptionCallback,
+    turn?: VoiceTurnHandlers
+  ): Promise<void> {
     if (!this.isInitialized) {
       throw new Error('VoiceService not initialized');
     }
@@ -102,6 +139,7 @@ export class VoiceService {
 
     try {
       this.isListening = true;
+      const nativeTurn = turn && await this.preparePipeline() ? turn : undefined;
 
       // Start recording
       this.recording = new Audio.Recording();
@@ -128,8 +166,13 @@ export class VoiceService {
 
       await this.recording.startAsync();
 
+      // The user is speaking: bring back anything evicted that this turn will
+      // need, while they talk rather than after. Best effort only.
+      this.residency.prefetch('whisper').catch(() => {});
+      this.residency.prefetch('llm').catch(() => {});
+
       // Start monitoring for voice activity
-      this.monitorAudio(onTranscription);
+      this.monitorAudio(onTranscription, nativeTurn);
     } catch (error) {
       console.error('Error starting voice recording:', error);
       this.isListening = false;
@@ -137,7 +180,10 @@ export class VoiceService {
     }
   }
 
-  private async monitorAudio(onTranscription: TranscriptionCallback): Promise<void> {
+  private async monitorAudio(
+    onTranscription: TranscriptionCallback,
+    turn?: VoiceTurnHandlers
+  ): Promise<void> {
     if (!this.recording || !this.isListening) return;
 
     try {
@@ -152,18 +198,22 @@ export class VoiceService {
         const uri = this.recording.getURI();
         if (!uri) throw new Error('No recording URI available');
 
-        // Convert audio to PCM data
-        const pcmData = await this.convertAudioToPCM(uri);
-        
-        // Transcribe the audio
-        const transcription = await this.whisperModule.transcribe(
-          pcmData,
-          16000,
-          { language: 'en' }
-        );
-
-        if (transcription.trim()) {
-          onTranscription(transcription.trim());
+        if (turn) {
+          await this.answerNatively(uri, turn);
+        } else {
+          // Convert audio to PCM data
+          const pcmData = await this.convertAudioToPCM(uri);
+
+          // Transcribe the audio
+          const transcription = await this.whisperModule.transcribe(
+            pcmData,
+            16000,
+            { language: 'en' }
+          );
+
+          if (transcription.trim()) {
+            onTranscription(transcription.trim());
+          }
         }
 
         // Start a new recording if still listening
@@ -195,7 +245,7 @@ export class VoiceService {
 
       // Continue monitoring if still listening
       if (this.isListening) {
-        setTimeout(() => this.monitorAudio(onTranscription), 500);
+        setTimeout(() => this.monitorAudio(onTranscription, turn), 500);
       }
     } catch (error) {
       console.error('Error monitoring audio:', error);
@@ -229,29 +279,22 @@ export class VoiceService {
         this.audioPlayer = null;
       }
 
-      // Generate speech using TTS
-      const audioSamples = await this.ttsModule.synthesize(text);
-
-      // Create an audio buffer from the samples
-      const audioBuffer = new ArrayBuffer(audioSamples.length * 4); // 4 bytes per float32
-      const view = new Float32Array(audioBuffer);
-      audioSamples.forEach((sample, i) => view[i] = sample);
-
-      // Create a temporary file for the audio
-      const tempFile = `${FileSystem.cacheDirectory}/temp_speech.wav`;
-      await FileSystem.writeAsStringAsync(tempFile, audioBuffer.toString());
+      // Synthesize to a WAV file natively (or reuse the cached rendering)
+      const wavPath = await this.ttsModule.synthesizeToFile(text);
+      if (!wavPath) {
+        throw new Error('Failed to synthesize speech');
+      }
 
       // Play the audio
       this.audioPlayer = new Audio.Sound();
-      await this.audioPlayer.loadAsync({ uri: tempFile });
+      await this.audioPlayer.loadAsync({ uri: `file://${wavPath}` });
       await this.audioPlayer.playAsync();
 
-      // Clean up when done
+      // Clean up when done; the WAV file stays in the cache for replays
       this.audioPlayer.setOnPlaybackStatusUpdate(async (status) => {
         if (status.didJustFinish) {
           await this.audioPlayer?.unloadAsync();
           this.audioPlayer = null;
-          await FileSystem.deleteAsync(tempFile, { idempotent: true });
         }
       });
     } catch (error) {
@@ -260,6 +303,74 @@ export class VoiceService {
     }
   }
 
+  /**
+   * Ready the native turn pipeline for the book loaded in RAGService. False
+   * means turns take the JS path: the pipeline couldn't be created, or
+   * there is no book index to answer from yet.
+   */
+  private async preparePipeline(): Promise<boolean> {
+    if (this.pipelineUnavailable) return false;
+
+    const chunks = this.ragService.getChunkTexts();
+    if (chunks.length === 0) return false;
+
+    try {
+      if (!this.pipelineCreated) {
+        // Shares the Whisper, LLM, FAISS and TTS contexts already loaded
+        if (!await this.voicePipeline.initialize()) {
+          this.pipelineUnavailable = true;
+          return false;
+        }
+        this.pipelineCreated = true;
+      }
+
+      const version = this.ragService.getIndexVersion();
+      if (version !== this.pipelineIndexVersion) {
+        await this.voicePipeline.setChunks(chunks);
+        this.pipelineIndexVersion = version;
+      }
+      return true;
+    } catch (error) {
+      console.error('Error initializing voice pipeline:', error);
+      if (!this.pipelineCreated) this.pipelineUnavailable = true;
+      return false;
+    }
+  }
+
+  /**
+   * Answer a recording natively: transcription, retrieval, generation and
+   * speech all run in a single bridge call, with audio played as each
+   * sentence is synthesized. Resolves once the answer has been spoken.
+   */
+  private async answerNatively(uri: string, turn: VoiceTurnHandlers): Promise<void> {
+    let answer = '';
+    let finish: () => void = () => {};
+    const finished = new Promise<void>(resolve => { finish = resolve; });
+
+    const unsubscribe = this.voicePipeline.addListener((event: VoicePipelineEvent) => {
+      if (event.type === 'transcript' && event.text.trim()) {
+        turn.onTranscript(event.text.trim());
+      } else if (event.type === 'done') {
+        answer = event.text;
+        finish();
+      } else if (event.type === 'error') {
+        console.warn('Voice turn failed:', event.text);
+        finish();
+      }
+    });
+
+    try {
+      // Events are delivered separately from the result; wait for the last
+      // one before letting go of the listener
+      if (await this.voicePipeline.runTurn(uri)) {
+        await finished;
+      }
+    } finally {
+      unsubscribe();
+      turn.onResponse(answer);
+    }
+  }
+
   private async convertAudioToPCM(uri: string): Promise<Float32Array> {
     try {
       // Read WAV file
@@ -302,6 +413,10 @@ export class VoiceService {
         this.audioPlayer = null;
       }
       if (this.isInitialized) {
+        await this.voicePipeline.cleanup();
+        this.pipelineCreated = false;
+        this.pipelineUnavailable = false;
+        this.pipelineIndexVersion = null;
         await Promise.all([
           this.whisperModule.cleanup(),
           this.ttsModule.cleanup()